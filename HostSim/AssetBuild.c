@@ -0,0 +1,58 @@
+/*!
+\file AssetBuild.c
+\brief Resource build tool
+\date 10/2026
+
+Builds the rescomp .res files of the game (Resource Compilation/images.res, sprites.res and audio.res) into the .s and
+.h files of Gemu/res on Linux, as the Compile *.bat scripts have rescomp do on Windows: the same structures under the
+same names (see Resource.h). Resources are converted on every core, and only when their input file changed since
+the last build: the outputs are kept by content hash in a cache directory (see ResourceBuild.h).
+
+Options:
+-c directory	Cache directory (default: .assetcache in the working directory). -c none converts everything.
+-j threads	Number of threads (default: one per core).
+-x command	SGDK's xgmtool, which compiles XGM music (default: $GDK/bin/xgmtool, or xgmtool on the PATH).
+
+Usage: assetbuild [-c cache] [-j threads] [-x xgmtool] outputDirectory file.res...
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ResourceBuild.h"
+#include "WorkStealing.h"
+
+#define DEFAULT_CACHE ".assetcache"	/*!< Cache directory, from the working directory. */
+
+
+int main(int argc, char **argv) {
+	char xgmtool[1024] = "xgmtool";
+	BuildOptions options = { DEFAULT_CACHE, xgmtool, 0 };
+	BuildStats stats;
+	int arg = 1;
+
+	if (getenv("GDK") != NULL)
+		snprintf(xgmtool, sizeof(xgmtool), "%s/bin/xgmtool", getenv("GDK"));
+	for (; arg + 1 < argc && argv[arg][0] == '-'; arg += 2) {
+		if (strcmp(argv[arg], "-c") == 0)
+			options.cacheDirectory = (strcmp(argv[arg + 1], "none") != 0) ? argv[arg + 1] : NULL;
+		else if (strcmp(argv[arg], "-j") == 0)
+			options.threads = (u32)strtoul(argv[arg + 1], NULL, 10);
+		else if (strcmp(argv[arg], "-x") == 0)
+			options.xgmtool = argv[arg + 1];
+		else
+			break;
+	}
+	if (argc - arg < 2) {
+		fprintf(stderr, "usage: %s [-c cache] [-j threads] [-x xgmtool] outputDirectory file.res...\n", argv[0]);
+		return 1;
+	}
+
+	uint64_t start = monotonicNanoseconds();
+	if (buildResources(&stats, (const char **)(argv + arg + 1), (u32)(argc - arg - 1), argv[arg], &options) != 0)
+		return 1;
+	printf("%u resources: %u converted, %u from the cache, %u files written, %.2f s\n", stats.resources, stats.converted,
+		stats.cached, stats.filesWritten, (monotonicNanoseconds() - start) / 1e9);
+	return 0;
+}
@@ -0,0 +1,542 @@
+/*!
+\file AssetCooker.c
+\brief Background asset cooker
+\date 10/2026
+
+Builds the IMAGE resources of a rescomp .res file (e.g. Resource Compilation/images.res) into the same SGDK Image
+structures rescomp writes (.s and .h), with less ROM:
+- Tiles shared across images: tilesets stored as is (NONE) become windows of one array of tiles, so that a tile that
+  several images have, as is or flipped, is stored once (see TileImage.h). rescomp only shares tiles inside an image.
+- Packing by measured unpack time: every tileset and tilemap is packed with aPLib and LZ4W (see Pack.h), and unpacked
+  by SGDK's own unpackers in the ROM on the 68000 interpreter (see Unpack68k.h), which checks the data and gives the
+  cycles. The compression column of the .res file chooses: NONE, APLIB or FAST/LZ4W as written. For the BEST/AUTO
+  assets of a stage, the methods that take the fewest bytes while unpacking the stage stays within a budget (-l).
+
+A stage is a group of IMAGE lines between blank lines. The report lists, for every stage, the ROM bytes of every
+asset with each method and the one chosen, the bytes saved against rescomp (NONE, no sharing across images), and the
+68000 cycles unpacking takes when the stage is loaded. Only uncompressed stages can be streamed into VRAM (main.c):
+the report says which stages are.
+
+Options:
+-a	Every image is BEST/AUTO, whatever its compression column says.
+-l frames	Unpacking budget of a stage load, in frames (default 8).
+-r file	Writes the report to a file instead of the standard output.
+
+Usage: assetcooker [-a] [-l frames] [-r report] rom.bin rom.out input.res output.s
+*/
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Png.h"
+#include "TileImage.h"
+#include "Pack.h"
+#include "Unpack68k.h"
+
+#define MAX_IMAGES 64	/*!< Most IMAGE lines in a .res file. */
+#define MAX_PATH 1024	/*!< Longest file path. */
+#define MAX_NAME 128	/*!< Longest resource name. */
+#define MAX_LINE 2048	/*!< Longest line of a .res file. */
+#define DEFAULT_BUDGET_FRAMES 8	/*!< Less than half the fade of a stage change (STAGE_FADE_FRAMES in main.c). */
+#define AUTOMATIC -1	/*!< Compression column BEST/AUTO. */
+#define ASSETS 2	/*!< Packed assets of an image: its tileset and its tilemap. */
+#define PALETTE_BYTES (TILE_PALETTE_COLORS * 2)
+
+/*! \brief Enumeration with the assets of an image. */
+typedef enum {
+	TilesetAsset,
+	TilemapAsset
+} AssetType;
+
+static const char *assetNames[ASSETS] = { "tileset", "tilemap" };
+
+/*! \brief Structure with an asset packed every way, and the way chosen. */
+typedef struct {
+	u8 *raw;
+	u32 rawSize;
+	u8 *packed[PACK_METHODS];	/**< NULL for PackNone, and for a method that cannot pack it */
+	u32 size[PACK_METHODS];	/**< ROM bytes with every method */
+	u32 cycles[PACK_METHODS];	/**< 68000 cycles to unpack with every method, 0 for PackNone */
+	PackMethod method;	/**< The method chosen */
+	u8 automatic;	/**< Chosen by the cooker (BEST/AUTO) */
+} Asset;
+
+/*! \brief Structure with an IMAGE resource. */
+typedef struct {
+	char name[MAX_NAME];
+	char path[MAX_PATH];
+	s8 compression;	/**< PackMethod, or AUTOMATIC */
+	u16 stage;	/**< Group of lines it is in */
+	TileImage tiles;
+	Asset asset[ASSETS];
+	u8 pooled;	/**< Its tileset is a window of the shared tiles */
+	u32 poolFirst;	/**< First tile of that window */
+	u32 sharedTiles;	/**< Tiles of that window stored for the image before it in the pool */
+} CookedImage;
+
+static CookedImage images[MAX_IMAGES];
+static u32 imageCount;
+static u16 stageCount;
+static TilePool pool;
+
+
+static int fail(const char *message, const char *detail) {
+	fprintf(stderr, "assetcooker: %s%s%s\n", message, (detail != NULL) ? ": " : "", (detail != NULL) ? detail : "");
+	return 1;
+}
+
+
+/*! Reads a compression column as rescomp does. Returns -2 if it is not one. */
+static int parseCompression(const char *text) {
+	static const char *names[] = { "-1", "BEST", "AUTO", "0", "NONE", "1", "APLIB", "2", "FAST", "LZ4W" };
+	static const s8 values[] = { AUTOMATIC, AUTOMATIC, AUTOMATIC, PackNone, PackNone, PackAplib, PackAplib, PackLz4w, PackLz4w, PackLz4w };
+	for (u32 i = 0; i < sizeof(values); ++i) {
+		const char *a = names[i], *b = text;
+		while (*a != '\0' && toupper((unsigned char)*b) == *a)
+			++a, ++b;
+		if (*a == '\0' && *b == '\0')
+			return values[i];
+	}
+	return -2;
+}
+
+
+/*! Splits a line into words; a word in quotes may hold spaces. Returns the number of words. */
+static u32 splitLine(char *line, char *words[], u32 most) {
+	u32 count = 0;
+	while (count < most) {
+		while (isspace((unsigned char)*line))
+			++line;
+		if (*line == '\0')
+			break;
+		if (*line == '"') {
+			words[count++] = ++line;
+			while (*line != '\0' && *line != '"')
+				++line;
+		}
+		else {
+			words[count++] = line;
+			while (*line != '\0' && !isspace((unsigned char)*line))
+				++line;
+		}
+		if (*line != '\0')
+			*line++ = '\0';
+	}
+	return count;
+}
+
+
+/*! Reads the IMAGE lines of a .res file. Other resources are left to rescomp. */
+static int readResources(const char *path, u8 allAutomatic) {
+	char line[MAX_LINE], directory[MAX_PATH];
+	FILE *file = fopen(path, "r");
+	u8 inStage = FALSE;
+
+	if (file == NULL)
+		return fail("cannot read", path);
+	strncpy(directory, path, sizeof(directory) - 1);
+	directory[sizeof(directory) - 1] = '\0';
+	char *slash = strrchr(directory, '/');
+	if (slash != NULL)
+		slash[1] = '\0';
+	else
+		directory[0] = '\0';
+
+	while (fgets(line, sizeof(line), file) != NULL) {
+		char *words[5];
+		u32 count = splitLine(line, words, 5);
+		if (count == 0) {
+			stageCount += inStage;
+			inStage = FALSE;
+			continue;
+		}
+		if (strcmp(words[0], "IMAGE") != 0)
+			continue;
+		if (count < 3 || count > 4)
+			return fclose(file), fail("IMAGE lines are: IMAGE name file [compression]", words[1]);
+		if (imageCount == MAX_IMAGES)
+			return fclose(file), fail("too many images", words[1]);
+
+		CookedImage *image = &images[imageCount++];
+		int compression = (count > 3) ? parseCompression(words[3]) : PackNone;
+		if (compression == -2)
+			return fclose(file), fail("unknown compression", words[3]);
+		image->compression = allAutomatic ? AUTOMATIC : (s8)compression;
+		image->stage = stageCount;
+		snprintf(image->name, sizeof(image->name), "%s", words[1]);
+		snprintf(image->path, sizeof(image->path), "%s%s", directory, words[2]);
+		inStage = TRUE;
+	}
+	stageCount += inStage;
+	fclose(file);
+	return 0;
+}
+
+
+/*! Writes the raw bytes of the tilemap of an image. */
+static void writeMapBytes(Asset *asset, const TileImage *tiles) {
+	for (u32 entry = 0; entry < asset->rawSize / 2; ++entry) {
+		asset->raw[2 * entry] = (u8)(tiles->map[entry] >> 8);
+		asset->raw[2 * entry + 1] = (u8)tiles->map[entry];
+	}
+}
+
+
+/*! Packs an asset with every method, and unpacks it on the 68000. */
+static int packAsset(Asset *asset, Unpacker *unpacker, u8 *unpacked, const char *name) {
+	asset->size[PackNone] = asset->rawSize;
+	asset->cycles[PackNone] = 0;
+	for (u8 method = PackAplib; method < PACK_METHODS; ++method) {
+		free(asset->packed[method]);
+		asset->packed[method] = malloc(packBound(asset->rawSize));
+		if (asset->packed[method] == NULL)
+			return fail("out of memory", name);
+		asset->size[method] = packData((PackMethod)method, asset->raw, asset->rawSize, asset->packed[method]);
+		if (asset->size[method] == 0) {
+			free(asset->packed[method]);
+			asset->packed[method] = NULL;
+			continue;
+		}
+		s32 size = unpackOnConsole(unpacker, (PackMethod)method, asset->packed[method], asset->size[method], unpacked, &asset->cycles[method]);
+		if (size != (s32)asset->rawSize || memcmp(unpacked, asset->raw, asset->rawSize) != 0)
+			return fail("the console does not unpack what was packed", name);
+	}
+	return 0;
+}
+
+
+static int loadImage(CookedImage *image, Unpacker *unpacker, u8 *unpacked) {
+	IndexedImage indexed;
+	char name[MAX_NAME + 16];
+
+	if (loadIndexedPng(&indexed, image->path) != 0)
+		return fail("not an indexed PNG image", image->path);
+	int converted = convertTileImage(&image->tiles, &indexed);
+	freeIndexedImage(&indexed);
+	if (converted != 0)
+		return fail("size not a multiple of 8, or more than 2048 tiles", image->path);
+
+	for (u8 type = 0; type < ASSETS; ++type) {
+		Asset *asset = &image->asset[type];
+		asset->rawSize = (type == TilesetAsset) ? image->tiles.tileCount * TILE_BYTES : image->tiles.width * image->tiles.height * 2u;
+		asset->raw = malloc(asset->rawSize + 1);
+		if (asset->raw == NULL)
+			return fail("out of memory", image->name);
+		if (type == TilesetAsset)
+			writeTileBytes(asset->raw, image->tiles.tiles, image->tiles.tileCount);
+		else
+			writeMapBytes(asset, &image->tiles);
+		asset->automatic = image->compression == AUTOMATIC;
+		asset->method = asset->automatic ? PackNone : (PackMethod)image->compression;
+		if (asset->rawSize > UNPACK_CAPACITY && asset->method != PackNone)
+			return fail("too large to unpack in RAM", image->name);
+		snprintf(name, sizeof(name), "%s %s", image->name, assetNames[type]);
+		if (asset->rawSize <= UNPACK_CAPACITY && packAsset(asset, unpacker, unpacked, name) != 0)
+			return 1;
+	}
+	return 0;
+}
+
+
+/*! \brief Structure with the search for the methods of the BEST/AUTO assets of a stage. */
+typedef struct {
+	Asset *asset[MAX_IMAGES * ASSETS];
+	u32 count;
+	PackMethod method[MAX_IMAGES * ASSETS];	/**< Methods being tried */
+	PackMethod best[MAX_IMAGES * ASSETS];	/**< Methods of the best choice found */
+	u32 bestBytes;
+	u32 bestCycles;
+} MethodSearch;
+
+
+/*! Tries every method for the assets from 'next' on, with the bytes and cycles of the ones before. */
+static void searchMethods(MethodSearch *search, u32 next, u32 bytes, u32 cycles, u32 budget) {
+	if (bytes > search->bestBytes)
+		return;
+	if (next == search->count) {
+		if (bytes < search->bestBytes || cycles < search->bestCycles) {
+			search->bestBytes = bytes;
+			search->bestCycles = cycles;
+			memcpy(search->best, search->method, sizeof(PackMethod) * search->count);
+		}
+		return;
+	}
+	const Asset *asset = search->asset[next];
+	for (u8 method = 0; method < PACK_METHODS; ++method)
+		if ((method == PackNone || asset->packed[method] != NULL) && cycles + asset->cycles[method] <= budget) {
+			search->method[next] = (PackMethod)method;
+			searchMethods(search, next + 1, bytes + asset->size[method], cycles + asset->cycles[method], budget);
+		}
+}
+
+
+/*! Chooses the methods of the BEST/AUTO assets of a stage: the fewest bytes, with unpacking within the budget. */
+static void chooseMethods(u16 stage, u32 budget) {
+	static MethodSearch search;
+	u32 fixed = 0;
+
+	search.count = 0;
+	for (u32 i = 0; i < imageCount; ++i)
+		for (u8 type = 0; type < ASSETS && images[i].stage == stage; ++type) {
+			Asset *asset = &images[i].asset[type];
+			if (asset->automatic)
+				search.asset[search.count++] = asset;
+			else
+				fixed += asset->cycles[asset->method];
+		}
+
+	// Uncompressed always fits what the forced methods leave.
+	search.bestBytes = UINT32_MAX;
+	search.bestCycles = UINT32_MAX;
+	searchMethods(&search, 0, 0, 0, (fixed < budget) ? budget - fixed : 0);
+	for (u32 i = 0; i < search.count; ++i)
+		search.asset[i]->method = search.best[i];
+}
+
+
+/*! Shares the tiles of the uncompressed tilesets, then packs their tilemaps again. */
+static int poolTilesets(Unpacker *unpacker, u8 *unpacked) {
+	TileImage pooled[MAX_IMAGES];
+	u32 index[MAX_IMAGES], count = 0;
+
+	for (u32 i = 0; i < imageCount; ++i)
+		if (images[i].asset[TilesetAsset].method == PackNone) {
+			index[count] = i;
+			pooled[count++] = images[i].tiles;
+		}
+	if (poolTileImages(&pool, pooled, count) != 0)
+		return fail("out of memory", "tile pool");
+
+	for (u32 p = 0; p < count; ++p) {
+		CookedImage *image = &images[index[p]];
+		u32 end = 0;
+		image->pooled = TRUE;
+		image->poolFirst = pool.first[p];
+		for (u32 q = 0; q < count; ++q)
+			if (pool.first[q] < pool.first[p] && pool.first[q] + pooled[q].tileCount > end)
+				end = pool.first[q] + pooled[q].tileCount;
+		image->sharedTiles = (end > image->poolFirst) ? end - image->poolFirst : 0;
+		writeTileBytes(image->asset[TilesetAsset].raw, image->tiles.tiles, image->tiles.tileCount);
+		writeMapBytes(&image->asset[TilemapAsset], &image->tiles);
+		if (image->asset[TilemapAsset].rawSize <= UNPACK_CAPACITY
+			&& packAsset(&image->asset[TilemapAsset], unpacker, unpacked, image->name) != 0)
+			return 1;
+	}
+	return 0;
+}
+
+
+static void writeLabel(FILE *out, const char *name, const char *suffix) {
+	fprintf(out, "    .align 2\n%s%s:\n", name, suffix);
+}
+
+static void writeWords(FILE *out, const u8 *bytes, u32 size) {
+	for (u32 i = 0; i < size / 2; ++i)
+		fprintf(out, "%s0x%04X%s", (i % 8 == 0) ? "    dc.w    " : "", (bytes[2 * i] << 8) | bytes[2 * i + 1],
+			(i % 8 == 7 || i == size / 2 - 1) ? "\n" : ", ");
+}
+
+static void writeBytes(FILE *out, const u8 *bytes, u32 size) {
+	for (u32 i = 0; i < size; ++i)
+		fprintf(out, "%s0x%02X%s", (i % 16 == 0) ? "    dc.b    " : "", bytes[i], (i % 16 == 15 || i == size - 1) ? "\n" : ", ");
+}
+
+/*! Writes an asset as the method chosen stores it. */
+static void writeAsset(FILE *out, const Asset *asset) {
+	if (asset->method == PackNone)
+		writeWords(out, asset->raw, asset->rawSize);
+	else
+		writeBytes(out, asset->packed[asset->method], asset->size[asset->method]);
+	fprintf(out, "\n");
+}
+
+
+/*! Writes the SGDK structures of every image, in the layout of rescomp, then the shared tiles. */
+static int writeAssembly(const char *path) {
+	FILE *out = fopen(path, "w");
+	if (out == NULL)
+		return fail("cannot write", path);
+
+	fprintf(out, ".section .rodata\n\n");
+	for (u32 i = 0; i < imageCount; ++i) {
+		const CookedImage *image = &images[i];
+		const Asset *tileset = &image->asset[TilesetAsset], *tilemap = &image->asset[TilemapAsset];
+		u8 palette[PALETTE_BYTES];
+		for (u8 color = 0; color < TILE_PALETTE_COLORS; ++color) {
+			palette[2 * color] = (u8)(image->tiles.palette[color] >> 8);
+			palette[2 * color + 1] = (u8)image->tiles.palette[color];
+		}
+
+		writeLabel(out, image->name, "_palette_pal");
+		writeWords(out, palette, PALETTE_BYTES);
+		fprintf(out, "\n");
+		writeLabel(out, image->name, "_palette");
+		fprintf(out, "    dc.w    0, %u\n    dc.l    %s_palette_pal\n\n", TILE_PALETTE_COLORS, image->name);
+		writeLabel(out, image->name, "_tilemap_map");
+		writeAsset(out, tilemap);
+		writeLabel(out, image->name, "_tilemap");
+		fprintf(out, "    dc.w    %u\n    dc.w    %u, %u\n    dc.l    %s_tilemap_map\n\n",
+			tilemap->method, image->tiles.width, image->tiles.height, image->name);
+		if (!image->pooled) {
+			writeLabel(out, image->name, "_tileset_tiles");
+			writeAsset(out, tileset);
+		}
+		writeLabel(out, image->name, "_tileset");
+		fprintf(out, "    dc.w    %u\n    dc.w    %u\n    dc.l    %s_tileset_tiles\n\n", tileset->method, image->tiles.tileCount, image->name);
+		fprintf(out, "    .align 2\n    .global %s\n%s:\n", image->name, image->name);
+		fprintf(out, "    dc.l    %s_palette\n    dc.l    %s_tileset\n    dc.l    %s_tilemap\n\n", image->name, image->name, image->name);
+	}
+
+	// The shared tiles, with the label of every tileset where its window starts.
+	if (pool.count > 0)
+		fprintf(out, "    .align 2\n");
+	for (u32 tile = 0; tile < pool.count; ++tile) {
+		u8 bytes[TILE_BYTES];
+		for (u32 i = 0; i < imageCount; ++i)
+			if (images[i].pooled && images[i].poolFirst == tile && images[i].tiles.tileCount > 0)
+				fprintf(out, "%s_tileset_tiles:\n", images[i].name);
+		writeTileBytes(bytes, &pool.tiles[tile], 1);
+		writeWords(out, bytes, TILE_BYTES);
+	}
+	fprintf(out, "\n");
+	return (fclose(out) == 0) ? 0 : fail("cannot write", path);
+}
+
+
+/*! Writes the header rescomp writes next to the .s file: output.h, with a guard from the file name. */
+static int writeHeader(const char *assemblyPath) {
+	char path[MAX_PATH], guard[MAX_PATH];
+	snprintf(path, sizeof(path), "%s", assemblyPath);
+	char *dot = strrchr(path, '.');
+	if (dot == NULL || strchr(dot, '/') != NULL)
+		dot = path + strlen(path);
+	strcpy(dot, ".h");
+
+	const char *base = strrchr(path, '/');
+	base = (base != NULL) ? base + 1 : path;
+	u32 length = 0;
+	for (; base[length] != '\0' && base[length] != '.'; ++length)
+		guard[length] = (char)toupper((unsigned char)base[length]);
+	guard[length] = '\0';
+
+	FILE *out = fopen(path, "w");
+	if (out == NULL)
+		return fail("cannot write", path);
+	fprintf(out, "#ifndef __%s_H_\n#define __%s_H_\n\n", guard, guard);
+	for (u32 i = 0; i < imageCount; ++i)
+		fprintf(out, "extern const Image %s;\n", images[i].name);
+	fprintf(out, "\n#endif // __%s_H_\n", guard);
+	return (fclose(out) == 0) ? 0 : fail("cannot write", path);
+}
+
+
+static void reportCandidate(FILE *report, const Asset *asset, PackMethod method) {
+	if (method == PackNone)
+		fprintf(report, " %7u", asset->size[PackNone]);
+	else if (asset->packed[method] == NULL)
+		fprintf(report, " %7s %9s", "-", "-");
+	else
+		fprintf(report, " %7u %9u", asset->size[method], asset->cycles[method]);
+}
+
+
+/*! Writes the bytes and unpack cycles of every stage. */
+static void writeReport(FILE *report, u32 budget) {
+	u32 totalRescomp = 0, totalCooked = 0, totalShared = 0;
+
+	fprintf(report, "Unpack budget of a stage load: %u cycles (%.1f frames)\n", budget, (double)budget / MD_FRAME_CYCLES);
+	for (u16 stage = 0; stage < stageCount; ++stage) {
+		u32 rescomp = 0, cooked = 0, shared = 0, cycles = 0;
+		u8 streamed = TRUE;
+
+		fprintf(report, "\nstage %u\n  %-28s %7s %7s %9s %7s %9s  %s\n", stage + 1, "asset", "NONE", "APLIB", "cycles", "FAST", "cycles", "chosen");
+		for (u32 i = 0; i < imageCount; ++i) {
+			const CookedImage *image = &images[i];
+			if (image->stage != stage)
+				continue;
+			rescomp += PALETTE_BYTES;
+			cooked += PALETTE_BYTES;
+			for (u8 type = 0; type < ASSETS; ++type) {
+				const Asset *asset = &image->asset[type];
+				// The name, padded to 28 columns: printed straight, so that no name is cut.
+				int written = fprintf(report, "  %s %s", image->name, assetNames[type]);
+				fprintf(report, "%*s", (written < 30) ? 30 - written : 0, "");
+				for (u8 method = 0; method < PACK_METHODS; ++method)
+					reportCandidate(report, asset, (PackMethod)method);
+				fprintf(report, "  %s%s", packMethodName(asset->method), asset->automatic ? " (auto)" : "");
+				if (type == TilesetAsset && image->pooled && image->sharedTiles > 0)
+					fprintf(report, ", shares %u tiles", image->sharedTiles);
+				fprintf(report, "\n");
+				rescomp += asset->rawSize;
+				cooked += asset->size[asset->method];
+				cycles += asset->cycles[asset->method];
+				streamed &= asset->method == PackNone;
+			}
+			if (image->pooled) {
+				shared += image->sharedTiles * TILE_BYTES;
+				cooked -= image->sharedTiles * TILE_BYTES;
+			}
+		}
+		fprintf(report, "  ROM: %u bytes with rescomp, %u cooked: %d saved (%u by shared tiles)\n",
+			rescomp, cooked, (int)(rescomp - cooked), shared);
+		fprintf(report, "  Stage load: %u cycles unpacking (%.2f frames), %s\n", cycles, (double)cycles / MD_FRAME_CYCLES,
+			streamed ? "can be streamed" : "cannot be streamed (packed assets)");
+		totalRescomp += rescomp;
+		totalCooked += cooked;
+		totalShared += shared;
+	}
+	fprintf(report, "\nTotal: %u bytes with rescomp, %u cooked: %d saved (%u by %u shared tiles)\n",
+		totalRescomp, totalCooked, (int)(totalRescomp - totalCooked), totalShared, totalShared / TILE_BYTES);
+}
+
+
+int main(int argc, char **argv) {
+	const char *reportPath = NULL;
+	u32 budgetFrames = DEFAULT_BUDGET_FRAMES;
+	u8 allAutomatic = FALSE;
+	int arg = 1;
+
+	for (; arg < argc && argv[arg][0] == '-'; ++arg) {
+		if (strcmp(argv[arg], "-a") == 0)
+			allAutomatic = TRUE;
+		else if (strcmp(argv[arg], "-l") == 0 && arg + 1 < argc)
+			budgetFrames = (u32)strtoul(argv[++arg], NULL, 10);
+		else if (strcmp(argv[arg], "-r") == 0 && arg + 1 < argc)
+			reportPath = argv[++arg];
+		else
+			break;
+	}
+	if (argc - arg != 4) {
+		fprintf(stderr, "usage: %s [-a] [-l frames] [-r report] rom.bin rom.out input.res output.s\n", argv[0]);
+		return 1;
+	}
+
+	Unpacker unpacker;
+	u8 *unpacked = malloc(UNPACK_CAPACITY);
+	if (unpacked == NULL || openUnpacker(&unpacker, argv[arg], argv[arg + 1]) != 0)
+		return fail("cannot load the unpackers of", argv[arg]);
+	if (readResources(argv[arg + 2], allAutomatic) != 0)
+		return 1;
+	for (u32 i = 0; i < imageCount; ++i)
+		if (loadImage(&images[i], &unpacker, unpacked) != 0)
+			return 1;
+
+	u32 budget = budgetFrames * MD_FRAME_CYCLES;
+	for (u16 stage = 0; stage < stageCount; ++stage)
+		chooseMethods(stage, budget);
+	if (poolTilesets(&unpacker, unpacked) != 0 || writeAssembly(argv[arg + 3]) != 0 || writeHeader(argv[arg + 3]) != 0)
+		return 1;
+
+	FILE *report = (reportPath != NULL) ? fopen(reportPath, "w") : stdout;
+	if (report == NULL)
+		return fail("cannot write", reportPath);
+	writeReport(report, budget);
+	if (report != stdout)
+		fclose(report);
+	closeUnpacker(&unpacker);
+	free(unpacked);
+	return 0;
+}
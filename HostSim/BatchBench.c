@@ -0,0 +1,149 @@
+/*!
+\file BatchBench.c
+\brief Host batched combat benchmark
+\date 10/2026
+
+Compares combatSystem, run world by world, with every combatSystemBatch kernel the CPU supports.
+The worlds are states sampled from real matches. Every round restores them and runs
+a number of combat frames, so that hits, parries and deaths keep happening.
+Only the combat frames are timed. The final states of all kernels are checked to be identical.
+
+Usage: batchbench [worlds] [rounds] [frames per round]
+*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Match.h"
+#include "WorldBatch.h"
+
+#define SAMPLE_INTERVAL 97	/*!< A world is sampled every this many frames of a match. */
+
+
+/*! Returns the monotonic clock in nanoseconds. */
+static long long nanoseconds() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+
+/*! Fills the arrays with states sampled from matches against a scripted player. */
+static void sampleMatches(World *worlds, SimContext *contexts, u32 count) {
+	static World world;
+	SimContext context;
+	PlayerBot bot;
+	ButtonInput buttonInput = { FALSE, Neutral };
+	u32 sampled = 0;
+
+	for (u32 match = 0; sampled < count; ++match) {
+		memset(&world, 0, sizeof(World));
+		initializeMatch(&world, &context, (u8)(1 + match % MAX_ALLIES), matchSeed(2018, match));
+		initializePlayerBot(&bot, matchSeed(2018, match));
+
+		for (u32 frame = 1; frame <= MATCH_FRAME_LIMIT && sampled < count; ++frame) {
+			context.difficultyAIaccumulator += DIFF_NORMAL;
+			playerBotInput(&bot, &world, &context, &buttonInput);
+			updateWorld(&world, &context, &buttonInput);
+			if (matchOutcome(&world, &context) != MatchPlaying)
+				break;
+			if (frame % SAMPLE_INTERVAL == 0) {
+				worlds[sampled] = world;
+				contexts[sampled] = context;
+				++sampled;
+			}
+		}
+	}
+}
+
+
+/*! Sums the fields combatSystem writes, so that different results show up as different checksums. */
+static u32 checksumWorld(const World *world, const SimContext *context) {
+	u32 sum = context->eventSFX;
+	for (EntitySlot entity = 0; entity < ENTITY_COUNT; ++entity)
+		sum = sum * 31 + world->mask[entity] + world->health[entity].points + world->health[entity].staggered
+			+ world->timing[entity].frames + world->timing[entity].facing + world->move[entity].move;
+	return sum;
+}
+
+
+int main(int argc, char **argv) {
+	u32 count = (argc > 1) ? (u32)atoi(argv[1]) : 4096;
+	u32 rounds = (argc > 2) ? (u32)atoi(argv[2]) : 200;
+	u32 frames = (argc > 3) ? (u32)atoi(argv[3]) : 32;
+
+	if (count == 0 || rounds == 0 || frames == 0) {
+		fprintf(stderr, "usage: %s [worlds] [rounds] [frames per round]\n", argv[0]);
+		return 1;
+	}
+
+	World *saved = malloc(sizeof(World) * count), *worlds = malloc(sizeof(World) * count);
+	SimContext *savedContexts = malloc(sizeof(SimContext) * count), *contexts = malloc(sizeof(SimContext) * count);
+	if (saved == NULL || worlds == NULL || savedContexts == NULL || contexts == NULL)
+		return 1;
+	sampleMatches(saved, savedContexts, count);
+
+	double worldFrames = (double)count * rounds * frames;
+	long long elapsed = 0;
+	u32 expected = 0;
+
+	// Reference: combatSystem on one World after the other.
+	for (u32 round = 0; round < rounds; ++round) {
+		memcpy(worlds, saved, sizeof(World) * count);
+		memcpy(contexts, savedContexts, sizeof(SimContext) * count);
+		long long start = nanoseconds();
+		for (u32 frame = 0; frame < frames; ++frame)
+			for (u32 index = 0; index < count; ++index)
+				combatSystem(&worlds[index], &contexts[index]);
+		elapsed += nanoseconds() - start;
+	}
+	for (u32 index = 0; index < count; ++index)
+		expected += checksumWorld(&worlds[index], &contexts[index]);
+
+	double reference = worldFrames / (elapsed / 1e9);
+	printf("batchbench: %u worlds, %u rounds of %u combat frames\n", count, rounds, frames);
+	printf("  %-14s: %12.0f world-frames/sec  %7.2f ns/world-frame\n", "combatSystem", reference, elapsed / worldFrames);
+
+	int failures = 0;
+	for (BatchKernel kernel = BatchKernelScalar; kernel <= bestBatchKernel(); ++kernel) {
+		WorldBatch savedBatch, batch;
+		u32 checksum = 0;
+
+		if (createWorldBatch(&savedBatch, count) != 0 || createWorldBatch(&batch, count) != 0)
+			return 1;
+		for (u32 index = 0; index < count; ++index)
+			storeWorldInBatch(&savedBatch, index, &saved[index], &savedContexts[index]);
+
+		elapsed = 0;
+		for (u32 round = 0; round < rounds; ++round) {
+			copyWorldBatch(&batch, &savedBatch);
+			long long start = nanoseconds();
+			for (u32 frame = 0; frame < frames; ++frame)
+				combatSystemBatch(&batch, kernel);
+			elapsed += nanoseconds() - start;
+		}
+		for (u32 index = 0; index < count; ++index) {
+			loadWorldFromBatch(&batch, index, &worlds[index], &contexts[index]);
+			checksum += checksumWorld(&worlds[index], &contexts[index]);
+		}
+
+		double rate = worldFrames / (elapsed / 1e9);
+		printf("  %-14s: %12.0f world-frames/sec  %7.2f ns/world-frame  %5.2fx%s\n", batchKernelName(kernel),
+			rate, elapsed / worldFrames, rate / reference, (checksum == expected) ? "" : "  MISMATCH");
+		failures += (checksum != expected);
+
+		destroyWorldBatch(&batch);
+		destroyWorldBatch(&savedBatch);
+	}
+
+	free(saved);
+	free(worlds);
+	free(savedContexts);
+	free(contexts);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,203 @@
+/*!
+\file FrameBench.c
+\brief Host frame benchmark
+\date 10/2026
+
+Drives updateWorld on the host for millions of frames and reports frames/sec,
+ns/frame and per-frame latency percentiles.
+Input is replayed from a pre-generated script, so the benchmark measures the model and not the input generation.
+Each match seeds the AI's random stream with the match number.
+framebench_profile, built with PROFILE_SYSTEMS, also prints the time histogram of every system (see Profile.h).
+
+Usage: framebench [frames] [allies] [difficulty]
+*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Match.h"
+#include "Profile.h"
+
+#define SCRIPT_LENGTH 4096	/*!< Number of scripted input frames. Must be a power of two. */
+#define LATENCY_SAMPLES (1 << 20)	/*!< Maximum number of individually timed frames. */
+
+static ButtonInput inputScript[SCRIPT_LENGTH];	/*!< Scripted controller input, replayed in a loop. */
+
+
+/*! Writes the input script.
+
+	The script alternates between holding a button for a while and releasing it,
+	so that attack chains, parries, guards and character switches all occur.
+*/
+static void writeScripts() {
+	static const Button buttons[] = { A, A, A, B, B, C, Up, Down };
+	static u16 values[SCRIPT_LENGTH];
+	RandomStream stream;
+	u16 frame = 0, next = 0;
+
+	seedRandom(&stream, 0x2018BEEF);
+	fillRandom(&stream, values, SCRIPT_LENGTH); // Every value covers at least one frame.
+
+	while (frame < SCRIPT_LENGTH) {
+		u16 r = values[next++];
+		Button button = buttons[r & 7];
+		u16 held = 1 + ((r >> 3) & 31);
+		u16 released = (r >> 8) & 15;
+
+		for (; held > 0 && frame < SCRIPT_LENGTH; --held, ++frame) {
+			inputScript[frame].isPressed = TRUE;
+			inputScript[frame].latestButtonPress = button;
+		}
+		for (; released > 0 && frame < SCRIPT_LENGTH; --released, ++frame) {
+			inputScript[frame].isPressed = FALSE;
+			inputScript[frame].latestButtonPress = button;
+		}
+	}
+}
+
+
+/*! Resets the model to the starting game state, like startGame in main.c. Every match gets the next seed. */
+static void startMatch(World *world, SimContext *context, u8 numAllies) {
+	static u32 seed = 0;
+	initializeMatch(world, context, numAllies, seed++);
+}
+
+
+/*! Returns the monotonic clock in nanoseconds. */
+static long long nanoseconds() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+
+static int compareTimes(const void *a, const void *b) {
+	long long x = *(const long long *)a, y = *(const long long *)b;
+	return (x > y) - (x < y);
+}
+
+
+#ifdef PROFILE_SYSTEMS
+/*! Prints the runs, mean time and share of the frame of every system, followed by its histogram. */
+static void printSystemProfile() {
+	static const char *names[PROFILED_SYSTEMS] = { "inputSystem", "AISystem", "combatSystem", "renderSystem" };
+	unsigned long long allTicks = 0;
+
+	for (u8 system = 0; system < PROFILED_SYSTEMS; ++system)
+		allTicks += systemProfile.totalTicks[system];
+
+	printf("per system (profileClock ticks):\n");
+	for (u8 system = 0; system < PROFILED_SYSTEMS; ++system) {
+		u32 runs = systemProfile.runs[system];
+		printf("  %-13s: %10u runs  %8.1f ticks/run  %5.1f%%\n", names[system], runs,
+			runs ? (double)systemProfile.totalTicks[system] / runs : 0.0,
+			allTicks ? 100.0 * systemProfile.totalTicks[system] / allTicks : 0.0);
+		printf("   ");
+		for (u8 bucket = 0; bucket < PROFILE_BUCKETS; ++bucket)
+			if (systemProfile.histogram[system][bucket])
+				printf(" %lu+:%u", 1UL << bucket, systemProfile.histogram[system][bucket]);
+		printf("\n");
+	}
+}
+#endif
+
+
+/*! Parses a difficulty given either by name or as the raw DIFF_* value. */
+static u16 parseDifficulty(const char *text) {
+	if (strcmp(text, "easy") == 0) return DIFF_EASY;
+	if (strcmp(text, "normal") == 0) return DIFF_NORMAL;
+	if (strcmp(text, "hard") == 0) return DIFF_HARD;
+	if (strcmp(text, "nightmare") == 0) return DIFF_NIGHTMARE;
+	if (strcmp(text, "perfect") == 0) return DIFF_PERFECT;
+	return (u16)atoi(text);
+}
+
+
+int main(int argc, char **argv) {
+	long long frames = (argc > 1) ? atoll(argv[1]) : 5000000LL;
+	u8 numAllies = (argc > 2) ? (u8)atoi(argv[2]) : 1;
+	u16 difficulty = (argc > 3) ? parseDifficulty(argv[3]) : DIFF_NORMAL;
+
+	if (frames <= 0 || numAllies == 0 || numAllies > MAX_ALLIES) {
+		fprintf(stderr, "usage: %s [frames] [allies 1-%d] [easy|normal|hard|nightmare|perfect]\n", argv[0], MAX_ALLIES);
+		return 1;
+	}
+
+	static World world;
+	SimContext context;
+	EventQueue queue;
+	u32 sink = 0; // Keeps the compiler from discarding the returned EventQueue.
+	long long matches = 0, matchFrames = 0, frame;
+
+	writeScripts();
+
+	// Throughput: no timing inside the loop, except for the systems in profile builds.
+#ifdef PROFILE_SYSTEMS
+	resetSystemProfile();
+#endif
+	startMatch(&world, &context, numAllies);
+	long long start = nanoseconds();
+	for (frame = 0; frame < frames; ++frame) {
+		context.difficultyAIaccumulator += difficulty;
+		queue = updateWorld(&world, &context, &inputScript[frame & (SCRIPT_LENGTH - 1)]);
+		sink += queue.commands;
+
+		if (matchOutcome(&world, &context) != MatchPlaying || ++matchFrames == MATCH_FRAME_LIMIT) {
+			++matches;
+			matchFrames = 0;
+			startMatch(&world, &context, numAllies);
+		}
+	}
+	long long elapsed = nanoseconds() - start;
+
+	printf("framebench: %lld frames, %d allies, difficulty %d\n", frames, numAllies, difficulty);
+	printf("  matches finished : %lld\n", matches);
+	printf("  total time       : %.3f s\n", elapsed / 1e9);
+	printf("  frames/sec       : %.0f\n", frames / (elapsed / 1e9));
+	printf("  ns/frame         : %.2f\n", (double)elapsed / frames);
+#ifdef PROFILE_SYSTEMS
+	printSystemProfile();
+#endif
+
+	// Latency: every frame timed individually.
+	long long samples = (frames < LATENCY_SAMPLES) ? frames : LATENCY_SAMPLES;
+	long long *times = malloc(sizeof(long long) * samples);
+	if (times == NULL)
+		return 1;
+
+	long long overhead = nanoseconds();
+	for (frame = 0; frame < 1000; ++frame)
+		nanoseconds();
+	overhead = (nanoseconds() - overhead) / 1000;
+
+	startMatch(&world, &context, numAllies);
+	matchFrames = 0;
+	for (frame = 0; frame < samples; ++frame) {
+		context.difficultyAIaccumulator += difficulty;
+		long long before = nanoseconds();
+		queue = updateWorld(&world, &context, &inputScript[frame & (SCRIPT_LENGTH - 1)]);
+		times[frame] = nanoseconds() - before;
+		sink += queue.commands;
+
+		if (matchOutcome(&world, &context) != MatchPlaying || ++matchFrames == MATCH_FRAME_LIMIT) {
+			matchFrames = 0;
+			startMatch(&world, &context, numAllies);
+		}
+	}
+	qsort(times, samples, sizeof(long long), compareTimes);
+
+	printf("latency per updateWorld call (%lld samples, clock overhead ~%lld ns included):\n", samples, overhead);
+	printf("  p50              : %lld ns\n", times[samples / 2]);
+	printf("  p90              : %lld ns\n", times[samples * 9 / 10]);
+	printf("  p99              : %lld ns\n", times[samples * 99 / 100]);
+	printf("  p99.9            : %lld ns\n", times[samples * 999 / 1000]);
+	printf("  max              : %lld ns\n", times[samples - 1]);
+	printf("  (checksum %u)\n", (unsigned)sink);
+
+	free(times);
+	return 0;
+}
@@ -0,0 +1,247 @@
+/*!
+\file MatchRunner.c
+\brief Host match runner
+\date 10/2026
+
+Plays many full matches (the starting game state of initializeModel in main.c,
+every DIFF_* level with 1 to MAX_ALLIES allies) on all cores,
+and reports win rate, match length and throughput per core.
+Matches are spread over the cores by the work-stealing scheduler (see WorkStealing.h)
+and results are gathered with atomic additions, without locks.
+With -f, matches jump over the frames in which nothing is decided (see fastForwardMatch), with the same results.
+
+Usage: matchrunner [-m matches] [-t threads] [-c chunk] [-s seed] [-f] [--scaling [maxThreads]]
+*/
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Match.h"
+#include "WorkStealing.h"
+
+#define DIFFICULTY_LEVELS 5	/*!< Number of DIFF_* levels. */
+#define SWEEP_CELLS (DIFFICULTY_LEVELS * MAX_ALLIES)	/*!< Every combination of difficulty and number of allies. */
+
+static const u16 difficulties[DIFFICULTY_LEVELS] = { DIFF_EASY, DIFF_NORMAL, DIFF_HARD, DIFF_NIGHTMARE, DIFF_PERFECT };
+static const char *difficultyNames[DIFFICULTY_LEVELS] = { "easy", "normal", "hard", "nightmare", "perfect" };
+
+/*! \brief Results of one combination of difficulty and number of allies, added to by every worker. */
+typedef struct {
+	_Atomic uint64_t matches;
+	_Atomic uint64_t won;
+	_Atomic uint64_t lost;
+	_Atomic uint64_t timedOut;
+	_Atomic uint64_t frames;
+} SweepCell;
+
+/*! \brief Frames simulated by one worker. Written only by that worker, one cache line each. */
+typedef struct {
+	_Alignas(64) uint64_t frames;
+} WorkerFrames;
+
+/*! \brief A sweep over every combination of difficulty and number of allies. */
+typedef struct {
+	SweepCell cells[SWEEP_CELLS];
+	WorkerFrames workerFrames[MAX_WORKERS];
+	u32 seed;
+	u8 fastForward;
+} Sweep;
+
+
+/*! Returns the setup of a match. Match number n plays combination n % SWEEP_CELLS. */
+static MatchSetup sweepSetup(u32 seed, u32 match) {
+	u32 cell = match % SWEEP_CELLS;
+	MatchSetup setup;
+	setup.numAllies = 1 + cell / DIFFICULTY_LEVELS;
+	setup.difficulty = difficulties[cell % DIFFICULTY_LEVELS];
+	setup.seed = matchSeed(seed, match);
+	return setup;
+}
+
+
+/*! WorkFunction playing matches begin to end-1. Tallies locally, then adds to the shared cells once. */
+static void playMatches(void *argument, u32 worker, u32 begin, u32 end) {
+	Sweep *sweep = argument;
+	uint64_t tally[SWEEP_CELLS][4];	// won, lost, timed out, frames
+	uint64_t frames = 0;
+	u32 match, cell;
+
+	memset(tally, 0, sizeof(tally));
+	for (match = begin; match < end; ++match) {
+		MatchSetup setup = sweepSetup(sweep->seed, match);
+		MatchResult result = sweep->fastForward ? fastForwardMatch(&setup) : playMatch(&setup);
+		cell = match % SWEEP_CELLS;
+
+		if (result.outcome == MatchWon) tally[cell][0]++;
+		else if (result.outcome == MatchLost) tally[cell][1]++;
+		else tally[cell][2]++;
+		tally[cell][3] += result.frames;
+		frames += result.frames;
+	}
+
+	for (cell = 0; cell < SWEEP_CELLS; ++cell) {
+		uint64_t played = tally[cell][0] + tally[cell][1] + tally[cell][2];
+		if (played == 0)
+			continue;
+		atomic_fetch_add_explicit(&sweep->cells[cell].matches, played, memory_order_relaxed);
+		atomic_fetch_add_explicit(&sweep->cells[cell].won, tally[cell][0], memory_order_relaxed);
+		atomic_fetch_add_explicit(&sweep->cells[cell].lost, tally[cell][1], memory_order_relaxed);
+		atomic_fetch_add_explicit(&sweep->cells[cell].timedOut, tally[cell][2], memory_order_relaxed);
+		atomic_fetch_add_explicit(&sweep->cells[cell].frames, tally[cell][3], memory_order_relaxed);
+	}
+	sweep->workerFrames[worker].frames += frames;
+}
+
+
+/*! Plays a sweep and returns its wall-clock time in nanoseconds, or 0 on failure. */
+static uint64_t runSweep(Sweep *sweep, u32 matches, u32 threads, u32 chunk, WorkerStats *stats) {
+	uint64_t start;
+	u32 i;
+
+	for (i = 0; i < SWEEP_CELLS; ++i) {
+		atomic_init(&sweep->cells[i].matches, 0);
+		atomic_init(&sweep->cells[i].won, 0);
+		atomic_init(&sweep->cells[i].lost, 0);
+		atomic_init(&sweep->cells[i].timedOut, 0);
+		atomic_init(&sweep->cells[i].frames, 0);
+	}
+	for (i = 0; i < MAX_WORKERS; ++i)
+		sweep->workerFrames[i].frames = 0;
+
+	start = monotonicNanoseconds();
+	if (runWorkStealing(matches, threads, chunk, playMatches, sweep, stats) != 0)
+		return 0;
+	return monotonicNanoseconds() - start;
+}
+
+
+static void printResults(Sweep *sweep) {
+	printf("difficulty  allies   matches    won%%   lost%%  timeout%%  mean frames  mean seconds\n");
+	for (u32 cell = 0; cell < SWEEP_CELLS; ++cell) {
+		double matches = (double)atomic_load(&sweep->cells[cell].matches);
+		if (matches == 0)
+			continue;
+		double frames = (double)atomic_load(&sweep->cells[cell].frames) / matches;
+		printf("%-10s  %6u  %8.0f  %6.2f  %6.2f  %8.2f  %11.1f  %12.1f\n",
+			difficultyNames[cell % DIFFICULTY_LEVELS], 1 + cell / DIFFICULTY_LEVELS, matches,
+			100.0 * atomic_load(&sweep->cells[cell].won) / matches,
+			100.0 * atomic_load(&sweep->cells[cell].lost) / matches,
+			100.0 * atomic_load(&sweep->cells[cell].timedOut) / matches,
+			frames, frames / 60.0);
+	}
+}
+
+
+static void printWorkers(Sweep *sweep, WorkerStats *stats, u32 threads) {
+	printf("worker   matches      frames   busy s  matches/s    frames/s  steals\n");
+	for (u32 i = 0; i < threads; ++i) {
+		double busy = stats[i].busyNanoseconds / 1e9;
+		printf("%6u  %8llu  %10llu  %7.3f  %9.0f  %10.0f  %6llu\n", i,
+			(unsigned long long)stats[i].jobs, (unsigned long long)sweep->workerFrames[i].frames, busy,
+			(busy > 0) ? stats[i].jobs / busy : 0.0, (busy > 0) ? sweep->workerFrames[i].frames / busy : 0.0,
+			(unsigned long long)stats[i].steals);
+	}
+}
+
+
+/*! Returns 1 (TRUE) if two sweeps gave the same results. */
+static u8 sameResults(Sweep *a, Sweep *b) {
+	for (u32 cell = 0; cell < SWEEP_CELLS; ++cell)
+		if (atomic_load(&a->cells[cell].matches) != atomic_load(&b->cells[cell].matches)
+			|| atomic_load(&a->cells[cell].won) != atomic_load(&b->cells[cell].won)
+			|| atomic_load(&a->cells[cell].lost) != atomic_load(&b->cells[cell].lost)
+			|| atomic_load(&a->cells[cell].frames) != atomic_load(&b->cells[cell].frames))
+			return FALSE;
+	return TRUE;
+}
+
+
+/*! Plays the same sweep with 1, 2, 4, ... maxThreads threads and prints how throughput scales. */
+static int runScaling(u32 matches, u32 maxThreads, u32 chunk, u32 seed, u8 fastForward, u32 cores) {
+	static Sweep reference, sweep;
+	static WorkerStats stats[MAX_WORKERS];
+	double baseline = 0;
+	u8 identical = TRUE;
+
+	reference.seed = sweep.seed = seed;
+	reference.fastForward = sweep.fastForward = fastForward;
+	printf("scaling: %u matches per run, %u cores online\n", matches, cores);
+	printf("threads   wall s  matches/s  speedup  efficiency  steals\n");
+	for (u32 threads = 1; threads <= maxThreads; threads *= 2) {
+		Sweep *current = (threads == 1) ? &reference : &sweep;
+		uint64_t wall = runSweep(current, matches, threads, chunk, stats);
+		uint64_t steals = 0;
+		if (wall == 0)
+			return 1;
+
+		for (u32 i = 0; i < threads; ++i)
+			steals += stats[i].steals;
+		double rate = matches / (wall / 1e9);
+		if (threads == 1)
+			baseline = rate;
+		else if (!sameResults(&reference, current))
+			identical = FALSE;
+
+		printf("%7u  %7.3f  %9.0f  %7.2f  %9.1f%%  %6llu\n", threads, wall / 1e9, rate, rate / baseline,
+			100.0 * rate / baseline / ((threads < cores) ? threads : cores), (unsigned long long)steals);
+	}
+	printf("results identical across thread counts: %s\n", identical ? "yes" : "NO");
+	return identical ? 0 : 1;
+}
+
+
+int main(int argc, char **argv) {
+	static Sweep sweep;
+	static WorkerStats stats[MAX_WORKERS];
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	u32 matches = 100000, threads = (cores > 0) ? (u32)cores : 1, chunk = 64, seed = 1;
+	u32 maxThreads = 0;
+	u8 fastForward = FALSE;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) matches = (u32)strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) threads = (u32)strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) chunk = (u32)strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) seed = (u32)strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-f") == 0) fastForward = TRUE;
+		else if (strcmp(argv[i], "--scaling") == 0) {
+			maxThreads = 64;
+			if (i + 1 < argc && argv[i + 1][0] != '-')
+				maxThreads = (u32)strtoul(argv[++i], NULL, 0);
+		}
+		else {
+			fprintf(stderr, "usage: %s [-m matches] [-t threads] [-c chunk] [-s seed] [-f] [--scaling [maxThreads]]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (threads == 0 || threads > MAX_WORKERS || maxThreads > MAX_WORKERS) {
+		fprintf(stderr, "threads must be 1-%d\n", MAX_WORKERS);
+		return 1;
+	}
+
+	if (maxThreads > 0)
+		return runScaling(matches, maxThreads, chunk, seed, fastForward, (cores > 0) ? (u32)cores : 1);
+
+	sweep.seed = seed;
+	sweep.fastForward = fastForward;
+	uint64_t wall = runSweep(&sweep, matches, threads, chunk, stats);
+	if (wall == 0) {
+		fprintf(stderr, "could not start worker threads\n");
+		return 1;
+	}
+
+	uint64_t frames = 0;
+	for (u32 i = 0; i < threads; ++i)
+		frames += sweep.workerFrames[i].frames;
+
+	printf("matchrunner: %u matches, %u threads, chunk %u, seed %u%s\n\n", matches, threads, chunk, seed, fastForward ? ", fast-forward" : "");
+	printResults(&sweep);
+	printf("\n");
+	printWorkers(&sweep, stats, threads);
+	printf("\ntotal: %.3f s, %.0f matches/s, %.0f frames/s\n", wall / 1e9, matches / (wall / 1e9), frames / (wall / 1e9));
+	return 0;
+}
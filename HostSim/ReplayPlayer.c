@@ -0,0 +1,217 @@
+/*!
+\file ReplayPlayer.c
+\brief Host replay recorder and player
+\date 10/2026
+
+record: plays matches with the scripted player (the same setups as matchrunner) and writes their replays to an archive.
+play: re-simulates the replays of an archive through updateWorld on all cores, as fast as possible,
+checks that every one ends the way it was recorded, and reports the throughput.
+show: prints the header and the input runs of one replay.
+
+Usage:
+	replayplayer record [-m matches] [-s seed] archive
+	replayplayer play [-t threads] [-c chunk] [-f first] [-n count] archive
+	replayplayer show archive index
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Replay.h"
+#include "WorkStealing.h"
+
+#define DIFFICULTY_LEVELS 5	/*!< Number of DIFF_* levels. */
+
+static const u16 difficulties[DIFFICULTY_LEVELS] = { DIFF_EASY, DIFF_NORMAL, DIFF_HARD, DIFF_NIGHTMARE, DIFF_PERFECT };
+static const char *outcomeNames[] = { "playing", "won", "lost", "timed out" };
+
+/*! \brief Frames and desyncs of one worker. Written only by that worker, one cache line each. */
+typedef struct {
+	_Alignas(64) uint64_t frames;
+	uint64_t desyncs;
+	uint64_t invalid;
+} WorkerTally;
+
+/*! \brief Replays to play back. */
+typedef struct {
+	ReplayArchive archive;
+	u32 first;
+	WorkerTally tally[MAX_WORKERS];
+} Playback;
+
+
+static void usage(const char *program) {
+	fprintf(stderr, "usage: %s record [-m matches] [-s seed] archive\n", program);
+	fprintf(stderr, "       %s play [-t threads] [-c chunk] [-f first] [-n count] archive\n", program);
+	fprintf(stderr, "       %s show archive index\n", program);
+}
+
+
+static int record(u32 matches, u32 seed, const char *path) {
+	ReplayArchiveWriter archive;
+	ReplayWriter replay;
+	uint64_t frames = 0, bytes = 0, start = monotonicNanoseconds();
+
+	memset(&replay, 0, sizeof(ReplayWriter));
+	if (createReplayArchive(&archive, path) != 0) {
+		fprintf(stderr, "cannot create %s\n", path);
+		return 1;
+	}
+	for (u32 match = 0; match < matches; ++match) {
+		u32 cell = match % (DIFFICULTY_LEVELS * MAX_ALLIES);
+		MatchSetup setup;
+		setup.numAllies = 1 + cell / DIFFICULTY_LEVELS;
+		setup.difficulty = difficulties[cell % DIFFICULTY_LEVELS];
+		setup.seed = matchSeed(seed, match);
+
+		MatchResult result = recordMatch(&setup, &replay);
+		if (addArchiveReplay(&archive, replay.data, replay.size) != 0) {
+			fprintf(stderr, "cannot write %s\n", path);
+			return 1;
+		}
+		frames += result.frames;
+		bytes += replay.size;
+	}
+	freeReplayWriter(&replay);
+	if (finishReplayArchive(&archive) != 0) {
+		fprintf(stderr, "cannot write %s\n", path);
+		return 1;
+	}
+
+	double seconds = (monotonicNanoseconds() - start) / 1e9;
+	printf("recorded %u matches, %llu frames, in %.3f s\n", matches, (unsigned long long)frames, seconds);
+	printf("replays: %llu bytes, %.1f bytes per replay, %.3f bytes per frame\n", (unsigned long long)bytes,
+		matches ? (double)bytes / matches : 0.0, frames ? (double)bytes / frames : 0.0);
+	return 0;
+}
+
+
+/*! WorkFunction playing back replays first+begin to first+end-1. */
+static void playReplays(void *argument, u32 worker, u32 begin, u32 end) {
+	Playback *playback = argument;
+	WorkerTally *tally = &playback->tally[worker];
+	World world;
+	SimContext context;
+	ReplayReader replay;
+
+	for (u32 i = begin; i < end; ++i) {
+		if (openArchivedReplay(&playback->archive, playback->first + i, &replay) != 0) {
+			++tally->invalid;
+			continue;
+		}
+		MatchResult result = playReplay(&replay, &world, &context);
+		if (result.outcome != replay.info.outcome || result.frames != replay.info.frames || result.hash != replay.info.hash)
+			++tally->desyncs;
+		tally->frames += result.frames;
+	}
+}
+
+
+static int play(u32 threads, u32 chunk, u32 first, u32 count, const char *path) {
+	static Playback playback;
+	static WorkerStats stats[MAX_WORKERS];
+	uint64_t frames = 0, desyncs = 0, invalid = 0;
+
+	if (openReplayArchive(&playback.archive, path) != 0) {
+		fprintf(stderr, "%s is not a replay archive\n", path);
+		return 1;
+	}
+	if (first > playback.archive.count)
+		first = playback.archive.count;
+	if (count > playback.archive.count - first)
+		count = playback.archive.count - first;
+	playback.first = first;
+
+	uint64_t start = monotonicNanoseconds();
+	if (runWorkStealing(count, threads, chunk, playReplays, &playback, stats) != 0) {
+		fprintf(stderr, "could not start worker threads\n");
+		return 1;
+	}
+	double seconds = (monotonicNanoseconds() - start) / 1e9;
+
+	for (u32 i = 0; i < threads; ++i) {
+		frames += playback.tally[i].frames;
+		desyncs += playback.tally[i].desyncs;
+		invalid += playback.tally[i].invalid;
+	}
+	printf("replayplayer: %u of %u replays from %u, %u threads\n", count, playback.archive.count, first, threads);
+	printf("%llu frames in %.3f s: %.0f replays/s, %.0f frames/s\n", (unsigned long long)frames, seconds,
+		count / seconds, frames / seconds);
+	printf("desyncs: %llu, invalid: %llu\n", (unsigned long long)desyncs, (unsigned long long)invalid);
+	closeReplayArchive(&playback.archive);
+	return (desyncs || invalid) ? 1 : 0;
+}
+
+
+static int show(const char *path, u32 index) {
+	ReplayArchive archive;
+	ReplayReader replay;
+	ButtonInput input, previous = { FALSE, Neutral };
+	u32 runStart = 1, runs = 0;
+
+	if (openReplayArchive(&archive, path) != 0 || openArchivedReplay(&archive, index, &replay) != 0) {
+		fprintf(stderr, "%s has no replay %u\n", path, index);
+		return 1;
+	}
+	printf("replay %u of %u: %u allies, difficulty %u, seed 0x%08X, %u frames, %s\n", index, archive.count,
+		replay.info.numAllies, replay.info.difficulty, replay.info.seed, replay.info.frames, outcomeNames[replay.info.outcome]);
+	printf(" first   frames  pressed  button\n");
+	while (nextReplayFrame(&replay, &input)) {
+		if (replay.frame > 1 && (input.isPressed != previous.isPressed || input.latestButtonPress != previous.latestButtonPress)) {
+			printf("%6u  %7u  %7u  %6u\n", runStart, replay.frame - runStart, previous.isPressed, previous.latestButtonPress);
+			runStart = replay.frame;
+			++runs;
+		}
+		previous = input;
+	}
+	if (replay.frame >= runStart) {
+		printf("%6u  %7u  %7u  %6u\n", runStart, replay.frame + 1 - runStart, previous.isPressed, previous.latestButtonPress);
+		++runs;
+	}
+	printf("%u runs\n", runs);
+	closeReplayArchive(&archive);
+	return 0;
+}
+
+
+int main(int argc, char **argv) {
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	u32 matches = 10000, seed = 1, threads = (cores > 0) ? (u32)cores : 1, chunk = 256, first = 0, count = 0xFFFFFFFF;
+	const char *path = NULL;
+	int i;
+
+	if (argc < 3) {
+		usage(argv[0]);
+		return 1;
+	}
+	if (strcmp(argv[1], "show") == 0 && argc == 4)
+		return show(argv[2], (u32)strtoul(argv[3], NULL, 0));
+
+	for (i = 2; i < argc; ++i) {
+		if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) matches = (u32)strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) seed = (u32)strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) threads = (u32)strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) chunk = (u32)strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) first = (u32)strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) count = (u32)strtoul(argv[++i], NULL, 0);
+		else if (argv[i][0] != '-' && path == NULL) path = argv[i];
+		else {
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (path == NULL || threads == 0 || threads > MAX_WORKERS || chunk == 0) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	if (strcmp(argv[1], "record") == 0)
+		return record(matches, seed, path);
+	if (strcmp(argv[1], "play") == 0)
+		return play(threads, chunk, first, count, path);
+	usage(argv[0]);
+	return 1;
+}
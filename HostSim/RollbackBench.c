@@ -0,0 +1,108 @@
+/*!
+\file RollbackBench.c
+\brief Host rollback benchmark
+\date 10/2026
+
+Plays matches whose input comes from a remote scripted player over a LoopbackLink (see Rollback.h),
+and times every local frame: receiving the input, rolling back, simulating again and simulating the new frame.
+Reports rollbacks, stalls, and the time of a frame by number of frames rolled back, next to the 16.6 ms of a frame.
+With a delay of ROLLBACK_MAX_FRAMES (the default), nearly every late input rolls back the full ROLLBACK_MAX_FRAMES.
+
+Usage: rollbackbench [matches] [delay] [jitter]
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Match.h"
+#include "Rollback.h"
+#include "WorkStealing.h"
+
+#define FRAME_BUDGET_NS 16666667	/*!< One frame at 60 Hz. */
+
+static Rollback rollback;	/*!< Local driver. */
+static uint64_t depthFrames[ROLLBACK_MAX_FRAMES + 1];	/*!< Local frames, by number of frames rolled back. */
+static uint64_t depthNanoseconds[ROLLBACK_MAX_FRAMES + 1];	/*!< Their total time. */
+static uint64_t depthWorst[ROLLBACK_MAX_FRAMES + 1];	/*!< Their longest time. */
+
+
+/*! Plays one match over the link. Returns the number of local frames. */
+static u32 playLinkedMatch(const MatchSetup *setup, LoopbackLink *link) {
+	u32 worldSeed = matchSeed(setup->seed, MATCH_WORLD_STREAM);
+	World remote;
+	SimContext remoteContext;
+	PlayerBot bot;
+	ButtonInput input = { FALSE, Neutral };
+	u32 remoteFrames = 0, frame, now;
+	u8 ended = FALSE;
+
+	memset(&remote, 0, sizeof(World));
+	initializeMatch(&remote, &remoteContext, setup->numAllies, worldSeed);
+	initializePlayerBot(&bot, setup->seed);
+	initializeRollback(&rollback, setup->numAllies, setup->difficulty, worldSeed);
+
+	for (now = 0; !ended || rollback.frame < remoteFrames || link->count > 0; ++now) {
+		if (!ended) {
+			remoteContext.difficultyAIaccumulator += setup->difficulty;
+			playerBotInput(&bot, &remote, &remoteContext, &input);
+			updateWorld(&remote, &remoteContext, &input);
+			sendLoopback(link, now, remoteFrames++, &input);
+			ended = remoteFrames == MATCH_FRAME_LIMIT || matchOutcome(&remote, &remoteContext) != MatchPlaying;
+		}
+
+		uint64_t start = monotonicNanoseconds();
+		u32 rolledBack = rollback.stats.resimulatedFrames;
+		while (receiveLoopback(link, now, &frame, &input))
+			addRollbackInput(&rollback, frame, &input);
+		if (rollback.frame < remoteFrames)
+			advanceRollback(&rollback, NULL);
+		else
+			resolveRollback(&rollback);
+		uint64_t time = monotonicNanoseconds() - start;
+
+		rolledBack = rollback.stats.resimulatedFrames - rolledBack;
+		depthFrames[rolledBack]++;
+		depthNanoseconds[rolledBack] += time;
+		if (time > depthWorst[rolledBack])
+			depthWorst[rolledBack] = time;
+	}
+	return now;
+}
+
+
+int main(int argc, char **argv) {
+	static const u16 difficulties[] = { DIFF_EASY, DIFF_NORMAL, DIFF_HARD, DIFF_NIGHTMARE, DIFF_PERFECT };
+	u32 matches = (argc > 1) ? (u32)atoi(argv[1]) : 200;
+	u32 delay = (argc > 2) ? (u32)atoi(argv[2]) : ROLLBACK_MAX_FRAMES;
+	u32 jitter = (argc > 3) ? (u32)atoi(argv[3]) : 0;
+	uint64_t frames = 0, rollbacks = 0, resimulated = 0, stalls = 0;
+	LoopbackLink link;
+
+	if (matches == 0) {
+		fprintf(stderr, "usage: %s [matches] [delay] [jitter]\n", argv[0]);
+		return 1;
+	}
+	initializeLoopback(&link, delay, jitter, 0x2018);
+	for (u32 match = 0; match < matches; ++match) {
+		MatchSetup setup = { (u8)(1 + match % MAX_ALLIES), difficulties[match % 5], matchSeed(1, match) };
+		frames += playLinkedMatch(&setup, &link);
+		rollbacks += rollback.stats.rollbacks;
+		resimulated += rollback.stats.resimulatedFrames;
+		stalls += rollback.stats.stalls;
+	}
+
+	printf("rollbackbench: %u matches, delay %u, jitter %u: %llu frames, %llu rollbacks, %llu frames simulated again, %llu stalls\n",
+		matches, delay, jitter, (unsigned long long)frames, (unsigned long long)rollbacks,
+		(unsigned long long)resimulated, (unsigned long long)stalls);
+	printf("rolled back     frames    mean ns   worst ns   worst/16.6 ms\n");
+	for (u32 depth = 0; depth <= ROLLBACK_MAX_FRAMES; ++depth) {
+		if (depthFrames[depth] == 0)
+			continue;
+		printf("%11u  %9llu  %9.0f  %9llu  %13.4f%%\n", depth, (unsigned long long)depthFrames[depth],
+			(double)depthNanoseconds[depth] / depthFrames[depth], (unsigned long long)depthWorst[depth],
+			100.0 * depthWorst[depth] / FRAME_BUDGET_NS);
+	}
+	return 0;
+}
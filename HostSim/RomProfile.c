@@ -0,0 +1,392 @@
+/*!
+\file RomProfile.c
+\brief Cycle profiler of the console ROM
+\date 10/2026
+
+Boots rom.bin on the host 68000 (see Cpu68k.h) in a minimal Mega Drive (see MegaDrive.h),
+presses Start until the game loop starts (the first call to startGame, or to the symbol given with -s), then plays with scripted button presses.
+Every N cycles it samples the program counter and charges the cycles to:
+- the function the program counter is in, from the symbols of rom.out;
+- the part of the game loop: the outermost function of the call stack that is one of the roots
+  (updateWorld, checkProgression, updateAnim and SPR_update by default), "interrupts" inside an interrupt handler,
+  "idle" in a busy-wait (a short loop that writes nothing, e.g. waiting for VBlank), and "other" for everything else.
+Reports the cycles per frame of every part, and the functions that take the most.
+
+With -b, compares with a baseline file and fails if a part takes more than the tolerance above it:
+CTest runs this on the ROM in the repository (see CMakeLists.txt). -w writes a baseline.
+Idle is left out of baselines: it only shrinks as the other parts grow.
+
+Functions the compiler inlined have no symbol and count towards their caller. SGDK links with LTO,
+which inlines startGame, updateWorld, checkProgression and updateAnim into main: COMPILE.bat cycles builds without it.
+The same input script and emulator always give the same cycles, so the baseline comparison is exact.
+
+Usage: romprofile [-f frames] [-i interval] [-s symbol] [-r root,root...] [-b baseline] [-t tolerance%] [-w baseline] rom.bin rom.out
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "MegaDrive.h"
+#include "RomSymbols.h"
+
+#define MAX_ROOTS 16	/*!< Maximum number of root functions. */
+#define MAX_CALL_DEPTH 256	/*!< Deeper calls are not tracked. */
+#define START_PERIOD 64	/*!< Before the game loop, Start is pressed once every this many frames... */
+#define START_FRAMES 4	/*!< ...for this many frames. */
+#define START_TIMEOUT (60 * 60)	/*!< Give up if the game loop has not started after this many frames. */
+#define PRESS_PERIOD 8	/*!< In game, a new button is pressed every this many frames... */
+#define PRESS_FRAMES 3	/*!< ...and held for this many frames. */
+#define TOP_FUNCTIONS 15	/*!< Number of functions listed. */
+#define MAX_ROM_SIZE 0x400000	/*!< Cartridge address space. */
+#define IDLE_LOOP_BYTES 32	/*!< Longest loop that counts as a busy-wait. */
+
+static const char *defaultRoots = "updateWorld,checkProgression,updateAnim,SPR_update";
+
+/*! \brief Structure with one subroutine or exception handler on the shadow call stack. */
+typedef struct {
+	u32 stackPointer;	/**< Where its return address is. It has returned once A7 is above this. */
+	s8 root;	/**< Index of the root function it is, or -1 */
+	u8 vector;	/**< Exception vector number, or 0 for a subroutine */
+} CallFrame;
+
+/*! \brief Structure with the state of the profiler. */
+typedef struct {
+	RomSymbols symbols;
+	char *rootNames[MAX_ROOTS + 3];	/**< Root functions, then "interrupts", "idle" and "other" */
+	s32 rootSymbols[MAX_ROOTS];	/**< Symbol index of each root, or -1 if not in rom.out */
+	u8 roots;	/**< Number of root functions */
+	u32 startAddress;	/**< Address of the symbol that starts the measurement */
+	u8 started;	/**< The start symbol was called */
+
+	CallFrame stack[MAX_CALL_DEPTH];
+	u32 depth;
+
+	u32 loopStart, loopEnd;	/**< Last short loop taken */
+	unsigned long long loopWrites;	/**< busWrites when it was last taken */
+	u8 idle;	/**< The last iteration of the loop wrote nothing */
+
+	unsigned long long *functionCycles;	/**< Cycles per symbol */
+	unsigned long long partCycles[MAX_ROOTS + 3];	/**< Cycles per root, then interrupts, idle and other */
+} Profiler;
+
+static MegaDrive machine;	/*!< Large (RAM and VRAM), so not on the stack. */
+static u8 rom[MAX_ROM_SIZE];	/*!< Contents of rom.bin. */
+static unsigned long long busWrites;	/*!< Writes of the CPU, to tell busy-waits from other loops. */
+static void (*machineWrite8)(void *context, u32 address, u8 value);
+static void (*machineWrite16)(void *context, u32 address, u16 value);
+
+
+static void countWrite8(void *context, u32 address, u8 value) {
+	++busWrites;
+	machineWrite8(context, address, value);
+}
+
+static void countWrite16(void *context, u32 address, u16 value) {
+	++busWrites;
+	machineWrite16(context, address, value);
+}
+
+
+static s8 rootOfAddress(const Profiler *profiler, u32 address) {
+	for (u8 root = 0; root < profiler->roots; ++root)
+		if (profiler->rootSymbols[root] >= 0 && profiler->symbols.symbols[profiler->rootSymbols[root]].address == address)
+			return (s8)root;
+	return -1;
+}
+
+
+/*! CpuCallHook: frames at or below the new return address have returned, the new one goes on top. */
+static void onCall(void *context, u32 target, u32 stackPointer, u8 vector) {
+	Profiler *profiler = context;
+
+	while (profiler->depth > 0 && profiler->stack[profiler->depth - 1].stackPointer <= stackPointer)
+		--profiler->depth;
+	if (profiler->depth < MAX_CALL_DEPTH) {
+		CallFrame *frame = &profiler->stack[profiler->depth++];
+		frame->stackPointer = stackPointer;
+		frame->root = vector ? -1 : rootOfAddress(profiler, target);
+		frame->vector = vector;
+	}
+	if (target == profiler->startAddress)
+		profiler->started = 1;
+}
+
+
+/*! Called after every instruction: a short backward branch taken twice in a row without writes in between is a busy-wait. */
+static void trackIdle(Profiler *profiler, const Cpu68k *cpu) {
+	u32 from = cpu->instructionPC, to = cpu->pc;
+
+	if (to < from && from - to <= IDLE_LOOP_BYTES) {
+		profiler->idle = (to == profiler->loopStart && busWrites == profiler->loopWrites);
+		profiler->loopStart = to;
+		profiler->loopEnd = from;
+		profiler->loopWrites = busWrites;
+	}
+	else if (to < profiler->loopStart || to > profiler->loopEnd)
+		profiler->idle = 0;
+}
+
+
+/*! Returns the part of the game loop running: interrupts, idle, the outermost root on the stack, or other. */
+static u8 currentPart(Profiler *profiler, u32 stackPointer, u32 programCounter) {
+	s8 root = -1;
+
+	while (profiler->depth > 0 && profiler->stack[profiler->depth - 1].stackPointer < stackPointer)
+		--profiler->depth;
+	for (u32 i = 0; i < profiler->depth; ++i) {
+		if (profiler->stack[i].vector)
+			return profiler->roots;
+		if (root < 0)
+			root = profiler->stack[i].root;
+	}
+	if (profiler->idle)
+		return profiler->roots + 1;
+	if (root < 0) { // Entered by a jump rather than a call, e.g. a tail call.
+		s32 symbol = findRomSymbol(&profiler->symbols, programCounter);
+		if (symbol >= 0)
+			root = rootOfAddress(profiler, profiler->symbols.symbols[symbol].address);
+	}
+	return (root < 0) ? profiler->roots + 2 : (u8)root;
+}
+
+
+/*! Scripted input: Start until the game loop runs, then a new button every PRESS_PERIOD frames. */
+static u16 scriptButtons(const Profiler *profiler, u32 frame, u32 *random) {
+	static const u16 buttons[] = { PAD_A, PAD_B, PAD_C, PAD_LEFT, PAD_RIGHT, PAD_UP, PAD_DOWN, 0 };
+
+	if (!profiler->started)
+		return (frame % START_PERIOD < START_FRAMES) ? PAD_START : 0;
+	if (frame % PRESS_PERIOD >= PRESS_FRAMES)
+		return 0;
+	if (frame % PRESS_PERIOD == 0) {
+		*random ^= *random << 13;
+		*random ^= *random >> 17;
+		*random ^= *random << 5;
+	}
+	return buttons[*random % 8];
+}
+
+
+static int parseRoots(Profiler *profiler, const char *list) {
+	char *copy = malloc(strlen(list) + 1), *name;
+
+	if (copy == NULL)
+		return -1;
+	strcpy(copy, list);
+	profiler->roots = 0;
+	for (name = strtok(copy, ","); name != NULL; name = strtok(NULL, ",")) {
+		if (profiler->roots == MAX_ROOTS) {
+			free(copy);
+			return -1;
+		}
+		profiler->rootNames[profiler->roots] = name;
+		profiler->rootSymbols[profiler->roots] = findRomSymbolByName(&profiler->symbols, name);
+		++profiler->roots;
+	}
+	profiler->rootNames[profiler->roots] = "interrupts";
+	profiler->rootNames[profiler->roots + 1] = "idle";
+	profiler->rootNames[profiler->roots + 2] = "other";
+	return 0; // copy stays allocated: the names point into it.
+}
+
+
+static u32 loadRom(const char *path) {
+	FILE *file = fopen(path, "rb");
+	u32 size;
+
+	if (file == NULL)
+		return 0;
+	size = (u32)fread(rom, 1, MAX_ROM_SIZE, file);
+	fclose(file);
+	return size;
+}
+
+
+static void printReport(const Profiler *profiler, u32 frames) {
+	unsigned long long total = 0;
+
+	for (u8 part = 0; part < profiler->roots + 3; ++part)
+		total += profiler->partCycles[part];
+	printf("part              cycles/frame   share\n");
+	for (u8 part = 0; part < profiler->roots + 3; ++part) {
+		if (part < profiler->roots && profiler->rootSymbols[part] < 0)
+			printf("  %-18s (not in rom.out: inlined or unused)\n", profiler->rootNames[part]);
+		else
+			printf("  %-18s %10llu  %5.1f%%\n", profiler->rootNames[part], profiler->partCycles[part] / frames,
+				100.0 * profiler->partCycles[part] / total);
+	}
+	printf("  %-18s %10llu  (budget %u)\n", "total", total / frames, MD_FRAME_CYCLES);
+	printf("  %-18s %10llu  %5.1f%%\n", "busy", (total - profiler->partCycles[profiler->roots + 1]) / frames,
+		100.0 * (total - profiler->partCycles[profiler->roots + 1]) / total);
+	printf("  %-18s %10llu\n", "DMA stalls", machine.dmaCycles / frames);
+
+	printf("functions (self)  cycles/frame   share\n");
+	unsigned long long *cycles = malloc(profiler->symbols.count * sizeof(unsigned long long));
+	if (cycles == NULL)
+		return;
+	memcpy(cycles, profiler->functionCycles, profiler->symbols.count * sizeof(unsigned long long));
+	for (u32 rank = 0; rank < TOP_FUNCTIONS; ++rank) {
+		u32 best = 0;
+		for (u32 i = 1; i < profiler->symbols.count; ++i)
+			if (cycles[i] > cycles[best])
+				best = i;
+		if (cycles[best] == 0)
+			break;
+		printf("  %-30s %10llu  %5.1f%%\n", profiler->symbols.symbols[best].name, cycles[best] / frames, 100.0 * cycles[best] / total);
+		cycles[best] = 0;
+	}
+	free(cycles);
+}
+
+
+static int writeBaseline(const Profiler *profiler, u32 frames, const char *path) {
+	FILE *file = fopen(path, "w");
+
+	if (file == NULL)
+		return -1;
+	fprintf(file, "# romprofile baseline: 68000 cycles per frame of each part of the game loop\n");
+	for (u8 part = 0; part < profiler->roots + 3; ++part)
+		if (profiler->partCycles[part] > 0 && part != profiler->roots + 1)
+			fprintf(file, "%s %llu\n", profiler->rootNames[part], profiler->partCycles[part] / frames);
+	fclose(file);
+	return 0;
+}
+
+
+/*! \return The number of parts above the baseline by more than tolerance percent, or -1 if the file cannot be read. */
+static int compareBaseline(const Profiler *profiler, u32 frames, const char *path, double tolerance) {
+	FILE *file = fopen(path, "r");
+	char line[256], name[128];
+	unsigned long long expected;
+	int regressions = 0;
+
+	if (file == NULL)
+		return -1;
+	while (fgets(line, sizeof(line), file) != NULL) {
+		if (line[0] == '#' || sscanf(line, "%127s %llu", name, &expected) != 2)
+			continue;
+		unsigned long long measured = 0;
+		u8 found = 0;
+		for (u8 part = 0; part < profiler->roots + 3; ++part) {
+			if (strcmp(profiler->rootNames[part], name) == 0) {
+				measured = profiler->partCycles[part] / frames;
+				found = 1;
+			}
+		}
+		double change = expected ? 100.0 * ((double)measured - (double)expected) / (double)expected : 0.0;
+		if (!found || change > tolerance) {
+			printf("REGRESSION %-18s %10llu cycles/frame, baseline %llu (%+.2f%%)\n", name, measured, expected, change);
+			++regressions;
+		}
+		else if (measured != expected)
+			printf("changed    %-18s %10llu cycles/frame, baseline %llu (%+.2f%%)\n", name, measured, expected, change);
+	}
+	fclose(file);
+	return regressions;
+}
+
+
+int main(int argc, char **argv) {
+	u32 frames = 600, interval = 61;
+	const char *startSymbol = "startGame", *roots = defaultRoots;
+	const char *baseline = NULL, *newBaseline = NULL, *romPath = NULL, *elfPath = NULL;
+	double tolerance = 1.0;
+	Profiler profiler;
+	u32 romSize, random = 0x2018;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) frames = (u32)strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) interval = (u32)strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) startSymbol = argv[++i];
+		else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) roots = argv[++i];
+		else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) baseline = argv[++i];
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) tolerance = atof(argv[++i]);
+		else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) newBaseline = argv[++i];
+		else if (argv[i][0] != '-' && romPath == NULL) romPath = argv[i];
+		else if (argv[i][0] != '-' && elfPath == NULL) elfPath = argv[i];
+		else {
+			romPath = NULL;
+			break;
+		}
+	}
+	if (romPath == NULL || elfPath == NULL || frames == 0 || interval == 0) {
+		fprintf(stderr, "usage: %s [-f frames] [-i interval] [-s symbol] [-r root,root...] [-b baseline] [-t tolerance%%] [-w baseline] rom.bin rom.out\n", argv[0]);
+		return 2;
+	}
+
+	memset(&profiler, 0, sizeof(Profiler));
+	if ((romSize = loadRom(romPath)) == 0) {
+		fprintf(stderr, "cannot read %s\n", romPath);
+		return 2;
+	}
+	if (loadRomSymbols(&profiler.symbols, elfPath) != 0 || profiler.symbols.count == 0) {
+		fprintf(stderr, "cannot read the symbols of %s\n", elfPath);
+		return 2;
+	}
+	s32 start = findRomSymbolByName(&profiler.symbols, startSymbol);
+	if (start < 0) {
+		fprintf(stderr, "%s is not in %s (inlined?). Pick another symbol with -s.\n", startSymbol, elfPath);
+		return 2;
+	}
+	profiler.startAddress = profiler.symbols.symbols[start].address;
+	profiler.functionCycles = calloc(profiler.symbols.count, sizeof(unsigned long long));
+	if (profiler.functionCycles == NULL || parseRoots(&profiler, roots) != 0) {
+		fprintf(stderr, "out of memory, or more than %d roots\n", MAX_ROOTS);
+		return 2;
+	}
+
+	powerOnMegaDrive(&machine, rom, romSize, onCall, &profiler);
+	machineWrite8 = machine.cpu.bus.write8;
+	machineWrite16 = machine.cpu.bus.write16;
+	machine.cpu.bus.write8 = countWrite8;
+	machine.cpu.bus.write16 = countWrite16;
+	while (!profiler.started) {
+		if (machine.frame >= START_TIMEOUT) {
+			fprintf(stderr, "%s was not called within %d frames\n", startSymbol, START_TIMEOUT);
+			return 2;
+		}
+		machine.buttons = scriptButtons(&profiler, machine.frame, &random);
+		runMegaDriveFrame(&machine);
+	}
+
+	// Measure whole frames, from the first one after the game loop started.
+	u32 firstFrame = machine.frame;
+	unsigned long long nextSample = machine.cpu.cycles;
+	machine.dmaCycles = 0;
+	while (machine.frame < firstFrame + frames) {
+		machine.buttons = scriptButtons(&profiler, machine.frame, &random);
+		u32 frame = machine.frame;
+		while (machine.frame == frame) {
+			stepMegaDrive(&machine);
+			trackIdle(&profiler, &machine.cpu);
+			while (nextSample <= machine.cpu.cycles) {
+				u32 programCounter = machine.cpu.instructionPC;
+				s32 symbol = findRomSymbol(&profiler.symbols, programCounter);
+				profiler.partCycles[currentPart(&profiler, machine.cpu.a[7], programCounter)] += interval;
+				if (symbol >= 0)
+					profiler.functionCycles[symbol] += interval;
+				nextSample += interval;
+			}
+		}
+	}
+
+	printf("romprofile: %s, %u frames from the first call to %s, 1 sample every %u cycles\n", romPath, frames, startSymbol, interval);
+	printReport(&profiler, frames);
+
+	if (newBaseline != NULL && writeBaseline(&profiler, frames, newBaseline) != 0) {
+		fprintf(stderr, "cannot write %s\n", newBaseline);
+		return 2;
+	}
+	if (baseline != NULL) {
+		int regressions = compareBaseline(&profiler, frames, baseline, tolerance);
+		if (regressions < 0) {
+			fprintf(stderr, "cannot read %s\n", baseline);
+			return 2;
+		}
+		printf("baseline %s: %s\n", baseline, regressions ? "FAILED" : "ok");
+		return regressions ? 1 : 0;
+	}
+	return 0;
+}
@@ -0,0 +1,132 @@
+/*!
+\file ScaleBench.c
+\brief Host benchmark of the model at large world capacities
+\date 10/2026
+
+Fills a World of ENTITY_COUNT entities with duelling pairs (slot 2n faces slot 2n+1) and runs combatSystem on it.
+Every frame, a script starts attacks, guards and parries on idle entities, releases guards, and replaces dying entities
+with new ones, so that entities are destroyed and created in waves through the free list.
+Reports the cost per entity and frame of combatSystem and of the script, which should stay flat as the capacity grows.
+
+ENTITY_COUNT is a compile-time constant, so CMake builds this file once per capacity:
+scalebench_20, scalebench_1000, scalebench_10000 and scalebench_100000.
+scalebench_wheel_<capacity> is the same with timers instead of counting in combatSystem (ECS_TIMER_WHEEL, see Entities.h).
+
+Usage: scalebench_<capacity> [frames]
+*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "Model.h"
+
+#define WARMUP_FRAMES 256	/*!< Frames run before timing, until busy and dying entities reach a steady share. */
+#define ENTITY_FRAMES 20000000	/*!< Default number of timed entity-frames, whatever the capacity. */
+#define START_CHANCE 8	/*!< An idle entity starts a move with a chance of 1 in this, every frame. */
+
+#if ENTITY_COUNT % 2
+#error scalebench pairs up entities: ENTITY_COUNT must be even.
+#endif
+
+static World world;	/*!< Too large for the stack at high capacities. */
+
+
+/*! Returns the monotonic clock in nanoseconds. */
+static long long nanoseconds() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+
+/*! Creates an enemy character facing its partner, and has the partner face it back. */
+static void spawnDuellist(World *world) {
+	EntitySlot entity = createEnemyChar(world, mockEnemy);
+	EntitySlot partner = entity ^ 1;
+	setFacing(world, entity, partner);
+	setFacing(world, partner, entity);
+	refreshEntityHash(world, entity);
+	refreshEntityHash(world, partner);
+}
+
+
+/*! Runs the script for one frame.
+\return The number of entities destroyed and created again.
+*/
+static u32 scriptFrame(World *world, RandomStream *random) {
+	static const u8 moves[] = { A1, B1, Guarding, Parrying };
+	u32 respawned = 0;
+
+	for (EntitySlot entity = 0; entity < ENTITY_COUNT; ++entity) {
+		if (world->move[entity].move == Dying) {
+			// The most recently destroyed slot is reused first, so the new entity takes the same slot.
+			destroyEntity(world, entity);
+			spawnDuellist(world);
+			++respawned;
+		}
+		else if (world->move[entity].move == Guarding && entityFrames(world, entity) > ATTACK_FRAMES) {
+			// Release the guard, like inputSystem does when the button is released.
+			world->move[entity].move = Idling;
+			setEntityFrames(world, entity, 0);
+			refreshBusyEntity(world, entity);
+		}
+		else if (world->move[entity].move == Idling && entityStaggered(world, entity) == 0
+			&& randomRange(random, START_CHANCE) == 0) {
+			world->move[entity].move = moves[randomRange(random, 4)];
+			setEntityFrames(world, entity, 0);
+			refreshBusyEntity(world, entity);
+		}
+	}
+	return respawned;
+}
+
+
+int main(int argc, char **argv) {
+	u32 frames = (argc > 1) ? (u32)atoi(argv[1]) : ENTITY_FRAMES / ENTITY_COUNT;
+	SimContext context;
+	RandomStream random;
+	long long scriptTime = 0, combatTime = 0;
+	u32 respawned = 0;
+	double busy = 0;
+
+	if (frames == 0) {
+		fprintf(stderr, "usage: %s [frames]\n", argv[0]);
+		return 1;
+	}
+
+	destroyAllEntities(&world);
+	for (u32 i = 0; i < ENTITY_COUNT; ++i)
+		spawnDuellist(&world);
+	context.currentPlayer = 0; // combatSystem never reaches its end of match code: dying entities are replaced first.
+	context.eventSFX = 0;
+	seedRandom(&random, ENTITY_COUNT);
+
+	for (u32 frame = 0; frame < WARMUP_FRAMES + frames; ++frame) {
+		long long start = nanoseconds();
+		u32 count = scriptFrame(&world, &random);
+		long long middle = nanoseconds();
+		combatSystem(&world, &context);
+		long long end = nanoseconds();
+
+		if (frame < WARMUP_FRAMES)
+			continue;
+		scriptTime += middle - start;
+		combatTime += end - middle;
+		respawned += count;
+		for (u32 word = 0; word < ENTITY_WORDS; ++word)
+			busy += __builtin_popcount(world.entitySet[COMPONENT_TYPES][word]);
+	}
+
+	double entityFrames = (double)ENTITY_COUNT * frames;
+	printf("scalebench: %u entities (%u-bit slots, World %zu bytes), %u frames\n",
+		(u32)ENTITY_COUNT, (u32)(sizeof(EntitySlot) * 8), sizeof(World), frames);
+	printf("  combatSystem: %7.2f ns/entity-frame\n", combatTime / entityFrames);
+	printf("  script      : %7.2f ns/entity-frame\n", scriptTime / entityFrames);
+	printf("  busy %.1f%%, %.2f%% of entities destroyed and created per frame\n",
+		100.0 * busy / entityFrames, 100.0 * respawned / entityFrames);
+	return 0;
+}
@@ -0,0 +1,88 @@
+/*!
+\file Cpu68k.h
+\brief 68000 interpreter header file
+\date 10/2026
+
+Interpreter of the Motorola 68000 instruction set, with the cycle counts of the 68000 user's manual.
+Memory and interrupts go through a CpuBus, so the same core runs under any memory map (see MegaDrive.h).
+
+Cycle counts include effective address calculation, and exact MULU/MULS/DIVU/DIVS times.
+Not modelled: wait states, bus arbitration, prefetch effects, trace mode and address errors.
+*/
+
+#ifndef HOST_CPU68K_H_
+#define HOST_CPU68K_H_
+
+#include "types.h"
+
+#define CPU_FLAG_C 0x0001	/*!< Carry */
+#define CPU_FLAG_V 0x0002	/*!< Overflow */
+#define CPU_FLAG_Z 0x0004	/*!< Zero */
+#define CPU_FLAG_N 0x0008	/*!< Negative */
+#define CPU_FLAG_X 0x0010	/*!< Extend */
+#define CPU_FLAG_S 0x2000	/*!< Supervisor mode */
+
+/*! \brief Structure with the memory map and interrupt controller seen by the CPU.
+
+	Addresses are 24-bit. Word accesses are always at even addresses.
+	acknowledge is called when the CPU takes an interrupt, and returns the exception vector number.
+*/
+typedef struct {
+	u8 (*read8)(void *context, u32 address);
+	u16 (*read16)(void *context, u32 address);
+	void (*write8)(void *context, u32 address, u8 value);
+	void (*write16)(void *context, u32 address, u16 value);
+	u8 (*acknowledge)(void *context, u8 level);
+	void *context;
+} CpuBus;
+
+/*! \brief Called when the CPU enters a subroutine (JSR, BSR) or an exception handler.
+	\param context CpuCallHook context given to the Cpu68k.
+	\param target Address of the subroutine or handler.
+	\param stackPointer A7 after the return address (and status register) were pushed.
+	\param vector Exception vector number, or 0 for JSR and BSR.
+*/
+typedef void (*CpuCallHook)(void *context, u32 target, u32 stackPointer, u8 vector);
+
+/*! \brief Structure with the state of a 68000.
+
+\param d[] Data registers.
+\param a[] Address registers. a[7] is the stack pointer of the current mode.
+\param otherStack The stack pointer of the other mode (USP in supervisor mode, SSP in user mode).
+\param pc Program counter.
+\param sr Status register.
+\param stopped Set by STOP until the next interrupt.
+\param interruptLevel Interrupt level requested by the hardware. 0: none.
+\param cycles Cycles run since resetCpu68k.
+\param instructionPC Address of the instruction being run, or of the last one run.
+*/
+typedef struct {
+	u32 d[8];
+	u32 a[8];
+	u32 otherStack;
+	u32 pc;
+	u16 sr;
+	u8 stopped;
+	u8 interruptLevel;
+	unsigned long long cycles;
+	u32 instructionPC;
+
+	CpuBus bus;	/**< Memory map */
+	CpuCallHook onCall;	/**< Optional, may be NULL */
+	void *hookContext;	/**< Passed to onCall */
+} Cpu68k;
+
+
+/*! \brief Resets the CPU: supervisor mode, interrupts masked, SSP and PC read from vectors 0 and 1.
+	\param *cpu The CPU. bus, onCall and hookContext must be set.
+	\return void
+*/
+void resetCpu68k(Cpu68k *cpu);
+
+/*! \brief Runs one instruction, or takes a pending interrupt.
+	\param *cpu The CPU.
+	\return Number of cycles taken. Also added to cpu->cycles.
+*/
+u32 stepCpu68k(Cpu68k *cpu);
+
+#endif // !HOST_CPU68K_H_
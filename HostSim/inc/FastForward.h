@@ -0,0 +1,42 @@
+/*!
+\file FastForward.h
+\brief Fast-forward header file
+\date 10/2026
+
+Jumps over the frames of a match in which no system decides anything.
+In most frames, updateWorld only counts: 'frames' of the busy entities up, 'staggered' down,
+and difficultyAIaccumulator up towards 100. quietFrames finds, from the counts, the input and the accumulator,
+the next frame in which a system does more (an attack starts, hits or ends, a stagger or a guard ends,
+the AI acts, ...), and fastForward plays the frames before it at once, with the result of playing them one by one.
+The rules follow combatSystem, inputSystem and AISystem in Systems.c: a change there needs a change here,
+which the fastforward test catches.
+*/
+
+#ifndef HOST_FAST_FORWARD_H_
+#define HOST_FAST_FORWARD_H_
+
+#include "Model.h"
+
+/*! \brief Counts the next frames in which updateWorld would only count, if given the same input in each.
+
+	Counts stop before a count reaches a value a system acts on, and before a count ends or wraps around,
+	so that fastForward has nothing else to update.
+	\param *world The game state as a World structure.
+	\param *context The simulation state belonging to the world.
+	\param *buttonInput The input of each of these frames.
+	\param difficulty The DIFF_* value added to difficultyAIaccumulator before each frame.
+	\param limit Count no further than this.
+	\return The number of frames, up to limit.
+*/
+u32 quietFrames(World *world, SimContext *context, const ButtonInput *buttonInput, u16 difficulty, u32 limit);
+
+/*! \brief Plays frames counted by quietFrames at once, difficultyAIaccumulator included.
+	\param *world The game state as a World structure.
+	\param *context The simulation state belonging to the world.
+	\param difficulty The DIFF_* value added to difficultyAIaccumulator before each frame.
+	\param frames Number of frames, at most what quietFrames returned.
+	\return The EventQueue of the last of these frames: like those of the others, it holds no command.
+*/
+EventQueue fastForward(World *world, SimContext *context, u16 difficulty, u32 frames);
+
+#endif // !HOST_FAST_FORWARD_H_
@@ -0,0 +1,83 @@
+/*!
+\file Match.h
+\brief Host match header file
+\date 10/2026
+
+Plays complete matches on the host, the same way startGame in main.c does on the console,
+with a scripted player (see PlayerBot.h) in place of the controller.
+*/
+
+#ifndef HOST_MATCH_H_
+#define HOST_MATCH_H_
+
+#include "Model.h"
+#include "PlayerBot.h"
+
+#define MATCH_FRAME_LIMIT (60 * 60 * 10)	/*!< A match is called off after 10 minutes of game time. */
+#define MATCH_WORLD_STREAM 0x5EED	/*!< Stream split from the match seed for initializeMatch (see matchSeed). */
+
+/*! \brief Enumeration with the ways a match can end. */
+typedef enum {
+	MatchPlaying,	/**< Match has not ended yet */
+	MatchWon,	/**< Last enemy finished dying: 'Stage Clear!' */
+	MatchLost,	/**< Current player character finished dying: 'Game Over' */
+	MatchTimedOut,	/**< MATCH_FRAME_LIMIT reached */
+} MatchOutcome;
+
+/*! \brief Structure with everything that decides how a match plays out.
+	\param numAllies Number of player characters. Range: 1-MAX_ALLIES
+	\param difficulty One of the DIFF_* values, added to difficultyAIaccumulator every frame.
+	\param seed Seed of the scripted player. The AI's stream (SimContext.randomAI) is split from it.
+*/
+typedef struct {
+	u8 numAllies;
+	u16 difficulty;
+	u32 seed;
+} MatchSetup;
+
+/*! \brief Structure with the result of a played match.
+	\param outcome How the match ended.
+	\param frames Number of frames the match lasted.
+	\param hash simulationHash of the game state after the last frame (see Entities.h).
+*/
+typedef struct {
+	MatchOutcome outcome;
+	u32 frames;
+	WorldHash hash;
+} MatchResult;
+
+
+/*! \brief Reads game state to see if the match has ended.
+
+	Uses the same conditions as checkProgression in main.c.
+	\param *world The game state as a World structure.
+	\param *context The simulation state belonging to the world.
+	\return MatchWon, MatchLost or MatchPlaying.
+*/
+MatchOutcome matchOutcome(World *world, SimContext *context);
+
+/*! \brief Plays one match from the starting game state until it ends.
+	\param *setup Number of allies, difficulty and seed of the match.
+	\return Outcome and length of the match.
+*/
+MatchResult playMatch(const MatchSetup *setup);
+
+/*! \brief Plays one match like playMatch, but jumps over the frames in which no system decides anything (see FastForward.h).
+
+	Gives the same result as playMatch, in a fraction of the time at low difficulties.
+	\param *setup Number of allies, difficulty and seed of the match.
+	\return Outcome and length of the match.
+*/
+MatchResult fastForwardMatch(const MatchSetup *setup);
+
+/*! \brief Derives the seed of one match from a sweep seed and the match number.
+
+	Every match gets its own seed, split from the sweep's stream with splitRandom,
+	so a sweep gives the same results whichever thread plays which match.
+	\param seed Seed of the whole sweep.
+	\param match Number of the match in the sweep.
+	\return Seed of the match.
+*/
+u32 matchSeed(u32 seed, u32 match);
+
+#endif // !HOST_MATCH_H_
@@ -0,0 +1,99 @@
+/*!
+\file MegaDrive.h
+\brief Mega Drive machine header file
+\date 10/2026
+
+Just enough of a Mega Drive (NTSC) to boot and run an SGDK ROM on the host under Cpu68k:
+cartridge, work RAM, a VDP that keeps VRAM/CRAM/VSRAM and raises VINT/HINT on time,
+one 3-button pad on port 1, and a stub in place of the Z80 and sound chips.
+
+Nothing is drawn and no sound is made. What counts is that the 68000 sees the same memory map,
+interrupts and DMA stalls as on the console, so that its cycle counts are those of the console.
+
+Timing: 262 lines of 488 cycles per frame, VINT at line 224. 68000 to VDP DMA halts the CPU for
+the time the VDP takes to copy (H40: 205 bytes per line in vertical blank or with the display off,
+18 bytes per line during active display). The Z80 never runs: its RAM is plain memory,
+bus requests are granted at once, and the status byte SGDK drivers poll reads as ready.
+*/
+
+#ifndef HOST_MEGA_DRIVE_H_
+#define HOST_MEGA_DRIVE_H_
+
+#include "Cpu68k.h"
+
+#define MD_LINE_CYCLES 488	/*!< 68000 cycles per scanline (3420 master clocks / 7, rounded down). */
+#define MD_FRAME_LINES 262	/*!< Scanlines per frame (NTSC). */
+#define MD_VBLANK_LINE 224	/*!< First line of vertical blank (V28 mode), when VINT is raised. */
+#define MD_FRAME_CYCLES (MD_LINE_CYCLES * MD_FRAME_LINES)	/*!< 68000 cycles per frame. */
+
+/*! Pad buttons, with the bit values of SGDK's BUTTON_* defines. */
+#define PAD_UP 0x0001
+#define PAD_DOWN 0x0002
+#define PAD_LEFT 0x0004
+#define PAD_RIGHT 0x0008
+#define PAD_B 0x0010
+#define PAD_C 0x0020
+#define PAD_A 0x0040
+#define PAD_START 0x0080
+
+/*! \brief Structure with the state of the machine.
+
+\param cpu The 68000. Its cycle counter is the machine's clock.
+\param rom Cartridge contents, big-endian as in rom.bin. Not owned.
+\param romSize Size of rom in bytes.
+\param buttons Buttons held on the pad of port 1 (PAD_*).
+\param frame Number of frames run.
+*/
+typedef struct {
+	Cpu68k cpu;
+	const u8 *rom;
+	u32 romSize;
+	u16 buttons;
+	u32 frame;
+
+	u8 ram[0x10000];	/**< Work RAM, 0xFF0000-0xFFFFFF */
+	u8 z80Ram[0x2000];	/**< Z80 RAM, 0xA00000-0xA01FFF */
+	u8 vram[0x10000];	/**< Video RAM */
+	u16 cram[64];	/**< Colour RAM */
+	u16 vsram[40];	/**< Vertical scroll RAM */
+	u8 vdpRegister[24];	/**< VDP registers */
+	u16 vdpAddress;	/**< Address of the next data port access */
+	u8 vdpCode;	/**< Access code (CD5-CD0) of the next data port access */
+	u8 vdpSecondWord;	/**< The first word of a two-word command was written */
+	u8 vdpFillPending;	/**< A DMA fill waits for its value on the data port */
+	u8 vintPending;	/**< VINT raised and not acknowledged */
+	u8 hintPending;	/**< HINT raised and not acknowledged */
+	s16 hintCounter;	/**< Lines left before the next HINT */
+	u32 line;	/**< Current scanline */
+	unsigned long long lineStart;	/**< cpu.cycles at the start of the current line */
+	u8 padControl;	/**< Port 1 control register (pin directions) */
+	u8 padData;	/**< Port 1 data register (TH output) */
+	u8 z80BusRequest;	/**< The 68000 holds the Z80 bus */
+	u8 z80Reset;	/**< The Z80 is held in reset */
+	unsigned long long dmaCycles;	/**< 68000 cycles lost to DMA since creation */
+} MegaDrive;
+
+
+/*! \brief Powers on the machine with a cartridge, and resets the 68000.
+	\param *machine The machine.
+	\param *rom Cartridge contents. Must stay allocated while the machine runs.
+	\param romSize Size of rom in bytes.
+	\param onCall Optional hook called on every JSR/BSR and exception (see CpuCallHook). May be NULL.
+	\param hookContext Passed to onCall.
+	\return void
+*/
+void powerOnMegaDrive(MegaDrive *machine, const u8 *rom, u32 romSize, CpuCallHook onCall, void *hookContext);
+
+/*! \brief Runs one 68000 instruction (or interrupt), and moves on to the next scanlines it reaches.
+	\param *machine The machine.
+	\return Number of cycles taken, DMA stalls included.
+*/
+u32 stepMegaDrive(MegaDrive *machine);
+
+/*! \brief Runs until the next frame starts.
+	\param *machine The machine.
+	\return void
+*/
+void runMegaDriveFrame(MegaDrive *machine);
+
+#endif // !HOST_MEGA_DRIVE_H_
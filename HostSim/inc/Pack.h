@@ -0,0 +1,49 @@
+/*!
+\file Pack.h
+\brief SGDK compression header file
+\date 10/2026
+
+Packs data in the two formats SGDK 1.5 unpacks on the console (tools.h, unpack()):
+- aPLib (COMPRESSION_APLIB): LZ77 on bytes with a bit stream of gamma codes. Small, slow to unpack.
+- LZ4W (COMPRESSION_FAST): LZ77 on 16-bit words with byte-aligned tokens. Larger, about 10 times faster to unpack.
+Both use an optimal parse over every match a hash chain finds. What the console takes to unpack them is measured
+by running SGDK's own unpackers from the ROM (see Unpack68k.h).
+*/
+
+#ifndef HOST_PACK_H_
+#define HOST_PACK_H_
+
+#include "types.h"
+
+/*! \brief Enumeration with the compression methods, with the values of SGDK's COMPRESSION_* defines. */
+typedef enum {
+	PackNone = 0,	/**< Stored as is */
+	PackAplib = 1,	/**< aPLib */
+	PackLz4w = 2	/**< LZ4W */
+} PackMethod;
+
+#define PACK_METHODS 3	/*!< Number of PackMethod values. */
+
+
+/*! \brief Returns the most bytes packing data of a size can take.
+	\param size Bytes of the data.
+	\return Size of the buffer to give packData.
+*/
+u32 packBound(u32 size);
+
+/*! \brief Packs data.
+	\param method The method.
+	\param *data The data.
+	\param size Bytes of the data.
+	\param *packed Written with the packed data. Must have room for packBound(size) bytes.
+	\return Bytes of the packed data, or 0 if the method cannot pack it (LZ4W: odd size).
+*/
+u32 packData(PackMethod method, const u8 *data, u32 size, u8 *packed);
+
+/*! \brief Returns the name of a method, as rescomp writes it in .res files.
+	\param method The method.
+	\return "NONE", "APLIB" or "FAST".
+*/
+const char *packMethodName(PackMethod method);
+
+#endif // !HOST_PACK_H_
@@ -0,0 +1,64 @@
+/*!
+\file PlayerBot.h
+\brief Scripted player header file
+\date 10/2026
+
+A scripted player that reads the game state and writes a ButtonInput structure every frame,
+in place of joyHandler in main.c. Used to play matches on the host without a controller.
+*/
+
+#ifndef HOST_PLAYER_BOT_H_
+#define HOST_PLAYER_BOT_H_
+
+#include "Model.h"
+
+/*! \brief Structure with the state of a scripted player.
+	\param random Random stream deciding the next button press.
+	\param button Button currently held down.
+	\param heldFrames Number of frames left before the button is released.
+*/
+typedef struct {
+	RandomStream random;
+	Button button;
+	u8 heldFrames;
+} PlayerBot;
+
+
+/*! \brief Prepares a scripted player.
+	\param *bot The scripted player.
+	\param seed Seed of its decisions.
+	\return void
+*/
+void initializePlayerBot(PlayerBot *bot, u32 seed);
+
+/*! \brief Decides the controller input for this frame.
+
+	The scripted player parries or guards incoming attacks, chains basic and special attacks,
+	and now and then switches character. It reacts imperfectly, so matches can be lost.
+	\param *bot The scripted player.
+	\param *world The game state as a World structure.
+	\param *context The simulation state belonging to the world.
+	\param *buttonInput Written with the input for this frame.
+	\return void
+*/
+void playerBotInput(PlayerBot *bot, World *world, SimContext *context, ButtonInput *buttonInput);
+
+/*! \brief Counts the next frames in which the scripted player keeps holding its button and decides nothing.
+
+	Assumes the game state only counts in those frames (see quietFrames in FastForward.h).
+	\param *bot The scripted player.
+	\param *world The game state as a World structure.
+	\param *context The simulation state belonging to the world.
+	\param *buttonInput Written with the input of each of these frames.
+	\return The number of frames. playerBotInput would give the same input in each.
+*/
+u32 playerBotHeldFrames(const PlayerBot *bot, World *world, SimContext *context, ButtonInput *buttonInput);
+
+/*! \brief Skips frames counted by playerBotHeldFrames, as if playerBotInput had been called in each.
+	\param *bot The scripted player.
+	\param frames Number of frames.
+	\return void
+*/
+void skipPlayerBot(PlayerBot *bot, u32 frames);
+
+#endif // !HOST_PLAYER_BOT_H_
@@ -0,0 +1,47 @@
+/*!
+\file Png.h
+\brief Indexed PNG reader header file
+\date 10/2026
+
+Reads the indexed (palette) PNG images SGDK's rescomp takes as backgrounds and sprites, with zlib.
+Only what rescomp accepts: colour type 3, 1, 2, 4 or 8 bits per pixel, not interlaced.
+*/
+
+#ifndef HOST_PNG_H_
+#define HOST_PNG_H_
+
+#include "types.h"
+
+#define PNG_MAX_COLORS 256	/*!< Entries of a PNG palette. */
+
+/*! \brief Structure with an indexed image.
+
+\param width Width in pixels.
+\param height Height in pixels.
+\param pixels Palette index of every pixel, row by row. Free with freeIndexedImage.
+\param colors Number of entries of the PLTE chunk.
+\param palette[] RGB of every entry. Entries past colors are black.
+*/
+typedef struct {
+	u32 width;
+	u32 height;
+	u8 *pixels;
+	u16 colors;
+	u8 palette[PNG_MAX_COLORS][3];
+} IndexedImage;
+
+
+/*! \brief Reads an indexed PNG file.
+	\param *image Written with the image.
+	\param *path Path of the PNG file.
+	\return 0 on success, -1 if the file cannot be read or is not an indexed, non-interlaced PNG.
+*/
+int loadIndexedPng(IndexedImage *image, const char *path);
+
+/*! \brief Frees what loadIndexedPng allocated.
+	\param *image The image.
+	\return void
+*/
+void freeIndexedImage(IndexedImage *image);
+
+#endif // !HOST_PNG_H_
@@ -0,0 +1,241 @@
+/*!
+\file Replay.h
+\brief Match replay header file
+\date 10/2026
+
+Records matches as the per-frame ButtonInput, with everything else that decides how they play out
+(seed of initializeMatch, number of allies, difficulty), and plays them back through updateWorld.
+The header also keeps the simulationHash of the last frame, so a replay that plays back differently
+is caught even when it ends the same way, on the same frame.
+
+A replay is a 25-byte header followed by runs. A run is one input byte (bit 7: isPressed,
+bits 0-6: latestButtonPress) and the number of frames it lasts as a LEB128 varint,
+so a stretch of frames with the same input costs 2-4 bytes however long it is.
+Numbers in the header are little-endian:
+
+| Offset | Size | Field |
+|---|---|---|
+| 0 | 4 | "GRPL" |
+| 4 | 1 | REPLAY_VERSION |
+| 5 | 1 | numAllies |
+| 6 | 2 | difficulty |
+| 8 | 4 | seed |
+| 12 | 4 | frames |
+| 16 | 1 | outcome (MatchOutcome) |
+| 17 | 8 | hash (simulationHash after the last frame) |
+
+A replay archive holds many replays in one file, with an index of their offsets at the end,
+and is memory-mapped to read any replay without parsing the others:
+
+| Offset | Size | Field |
+|---|---|---|
+| 0 | 4 | "GRPA" |
+| 4 | 4 | REPLAY_ARCHIVE_VERSION |
+| 8 | 4 | count |
+| 12 | 4 | 0 |
+| 16 | 8 | offset of the index |
+| 24 | | replays, one after the other |
+| index | 8 * (count + 1) | offset of every replay, then the offset of the index |
+*/
+
+#ifndef HOST_REPLAY_H_
+#define HOST_REPLAY_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Match.h"
+
+#define REPLAY_VERSION 3	/*!< Version of the replay format. Version 1 had no hash, version 2 hashed 'staggered' differently. */
+#define REPLAY_HEADER_SIZE 25	/*!< Bytes before the first run. */
+#define REPLAY_ARCHIVE_VERSION 1	/*!< Version of the archive format. */
+#define REPLAY_ARCHIVE_HEADER_SIZE 24	/*!< Bytes before the first replay of an archive. */
+
+/*! \brief Structure with the header of a replay.
+	\param numAllies Number of player characters. Range: 1-MAX_ALLIES
+	\param difficulty The DIFF_* value added to difficultyAIaccumulator every frame (AILevel in main.c).
+	\param seed Seed given to initializeMatch.
+	\param frames Number of frames recorded.
+	\param outcome How the match ended. MatchPlaying if it was recorded before it ended.
+	\param hash simulationHash of the game state after the last frame.
+*/
+typedef struct {
+	u8 numAllies;
+	u16 difficulty;
+	u32 seed;
+	u32 frames;
+	MatchOutcome outcome;
+	WorldHash hash;
+} ReplayInfo;
+
+/*! \brief Structure with a replay being recorded.
+
+	Zero it before the first beginReplay. The buffer is kept from one replay to the next.
+	\param info Header of the replay.
+	\param *data The replay, complete after endReplay.
+	\param size Size of the replay in bytes.
+	\param capacity Allocated size of data.
+	\param runInput Input byte of the run being recorded.
+	\param runLength Number of frames of the run being recorded.
+*/
+typedef struct {
+	ReplayInfo info;
+	u8 *data;
+	u32 size;
+	u32 capacity;
+	u8 runInput;
+	u32 runLength;
+} ReplayWriter;
+
+/*! \brief Structure with a replay being played back.
+	\param info Header of the replay.
+	\param *next Next run.
+	\param *end End of the replay.
+	\param input Input of the current run.
+	\param runLeft Number of frames left in the current run.
+	\param frame Number of frames read.
+*/
+typedef struct {
+	ReplayInfo info;
+	const u8 *next;
+	const u8 *end;
+	ButtonInput input;
+	u32 runLeft;
+	u32 frame;
+} ReplayReader;
+
+/*! \brief Structure with a memory-mapped replay archive.
+	\param *map The mapped file.
+	\param size Size of the file.
+	\param count Number of replays.
+	\param *index Offsets of the replays (count + 1 little-endian u64).
+*/
+typedef struct {
+	const u8 *map;
+	size_t size;
+	u32 count;
+	const u8 *index;
+} ReplayArchive;
+
+/*! \brief Structure with a replay archive being written.
+	\param *file The file.
+	\param *offsets Offset of every replay added.
+	\param count Number of replays added.
+	\param capacity Allocated length of offsets.
+	\param position Offset of the end of the file.
+*/
+typedef struct {
+	FILE *file;
+	uint64_t *offsets;
+	u32 count;
+	u32 capacity;
+	uint64_t position;
+} ReplayArchiveWriter;
+
+
+/*! \brief Starts recording a replay.
+	\param *replay The replay. Zeroed before its first use.
+	\param numAllies Number of player characters.
+	\param difficulty The DIFF_* value of the match.
+	\param seed Seed given to initializeMatch.
+	\return void
+*/
+void beginReplay(ReplayWriter *replay, u8 numAllies, u16 difficulty, u32 seed);
+
+/*! \brief Records the input of one frame.
+	\param *replay The replay.
+	\param *buttonInput The input given to updateWorld this frame.
+	\return 0 on success, -1 if out of memory.
+*/
+int recordReplayFrame(ReplayWriter *replay, const ButtonInput *buttonInput);
+
+/*! \brief Ends the recording: writes the last run and the header.
+	\param *replay The replay. data and size then hold it.
+	\param outcome How the match ended.
+	\param hash simulationHash of the game state after the last frame.
+	\return 0 on success, -1 if out of memory.
+*/
+int endReplay(ReplayWriter *replay, MatchOutcome outcome, WorldHash hash);
+
+/*! \brief Frees the buffer of a replay writer.
+	\param *replay The replay.
+	\return void
+*/
+void freeReplayWriter(ReplayWriter *replay);
+
+/*! \brief Plays one match with the scripted player, as playMatch does, and records it.
+	\param *setup Number of allies, difficulty and seed of the match.
+	\param *replay Written with the replay.
+	\return Outcome and length of the match. MatchTimedOut also if out of memory.
+*/
+MatchResult recordMatch(const MatchSetup *setup, ReplayWriter *replay);
+
+/*! \brief Starts reading a replay.
+	\param *replay The reader.
+	\param *data The replay. Must stay allocated while it is read.
+	\param size Size of the replay in bytes.
+	\return 0 on success, -1 if the data is not a replay of this version.
+*/
+int openReplay(ReplayReader *replay, const u8 *data, size_t size);
+
+/*! \brief Reads the input of the next frame.
+	\param *replay The reader.
+	\param *buttonInput Written with the input.
+	\return TRUE, or FALSE after the last frame (or at corrupt data).
+*/
+u8 nextReplayFrame(ReplayReader *replay, ButtonInput *buttonInput);
+
+/*! \brief Re-simulates a replay through updateWorld, from the starting game state.
+
+	Stops when the match ends, like startGame. Compare the result with replay->info
+	to check that the model still plays the match the same way.
+	\param *replay The reader, freshly opened.
+	\param *world Written with the game state at the end.
+	\param *context Written with the simulation state at the end.
+	\return Outcome and length of the match. MatchPlaying if the input ran out first.
+*/
+MatchResult playReplay(ReplayReader *replay, World *world, SimContext *context);
+
+/*! \brief Creates a replay archive.
+	\param *archive The writer.
+	\param *path Path of the file. Overwritten.
+	\return 0 on success, -1 if the file cannot be created.
+*/
+int createReplayArchive(ReplayArchiveWriter *archive, const char *path);
+
+/*! \brief Appends a replay to an archive.
+	\param *archive The writer.
+	\param *data The replay.
+	\param size Size of the replay in bytes.
+	\return 0 on success, -1 on a write error or if out of memory.
+*/
+int addArchiveReplay(ReplayArchiveWriter *archive, const u8 *data, u32 size);
+
+/*! \brief Writes the index and closes an archive.
+	\param *archive The writer.
+	\return 0 on success, -1 on a write error.
+*/
+int finishReplayArchive(ReplayArchiveWriter *archive);
+
+/*! \brief Maps a replay archive into memory.
+	\param *archive Written with the mapped archive.
+	\param *path Path of the file.
+	\return 0 on success, -1 if the file cannot be mapped or is not an archive of this version.
+*/
+int openReplayArchive(ReplayArchive *archive, const char *path);
+
+/*! \brief Opens one replay of an archive, without reading the others.
+	\param *archive The archive.
+	\param index Number of the replay. Range: 0 to count-1
+	\param *replay Written with a reader of the replay.
+	\return 0 on success, -1 if the index or the replay is invalid.
+*/
+int openArchivedReplay(const ReplayArchive *archive, u32 index, ReplayReader *replay);
+
+/*! \brief Unmaps a replay archive.
+	\param *archive The archive.
+	\return void
+*/
+void closeReplayArchive(ReplayArchive *archive);
+
+#endif // !HOST_REPLAY_H_
@@ -0,0 +1,123 @@
+/*!
+\file Resource.h
+\brief rescomp resource header file
+\date 10/2026
+
+Reads rescomp .res files and writes each resource as rescomp 1.5 does: the SGDK structures in the assembly of the .s
+file, and the declaration of the .h file. The resources of the game:
+- IMAGE name file [compression]: palette, tileset and tilemap (see TileImage.h).
+- SPRITE name file width height [compression [time [collision]]]: SpriteDefinition, animations of frames of hardware
+  sprites (see SpriteSheet.h). Frame size in tiles, time in frames. No collision boxes (NONE).
+- WAV name file XGM: 8-bit signed samples at 14 kHz for the XGM driver (see Wav.h), 256-byte aligned.
+- XGM name file: music for the XGM driver. A .vgm or .xgm file is compiled by SGDK's xgmtool, as rescomp does;
+  a .xgc file is taken as is.
+- SPRITE_DELTA name file width height [gap]: not a rescomp resource. The SpriteDelta of a SPRITE's sheet
+  (Gemu/inc/SpriteDelta.h): the tiles that change from each frame of an animation to the next (see changedTileRuns).
+Compression: NONE (0), APLIB (1), FAST or LZ4W (2), or BEST/AUTO (-1): the smallest (see Pack.h).
+*/
+
+#ifndef HOST_RESOURCE_H_
+#define HOST_RESOURCE_H_
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "types.h"
+
+#define RESOURCE_NAME 128	/*!< Longest resource name. */
+#define RESOURCE_PATH 1024	/*!< Longest file path. */
+#define RESOURCE_DECLARATION (RESOURCE_NAME + 64)	/*!< Longest line of a .h file. */
+#define COMPRESSION_BEST -1	/*!< Compression column BEST/AUTO. */
+
+/*! \brief Enumeration with the resource types. */
+typedef enum {
+	ResourceImage,
+	ResourceSprite,
+	ResourceWav,
+	ResourceXgm,
+	ResourceSpriteDelta
+} ResourceType;
+
+/*! \brief Structure with a line of a .res file.
+
+\param type The type.
+\param name Name of the structure in the ROM.
+\param path Input file, from the working directory.
+\param compression PackMethod, or COMPRESSION_BEST. IMAGE and SPRITE.
+\param width SPRITE, SPRITE_DELTA: frame width in tiles.
+\param height SPRITE, SPRITE_DELTA: frame height in tiles.
+\param time SPRITE: frames each animation frame is shown.
+\param gap SPRITE_DELTA: most unchanged tiles sent to join two runs of changed tiles.
+\param group Number of the group of lines it is in: groups are separated by blank lines.
+\param line Line in the .res file.
+*/
+typedef struct {
+	ResourceType type;
+	char name[RESOURCE_NAME];
+	char path[RESOURCE_PATH];
+	s8 compression;
+	u16 width;
+	u16 height;
+	u16 time;
+	u16 gap;
+	u16 group;
+	u32 line;
+} Resource;
+
+
+/*! \brief Reads a compression column as rescomp does.
+	\param *text The column.
+	\return PackMethod, COMPRESSION_BEST, or -2 if it is not a compression.
+*/
+int parseCompression(const char *text);
+
+/*! \brief Reads a .res file. Prints what is wrong with it to the standard error.
+	\param **resources Written with its resources, in order. Free with free.
+	\param *count Written with the number of resources.
+	\param *path Path of the .res file. Input files are relative to its directory.
+	\return 0 on success, -1 if it cannot be read or has a line that is not a resource above.
+*/
+int readResourceFile(Resource **resources, u32 *count, const char *path);
+
+/*! \brief Writes a resource as rescomp does. Prints what went wrong to the standard error.
+	\param *out Written with the assembly of the resource.
+	\param declaration[] Written with the line of the .h file that declares it.
+	\param *resource The resource.
+	\param *xgmtool Command of SGDK's xgmtool, for XGM resources.
+	\return 0 on success, -1 if its file cannot be read or converted.
+*/
+int writeResource(FILE *out, char declaration[RESOURCE_DECLARATION], const Resource *resource, const char *xgmtool);
+
+/*! \brief Writes the guard of the .h file rescomp writes next to a .s file: its name in capitals.
+	\param guard[] Written with the guard.
+	\param size Size of guard.
+	\param *assemblyPath Path of the .s file.
+	\return void
+*/
+void resourceHeaderGuard(char *guard, size_t size, const char *assemblyPath);
+
+/*! \brief Writes a label as rescomp does: word-aligned.
+	\param *out The assembly.
+	\param *name The resource name.
+	\param *suffix Added to the name.
+	\return void
+*/
+void writeAssemblyLabel(FILE *out, const char *name, const char *suffix);
+
+/*! \brief Writes data as rescomp does: big-endian words, 8 a line.
+	\param *out The assembly.
+	\param *bytes The data.
+	\param size Bytes of the data. Even.
+	\return void
+*/
+void writeAssemblyWords(FILE *out, const u8 *bytes, u32 size);
+
+/*! \brief Writes data as bytes, 16 a line.
+	\param *out The assembly.
+	\param *bytes The data.
+	\param size Bytes of the data.
+	\return void
+*/
+void writeAssemblyBytes(FILE *out, const u8 *bytes, u32 size);
+
+#endif // !HOST_RESOURCE_H_
@@ -0,0 +1,60 @@
+/*!
+\file ResourceBuild.h
+\brief Incremental resource build header file
+\date 10/2026
+
+Builds .res files into the .s and .h files rescomp writes (see Resource.h), on every core, and only what changed:
+- Every resource of every file is a job of a work-stealing scheduler (see WorkStealing.h), so a slow one (a sprite
+  sheet, music through xgmtool) does not hold up the others.
+- A job first hashes what its output depends on: the resource line, the contents of its input file and the
+  version of the conversions (RESOURCE_BUILD_VERSION). The cache directory keeps the output of every hash, so an
+  input file is only converted again once its contents change, whatever its date.
+- A .s or .h file is only written when its contents change, so that make does not assemble it again for nothing.
+*/
+
+#ifndef HOST_RESOURCE_BUILD_H_
+#define HOST_RESOURCE_BUILD_H_
+
+#include "types.h"
+
+/*! \brief Version of the conversions, part of every hash: raise it when an output changes for the same input. */
+#define RESOURCE_BUILD_VERSION 1
+
+/*! \brief Structure with how to build.
+
+\param cacheDirectory Directory of the outputs by hash, made if missing. NULL to convert everything.
+\param xgmtool Command of SGDK's xgmtool, for XGM resources.
+\param threads Number of threads. 0 for one per core.
+*/
+typedef struct {
+	const char *cacheDirectory;
+	const char *xgmtool;
+	u32 threads;
+} BuildOptions;
+
+/*! \brief Structure with what a build did.
+
+\param resources Number of resources.
+\param converted Number of resources converted.
+\param cached Number of resources taken from the cache.
+\param filesWritten Number of .s and .h files written because their contents changed.
+*/
+typedef struct {
+	u32 resources;
+	u32 converted;
+	u32 cached;
+	u32 filesWritten;
+} BuildStats;
+
+
+/*! \brief Builds .res files. Prints what went wrong to the standard error.
+	\param *stats Written with what the build did.
+	\param resourcePaths[] Paths of the .res files.
+	\param count Number of .res files.
+	\param *outputDirectory Directory of the output: name.s and name.h for every name.res.
+	\param *options How to build.
+	\return 0 on success, -1 if a file cannot be read, converted or written. Nothing is written then.
+*/
+int buildResources(BuildStats *stats, const char *resourcePaths[], u32 count, const char *outputDirectory, const BuildOptions *options);
+
+#endif // !HOST_RESOURCE_BUILD_H_
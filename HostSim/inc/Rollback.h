@@ -0,0 +1,152 @@
+/*!
+\file Rollback.h
+\brief Rollback driver header file
+\date 10/2026
+
+Runs a match whose controller input comes from a remote player and arrives late.
+Frames whose input has not arrived are simulated with a predicted input (the input of the frame before).
+When the real input of such a frame arrives and differs from the prediction, the driver restores
+the snapshot taken before that frame (see Snapshot.h) and simulates the frames since then again,
+before it simulates the next one. It never runs more than ROLLBACK_MAX_FRAMES frames ahead of the input.
+
+The model has a single controller (ButtonInput), so the remote player drives it
+and the local machine only predicts and corrects.
+
+LoopbackLink stands in for the network in tests and benchmarks:
+it delivers every input it is given after a fixed delay plus a random jitter, possibly out of order.
+*/
+
+#ifndef HOST_ROLLBACK_H_
+#define HOST_ROLLBACK_H_
+
+#include "Snapshot.h"
+
+#define ROLLBACK_MAX_FRAMES 8	/*!< Frames the driver may simulate without their input. Less than SNAPSHOT_SLOTS. */
+#define ROLLBACK_INPUT_SLOTS 32	/*!< Frames of input kept, from the first unconfirmed one. Power of two. */
+#define ROLLBACK_NONE 0xFFFFFFFF	/*!< No frame to roll back to. */
+#define LOOPBACK_PACKETS 64	/*!< Inputs a LoopbackLink can hold in flight. */
+
+/*! \brief Structure with what a rollback driver did.
+	\param rollbacks Number of rollbacks.
+	\param resimulatedFrames Number of frames simulated again by rollbacks.
+	\param longestRollback Most frames simulated again by one rollback.
+	\param stalls Number of times the driver waited for input instead of simulating a frame.
+*/
+typedef struct {
+	u32 rollbacks;
+	u32 resimulatedFrames;
+	u32 longestRollback;
+	u32 stalls;
+} RollbackStats;
+
+/*! \brief Structure with a match driven by late input.
+	\param world The game state after 'frame' frames. May be rolled back: only frames below confirmedFrames are final.
+	\param context The simulation state belonging to the world.
+	\param difficulty The DIFF_* value added to difficultyAIaccumulator every frame.
+	\param frame Number of frames simulated.
+	\param confirmedFrames Every frame below this has its real input.
+	\param rollbackFrom First simulated frame whose real input differs from the one it was simulated with, or ROLLBACK_NONE.
+	\param input[] Input of frame n in slot n % ROLLBACK_INPUT_SLOTS, real or predicted.
+	\param confirmed[] The input of the slot is real. Cleared when confirmedFrames passes it.
+	\param snapshots State before each of the last SNAPSHOT_SLOTS frames.
+	\param stats What the driver did.
+*/
+typedef struct {
+	World world;
+	SimContext context;
+	u16 difficulty;
+	u32 frame;
+	u32 confirmedFrames;
+	u32 rollbackFrom;
+	ButtonInput input[ROLLBACK_INPUT_SLOTS];
+	u8 confirmed[ROLLBACK_INPUT_SLOTS];
+	SnapshotRing snapshots;
+	RollbackStats stats;
+} Rollback;
+
+/*! \brief Structure with one input on its way through a LoopbackLink. */
+typedef struct {
+	u32 deliverAt;	/**< Time at which it arrives */
+	u32 frame;	/**< Frame it is the input of */
+	ButtonInput input;
+} LoopbackPacket;
+
+/*! \brief Structure with a simulated network link. Time is counted in frames.
+	\param delay Frames every input takes to arrive.
+	\param jitter Up to this many frames more, at random.
+	\param random Random stream of the jitter.
+	\param packets[] Inputs in flight.
+	\param count Number of inputs in flight.
+*/
+typedef struct {
+	u32 delay;
+	u32 jitter;
+	RandomStream random;
+	LoopbackPacket packets[LOOPBACK_PACKETS];
+	u32 count;
+} LoopbackLink;
+
+
+/*! \brief Starts a match, from the starting game state of initializeMatch.
+	\param *rollback The driver.
+	\param numAllies Number of player characters. Range: 1-MAX_ALLIES
+	\param difficulty The DIFF_* value of the match.
+	\param seed Seed given to initializeMatch.
+	\return void
+*/
+void initializeRollback(Rollback *rollback, u8 numAllies, u16 difficulty, u32 seed);
+
+/*! \brief Gives the real input of a frame, in any order. Inputs already given are ignored.
+
+	If the frame was already simulated with another input, the next advanceRollback rolls back to it.
+	\param *rollback The driver.
+	\param frame The frame.
+	\param *buttonInput Its input.
+	\return 0 on success, -1 if the frame is ROLLBACK_INPUT_SLOTS or more frames past the first unconfirmed one.
+*/
+int addRollbackInput(Rollback *rollback, u32 frame, const ButtonInput *buttonInput);
+
+/*! \brief Rolls back now if an input differed from its prediction: restores the state before that frame
+	and simulates the frames since then again, with the inputs now known. advanceRollback does this first.
+	\param *rollback The driver.
+	\return void
+*/
+void resolveRollback(Rollback *rollback);
+
+/*! \brief Rolls back if an input differed from its prediction, then simulates the next frame.
+
+	Does not simulate a frame if ROLLBACK_MAX_FRAMES frames are already waiting for their input.
+	\param *rollback The driver.
+	\param *events Written with the EventQueue of the new frame. Can be NULL.
+	\return 0 if a frame was simulated, -1 if the driver waits for input.
+*/
+int advanceRollback(Rollback *rollback, EventQueue *events);
+
+/*! \brief Prepares a link.
+	\param *link The link.
+	\param delay Frames every input takes to arrive.
+	\param jitter Up to this many frames more, at random.
+	\param seed Seed of the jitter.
+	\return void
+*/
+void initializeLoopback(LoopbackLink *link, u32 delay, u32 jitter, u32 seed);
+
+/*! \brief Sends the input of a frame.
+	\param *link The link.
+	\param now Current time.
+	\param frame The frame.
+	\param *buttonInput Its input.
+	\return 0 on success, -1 if LOOPBACK_PACKETS inputs are already in flight.
+*/
+int sendLoopback(LoopbackLink *link, u32 now, u32 frame, const ButtonInput *buttonInput);
+
+/*! \brief Takes one input that has arrived.
+	\param *link The link.
+	\param now Current time.
+	\param *frame Written with the frame of the input.
+	\param *buttonInput Written with the input.
+	\return TRUE if an input has arrived, FALSE if none has.
+*/
+u8 receiveLoopback(LoopbackLink *link, u32 now, u32 *frame, ButtonInput *buttonInput);
+
+#endif // !HOST_ROLLBACK_H_
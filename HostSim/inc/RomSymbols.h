@@ -0,0 +1,58 @@
+/*!
+\file RomSymbols.h
+\brief ROM symbol table header file
+\date 10/2026
+
+Reads the code symbols of rom.out (the ELF file SGDK links before making rom.bin),
+to map program counter values to function names.
+*/
+
+#ifndef HOST_ROM_SYMBOLS_H_
+#define HOST_ROM_SYMBOLS_H_
+
+#include "types.h"
+
+/*! \brief Structure with one code symbol. */
+typedef struct {
+	u32 address;	/**< Start address in the ROM */
+	const char *name;	/**< Symbol name */
+} RomSymbol;
+
+/*! \brief Structure with the code symbols of a ROM, sorted by address. */
+typedef struct {
+	RomSymbol *symbols;
+	u32 count;
+	char *names;	/**< String table the names point into */
+} RomSymbols;
+
+
+/*! \brief Reads the function and code label symbols of a 68000 ELF file.
+
+	Symbols of executable sections are kept, except local labels (names starting with '.').
+	\param *symbols Written with the symbols. Free with freeRomSymbols.
+	\param *path Path of the ELF file, e.g. out/rom.out.
+	\return 0 on success, -1 if the file cannot be read or is not a big-endian ELF32 file with a symbol table.
+*/
+int loadRomSymbols(RomSymbols *symbols, const char *path);
+
+/*! \brief Frees what loadRomSymbols allocated.
+	\param *symbols The symbols.
+	\return void
+*/
+void freeRomSymbols(RomSymbols *symbols);
+
+/*! \brief Finds the symbol an address belongs to: the last symbol at or below it.
+	\param *symbols The symbols.
+	\param address A ROM address.
+	\return Index of the symbol, or -1 if the address is below the first symbol.
+*/
+s32 findRomSymbol(const RomSymbols *symbols, u32 address);
+
+/*! \brief Finds a symbol by name.
+	\param *symbols The symbols.
+	\param *name The name.
+	\return Index of the symbol, or -1 if there is none.
+*/
+s32 findRomSymbolByName(const RomSymbols *symbols, const char *name);
+
+#endif // !HOST_ROM_SYMBOLS_H_
@@ -0,0 +1,63 @@
+/*!
+\file Snapshot.h
+\brief Simulation snapshot header file
+\date 10/2026
+
+Saves and restores the full simulation state of a match: the World and its SimContext.
+Between frames the systems keep no other state (no globals, no statics), and both structures are plain data,
+so a snapshot is two copies of a few hundred bytes.
+
+Snapshots go into a ring of SNAPSHOT_SLOTS preallocated slots, one per frame.
+Saving frame n overwrites frame n - SNAPSHOT_SLOTS.
+*/
+
+#ifndef HOST_SNAPSHOT_H_
+#define HOST_SNAPSHOT_H_
+
+#include "Model.h"
+
+#define SNAPSHOT_SLOTS 16	/*!< Number of frames kept. Power of two. */
+#define SNAPSHOT_NONE 0xFFFFFFFF	/*!< Frame number of an empty slot. */
+
+/*! \brief Structure with the simulation state before a frame.
+	\param frame Number of frames simulated when it was saved, or SNAPSHOT_NONE.
+	\param world The game state.
+	\param context The simulation state belonging to the world.
+*/
+typedef struct {
+	u32 frame;
+	World world;
+	SimContext context;
+} Snapshot;
+
+/*! \brief Structure with a ring of snapshots, slot frame % SNAPSHOT_SLOTS for each frame. */
+typedef struct {
+	Snapshot slots[SNAPSHOT_SLOTS];
+} SnapshotRing;
+
+
+/*! \brief Empties every slot of a ring.
+	\param *ring The ring.
+	\return void
+*/
+void clearSnapshots(SnapshotRing *ring);
+
+/*! \brief Saves the simulation state of a frame.
+	\param *ring The ring.
+	\param frame Number of frames simulated so far.
+	\param *world The game state.
+	\param *context The simulation state belonging to the world.
+	\return void
+*/
+void saveSnapshot(SnapshotRing *ring, u32 frame, const World *world, const SimContext *context);
+
+/*! \brief Restores the simulation state of a frame.
+	\param *ring The ring.
+	\param frame Number of frames simulated when the state was saved.
+	\param *world Written with the game state.
+	\param *context Written with the simulation state belonging to the world.
+	\return 0 on success, -1 if that frame is no longer (or not yet) in the ring.
+*/
+int restoreSnapshot(const SnapshotRing *ring, u32 frame, World *world, SimContext *context);
+
+#endif // !HOST_SNAPSHOT_H_
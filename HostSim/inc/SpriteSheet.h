@@ -0,0 +1,97 @@
+/*!
+\file SpriteSheet.h
+\brief Sprite sheet conversion header file
+\date 10/2026
+
+Converts indexed images into the frames of an SGDK SpriteDefinition the way rescomp 1.5 does:
+- Every row of frames of the sheet is an animation. Its frames end at the last one that is not empty (every pixel 0).
+- A frame is cut into hardware sprites of up to 4x4 tiles, row by row. Every frame of a sheet has the same sprites.
+- The tiles of a frame are those of its sprites in turn, column by column in each sprite, as the VDP takes them.
+  Tiles are neither shared nor left out, even when they are empty or the same as others.
+convertSpriteSheet gives the same frames as rescomp (see HostSim/test/AssetBuildTest.c).
+*/
+
+#ifndef HOST_SPRITE_SHEET_H_
+#define HOST_SPRITE_SHEET_H_
+
+#include "types.h"
+#include "Png.h"
+#include "TileImage.h"
+
+#define SPRITE_MAX_TILES 4	/*!< Most tiles of a side of a hardware sprite. */
+#define SPRITE_DELTA_GAP 2	/*!< Unchanged tiles between two runs of changed tiles that are sent anyway, to start one DMA less. */
+
+/*! \brief Structure with a hardware sprite of a frame.
+
+\param x Left edge in the frame, in pixels.
+\param y Top edge in the frame, in pixels.
+\param width Width in tiles. Range: 1-4
+\param height Height in tiles. Range: 1-4
+*/
+typedef struct {
+	u16 x;
+	u16 y;
+	u8 width;
+	u8 height;
+} HardwareSprite;
+
+/*! \brief Structure with a frame: the tiles of its sprites. */
+typedef struct {
+	Tile *tiles;
+} SpriteFrame;
+
+/*! \brief Structure with an animation: a row of the sheet. */
+typedef struct {
+	SpriteFrame *frames;
+	u16 frameCount;
+} SpriteAnimation;
+
+/*! \brief Structure with a sprite sheet converted to frames.
+
+\param width Width of a frame in tiles.
+\param height Height of a frame in tiles.
+\param palette[] The palette, in VDP colours (0x0BGR).
+\param sprites The hardware sprites of every frame.
+\param spriteCount Number of sprites of a frame.
+\param tileCount Number of tiles of a frame: width * height.
+\param animations The animations.
+\param animationCount Number of animations.
+*/
+typedef struct {
+	u16 width;
+	u16 height;
+	u16 palette[TILE_PALETTE_COLORS];
+	HardwareSprite *sprites;
+	u16 spriteCount;
+	u16 tileCount;
+	SpriteAnimation *animations;
+	u16 animationCount;
+} SpriteSheet;
+
+
+/*! \brief Converts an indexed image to animations of frames, as rescomp does.
+	\param *sheet Written with the frames. Free with freeSpriteSheet.
+	\param *image The image. Its width and height must be multiples of the frame size.
+	\param width Width of a frame in tiles.
+	\param height Height of a frame in tiles.
+	\return 0 on success, -1 if the image is not made of whole frames or out of memory.
+*/
+int convertSpriteSheet(SpriteSheet *sheet, const IndexedImage *image, u16 width, u16 height);
+
+/*! \brief Frees what convertSpriteSheet allocated.
+	\param *sheet The sheet.
+	\return void
+*/
+void freeSpriteSheet(SpriteSheet *sheet);
+
+/*! \brief Finds the tiles of a frame that differ from another frame, as runs of consecutive tiles.
+	\param runs[][] Written with the first tile and number of tiles of every run. Room for tileCount / 2 + 1 runs.
+	\param *sheet The sheet of both frames.
+	\param *from The frame in VRAM.
+	\param *to The next frame.
+	\param gap Most unchanged tiles between two runs that join them into one (see SPRITE_DELTA_GAP).
+	\return The number of runs.
+*/
+u16 changedTileRuns(u16 runs[][2], const SpriteSheet *sheet, const SpriteFrame *from, const SpriteFrame *to, u16 gap);
+
+#endif // !HOST_SPRITE_SHEET_H_
@@ -0,0 +1,137 @@
+/*!
+\file TileImage.h
+\brief Background tile conversion header file
+\date 10/2026
+
+Converts indexed images into SGDK Image data (palette, tileset, tilemap) the way rescomp does: 8x8 tiles in rows,
+each tile that is the same as an earlier one, as is or flipped, drawn with that one and the flip bits in the tilemap.
+convertTileImage gives the same tiles, tilemap and palette as rescomp (see HostSim/test/AssetCookerTest.c).
+
+poolTileImages then shares tiles across images: the tiles of every image become a window of one array of tiles,
+and each image shares the tiles it has in common with the images next to it, as is or flipped.
+SGDK only needs the tiles of a tileset to be contiguous, so its TileSet points into that array.
+*/
+
+#ifndef HOST_TILE_IMAGE_H_
+#define HOST_TILE_IMAGE_H_
+
+#include "types.h"
+#include "Png.h"
+
+#define TILE_SIZE 8	/*!< Pixels of a side of a tile. */
+#define TILE_BYTES 32	/*!< Bytes of a tile, 4 bits per pixel. */
+#define TILE_PALETTE_COLORS 16	/*!< Colours of an image's palette. */
+#define TILE_FLIP_H 0x0800	/*!< Tilemap entry bit: horizontal flip. */
+#define TILE_FLIP_V 0x1000	/*!< Tilemap entry bit: vertical flip. */
+#define TILE_INDEX_MASK 0x07FF	/*!< Tilemap entry bits of the tile index. */
+
+/*! \brief Structure with a tile: 8 rows of 8 pixels, 4 bits each, leftmost pixel in the high bits. */
+typedef struct {
+	u32 row[TILE_SIZE];
+} Tile;
+
+/*! \brief Structure with an image converted to tiles.
+
+\param width Width in tiles.
+\param height Height in tiles.
+\param map Tilemap entry of every tile, row by row: tile index and flip bits.
+\param tiles The tileset.
+\param tileCount Number of tiles of the tileset.
+\param palette[] The palette, in VDP colours (0x0BGR).
+*/
+typedef struct {
+	u16 width;
+	u16 height;
+	u16 *map;
+	Tile *tiles;
+	u16 tileCount;
+	u16 palette[TILE_PALETTE_COLORS];
+} TileImage;
+
+/*! \brief Structure with the tiles of several images, and where each image's tileset starts in them.
+
+\param tiles The tiles.
+\param count Number of tiles.
+\param first First tile of the tileset of every image.
+*/
+typedef struct {
+	Tile *tiles;
+	u32 count;
+	u32 *first;
+} TilePool;
+
+
+/*! \brief Converts an indexed image to tiles, as rescomp does.
+
+	Pixels keep the low 4 bits of their index. The palette has the first 16 PLTE entries, black past the last one.
+	\param *tileImage Written with the tiles. Free with freeTileImage.
+	\param *image The image. Its width and height must be multiples of 8.
+	\return 0 on success, -1 if the size is not a multiple of 8 or the image has more than 2048 different tiles.
+*/
+int convertTileImage(TileImage *tileImage, const IndexedImage *image);
+
+/*! \brief Frees what convertTileImage allocated.
+	\param *tileImage The image.
+	\return void
+*/
+void freeTileImage(TileImage *tileImage);
+
+/*! \brief Converts a PNG palette entry to a VDP colour, as rescomp does: the top 3 bits of each component.
+	\param rgb[] The entry.
+	\return The colour (0x0BGR).
+*/
+u16 vdpColor(const u8 rgb[3]);
+
+/*! \brief Reads a tile of an indexed image. Pixels keep the low 4 bits of their index.
+	\param *tile Written with the tile.
+	\param *image The image.
+	\param tx Column of the tile, in tiles.
+	\param ty Row of the tile, in tiles.
+	\return void
+*/
+void readTile(Tile *tile, const IndexedImage *image, u32 tx, u32 ty);
+
+/*! \brief Flips a tile.
+	\param *flipped Written with the flipped tile.
+	\param *tile The tile.
+	\param flip TILE_FLIP_H, TILE_FLIP_V, both or none.
+	\return void
+*/
+void flipTile(Tile *flipped, const Tile *tile, u16 flip);
+
+/*! \brief Finds the first tile that is the same as a tile, as is or flipped, in rescomp's order.
+	\param *tiles The tiles to search.
+	\param count Number of tiles.
+	\param *tile The tile.
+	\param *flip Written with how to flip the tile found to get the tile.
+	\return Index of the tile found, or -1 if none.
+*/
+s32 findTile(const Tile *tiles, u32 count, const Tile *tile, u16 *flip);
+
+/*! \brief Writes tiles as the VDP takes them: 4 bytes per row, big-endian.
+	\param *bytes Written with count * TILE_BYTES bytes.
+	\param *tiles The tiles.
+	\param count Number of tiles.
+	\return void
+*/
+void writeTileBytes(u8 *bytes, const Tile *tiles, u32 count);
+
+/*! \brief Shares tiles across images.
+
+	Chains the images so that each one has many tiles in common with the one before, then lays out the tiles:
+	the tiles an image shares with the one before, its own tiles, the tiles it shares with the one after.
+	Reorders the tiles of every image so that they are its window of the pool, and updates its tilemap.
+	\param *pool Written with the tiles and where each image's tiles start. Free with freeTilePool.
+	\param images[] The images. Their tiles and tilemaps are rewritten.
+	\param count Number of images.
+	\return 0 on success, -1 if out of memory.
+*/
+int poolTileImages(TilePool *pool, TileImage images[], u32 count);
+
+/*! \brief Frees what poolTileImages allocated.
+	\param *pool The pool.
+	\return void
+*/
+void freeTilePool(TilePool *pool);
+
+#endif // !HOST_TILE_IMAGE_H_
@@ -0,0 +1,59 @@
+/*!
+\file Unpack68k.h
+\brief Console unpacker header file
+\date 10/2026
+
+Unpacks data with the unpackers of SGDK linked in the ROM (aplib_unpack and lz4w_unpack, found in rom.out), run by the
+68000 interpreter in a Mega Drive (see MegaDrive.h), as on the console: packed data in the cartridge, after the ROM,
+unpacked into work RAM. Gives what the console unpacks, and the 68000 cycles it takes.
+*/
+
+#ifndef HOST_UNPACK_68K_H_
+#define HOST_UNPACK_68K_H_
+
+#include "MegaDrive.h"
+#include "Pack.h"
+
+#define UNPACK_CAPACITY 0xF000	/*!< Most bytes unpacked: work RAM, but for the stack. */
+
+/*! \brief Structure with a ROM to unpack with.
+
+\param machine The Mega Drive that runs the unpackers.
+\param rom The ROM, with room after it for the packed data.
+\param romSize Size of the ROM without packed data.
+\param entry[] Address of the unpacker of each method, 0 if the ROM has none.
+*/
+typedef struct {
+	MegaDrive *machine;
+	u8 *rom;
+	u32 romSize;
+	u32 entry[PACK_METHODS];
+} Unpacker;
+
+
+/*! \brief Loads a ROM and finds its unpackers.
+	\param *unpacker Written with the ROM. Free with closeUnpacker.
+	\param *romPath Path of rom.bin.
+	\param *symbolsPath Path of rom.out.
+	\return 0 on success, -1 if a file cannot be read or the ROM has no unpacker.
+*/
+int openUnpacker(Unpacker *unpacker, const char *romPath, const char *symbolsPath);
+
+/*! \brief Frees what openUnpacker allocated.
+	\param *unpacker The unpacker.
+	\return void
+*/
+void closeUnpacker(Unpacker *unpacker);
+
+/*! \brief Unpacks data on the 68000.
+	\param *unpacker The unpacker.
+	\param method PackAplib or PackLz4w.
+	\param *packed The packed data.
+	\param size Bytes of the packed data.
+	\param *data Written with what the console unpacks: at most UNPACK_CAPACITY bytes.
+	\param *cycles Written with the 68000 cycles the unpacker took, from its first instruction to its return.
+	\return Bytes unpacked, or -1 if the ROM has no unpacker for the method or it did not return.
+*/
+s32 unpackOnConsole(Unpacker *unpacker, PackMethod method, const u8 *packed, u32 size, u8 *data, u32 *cycles);
+
+#endif // !HOST_UNPACK_68K_H_
@@ -0,0 +1,59 @@
+/*!
+\file Wav.h
+\brief WAV sound conversion header file
+\date 10/2026
+
+Reads PCM WAV files and converts them to the 8-bit signed mono samples of SGDK's sound drivers, at the driver's rate.
+Each sample is the mean of the source samples it spans, which keeps frequencies above the new rate from folding
+back into the sound. rescomp 1.5 gives as many samples, most of them the same or one step away.
+*/
+
+#ifndef HOST_WAV_H_
+#define HOST_WAV_H_
+
+#include "types.h"
+
+#define WAV_XGM_RATE 14000	/*!< Sample rate of sound effects with the XGM driver. */
+
+/*! \brief Structure with a sound.
+
+\param rate Samples per second.
+\param count Number of samples.
+\param samples Every sample, channels mixed, 16-bit signed.
+*/
+typedef struct {
+	u32 rate;
+	u32 count;
+	s16 *samples;
+} WavSound;
+
+
+/*! \brief Reads a PCM WAV file (8 or 16 bits, any number of channels).
+	\param *sound Written with the sound. Free with freeWav.
+	\param *path Path of the WAV file.
+	\return 0 on success, -1 if the file cannot be read or is not PCM.
+*/
+int loadWav(WavSound *sound, const char *path);
+
+/*! \brief Frees what loadWav allocated.
+	\param *sound The sound.
+	\return void
+*/
+void freeWav(WavSound *sound);
+
+/*! \brief Returns the number of samples a sound has at another rate.
+	\param *sound The sound.
+	\param rate The rate.
+	\return The number of samples.
+*/
+u32 resampledLength(const WavSound *sound, u32 rate);
+
+/*! \brief Converts a sound to 8-bit signed samples at another rate.
+	\param *pcm Written with resampledLength(sound, rate) samples.
+	\param *sound The sound.
+	\param rate The rate.
+	\return void
+*/
+void resampleWav(s8 *pcm, const WavSound *sound, u32 rate);
+
+#endif // !HOST_WAV_H_
@@ -0,0 +1,57 @@
+/*!
+\file WorkStealing.h
+\brief Work-stealing scheduler header file
+\date 10/2026
+
+Runs a numbered set of jobs (e.g. matches) on several threads.
+Every worker starts with an equal share of the job numbers and takes them in chunks.
+A worker that runs out steals the back half of another worker's remaining jobs.
+Taking and stealing are a single compare-and-swap on the worker's range, so no locks are used.
+*/
+
+#ifndef HOST_WORK_STEALING_H_
+#define HOST_WORK_STEALING_H_
+
+#include <stdint.h>
+
+#include "types.h"
+
+#define MAX_WORKERS 256	/*!< Maximum number of worker threads. */
+
+/*! \brief Function that runs the jobs numbered begin to end-1.
+	\param *argument The argument given to runWorkStealing.
+	\param worker Number of the worker thread running the jobs. Range: 0 to threadCount-1
+	\param begin First job number.
+	\param end One past the last job number.
+*/
+typedef void WorkFunction(void *argument, u32 worker, u32 begin, u32 end);
+
+/*! \brief Structure with what one worker thread did.
+	\param jobs Number of jobs the worker ran.
+	\param chunks Number of times the worker called the WorkFunction.
+	\param steals Number of times the worker stole jobs from another worker.
+	\param busyNanoseconds Time spent inside the WorkFunction.
+*/
+typedef struct {
+	uint64_t jobs;
+	uint64_t chunks;
+	uint64_t steals;
+	uint64_t busyNanoseconds;
+} WorkerStats;
+
+
+/*! \brief Runs jobs 0 to jobCount-1 on threadCount threads and waits for all of them.
+	\param jobCount Number of jobs.
+	\param threadCount Number of worker threads. Range: 1-MAX_WORKERS
+	\param chunk Number of jobs a worker takes at once.
+	\param *work Function that runs the jobs.
+	\param *argument Passed on to the WorkFunction.
+	\param *stats Array of threadCount structures, written with what each worker did. Can be NULL.
+	\return 0 on success, -1 if the threads could not be started.
+*/
+int runWorkStealing(u32 jobCount, u32 threadCount, u32 chunk, WorkFunction *work, void *argument, WorkerStats *stats);
+
+/*! \brief Returns the monotonic clock in nanoseconds. */
+uint64_t monotonicNanoseconds();
+
+#endif // !HOST_WORK_STEALING_H_
@@ -0,0 +1,114 @@
+/*!
+\file WorldBatch.h
+\brief Batched world header file
+\date 10/2026
+
+Structure-of-arrays layout holding many worlds at once, for bulk simulation on the host.
+For every component field and every entity slot, the values of all worlds are contiguous,
+so one SIMD instruction updates the same field of 8 (SSE2) or 16 (AVX2) worlds.
+
+combatSystemBatch runs combatSystem on every world of the batch and gives bit-identical results.
+Stagger countdown, idle transitions and frame counting are vectorized.
+Hits and finished death animations are rare and are resolved world by world.
+*/
+
+#ifndef HOST_WORLD_BATCH_H_
+#define HOST_WORLD_BATCH_H_
+
+#include "Model.h"
+
+#define BATCH_ALIGNMENT 16	/*!< The number of worlds is rounded up to a multiple of this (one AVX2 vector of u16). */
+
+/*! \brief Structure of N worlds in structure-of-arrays layout.
+
+	Component fields are arrays of ENTITY_COUNT rows of 'stride' values: field[entity * stride + world].
+	Context fields hold one value per world. All values but the random state are widened to u16.
+	Padding worlds (from 'worlds' to 'stride') are kept idle.
+*/
+typedef struct {
+	u32 worlds;	/**< Number of worlds in the batch */
+	u32 stride;	/**< Number of worlds rounded up to BATCH_ALIGNMENT */
+
+	u16 *mask;	/**< World.mask */
+	u16 *points;	/**< Health.points */
+	u16 *staggered;	/**< Health.staggered */
+	u16 *frames;	/**< Timing.frames */
+	u16 *facing;	/**< Timing.facing */
+	u16 *move;	/**< Move.move */
+	u16 *spriteData;	/**< CharacterSprite.spriteData */
+	u16 *isActive;	/**< TeamMember.isActive */
+	u16 *memberId;	/**< TeamMember.id */
+	u16 *facingGeneration;	/**< Timing.facingGeneration */
+	u16 *generation;	/**< World.generation */
+
+	u16 *currentPlayer;	/**< SimContext.currentPlayer */
+	u16 *eventSFX;	/**< SimContext.eventSFX */
+	u16 *difficultyAIaccumulator;	/**< SimContext.difficultyAIaccumulator */
+	u16 *finished;	/**< Scratch: 0xFFFF once combatSystem stopped looping over entities for this world */
+	u32 *randomAI;	/**< SimContext.randomAI.state */
+
+	void *memory;	/**< Single allocation holding all arrays */
+} WorldBatch;
+
+/*! \brief Enumeration with the implementations of combatSystemBatch. */
+typedef enum {
+	BatchKernelScalar,	/**< Portable, one world at a time */
+	BatchKernelSSE2,	/**< 8 worlds per instruction */
+	BatchKernelAVX2,	/**< 16 worlds per instruction */
+} BatchKernel;
+
+
+/*! \brief Allocates a batch. All worlds start with every entity slot unused and idle.
+	\param *batch The batch.
+	\param worlds Number of worlds.
+	\return 0 on success, -1 if out of memory.
+*/
+int createWorldBatch(WorldBatch *batch, u32 worlds);
+
+/*! \brief Frees the memory of a batch.
+	\param *batch The batch.
+	\return void
+*/
+void destroyWorldBatch(WorldBatch *batch);
+
+/*! \brief Copies every world of a batch into another batch of the same size.
+	\param *destination The batch to overwrite.
+	\param *source The batch to copy.
+	\return void
+*/
+void copyWorldBatch(WorldBatch *destination, const WorldBatch *source);
+
+/*! \brief Copies a world and its context into a batch.
+	\param *batch The batch.
+	\param index Which world of the batch to overwrite.
+	\param *world The game state as a World structure.
+	\param *context The simulation state belonging to the world.
+	\return void
+*/
+void storeWorldInBatch(WorldBatch *batch, u32 index, const World *world, const SimContext *context);
+
+/*! \brief Copies a world and its context out of a batch.
+	\param *batch The batch.
+	\param index Which world of the batch to read.
+	\param *world Written with the game state.
+	\param *context Written with the simulation state.
+	\return void
+*/
+void loadWorldFromBatch(const WorldBatch *batch, u32 index, World *world, SimContext *context);
+
+/*! \brief Returns the fastest implementation the CPU supports. */
+BatchKernel bestBatchKernel();
+
+/*! \brief Returns the name of an implementation, e.g. "avx2". */
+const char *batchKernelName(BatchKernel kernel);
+
+/*! \brief Runs combatSystem once on every world of the batch.
+
+	Gives the same result as calling combatSystem on each world, bit for bit.
+	\param *batch The batch.
+	\param kernel Implementation to use. Must be supported by the CPU.
+	\return void
+*/
+void combatSystemBatch(WorldBatch *batch, BatchKernel kernel);
+
+#endif // !HOST_WORLD_BATCH_H_
@@ -0,0 +1,1191 @@
+/*!
+\file Cpu68k.c
+\brief 68000 interpreter file
+\date 10/2026
+
+Decodes and runs 68000 instructions (see Cpu68k.h). Timings are from the 68000 user's manual,
+section 8, with the MULU/MULS/DIVU/DIVS formulas measured by Jorge Cwik.
+*/
+
+#include <stdint.h>
+
+#include "../inc/Cpu68k.h"
+
+#define FLAGS_NZVC (CPU_FLAG_N | CPU_FLAG_Z | CPU_FLAG_V | CPU_FLAG_C)
+
+#define VECTOR_ILLEGAL 4
+#define VECTOR_ZERO_DIVIDE 5
+#define VECTOR_CHK 6
+#define VECTOR_TRAPV 7
+#define VECTOR_PRIVILEGE 8
+#define VECTOR_LINE_A 10
+#define VECTOR_LINE_F 11
+#define VECTOR_TRAP 32
+
+/*! \brief Enumeration with the kinds of operand an effective address can give. */
+typedef enum {
+	OperandData,	/**< Dn */
+	OperandAddress,	/**< An */
+	OperandMemory,	/**< Any memory mode */
+	OperandImmediate	/**< #<data> */
+} OperandKind;
+
+/*! \brief Structure with a decoded effective address. */
+typedef struct {
+	OperandKind kind;
+	u8 reg;	/**< Register number, for OperandData and OperandAddress */
+	u32 address;	/**< For OperandMemory */
+	u32 value;	/**< For OperandImmediate */
+} Operand;
+
+/*! Effective address calculation times (byte/word, long), indexed by eaIndex: Dn, An, (An), (An)+, -(An),
+	d16(An), d8(An,Xn), abs.W, abs.L, d16(PC), d8(PC,Xn), #imm. */
+static const u8 eaTime[12][2] = {
+	{ 0, 0 }, { 0, 0 }, { 4, 8 }, { 4, 8 }, { 6, 10 }, { 8, 12 }, { 10, 14 }, { 8, 12 }, { 12, 16 }, { 8, 12 }, { 10, 14 }, { 4, 8 }
+};
+/*! Destination times of MOVE: like eaTime, except -(An) costs the same as (An). */
+static const u8 moveDestinationTime[12][2] = {
+	{ 0, 0 }, { 0, 0 }, { 4, 8 }, { 4, 8 }, { 4, 8 }, { 8, 12 }, { 10, 14 }, { 8, 12 }, { 12, 16 }, { 8, 12 }, { 10, 14 }, { 4, 8 }
+};
+/*! LEA and JMP times by eaIndex (control modes only). PEA is LEA + 8, JSR is JMP + 8. */
+static const u8 leaTime[12] = { 0, 0, 4, 0, 0, 8, 12, 8, 12, 8, 12, 0 };
+static const u8 jmpTime[12] = { 0, 0, 8, 0, 0, 10, 14, 10, 12, 10, 14, 0 };
+/*! MOVEM base times by eaIndex, memory to registers and registers to memory. Add 4 (word) or 8 (long) per register. */
+static const u8 movemReadTime[12] = { 0, 0, 12, 12, 0, 16, 18, 16, 20, 16, 18, 0 };
+static const u8 movemWriteTime[12] = { 0, 0, 8, 0, 8, 12, 14, 12, 16, 0, 0, 0 };
+
+
+static u8 eaIndex(u8 mode, u8 reg) {
+	return (mode < 7) ? mode : 7 + reg;
+}
+
+static u32 sizeMask(u8 size) {
+	return (size == 1) ? 0xFF : (size == 2) ? 0xFFFF : 0xFFFFFFFF;
+}
+
+static u32 sizeMsb(u8 size) {
+	return (size == 1) ? 0x80 : (size == 2) ? 0x8000 : 0x80000000;
+}
+
+static u32 signExtend(u32 value, u8 size) {
+	return (size == 1) ? (u32)(s32)(s8)value : (size == 2) ? (u32)(s32)(s16)value : value;
+}
+
+
+static u8 read8(Cpu68k *cpu, u32 address) {
+	return cpu->bus.read8(cpu->bus.context, address & 0xFFFFFF);
+}
+
+static u16 read16(Cpu68k *cpu, u32 address) {
+	return cpu->bus.read16(cpu->bus.context, address & 0xFFFFFE);
+}
+
+static u32 read32(Cpu68k *cpu, u32 address) {
+	u32 high = read16(cpu, address);
+	return (high << 16) | read16(cpu, address + 2);
+}
+
+static void write8(Cpu68k *cpu, u32 address, u8 value) {
+	cpu->bus.write8(cpu->bus.context, address & 0xFFFFFF, value);
+}
+
+static void write16(Cpu68k *cpu, u32 address, u16 value) {
+	cpu->bus.write16(cpu->bus.context, address & 0xFFFFFE, value);
+}
+
+static void write32(Cpu68k *cpu, u32 address, u32 value) {
+	write16(cpu, address, (u16)(value >> 16));
+	write16(cpu, address + 2, (u16)value);
+}
+
+static u32 readSized(Cpu68k *cpu, u32 address, u8 size) {
+	return (size == 1) ? read8(cpu, address) : (size == 2) ? read16(cpu, address) : read32(cpu, address);
+}
+
+static void writeSized(Cpu68k *cpu, u32 address, u32 value, u8 size) {
+	if (size == 1)
+		write8(cpu, address, (u8)value);
+	else if (size == 2)
+		write16(cpu, address, (u16)value);
+	else
+		write32(cpu, address, value);
+}
+
+static u16 fetch16(Cpu68k *cpu) {
+	u16 value = read16(cpu, cpu->pc);
+	cpu->pc += 2;
+	return value;
+}
+
+static u32 fetch32(Cpu68k *cpu) {
+	u32 high = fetch16(cpu);
+	return (high << 16) | fetch16(cpu);
+}
+
+static void push16(Cpu68k *cpu, u16 value) {
+	cpu->a[7] -= 2;
+	write16(cpu, cpu->a[7], value);
+}
+
+static void push32(Cpu68k *cpu, u32 value) {
+	cpu->a[7] -= 4;
+	write32(cpu, cpu->a[7], value);
+}
+
+static u32 pop32(Cpu68k *cpu) {
+	u32 value = read32(cpu, cpu->a[7]);
+	cpu->a[7] += 4;
+	return value;
+}
+
+
+/*! Writes the status register, and swaps the stack pointers when the supervisor bit changes. */
+static void setStatus(Cpu68k *cpu, u16 value) {
+	value &= 0xA71F;
+	if ((value ^ cpu->sr) & CPU_FLAG_S) {
+		u32 stack = cpu->a[7];
+		cpu->a[7] = cpu->otherStack;
+		cpu->otherStack = stack;
+	}
+	cpu->sr = value;
+}
+
+static void setFlag(Cpu68k *cpu, u16 flag, u32 condition) {
+	if (condition)
+		cpu->sr |= flag;
+	else
+		cpu->sr &= ~flag;
+}
+
+/*! Sets N and Z from a result, and clears V and C, as logic operations and moves do. */
+static void setLogicFlags(Cpu68k *cpu, u32 result, u8 size) {
+	cpu->sr &= ~FLAGS_NZVC;
+	if ((result & sizeMask(size)) == 0)
+		cpu->sr |= CPU_FLAG_Z;
+	if (result & sizeMsb(size))
+		cpu->sr |= CPU_FLAG_N;
+}
+
+/*! Returns destination + source (+ X), and sets the flags. withExtend is for ADDX: Z is only ever cleared. */
+static u32 addValues(Cpu68k *cpu, u32 source, u32 destination, u8 size, u8 withExtend) {
+	u32 mask = sizeMask(size), msb = sizeMsb(size);
+	u32 extend = (withExtend && (cpu->sr & CPU_FLAG_X)) ? 1 : 0;
+	source &= mask;
+	destination &= mask;
+	u32 result = (destination + source + extend) & mask;
+	u32 carry = ((source & destination) | (~result & (source | destination))) & msb;
+	u32 overflow = ~(source ^ destination) & (source ^ result) & msb;
+	u8 zero = withExtend ? (result == 0 && (cpu->sr & CPU_FLAG_Z)) : (result == 0);
+
+	cpu->sr &= ~(FLAGS_NZVC | CPU_FLAG_X);
+	cpu->sr |= (carry ? CPU_FLAG_C | CPU_FLAG_X : 0) | (overflow ? CPU_FLAG_V : 0)
+		| ((result & msb) ? CPU_FLAG_N : 0) | (zero ? CPU_FLAG_Z : 0);
+	return result;
+}
+
+/*! Returns destination - source (- X), and sets the flags. compare leaves X alone, as CMP does. */
+static u32 subtractValues(Cpu68k *cpu, u32 source, u32 destination, u8 size, u8 withExtend, u8 compare) {
+	u32 mask = sizeMask(size), msb = sizeMsb(size);
+	u32 extend = (withExtend && (cpu->sr & CPU_FLAG_X)) ? 1 : 0;
+	source &= mask;
+	destination &= mask;
+	u32 result = (destination - source - extend) & mask;
+	u32 carry = ((source & ~destination) | (result & ~destination) | (source & result)) & msb;
+	u32 overflow = (source ^ destination) & (result ^ destination) & msb;
+	u8 zero = withExtend ? (result == 0 && (cpu->sr & CPU_FLAG_Z)) : (result == 0);
+
+	cpu->sr &= compare ? ~FLAGS_NZVC : ~(FLAGS_NZVC | CPU_FLAG_X);
+	cpu->sr |= (carry ? (compare ? CPU_FLAG_C : CPU_FLAG_C | CPU_FLAG_X) : 0) | (overflow ? CPU_FLAG_V : 0)
+		| ((result & msb) ? CPU_FLAG_N : 0) | (zero ? CPU_FLAG_Z : 0);
+	return result;
+}
+
+static u8 testCondition(Cpu68k *cpu, u8 condition) {
+	u8 c = (cpu->sr & CPU_FLAG_C) != 0, v = (cpu->sr & CPU_FLAG_V) != 0;
+	u8 z = (cpu->sr & CPU_FLAG_Z) != 0, n = (cpu->sr & CPU_FLAG_N) != 0;
+
+	switch (condition)
+	{
+	case 0: return 1;
+	case 1: return 0;
+	case 2: return !c && !z;
+	case 3: return c || z;
+	case 4: return !c;
+	case 5: return c;
+	case 6: return !z;
+	case 7: return z;
+	case 8: return !v;
+	case 9: return v;
+	case 10: return !n;
+	case 11: return n;
+	case 12: return n == v;
+	case 13: return n != v;
+	case 14: return !z && n == v;
+	default: return z || n != v;
+	}
+}
+
+
+/*! Enters an exception handler: pushes the return address and status register in supervisor mode. */
+static void raiseException(Cpu68k *cpu, u8 vector, u32 returnAddress) {
+	u16 status = cpu->sr;
+
+	setStatus(cpu, (status | CPU_FLAG_S) & 0x7FFF);
+	push32(cpu, returnAddress);
+	push16(cpu, status);
+	cpu->pc = read32(cpu, (u32)vector * 4);
+	if (cpu->onCall)
+		cpu->onCall(cpu->hookContext, cpu->pc, cpu->a[7], vector);
+}
+
+/*! Takes a trap-like exception for the current instruction. \return The cycles of exception processing. */
+static u32 trap(Cpu68k *cpu, u8 vector, u32 returnAddress, u32 cycles) {
+	raiseException(cpu, vector, returnAddress);
+	return cycles;
+}
+
+static void enterSubroutine(Cpu68k *cpu, u32 target) {
+	push32(cpu, cpu->pc);
+	cpu->pc = target;
+	if (cpu->onCall)
+		cpu->onCall(cpu->hookContext, target, cpu->a[7], 0);
+}
+
+
+static u32 indexedAddress(Cpu68k *cpu, u32 base) {
+	u16 extension = fetch16(cpu);
+	u8 reg = (extension >> 12) & 7;
+	u32 index = (extension & 0x8000) ? cpu->a[reg] : cpu->d[reg];
+
+	if (!(extension & 0x0800))
+		index = (u32)(s32)(s16)index;
+	return base + (u32)(s32)(s8)extension + index;
+}
+
+/*! Decodes an effective address, fetching its extension words and applying (An)+ and -(An). */
+static Operand decodeOperand(Cpu68k *cpu, u8 mode, u8 reg, u8 size) {
+	Operand operand = { OperandMemory, reg, 0, 0 };
+	u8 step = (size == 1 && reg == 7) ? 2 : size; // The stack pointer stays word-aligned.
+	u32 base;
+
+	switch (mode)
+	{
+	case 0:
+		operand.kind = OperandData;
+		break;
+	case 1:
+		operand.kind = OperandAddress;
+		break;
+	case 2:
+		operand.address = cpu->a[reg];
+		break;
+	case 3:
+		operand.address = cpu->a[reg];
+		cpu->a[reg] += step;
+		break;
+	case 4:
+		cpu->a[reg] -= step;
+		operand.address = cpu->a[reg];
+		break;
+	case 5:
+		base = cpu->a[reg];
+		operand.address = base + (u32)(s32)(s16)fetch16(cpu);
+		break;
+	case 6:
+		operand.address = indexedAddress(cpu, cpu->a[reg]);
+		break;
+	default:
+		switch (reg)
+		{
+		case 0:
+			operand.address = (u32)(s32)(s16)fetch16(cpu);
+			break;
+		case 1:
+			operand.address = fetch32(cpu);
+			break;
+		case 2:
+			base = cpu->pc;
+			operand.address = base + (u32)(s32)(s16)fetch16(cpu);
+			break;
+		case 3:
+			operand.address = indexedAddress(cpu, cpu->pc);
+			break;
+		default:
+			operand.kind = OperandImmediate;
+			operand.value = (size == 4) ? fetch32(cpu) : (fetch16(cpu) & sizeMask(size));
+			break;
+		}
+		break;
+	}
+	return operand;
+}
+
+static u32 readOperand(Cpu68k *cpu, const Operand *operand, u8 size) {
+	switch (operand->kind)
+	{
+	case OperandData:
+		return cpu->d[operand->reg] & sizeMask(size);
+	case OperandAddress:
+		return cpu->a[operand->reg] & sizeMask(size);
+	case OperandMemory:
+		return readSized(cpu, operand->address, size);
+	default:
+		return operand->value;
+	}
+}
+
+static void writeOperand(Cpu68k *cpu, const Operand *operand, u32 value, u8 size) {
+	u32 mask = sizeMask(size);
+
+	switch (operand->kind)
+	{
+	case OperandData:
+		cpu->d[operand->reg] = (cpu->d[operand->reg] & ~mask) | (value & mask);
+		break;
+	case OperandAddress:
+		cpu->a[operand->reg] = value;
+		break;
+	case OperandMemory:
+		writeSized(cpu, operand->address, value, size);
+		break;
+	default:
+		break;
+	}
+}
+
+
+/*! MULU: 38 + 2 per bit set in the source. */
+static u32 muluTime(u16 source) {
+	return 38 + 2 * (u32)__builtin_popcount(source);
+}
+
+/*! MULS: 38 + 2 per 01 or 10 pair in the source with a 0 appended. */
+static u32 mulsTime(u16 source) {
+	return 38 + 2 * (u32)__builtin_popcount((u16)(source ^ (source << 1)));
+}
+
+static u32 divuTime(u32 dividend, u16 divisor) {
+	u32 cycles = 38;
+	u32 shiftedDivisor = (u32)divisor << 16;
+
+	if ((dividend >> 16) >= divisor)
+		return 10;
+	for (u8 i = 0; i < 15; ++i) {
+		u32 previous = dividend;
+		dividend <<= 1;
+		if (previous & 0x80000000)
+			dividend -= shiftedDivisor;
+		else {
+			cycles += 2;
+			if (dividend >= shiftedDivisor) {
+				dividend -= shiftedDivisor;
+				--cycles;
+			}
+		}
+	}
+	return cycles * 2;
+}
+
+static u32 divsTime(s32 dividend, s16 divisor) {
+	u32 cycles = (dividend < 0) ? 7 : 6;
+	u32 absoluteDividend = (dividend < 0) ? (u32)-(int64_t)dividend : (u32)dividend;
+	u32 absoluteDivisor = (divisor < 0) ? (u32)-divisor : (u32)divisor;
+
+	if ((absoluteDividend >> 16) >= absoluteDivisor)
+		return (cycles + 2) * 2;
+	u32 quotient = absoluteDividend / absoluteDivisor;
+	cycles += 55;
+	if (divisor >= 0)
+		cycles += (dividend >= 0) ? -1 : 1;
+	for (u8 i = 0; i < 15; ++i) {
+		if (!(quotient & 0x8000))
+			++cycles;
+		quotient <<= 1;
+	}
+	return cycles * 2;
+}
+
+
+/*! Shifts or rotates one value. type: 0 AS, 1 LS, 2 ROX, 3 RO. Sets the flags. */
+static u32 shiftValue(Cpu68k *cpu, u8 type, u8 left, u32 value, u8 count, u8 size) {
+	u32 mask = sizeMask(size), msb = sizeMsb(size);
+	u8 extend = (cpu->sr & CPU_FLAG_X) != 0, carry = 0, overflow = 0;
+
+	value &= mask;
+	for (u8 i = 0; i < count; ++i) {
+		u8 out;
+		if (left) {
+			out = (value & msb) != 0;
+			u32 in = (type == 2) ? extend : (type == 3) ? out : 0;
+			value = ((value << 1) | in) & mask;
+			if (type == 0 && ((value & msb) != 0) != out)
+				overflow = 1;
+		}
+		else {
+			out = value & 1;
+			u32 in = (type == 0) ? (value & msb) : (type == 2) ? (extend ? msb : 0) : (type == 3) ? (out ? msb : 0) : 0;
+			value = (value >> 1) | in;
+		}
+		carry = out;
+		if (type != 3)
+			extend = out;
+	}
+	if (count == 0)
+		carry = (type == 2) ? extend : 0;
+
+	setLogicFlags(cpu, value, size);
+	setFlag(cpu, CPU_FLAG_C, carry);
+	setFlag(cpu, CPU_FLAG_V, overflow);
+	if (count > 0 && type != 3)
+		setFlag(cpu, CPU_FLAG_X, extend);
+	return value;
+}
+
+
+static u8 addBcd(Cpu68k *cpu, u8 source, u8 destination) {
+	u32 result = (source & 0x0F) + (destination & 0x0F) + ((cpu->sr & CPU_FLAG_X) ? 1 : 0);
+	if (result > 9)
+		result += 6;
+	result += (source & 0xF0) + (destination & 0xF0);
+	u8 carry = result > 0x99;
+	if (carry)
+		result -= 0xA0;
+	setFlag(cpu, CPU_FLAG_C | CPU_FLAG_X, carry);
+	if (result & 0xFF)
+		cpu->sr &= ~CPU_FLAG_Z;
+	setFlag(cpu, CPU_FLAG_N, result & 0x80);
+	return (u8)result;
+}
+
+static u8 subtractBcd(Cpu68k *cpu, u8 source, u8 destination) {
+	u32 result = (destination & 0x0F) - (source & 0x0F) - ((cpu->sr & CPU_FLAG_X) ? 1 : 0);
+	if (result > 9)
+		result -= 6;
+	result += (destination & 0xF0) - (source & 0xF0);
+	u8 carry = result > 0x99;
+	if (carry)
+		result += 0xA0;
+	setFlag(cpu, CPU_FLAG_C | CPU_FLAG_X, carry);
+	if (result & 0xFF)
+		cpu->sr &= ~CPU_FLAG_Z;
+	setFlag(cpu, CPU_FLAG_N, result & 0x80);
+	return (u8)result;
+}
+
+
+/*! BTST, BCHG, BCLR and BSET, with the bit number in a register (dynamic) or an extension word (static). */
+static u32 bitOperation(Cpu68k *cpu, u16 opcode, u32 bit, u8 isStatic) {
+	u8 type = (opcode >> 6) & 3, mode = (opcode >> 3) & 7, reg = opcode & 7;
+
+	if (mode == 0) {
+		u32 flag = 1U << (bit & 31);
+		setFlag(cpu, CPU_FLAG_Z, !(cpu->d[reg] & flag));
+		if (type == 1)
+			cpu->d[reg] ^= flag;
+		else if (type == 2)
+			cpu->d[reg] &= ~flag;
+		else if (type == 3)
+			cpu->d[reg] |= flag;
+		static const u8 registerTime[2][4] = { { 6, 8, 10, 8 }, { 10, 12, 14, 12 } };
+		return registerTime[isStatic][type];
+	}
+
+	Operand operand = decodeOperand(cpu, mode, reg, 1);
+	u8 flag = (u8)(1U << (bit & 7));
+	u8 value = (u8)readOperand(cpu, &operand, 1);
+	setFlag(cpu, CPU_FLAG_Z, !(value & flag));
+	if (type != 0)
+		writeOperand(cpu, &operand, (type == 1) ? (value ^ flag) : (type == 2) ? (value & ~flag) : (value | flag), 1);
+	return (type == 0 ? 4 : 8) + (isStatic ? 4 : 0) + eaTime[eaIndex(mode, reg)][0];
+}
+
+static u32 movep(Cpu68k *cpu, u16 opcode) {
+	u8 dataReg = (opcode >> 9) & 7, opmode = (opcode >> 6) & 7;
+	u32 address = cpu->a[opcode & 7] + (u32)(s32)(s16)fetch16(cpu);
+	u8 bytes = (opmode & 1) ? 4 : 2;
+
+	if (opmode < 6) {
+		u32 value = 0;
+		for (u8 i = 0; i < bytes; ++i)
+			value = (value << 8) | read8(cpu, address + 2 * i);
+		writeOperand(cpu, &(Operand){ OperandData, dataReg, 0, 0 }, value, bytes);
+	}
+	else {
+		for (u8 i = 0; i < bytes; ++i)
+			write8(cpu, address + 2 * i, (u8)(cpu->d[dataReg] >> (8 * (bytes - 1 - i))));
+	}
+	return (bytes == 4) ? 24 : 16;
+}
+
+/*! ORI, ANDI, SUBI, ADDI, EORI, CMPI, and their CCR/SR forms. */
+static u32 immediateOperation(Cpu68k *cpu, u16 opcode) {
+	u8 kind = (opcode >> 9) & 7, mode = (opcode >> 3) & 7, reg = opcode & 7;
+	u8 sizeCode = (opcode >> 6) & 3;
+
+	if ((opcode & 0x3F) == 0x3C && sizeCode < 2 && (kind == 0 || kind == 1 || kind == 5)) {
+		u16 value = fetch16(cpu);
+		u16 status = cpu->sr;
+		if (sizeCode == 0)
+			value &= 0x1F;
+		else if (!(cpu->sr & CPU_FLAG_S))
+			return trap(cpu, VECTOR_PRIVILEGE, cpu->instructionPC, 34);
+		if (kind == 0)
+			status |= value;
+		else if (kind == 1)
+			status &= (sizeCode == 0) ? (value | 0xFF00) : value;
+		else
+			status ^= value;
+		setStatus(cpu, status);
+		return 20;
+	}
+	if (sizeCode == 3 || kind == 7)
+		return trap(cpu, VECTOR_ILLEGAL, cpu->instructionPC, 34);
+
+	u8 size = 1 << sizeCode;
+	u32 immediate = (size == 4) ? fetch32(cpu) : (fetch16(cpu) & sizeMask(size));
+	Operand operand = decodeOperand(cpu, mode, reg, size);
+	u32 value = readOperand(cpu, &operand, size), result;
+
+	switch (kind)
+	{
+	case 0:
+		result = value | immediate;
+		setLogicFlags(cpu, result, size);
+		break;
+	case 1:
+		result = value & immediate;
+		setLogicFlags(cpu, result, size);
+		break;
+	case 2:
+		result = subtractValues(cpu, immediate, value, size, 0, 0);
+		break;
+	case 3:
+		result = addValues(cpu, immediate, value, size, 0);
+		break;
+	case 5:
+		result = value ^ immediate;
+		setLogicFlags(cpu, result, size);
+		break;
+	default:
+		subtractValues(cpu, immediate, value, size, 0, 1);
+		if (mode == 0)
+			return (size == 4) ? 14 : 8;
+		return ((size == 4) ? 12 : 8) + eaTime[eaIndex(mode, reg)][size == 4];
+	}
+	writeOperand(cpu, &operand, result, size);
+	if (mode == 0)
+		return (size == 4) ? ((kind == 1) ? 14 : 16) : 8;
+	return ((size == 4) ? 20 : 12) + eaTime[eaIndex(mode, reg)][size == 4];
+}
+
+static u32 executeGroup0(Cpu68k *cpu, u16 opcode) {
+	if (opcode & 0x0100) {
+		if (((opcode >> 3) & 7) == 1)
+			return movep(cpu, opcode);
+		return bitOperation(cpu, opcode, cpu->d[(opcode >> 9) & 7], 0);
+	}
+	if (((opcode >> 9) & 7) == 4)
+		return bitOperation(cpu, opcode, fetch16(cpu) & 0xFF, 1);
+	return immediateOperation(cpu, opcode);
+}
+
+
+static u32 executeMove(Cpu68k *cpu, u16 opcode) {
+	u8 size = ((opcode >> 12) == 1) ? 1 : ((opcode >> 12) == 3) ? 2 : 4;
+	u8 sourceMode = (opcode >> 3) & 7, sourceReg = opcode & 7;
+	u8 destinationMode = (opcode >> 6) & 7, destinationReg = (opcode >> 9) & 7;
+	Operand source = decodeOperand(cpu, sourceMode, sourceReg, size);
+	u32 value = readOperand(cpu, &source, size);
+	u32 cycles = 4 + eaTime[eaIndex(sourceMode, sourceReg)][size == 4];
+
+	if (destinationMode == 1) {
+		cpu->a[destinationReg] = signExtend(value, size);
+		return cycles;
+	}
+	Operand destination = decodeOperand(cpu, destinationMode, destinationReg, size);
+	writeOperand(cpu, &destination, value, size);
+	setLogicFlags(cpu, value, size);
+	return cycles + moveDestinationTime[eaIndex(destinationMode, destinationReg)][size == 4];
+}
+
+
+static u32 movem(Cpu68k *cpu, u16 opcode) {
+	u8 size = (opcode & 0x40) ? 4 : 2, mode = (opcode >> 3) & 7, reg = opcode & 7;
+	u16 registers = fetch16(cpu);
+	u32 count = (u32)__builtin_popcount(registers);
+	u32 address;
+
+	if (opcode & 0x0400) { // Memory to registers
+		address = (mode == 3) ? cpu->a[reg] : decodeOperand(cpu, mode, reg, size).address;
+		for (u8 i = 0; i < 16; ++i) {
+			if (registers & (1 << i)) {
+				u32 value = signExtend(readSized(cpu, address, size), size);
+				if (i < 8)
+					cpu->d[i] = value;
+				else
+					cpu->a[i - 8] = value;
+				address += size;
+			}
+		}
+		if (mode == 3)
+			cpu->a[reg] = address;
+		return movemReadTime[eaIndex(mode, reg)] + count * ((size == 4) ? 8 : 4);
+	}
+
+	if (mode == 4) { // Registers to -(An), the mask is reversed: bit 0 is A7.
+		address = cpu->a[reg];
+		for (u8 i = 0; i < 16; ++i) {
+			if (registers & (1 << i)) {
+				u8 index = 15 - i;
+				address -= size;
+				writeSized(cpu, address, (index < 8) ? cpu->d[index] : cpu->a[index - 8], size);
+			}
+		}
+		cpu->a[reg] = address;
+	}
+	else {
+		address = decodeOperand(cpu, mode, reg, size).address;
+		for (u8 i = 0; i < 16; ++i) {
+			if (registers & (1 << i)) {
+				writeSized(cpu, address, (i < 8) ? cpu->d[i] : cpu->a[i - 8], size);
+				address += size;
+			}
+		}
+	}
+	return movemWriteTime[eaIndex(mode, reg)] + count * ((size == 4) ? 8 : 4);
+}
+
+/*! NEGX, CLR, NEG, NOT, TST: one operand, size in bits 6-7. */
+static u32 singleOperand(Cpu68k *cpu, u16 opcode) {
+	u8 kind = (opcode >> 9) & 7, mode = (opcode >> 3) & 7, reg = opcode & 7;
+	u8 size = 1 << ((opcode >> 6) & 3);
+	Operand operand = decodeOperand(cpu, mode, reg, size);
+	u32 ea = eaTime[eaIndex(mode, reg)][size == 4];
+	u32 value = readOperand(cpu, &operand, size), result;
+
+	switch (kind)
+	{
+	case 0:
+		result = subtractValues(cpu, value, 0, size, 1, 0);
+		break;
+	case 1:
+		result = 0;
+		setLogicFlags(cpu, 0, size);
+		break;
+	case 2:
+		result = subtractValues(cpu, value, 0, size, 0, 0);
+		break;
+	case 3:
+		result = ~value;
+		setLogicFlags(cpu, result, size);
+		break;
+	default:
+		setLogicFlags(cpu, value, size);
+		return 4 + ea;
+	}
+	writeOperand(cpu, &operand, result, size);
+	if (mode == 0)
+		return (size == 4) ? 6 : 4;
+	return ((size == 4) ? 12 : 8) + ea;
+}
+
+static u32 executeGroup4(Cpu68k *cpu, u16 opcode) {
+	u8 mode = (opcode >> 3) & 7, reg = opcode & 7;
+	u8 index = eaIndex(mode, reg);
+	Operand operand;
+	u32 value;
+
+	if ((opcode & 0xF1C0) == 0x41C0) { // LEA
+		cpu->a[(opcode >> 9) & 7] = decodeOperand(cpu, mode, reg, 4).address;
+		return leaTime[index];
+	}
+	if ((opcode & 0xF1C0) == 0x4180) { // CHK.W
+		operand = decodeOperand(cpu, mode, reg, 2);
+		s16 bound = (s16)readOperand(cpu, &operand, 2);
+		s16 data = (s16)cpu->d[(opcode >> 9) & 7];
+		if (data < 0 || data > bound) {
+			setFlag(cpu, CPU_FLAG_N, data < 0);
+			return trap(cpu, VECTOR_CHK, cpu->pc, 40 + eaTime[index][0]);
+		}
+		return 10 + eaTime[index][0];
+	}
+
+	switch (opcode)
+	{
+	case 0x4AFC: // ILLEGAL
+		return trap(cpu, VECTOR_ILLEGAL, cpu->instructionPC, 34);
+	case 0x4E70: // RESET
+		if (!(cpu->sr & CPU_FLAG_S))
+			return trap(cpu, VECTOR_PRIVILEGE, cpu->instructionPC, 34);
+		return 132;
+	case 0x4E71: // NOP
+		return 4;
+	case 0x4E72: // STOP
+		value = fetch16(cpu);
+		if (!(cpu->sr & CPU_FLAG_S))
+			return trap(cpu, VECTOR_PRIVILEGE, cpu->instructionPC, 34);
+		setStatus(cpu, (u16)value);
+		cpu->stopped = 1;
+		return 4;
+	case 0x4E73: // RTE
+		if (!(cpu->sr & CPU_FLAG_S))
+			return trap(cpu, VECTOR_PRIVILEGE, cpu->instructionPC, 34);
+		value = read16(cpu, cpu->a[7]);
+		cpu->pc = read32(cpu, cpu->a[7] + 2);
+		cpu->a[7] += 6;
+		setStatus(cpu, (u16)value);
+		return 20;
+	case 0x4E75: // RTS
+		cpu->pc = pop32(cpu);
+		return 16;
+	case 0x4E76: // TRAPV
+		if (cpu->sr & CPU_FLAG_V)
+			return trap(cpu, VECTOR_TRAPV, cpu->pc, 34);
+		return 4;
+	case 0x4E77: // RTR
+		value = read16(cpu, cpu->a[7]);
+		cpu->a[7] += 2;
+		cpu->sr = (cpu->sr & 0xFF00) | (value & 0x1F);
+		cpu->pc = pop32(cpu);
+		return 20;
+	default:
+		break;
+	}
+
+	switch (opcode & 0xFFF8)
+	{
+	case 0x4840: // SWAP
+		cpu->d[reg] = (cpu->d[reg] << 16) | (cpu->d[reg] >> 16);
+		setLogicFlags(cpu, cpu->d[reg], 4);
+		return 4;
+	case 0x4880: // EXT.W
+		cpu->d[reg] = (cpu->d[reg] & 0xFFFF0000) | ((u32)(s32)(s8)cpu->d[reg] & 0xFFFF);
+		setLogicFlags(cpu, cpu->d[reg], 2);
+		return 4;
+	case 0x48C0: // EXT.L
+		cpu->d[reg] = (u32)(s32)(s16)cpu->d[reg];
+		setLogicFlags(cpu, cpu->d[reg], 4);
+		return 4;
+	case 0x4E50: // LINK
+		push32(cpu, cpu->a[reg]);
+		cpu->a[reg] = cpu->a[7];
+		cpu->a[7] += (u32)(s32)(s16)fetch16(cpu);
+		return 16;
+	case 0x4E58: // UNLK
+		cpu->a[7] = cpu->a[reg];
+		cpu->a[reg] = pop32(cpu);
+		return 12;
+	case 0x4E60: // MOVE An,USP
+	case 0x4E68: // MOVE USP,An
+		if (!(cpu->sr & CPU_FLAG_S))
+			return trap(cpu, VECTOR_PRIVILEGE, cpu->instructionPC, 34);
+		if (opcode & 8)
+			cpu->a[reg] = cpu->otherStack;
+		else
+			cpu->otherStack = cpu->a[reg];
+		return 4;
+	default:
+		break;
+	}
+
+	if ((opcode & 0xFFF0) == 0x4E40) // TRAP
+		return trap(cpu, VECTOR_TRAP + (opcode & 15), cpu->pc, 34);
+
+	switch (opcode & 0xFFC0)
+	{
+	case 0x4E80: // JSR
+		value = decodeOperand(cpu, mode, reg, 4).address;
+		enterSubroutine(cpu, value);
+		return jmpTime[index] + 8;
+	case 0x4EC0: // JMP
+		cpu->pc = decodeOperand(cpu, mode, reg, 4).address;
+		return jmpTime[index];
+	case 0x4840: // PEA
+		value = decodeOperand(cpu, mode, reg, 4).address;
+		push32(cpu, value);
+		return leaTime[index] + 8;
+	case 0x40C0: // MOVE SR,<ea>
+		operand = decodeOperand(cpu, mode, reg, 2);
+		writeOperand(cpu, &operand, cpu->sr, 2);
+		return (mode == 0) ? 6 : 8 + eaTime[index][0];
+	case 0x44C0: // MOVE <ea>,CCR
+		operand = decodeOperand(cpu, mode, reg, 2);
+		cpu->sr = (cpu->sr & 0xFF00) | (readOperand(cpu, &operand, 2) & 0x1F);
+		return 12 + eaTime[index][0];
+	case 0x46C0: // MOVE <ea>,SR
+		if (!(cpu->sr & CPU_FLAG_S))
+			return trap(cpu, VECTOR_PRIVILEGE, cpu->instructionPC, 34);
+		operand = decodeOperand(cpu, mode, reg, 2);
+		setStatus(cpu, (u16)readOperand(cpu, &operand, 2));
+		return 12 + eaTime[index][0];
+	case 0x4800: // NBCD
+		operand = decodeOperand(cpu, mode, reg, 1);
+		value = readOperand(cpu, &operand, 1);
+		writeOperand(cpu, &operand, subtractBcd(cpu, (u8)value, 0), 1);
+		return (mode == 0) ? 6 : 8 + eaTime[index][0];
+	case 0x4AC0: // TAS
+		operand = decodeOperand(cpu, mode, reg, 1);
+		value = readOperand(cpu, &operand, 1);
+		setLogicFlags(cpu, value, 1);
+		writeOperand(cpu, &operand, value | 0x80, 1);
+		return (mode == 0) ? 4 : 14 + eaTime[index][0];
+	default:
+		break;
+	}
+
+	if ((opcode & 0xFB80) == 0x4880)
+		return movem(cpu, opcode);
+	if (((opcode >> 6) & 3) != 3) {
+		switch ((opcode >> 8) & 15)
+		{
+		case 0x0: case 0x2: case 0x4: case 0x6: case 0xA:
+			return singleOperand(cpu, opcode);
+		default:
+			break;
+		}
+	}
+	return trap(cpu, VECTOR_ILLEGAL, cpu->instructionPC, 34);
+}
+
+
+/*! ADDQ, SUBQ, Scc, DBcc. */
+static u32 executeGroup5(Cpu68k *cpu, u16 opcode) {
+	u8 mode = (opcode >> 3) & 7, reg = opcode & 7;
+
+	if (((opcode >> 6) & 3) == 3) {
+		u8 condition = testCondition(cpu, (opcode >> 8) & 15);
+		if (mode == 1) { // DBcc
+			u32 base = cpu->pc;
+			u32 displacement = (u32)(s32)(s16)fetch16(cpu);
+			if (condition)
+				return 12;
+			u16 counter = (u16)(cpu->d[reg] - 1);
+			cpu->d[reg] = (cpu->d[reg] & 0xFFFF0000) | counter;
+			if (counter == 0xFFFF)
+				return 14;
+			cpu->pc = base + displacement;
+			return 10;
+		}
+		Operand operand = decodeOperand(cpu, mode, reg, 1);
+		writeOperand(cpu, &operand, condition ? 0xFF : 0, 1);
+		if (mode == 0)
+			return condition ? 6 : 4;
+		return 8 + eaTime[eaIndex(mode, reg)][0];
+	}
+
+	u8 size = 1 << ((opcode >> 6) & 3);
+	u32 data = ((opcode >> 9) & 7) ? ((opcode >> 9) & 7) : 8;
+	if (mode == 1) { // The whole address register, without flags.
+		cpu->a[reg] = (opcode & 0x0100) ? cpu->a[reg] - data : cpu->a[reg] + data;
+		return 8;
+	}
+	Operand operand = decodeOperand(cpu, mode, reg, size);
+	u32 value = readOperand(cpu, &operand, size);
+	value = (opcode & 0x0100) ? subtractValues(cpu, data, value, size, 0, 0) : addValues(cpu, data, value, size, 0);
+	writeOperand(cpu, &operand, value, size);
+	if (mode == 0)
+		return (size == 4) ? 8 : 4;
+	return ((size == 4) ? 12 : 8) + eaTime[eaIndex(mode, reg)][size == 4];
+}
+
+
+/*! Bcc, BRA, BSR. */
+static u32 executeBranch(Cpu68k *cpu, u16 opcode) {
+	u8 condition = (opcode >> 8) & 15;
+	u32 base = cpu->pc;
+	u32 displacement = (u32)(s32)(s8)opcode;
+	u8 isWord = (opcode & 0xFF) == 0;
+
+	if (isWord)
+		displacement = (u32)(s32)(s16)fetch16(cpu);
+	if (condition == 1) {
+		enterSubroutine(cpu, base + displacement);
+		return 18;
+	}
+	if (testCondition(cpu, condition)) {
+		cpu->pc = base + displacement;
+		return 10;
+	}
+	return isWord ? 12 : 8;
+}
+
+
+/*! ADD, SUB, AND, OR, CMP and EOR between a data register and an effective address. */
+typedef enum { BinaryAdd, BinarySubtract, BinaryAnd, BinaryOr, BinaryCompare, BinaryExclusiveOr } BinaryKind;
+
+static u32 binaryOperation(Cpu68k *cpu, u16 opcode, BinaryKind kind) {
+	u8 reg = (opcode >> 9) & 7, opmode = (opcode >> 6) & 7;
+	u8 mode = (opcode >> 3) & 7, eaReg = opcode & 7;
+	u8 size = 1 << (opmode & 3);
+	u8 toMemory = (opmode & 4) != 0;
+	Operand operand = decodeOperand(cpu, mode, eaReg, size);
+	u32 ea = eaTime[eaIndex(mode, eaReg)][size == 4];
+	u32 operandValue = readOperand(cpu, &operand, size);
+	u32 source = toMemory ? cpu->d[reg] : operandValue;
+	u32 destination = toMemory ? operandValue : cpu->d[reg];
+	u32 result;
+
+	switch (kind)
+	{
+	case BinaryAdd:
+		result = addValues(cpu, source, destination, size, 0);
+		break;
+	case BinarySubtract:
+		result = subtractValues(cpu, source, destination, size, 0, 0);
+		break;
+	case BinaryAnd:
+		result = source & destination;
+		setLogicFlags(cpu, result, size);
+		break;
+	case BinaryOr:
+		result = source | destination;
+		setLogicFlags(cpu, result, size);
+		break;
+	case BinaryExclusiveOr:
+		result = source ^ destination;
+		setLogicFlags(cpu, result, size);
+		break;
+	default:
+		subtractValues(cpu, source, destination, size, 0, 1);
+		return ((size == 4) ? 6 : 4) + ea;
+	}
+
+	if (!toMemory) {
+		writeOperand(cpu, &(Operand){ OperandData, reg, 0, 0 }, result, size);
+		if (size == 4 && (mode <= 1 || eaIndex(mode, eaReg) == 11))
+			return 8 + ea;
+		return ((size == 4) ? 6 : 4) + ea;
+	}
+	writeOperand(cpu, &operand, result, size);
+	if (mode == 0) // EOR Dn,Dn
+		return (size == 4) ? 8 : 4;
+	return ((size == 4) ? 12 : 8) + ea;
+}
+
+/*! ADDA, SUBA, CMPA. */
+static u32 addressOperation(Cpu68k *cpu, u16 opcode, BinaryKind kind) {
+	u8 reg = (opcode >> 9) & 7, mode = (opcode >> 3) & 7, eaReg = opcode & 7;
+	u8 size = (opcode & 0x0100) ? 4 : 2;
+	Operand operand = decodeOperand(cpu, mode, eaReg, size);
+	u32 ea = eaTime[eaIndex(mode, eaReg)][size == 4];
+	u32 value = signExtend(readOperand(cpu, &operand, size), size);
+
+	if (kind == BinaryCompare) {
+		subtractValues(cpu, value, cpu->a[reg], 4, 0, 1);
+		return 6 + ea;
+	}
+	cpu->a[reg] = (kind == BinaryAdd) ? cpu->a[reg] + value : cpu->a[reg] - value;
+	if (size == 2)
+		return 8 + ea;
+	return ((mode <= 1 || eaIndex(mode, eaReg) == 11) ? 8 : 6) + ea;
+}
+
+/*! ADDX, SUBX, ABCD, SBCD: Dy,Dx or -(Ay),-(Ax). */
+static u32 extendedOperation(Cpu68k *cpu, u16 opcode, BinaryKind kind, u8 isBcd) {
+	u8 x = (opcode >> 9) & 7, y = opcode & 7;
+	u8 size = isBcd ? 1 : 1 << ((opcode >> 6) & 3);
+	u8 inMemory = (opcode & 8) != 0;
+	Operand source = decodeOperand(cpu, inMemory ? 4 : 0, y, size);
+	u32 sourceValue = readOperand(cpu, &source, size);
+	Operand destination = decodeOperand(cpu, inMemory ? 4 : 0, x, size);
+	u32 destinationValue = readOperand(cpu, &destination, size), result;
+
+	if (isBcd)
+		result = (kind == BinaryAdd) ? addBcd(cpu, (u8)sourceValue, (u8)destinationValue) : subtractBcd(cpu, (u8)sourceValue, (u8)destinationValue);
+	else
+		result = (kind == BinaryAdd) ? addValues(cpu, sourceValue, destinationValue, size, 1) : subtractValues(cpu, sourceValue, destinationValue, size, 1, 0);
+	writeOperand(cpu, &destination, result, size);
+	if (isBcd)
+		return inMemory ? 18 : 6;
+	if (inMemory)
+		return (size == 4) ? 30 : 18;
+	return (size == 4) ? 8 : 4;
+}
+
+static u32 multiply(Cpu68k *cpu, u16 opcode, u8 isSigned) {
+	u8 reg = (opcode >> 9) & 7, mode = (opcode >> 3) & 7, eaReg = opcode & 7;
+	Operand operand = decodeOperand(cpu, mode, eaReg, 2);
+	u16 source = (u16)readOperand(cpu, &operand, 2);
+	u32 result = isSigned ? (u32)((s32)(s16)source * (s32)(s16)cpu->d[reg]) : (u32)source * (u16)cpu->d[reg];
+
+	cpu->d[reg] = result;
+	setLogicFlags(cpu, result, 4);
+	return (isSigned ? mulsTime(source) : muluTime(source)) + eaTime[eaIndex(mode, eaReg)][0];
+}
+
+static u32 divide(Cpu68k *cpu, u16 opcode, u8 isSigned) {
+	u8 reg = (opcode >> 9) & 7, mode = (opcode >> 3) & 7, eaReg = opcode & 7;
+	Operand operand = decodeOperand(cpu, mode, eaReg, 2);
+	u16 source = (u16)readOperand(cpu, &operand, 2);
+	u32 ea = eaTime[eaIndex(mode, eaReg)][0];
+	u32 dividend = cpu->d[reg];
+
+	if (source == 0)
+		return trap(cpu, VECTOR_ZERO_DIVIDE, cpu->pc, 38 + ea);
+
+	u32 cycles = ea + (isSigned ? divsTime((s32)dividend, (s16)source) : divuTime(dividend, source));
+	cpu->sr &= ~CPU_FLAG_C;
+	if (isSigned) {
+		int64_t quotient = (int64_t)(s32)dividend / (s16)source;
+		int64_t remainder = (int64_t)(s32)dividend % (s16)source;
+		if (quotient < -32768 || quotient > 32767) {
+			cpu->sr |= CPU_FLAG_V;
+			return cycles;
+		}
+		cpu->d[reg] = ((u32)(u16)remainder << 16) | (u16)quotient;
+	}
+	else {
+		u32 quotient = dividend / source;
+		if (quotient > 0xFFFF) {
+			cpu->sr |= CPU_FLAG_V;
+			return cycles;
+		}
+		cpu->d[reg] = ((dividend % source) << 16) | quotient;
+	}
+	setLogicFlags(cpu, cpu->d[reg], 2);
+	return cycles;
+}
+
+static u32 executeGroup8(Cpu68k *cpu, u16 opcode) {
+	u8 opmode = (opcode >> 6) & 7;
+	if (opmode == 3 || opmode == 7)
+		return divide(cpu, opcode, opmode == 7);
+	if ((opcode & 0x01F0) == 0x0100)
+		return extendedOperation(cpu, opcode, BinarySubtract, 1);
+	return binaryOperation(cpu, opcode, BinaryOr);
+}
+
+static u32 executeGroupC(Cpu68k *cpu, u16 opcode) {
+	u8 opmode = (opcode >> 6) & 7, x = (opcode >> 9) & 7, y = opcode & 7;
+	u32 swap;
+
+	if (opmode == 3 || opmode == 7)
+		return multiply(cpu, opcode, opmode == 7);
+	switch (opcode & 0x01F8)
+	{
+	case 0x0140:
+		swap = cpu->d[x]; cpu->d[x] = cpu->d[y]; cpu->d[y] = swap;
+		return 6;
+	case 0x0148:
+		swap = cpu->a[x]; cpu->a[x] = cpu->a[y]; cpu->a[y] = swap;
+		return 6;
+	case 0x0188:
+		swap = cpu->d[x]; cpu->d[x] = cpu->a[y]; cpu->a[y] = swap;
+		return 6;
+	default:
+		break;
+	}
+	if ((opcode & 0x01F0) == 0x0100)
+		return extendedOperation(cpu, opcode, BinaryAdd, 1);
+	return binaryOperation(cpu, opcode, BinaryAnd);
+}
+
+/*! ADD/SUB and their A and X forms. */
+static u32 executeAddSubtract(Cpu68k *cpu, u16 opcode, BinaryKind kind) {
+	u8 opmode = (opcode >> 6) & 7;
+	if (opmode == 3 || opmode == 7)
+		return addressOperation(cpu, opcode, kind);
+	if ((opcode & 0x0130) == 0x0100)
+		return extendedOperation(cpu, opcode, kind, 0);
+	return binaryOperation(cpu, opcode, kind);
+}
+
+static u32 executeGroupB(Cpu68k *cpu, u16 opcode) {
+	u8 opmode = (opcode >> 6) & 7, mode = (opcode >> 3) & 7;
+
+	if (opmode == 3 || opmode == 7)
+		return addressOperation(cpu, opcode, BinaryCompare);
+	if (opmode < 3)
+		return binaryOperation(cpu, opcode, BinaryCompare);
+	if (mode == 1) { // CMPM (Ay)+,(Ax)+
+		u8 size = 1 << (opmode & 3);
+		Operand source = decodeOperand(cpu, 3, opcode & 7, size);
+		u32 sourceValue = readOperand(cpu, &source, size);
+		Operand destination = decodeOperand(cpu, 3, (opcode >> 9) & 7, size);
+		subtractValues(cpu, sourceValue, readOperand(cpu, &destination, size), size, 0, 1);
+		return (size == 4) ? 20 : 12;
+	}
+	return binaryOperation(cpu, opcode, BinaryExclusiveOr);
+}
+
+static u32 executeShift(Cpu68k *cpu, u16 opcode) {
+	u8 left = (opcode & 0x0100) != 0;
+
+	if ((opcode & 0x00C0) == 0x00C0) { // Memory, one bit, word.
+		u8 mode = (opcode >> 3) & 7, reg = opcode & 7;
+		Operand operand = decodeOperand(cpu, mode, reg, 2);
+		u32 value = readOperand(cpu, &operand, 2);
+		writeOperand(cpu, &operand, shiftValue(cpu, (opcode >> 9) & 3, left, value, 1, 2), 2);
+		return 8 + eaTime[eaIndex(mode, reg)][0];
+	}
+
+	u8 size = 1 << ((opcode >> 6) & 3), reg = opcode & 7;
+	u8 count = (u8)((opcode & 0x20) ? (cpu->d[(opcode >> 9) & 7] & 63) : ((((opcode >> 9) & 7) == 0) ? 8 : (opcode >> 9) & 7));
+	u32 value = shiftValue(cpu, (opcode >> 3) & 3, left, cpu->d[reg], count, size);
+	writeOperand(cpu, &(Operand){ OperandData, reg, 0, 0 }, value, size);
+	return ((size == 4) ? 8 : 6) + 2 * (u32)count;
+}
+
+
+static u32 execute(Cpu68k *cpu, u16 opcode) {
+	switch (opcode >> 12)
+	{
+	case 0x0: return executeGroup0(cpu, opcode);
+	case 0x1: case 0x2: case 0x3: return executeMove(cpu, opcode);
+	case 0x4: return executeGroup4(cpu, opcode);
+	case 0x5: return executeGroup5(cpu, opcode);
+	case 0x6: return executeBranch(cpu, opcode);
+	case 0x7:
+		if (opcode & 0x0100)
+			break;
+		cpu->d[(opcode >> 9) & 7] = (u32)(s32)(s8)opcode;
+		setLogicFlags(cpu, (u32)(s32)(s8)opcode, 4);
+		return 4;
+	case 0x8: return executeGroup8(cpu, opcode);
+	case 0x9: return executeAddSubtract(cpu, opcode, BinarySubtract);
+	case 0xA: return trap(cpu, VECTOR_LINE_A, cpu->instructionPC, 34);
+	case 0xB: return executeGroupB(cpu, opcode);
+	case 0xC: return executeGroupC(cpu, opcode);
+	case 0xD: return executeAddSubtract(cpu, opcode, BinaryAdd);
+	case 0xE: return executeShift(cpu, opcode);
+	default: return trap(cpu, VECTOR_LINE_F, cpu->instructionPC, 34);
+	}
+	return trap(cpu, VECTOR_ILLEGAL, cpu->instructionPC, 34);
+}
+
+
+void resetCpu68k(Cpu68k *cpu) {
+	for (u8 i = 0; i < 8; ++i)
+		cpu->d[i] = cpu->a[i] = 0;
+	cpu->sr = CPU_FLAG_S | 0x0700;
+	cpu->otherStack = 0;
+	cpu->stopped = 0;
+	cpu->interruptLevel = 0;
+	cpu->cycles = 0;
+	cpu->a[7] = read32(cpu, 0);
+	cpu->pc = read32(cpu, 4);
+	cpu->instructionPC = cpu->pc;
+}
+
+
+u32 stepCpu68k(Cpu68k *cpu) {
+	u8 level = cpu->interruptLevel;
+	u32 cycles;
+
+	if (level && (level == 7 || level > ((cpu->sr >> 8) & 7))) {
+		u8 vector = cpu->bus.acknowledge(cpu->bus.context, level);
+		cpu->stopped = 0;
+		cpu->instructionPC = cpu->pc;
+		raiseException(cpu, vector, cpu->pc);
+		cpu->sr = (cpu->sr & ~0x0700) | ((u16)level << 8);
+		cycles = 44;
+	}
+	else if (cpu->stopped)
+		cycles = 4;
+	else {
+		cpu->instructionPC = cpu->pc;
+		cycles = execute(cpu, fetch16(cpu));
+	}
+	cpu->cycles += cycles;
+	return cycles;
+}
@@ -0,0 +1,149 @@
+/*!
+\file FastForward.c
+\brief Fast-forward file
+\date 10/2026
+
+Jumps over the frames of a match in which no system decides anything (see FastForward.h).
+*/
+
+#include "../inc/FastForward.h"
+#include "Timers.h"
+
+#define FRAME_NEVER 0xFFFFFFFFUL	/*!< No frame ahead. */
+
+
+static u32 earliest(u32 a, u32 b) {
+	return (a < b) ? a : b;
+}
+
+static u8 isAttack(u8 move) {
+	return move >= A1 && move <= B3;
+}
+
+#ifndef ECS_TIMER_WHEEL // With timers, quietFrames reads the wheel instead (see quietTimerFrames).
+/*! Returns after how many frames 'frames', counting up from 'frames', reaches 'target'. 'frames' wraps around. */
+static u32 countsUntil(u16 frames, u16 target) {
+	return (u32)(u16)(target - 1 - frames) + 1;
+}
+
+/*! Returns the frame (1 for the next one) at which a move that lasts 'limit' frames, and has played 'frames', ends. */
+static u32 framesAbove(u16 frames, u16 limit) {
+	return (frames > limit) ? 1 : (u32)(limit + 2 - frames);
+}
+
+
+/*! Returns the next frame (1 for the next one) at which combatSystem does more than count on a busy entity,
+	or at which one of its counts ends or wraps around. The same conditions as nextTimer in Timers.c. */
+static u32 nextCombatFrame(World *world, EntitySlot entity) {
+	u8 move = world->move[entity].move;
+	u16 frames = entityFrames(world, entity);
+	u8 staggered = entityStaggered(world, entity);
+	u32 next = FRAME_NEVER;
+
+	if (staggered > 0)
+		next = staggered; // Counts down to 0.
+	else if (move == Staggered)
+		return 1; // Goes idle.
+	if (move == Idling || move == Staggered)
+		return next;
+
+	next = earliest(next, countsUntil(frames, 0)); // Wraps around.
+	switch (move)
+	{
+	case Guarding:
+		break;
+	case Parrying:
+		next = earliest(next, framesAbove(frames, PARRY_FRAMES + FOLLOWUP_FRAMES));
+		break;
+	case Dying:
+		next = earliest(next, countsUntil(frames, DEATH_FRAMES));
+		break;
+	default: // Attacks
+		if (frames < ATTACK_FRAMES)
+			next = earliest(next, countsUntil(frames, ATTACK_FRAMES));
+		next = earliest(next, framesAbove(frames, ATTACK_FRAMES + FOLLOWUP_FRAMES));
+		break;
+	}
+	return next;
+}
+#endif // !ECS_TIMER_WHEEL
+
+
+/*! Returns the next frame at which inputSystem does something with this input. */
+static u32 nextInputFrame(World *world, SimContext *context, const ButtonInput *buttonInput) {
+	EntitySlot player = context->currentPlayer;
+	u8 move = world->move[player].move;
+	u16 frames = entityFrames(world, player);
+
+	EntitySlot opponent = facedEntity(world, player);
+	if (move == Dying || opponent == ENTITY_NONE || world->move[opponent].move == Dying)
+		return FRAME_NEVER;
+	if (buttonInput->isPressed != TRUE)
+		return (move == Guarding) ? 1 : FRAME_NEVER; // Releases the guard.
+
+	switch (buttonInput->latestButtonPress)
+	{
+	case A: case B: case C:
+		// Starts an attack or a switch, or chains one when timed right (see timedRight).
+		if (move == Idling)
+			return 1;
+		if (!isAttack(move))
+			return FRAME_NEVER;
+		if (frames == 0 || (frames > ATTACK_FRAMES && frames < ATTACK_FRAMES + FOLLOWUP_FRAMES))
+			return 1;
+		return (frames <= ATTACK_FRAMES) ? (u32)(ATTACK_FRAMES + 2 - frames) : FRAME_NEVER;
+
+	case Up: case Down:
+		return (move == Idling) ? 1 : FRAME_NEVER;
+
+	default:
+		return FRAME_NEVER;
+	}
+}
+
+
+/*! Returns the next frame at which AISystem acts: difficultyAIaccumulator reaches 100. */
+static u32 nextAIFrame(SimContext *context, u16 difficulty) {
+	u32 accumulator = context->difficultyAIaccumulator;
+	if (accumulator + difficulty >= 100)
+		return 1;
+	if (difficulty == 0)
+		return FRAME_NEVER;
+	return (100 - accumulator + difficulty - 1) / difficulty;
+}
+
+
+u32 quietFrames(World *world, SimContext *context, const ButtonInput *buttonInput, u16 difficulty, u32 limit) {
+	if (limit == 0)
+		return 0;
+
+	u32 quiet = earliest(earliest(nextAIFrame(context, difficulty), nextInputFrame(world, context, buttonInput)) - 1, limit);
+#ifdef ECS_TIMER_WHEEL
+	// The timers are due at the frames nextCombatFrame would find.
+	return quietTimerFrames(world, quiet);
+#else
+	for (EntitySlot entity = nextEntityWith(world, ENTITY_BUSY, 0); entity < ENTITY_COUNT && quiet > 0; entity = nextEntityWith(world, ENTITY_BUSY, entity + 1))
+		quiet = earliest(quiet, nextCombatFrame(world, entity) - 1);
+	return quiet;
+#endif
+}
+
+
+EventQueue fastForward(World *world, SimContext *context, u16 difficulty, u32 frames) {
+	context->difficultyAIaccumulator += difficulty * frames;
+	context->eventSFX = 0;
+#ifdef ECS_TIMER_WHEEL
+	skipTimerFrames(world, frames);
+#else
+	// No count ends or wraps around in these frames: the busy entities stay busy.
+	for (EntitySlot entity = nextEntityWith(world, ENTITY_BUSY, 0); entity < ENTITY_COUNT; entity = nextEntityWith(world, ENTITY_BUSY, entity + 1)) {
+		u8 move = world->move[entity].move;
+		if (world->health[entity].staggered > 0)
+			world->health[entity].staggered -= frames;
+		if (move != Idling && move != Staggered)
+			world->timing[entity].frames += frames;
+		refreshEntityHash(world, entity);
+	}
+#endif
+	return renderSystem(world, context);
+}
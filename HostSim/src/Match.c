@@ -0,0 +1,85 @@
+/*!
+\file Match.c
+\brief Host match file
+\date 10/2026
+
+Plays complete matches on the host.
+*/
+
+#include <string.h>
+
+#include "../inc/Match.h"
+#include "../inc/FastForward.h"
+
+
+MatchOutcome matchOutcome(World *world, SimContext *context) {
+	// If a player character died, Game Over.
+	if (world->move[context->currentPlayer].move == Dying && entityFrames(world, context->currentPlayer) == DEATH_FRAMES)
+		return MatchLost;
+	// If last enemy died, then Stage Clear! (First slot is always final enemy.)
+	if (world->move[0].move == Dying && entityFrames(world, 0) == DEATH_FRAMES)
+		return MatchWon;
+	return MatchPlaying;
+}
+
+
+/*! Plays one match, frame by frame or jumping over the frames in which nothing is decided. */
+static MatchResult runMatch(const MatchSetup *setup, u8 skipQuietFrames) {
+	World world;
+	SimContext context;
+	PlayerBot bot;
+	ButtonInput buttonInput = { FALSE, Neutral };
+	MatchResult result;
+
+	memset(&world, 0, sizeof(World)); // Like ECSWorld in main.c, start from a cleared world.
+	initializeMatch(&world, &context, setup->numAllies, matchSeed(setup->seed, MATCH_WORLD_STREAM));
+	initializePlayerBot(&bot, setup->seed);
+
+	result.outcome = MatchPlaying;
+	for (result.frames = 1; result.frames <= MATCH_FRAME_LIMIT; ++result.frames) {
+		if (skipQuietFrames) {
+			u32 limit = MATCH_FRAME_LIMIT + 1 - result.frames;
+			u32 frames = playerBotHeldFrames(&bot, &world, &context, &buttonInput);
+			frames = quietFrames(&world, &context, &buttonInput, setup->difficulty, (frames < limit) ? frames : limit);
+			if (frames > 0) {
+				skipPlayerBot(&bot, frames);
+				fastForward(&world, &context, setup->difficulty, frames);
+				result.frames += frames;
+				if (result.frames > MATCH_FRAME_LIMIT)
+					break;
+			}
+		}
+		context.difficultyAIaccumulator += setup->difficulty;
+		playerBotInput(&bot, &world, &context, &buttonInput);
+		updateWorld(&world, &context, &buttonInput);
+
+		result.outcome = matchOutcome(&world, &context);
+		if (result.outcome != MatchPlaying)
+			break;
+	}
+
+	if (result.outcome == MatchPlaying) {
+		result.frames = MATCH_FRAME_LIMIT;
+		result.outcome = MatchTimedOut;
+	}
+	result.hash = simulationHash(&world, &context);
+	return result;
+}
+
+
+MatchResult playMatch(const MatchSetup *setup) {
+	return runMatch(setup, FALSE);
+}
+
+
+MatchResult fastForwardMatch(const MatchSetup *setup) {
+	return runMatch(setup, TRUE);
+}
+
+
+u32 matchSeed(u32 seed, u32 match) {
+	RandomStream root, child;
+	seedRandom(&root, seed);
+	splitRandom(&root, &child, match);
+	return child.state;
+}
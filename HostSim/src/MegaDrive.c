@@ -0,0 +1,419 @@
+/*!
+\file MegaDrive.c
+\brief Mega Drive machine file
+\date 10/2026
+
+Memory map, VDP, pad and Z80 stub of MegaDrive.h, as a CpuBus for Cpu68k.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "../inc/MegaDrive.h"
+
+#define VDP_STATUS_FIFO_EMPTY 0x0200
+#define VDP_STATUS_VINT 0x0080
+#define VDP_STATUS_VBLANK 0x0008
+#define VDP_STATUS_HBLANK 0x0004
+#define HBLANK_START 404	/*!< Cycle of the line from which the status reports horizontal blank. */
+#define Z80_DRIVER_STATUS 0x0102	/*!< Status byte of the SGDK Z80 drivers. */
+#define Z80_DRIVER_READY 0x80	/*!< "Driver ready" bit of the status byte. */
+
+
+static u8 inVerticalBlank(const MegaDrive *machine) {
+	return machine->line >= MD_VBLANK_LINE || !(machine->vdpRegister[1] & 0x40);
+}
+
+static void updateInterruptLevel(MegaDrive *machine) {
+	if (machine->vintPending && (machine->vdpRegister[1] & 0x20))
+		machine->cpu.interruptLevel = 6;
+	else if (machine->hintPending && (machine->vdpRegister[0] & 0x10))
+		machine->cpu.interruptLevel = 4;
+	else
+		machine->cpu.interruptLevel = 0;
+}
+
+static u8 acknowledgeInterrupt(void *context, u8 level) {
+	MegaDrive *machine = context;
+	if (level == 6)
+		machine->vintPending = 0;
+	else if (level == 4)
+		machine->hintPending = 0;
+	updateInterruptLevel(machine);
+	return 24 + level; // Autovector
+}
+
+
+static void writeVdpData(MegaDrive *machine, u16 value) {
+	u16 address = machine->vdpAddress;
+
+	switch (machine->vdpCode & 0x0F)
+	{
+	case 1:
+		machine->vram[address & 0xFFFE] = (u8)(value >> 8);
+		machine->vram[(address & 0xFFFE) + 1] = (u8)value;
+		break;
+	case 3:
+		machine->cram[(address >> 1) & 63] = value;
+		break;
+	case 5:
+		if ((address >> 1) < 40)
+			machine->vsram[address >> 1] = value;
+		break;
+	default:
+		break;
+	}
+	machine->vdpAddress += machine->vdpRegister[15];
+}
+
+static u16 readVdpData(MegaDrive *machine) {
+	u16 address = machine->vdpAddress, value;
+
+	switch (machine->vdpCode & 0x0F)
+	{
+	case 0:
+		value = (u16)((machine->vram[address & 0xFFFE] << 8) | machine->vram[(address & 0xFFFE) + 1]);
+		break;
+	case 4:
+		value = ((address >> 1) < 40) ? machine->vsram[address >> 1] : 0;
+		break;
+	case 8:
+		value = machine->cram[(address >> 1) & 63];
+		break;
+	default:
+		value = 0;
+		break;
+	}
+	machine->vdpAddress += machine->vdpRegister[15];
+	return value;
+}
+
+static u32 dmaLength(const MegaDrive *machine) {
+	u32 length = machine->vdpRegister[19] | ((u32)machine->vdpRegister[20] << 8);
+	return length ? length : 0x10000;
+}
+
+/*! Copies words from 68000 memory to VRAM, CRAM or VSRAM, and halts the CPU while the VDP copies. */
+static void runMemoryDma(MegaDrive *machine) {
+	u32 length = dmaLength(machine);
+	u32 source = ((u32)(machine->vdpRegister[23] & 0x7F) << 17) | ((u32)machine->vdpRegister[22] << 9)
+		| ((u32)machine->vdpRegister[21] << 1);
+	u8 wide = (machine->vdpRegister[12] & 0x81) != 0;
+	u32 bytesPerLine = inVerticalBlank(machine) ? (wide ? 205 : 167) : (wide ? 18 : 16);
+
+	for (u32 i = 0; i < length; ++i) {
+		writeVdpData(machine, machine->cpu.bus.read16(machine, source & 0xFFFFFE));
+		source = (source & 0xFE0000) | ((source + 2) & 0x1FFFF); // The source wraps around within 128 KB.
+	}
+	machine->vdpRegister[19] = machine->vdpRegister[20] = 0;
+	machine->vdpRegister[21] = (u8)(source >> 1);
+	machine->vdpRegister[22] = (u8)(source >> 9);
+
+	u32 stall = (2 * length * MD_LINE_CYCLES + bytesPerLine - 1) / bytesPerLine;
+	machine->cpu.cycles += stall;
+	machine->dmaCycles += stall;
+}
+
+static void runCopyDma(MegaDrive *machine) {
+	u32 length = dmaLength(machine);
+	u16 source = (u16)(machine->vdpRegister[21] | (machine->vdpRegister[22] << 8));
+
+	for (u32 i = 0; i < length; ++i) {
+		machine->vram[machine->vdpAddress] = machine->vram[source++];
+		machine->vdpAddress += machine->vdpRegister[15];
+	}
+	machine->vdpRegister[19] = machine->vdpRegister[20] = 0;
+}
+
+static void runFillDma(MegaDrive *machine, u16 value) {
+	u32 length = dmaLength(machine);
+
+	for (u32 i = 0; i < length; ++i) {
+		machine->vram[machine->vdpAddress ^ 1] = (u8)(value >> 8);
+		machine->vdpAddress += machine->vdpRegister[15];
+	}
+	machine->vdpRegister[19] = machine->vdpRegister[20] = 0;
+	machine->vdpFillPending = 0;
+}
+
+static void writeVdpControl(MegaDrive *machine, u16 value) {
+	if (machine->vdpSecondWord) {
+		machine->vdpSecondWord = 0;
+		machine->vdpAddress = (u16)((machine->vdpAddress & 0x3FFF) | ((value & 3) << 14));
+		machine->vdpCode = (u8)((machine->vdpCode & 0x03) | ((value >> 2) & 0x3C));
+		if ((machine->vdpCode & 0x20) && (machine->vdpRegister[1] & 0x10)) {
+			switch (machine->vdpRegister[23] >> 6)
+			{
+			case 2:
+				machine->vdpFillPending = 1;
+				break;
+			case 3:
+				runCopyDma(machine);
+				break;
+			default:
+				runMemoryDma(machine);
+				break;
+			}
+		}
+	}
+	else if ((value & 0xC000) == 0x8000) {
+		u8 reg = (value >> 8) & 0x1F;
+		if (reg < 24)
+			machine->vdpRegister[reg] = (u8)value;
+		updateInterruptLevel(machine);
+	}
+	else {
+		machine->vdpSecondWord = 1;
+		machine->vdpAddress = (u16)((machine->vdpAddress & 0xC000) | (value & 0x3FFF));
+		machine->vdpCode = (u8)((machine->vdpCode & 0x3C) | (value >> 14));
+	}
+}
+
+static u16 readVdpStatus(MegaDrive *machine) {
+	u16 status = 0x3400 | VDP_STATUS_FIFO_EMPTY;
+
+	machine->vdpSecondWord = 0;
+	if (inVerticalBlank(machine))
+		status |= VDP_STATUS_VBLANK;
+	if (machine->cpu.cycles - machine->lineStart >= HBLANK_START)
+		status |= VDP_STATUS_HBLANK;
+	if (machine->vintPending)
+		status |= VDP_STATUS_VINT;
+	return status;
+}
+
+/*! HV counter, NTSC V28 H40: the V counter jumps from 0xEA to 0xE5, the H counter from 0xB6 to 0xE4. */
+static u16 readHVCounter(const MegaDrive *machine) {
+	u32 vertical = (machine->line <= 0xEA) ? machine->line : machine->line - 6;
+	u32 horizontal = (u32)(machine->cpu.cycles - machine->lineStart) * 210 / MD_LINE_CYCLES;
+
+	if (horizontal > 0xB6)
+		horizontal += 0xE4 - 0xB7;
+	return (u16)(((vertical & 0xFF) << 8) | (horizontal & 0xFF));
+}
+
+static u16 readVdp(MegaDrive *machine, u32 address) {
+	switch (address & 0x1C)
+	{
+	case 0x00:
+		return readVdpData(machine);
+	case 0x04:
+		return readVdpStatus(machine);
+	case 0x08:
+	case 0x0C:
+		return readHVCounter(machine);
+	default:
+		return 0xFFFF;
+	}
+}
+
+static void writeVdp(MegaDrive *machine, u32 address, u16 value) {
+	switch (address & 0x1C)
+	{
+	case 0x00:
+		machine->vdpSecondWord = 0;
+		if (machine->vdpFillPending) {
+			writeVdpData(machine, value);
+			runFillDma(machine, value);
+		}
+		else
+			writeVdpData(machine, value);
+		break;
+	case 0x04:
+		writeVdpControl(machine, value);
+		break;
+	default:
+		break; // PSG and test registers
+	}
+}
+
+
+/*! Port 1: a 3-button pad. With TH high it reports C B Right Left Down Up, with TH low Start A 0 0 Down Up. */
+static u8 readPad(const MegaDrive *machine) {
+	u8 th = (machine->padControl & 0x40) ? (machine->padData & 0x40) : 0x40;
+	u16 released = (u16)~machine->buttons;
+	u8 value;
+
+	if (th)
+		value = 0x40 | (released & 0x3F);
+	else
+		value = (u8)((released & 0x03) | ((released >> 2) & 0x30));
+	return (u8)((value & ~machine->padControl) | (machine->padData & machine->padControl)) & 0x7F;
+}
+
+static u8 readIo(const MegaDrive *machine, u32 address) {
+	switch (address & 0x1F)
+	{
+	case 0x01:
+		return 0xA0; // Overseas NTSC, no expansion unit, no TMSS.
+	case 0x03:
+		return readPad(machine);
+	case 0x09:
+		return machine->padControl;
+	case 0x05:
+	case 0x07:
+		return 0x7F; // Nothing plugged in.
+	default:
+		return 0;
+	}
+}
+
+static void writeIo(MegaDrive *machine, u32 address, u8 value) {
+	switch (address & 0x1F)
+	{
+	case 0x03:
+		machine->padData = value;
+		break;
+	case 0x09:
+		machine->padControl = value;
+		break;
+	default:
+		break;
+	}
+}
+
+static u8 readZ80Area(const MegaDrive *machine, u32 address) {
+	if ((address & 0xFFFF) < 0x4000) {
+		u16 z80Address = address & 0x1FFF;
+		u8 value = machine->z80Ram[z80Address];
+		return (z80Address == Z80_DRIVER_STATUS) ? (value | Z80_DRIVER_READY) : value;
+	}
+	if ((address & 0xFFFF) < 0x6000)
+		return 0; // YM2612 status: never busy.
+	return 0xFF;
+}
+
+
+static u8 busRead8(void *context, u32 address) {
+	MegaDrive *machine = context;
+
+	if (address < 0x400000)
+		return (address < machine->romSize) ? machine->rom[address] : 0xFF;
+	if (address >= 0xE00000)
+		return machine->ram[address & 0xFFFF];
+	if (address >= 0xC00000 && address < 0xC00020) {
+		u16 value = readVdp(machine, address & ~1U);
+		return (address & 1) ? (u8)value : (u8)(value >> 8);
+	}
+	if (address >= 0xA00000 && address < 0xA10000)
+		return readZ80Area(machine, address);
+	if (address >= 0xA10000 && address < 0xA10020)
+		return readIo(machine, address | 1);
+	if (address == 0xA11100)
+		return machine->z80BusRequest ? 0 : 1;
+	return 0;
+}
+
+static u16 busRead16(void *context, u32 address) {
+	MegaDrive *machine = context;
+
+	if (address < 0x400000)
+		return (address + 1 < machine->romSize) ? (u16)((machine->rom[address] << 8) | machine->rom[address + 1]) : 0xFFFF;
+	if (address >= 0xE00000)
+		return (u16)((machine->ram[address & 0xFFFF] << 8) | machine->ram[(address & 0xFFFF) + 1]);
+	if (address >= 0xC00000 && address < 0xC00020)
+		return readVdp(machine, address);
+	if (address >= 0xA00000 && address < 0xA10000) {
+		u8 value = readZ80Area(machine, address);
+		return (u16)((value << 8) | value);
+	}
+	if (address >= 0xA10000 && address < 0xA10020) {
+		u8 value = readIo(machine, address | 1);
+		return (u16)((value << 8) | value);
+	}
+	if (address == 0xA11100)
+		return machine->z80BusRequest ? 0 : 0x0100;
+	return 0;
+}
+
+static void busWrite8(void *context, u32 address, u8 value) {
+	MegaDrive *machine = context;
+
+	if (address >= 0xE00000)
+		machine->ram[address & 0xFFFF] = value;
+	else if (address >= 0xC00000 && address < 0xC00020)
+		writeVdp(machine, address & ~1U, (u16)((value << 8) | value));
+	else if (address >= 0xA00000 && address < 0xA04000)
+		machine->z80Ram[address & 0x1FFF] = value;
+	else if (address >= 0xA10000 && address < 0xA10020)
+		writeIo(machine, address | 1, value);
+	else if (address == 0xA11100)
+		machine->z80BusRequest = value & 1;
+	else if (address == 0xA11200)
+		machine->z80Reset = !(value & 1);
+}
+
+static void busWrite16(void *context, u32 address, u16 value) {
+	MegaDrive *machine = context;
+
+	if (address >= 0xE00000) {
+		machine->ram[address & 0xFFFF] = (u8)(value >> 8);
+		machine->ram[(address & 0xFFFF) + 1] = (u8)value;
+	}
+	else if (address >= 0xC00000 && address < 0xC00020)
+		writeVdp(machine, address, value);
+	else if (address >= 0xA00000 && address < 0xA04000)
+		machine->z80Ram[address & 0x1FFF] = (u8)(value >> 8);
+	else if (address >= 0xA10000 && address < 0xA10020)
+		writeIo(machine, address | 1, (u8)value);
+	else if (address == 0xA11100)
+		machine->z80BusRequest = (value & 0x0100) != 0;
+	else if (address == 0xA11200)
+		machine->z80Reset = !(value & 0x0100);
+}
+
+
+/*! Raises the interrupts of the line that just started. */
+static void startLine(MegaDrive *machine) {
+	if (machine->line <= MD_VBLANK_LINE) {
+		if (--machine->hintCounter < 0) {
+			machine->hintCounter = machine->vdpRegister[10];
+			machine->hintPending = 1;
+		}
+	}
+	else
+		machine->hintCounter = machine->vdpRegister[10];
+	if (machine->line == MD_VBLANK_LINE)
+		machine->vintPending = 1;
+	updateInterruptLevel(machine);
+}
+
+
+void powerOnMegaDrive(MegaDrive *machine, const u8 *rom, u32 romSize, CpuCallHook onCall, void *hookContext) {
+	memset(machine, 0, sizeof(MegaDrive));
+	machine->rom = rom;
+	machine->romSize = romSize;
+	machine->z80Reset = 1;
+	machine->cpu.bus.read8 = busRead8;
+	machine->cpu.bus.read16 = busRead16;
+	machine->cpu.bus.write8 = busWrite8;
+	machine->cpu.bus.write16 = busWrite16;
+	machine->cpu.bus.acknowledge = acknowledgeInterrupt;
+	machine->cpu.bus.context = machine;
+	machine->cpu.onCall = onCall;
+	machine->cpu.hookContext = hookContext;
+	resetCpu68k(&machine->cpu);
+}
+
+
+u32 stepMegaDrive(MegaDrive *machine) {
+	unsigned long long start = machine->cpu.cycles;
+
+	stepCpu68k(&machine->cpu);
+	while (machine->cpu.cycles - machine->lineStart >= MD_LINE_CYCLES) {
+		machine->lineStart += MD_LINE_CYCLES;
+		if (++machine->line == MD_FRAME_LINES) {
+			machine->line = 0;
+			++machine->frame;
+		}
+		startLine(machine);
+	}
+	return (u32)(machine->cpu.cycles - start);
+}
+
+
+void runMegaDriveFrame(MegaDrive *machine) {
+	u32 frame = machine->frame;
+	while (machine->frame == frame)
+		stepMegaDrive(machine);
+}
@@ -0,0 +1,423 @@
+/*!
+\file Pack.c
+\brief SGDK compression file
+\date 10/2026
+
+aPLib and LZ4W packers (see Pack.h).
+
+Both find matches with a hash chain, then pick the cheapest way to reach every position (optimal parse):
+for every match found at a position, every length up to its own, at the distance of the nearest match that long.
+
+aPLib stream: a first byte as is, then a bit stream whose tag bytes sit in the byte stream where the unpacker first
+needs one of their bits. Bits are read from the high bit of each tag.
+- 0, byte: a literal byte.
+- 111, 4 bits: one byte from 1 to 15 bytes back, or a 0 byte.
+- 110, byte: 2 or 3 bytes (low bit) from 1 to 127 bytes back (the other bits). 0 ends the stream.
+- 10, gamma: if the last step was not a match and the gamma code is 2, a match at the last distance, of a gamma code bytes.
+  Otherwise the high byte of the distance, plus 3 (2 after a match), then its low byte, then the length in a gamma code,
+  minus 2 below 128 bytes back, minus 1 from 1280, minus 2 from 32000.
+- Gamma code of v >= 2: the bits of v after its highest one, each followed by a 1 if more follow, or a 0 for the last one.
+
+LZ4W stream, in 16-bit words: tokens of 2 bytes, the literal count in the high 4 bits of the first byte.
+- Match count 1 to 15 (low 4 bits of the first byte): the literals, then a match of count + 1 words,
+  from second byte + 1 words back.
+- Match count 0, second byte not 0: the literals, then the distance in a word (2 * (words back - 1)),
+  then a match of second byte + 2 words.
+- Match count 0, second byte 0: only the literals, or the end of the stream if there are none, followed by a word
+  with its high bit set if one more byte (its low byte) ends the data.
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../inc/Pack.h"
+
+#define HASH_SIZE 0x10000	/*!< Entries of the hash chain heads. */
+#define CHAIN_LIMIT 256	/*!< Most earlier positions tried per position. */
+#define GOOD_LENGTH 258	/*!< Stop looking once a match this long is found. */
+#define EXACT_LENGTHS 64	/*!< Every length up to this is tried; longer matches only with their full length. */
+#define MAX_MATCHES 32	/*!< Most matches of different lengths kept per position. */
+
+#define APLIB_LITERAL_BITS 9
+#define APLIB_SHORT_BYTE_BITS 7
+#define APLIB_SHORT_MATCH_BITS 11
+#define APLIB_NEAR 128	/*!< Below this distance, long matches are 2 bytes longer than their code. */
+#define APLIB_FAR 1280	/*!< From this distance, 1 byte longer. */
+#define APLIB_FARTHEST 32000	/*!< From this distance, 2 bytes longer. */
+
+#define LZ4W_LITERALS 15	/*!< Most literal words of a token. */
+#define LZ4W_SHORT_LENGTH 16	/*!< Longest short match, in words. */
+#define LZ4W_SHORT_DISTANCE 256	/*!< Farthest short match, in words. */
+#define LZ4W_LONG_LENGTH 257	/*!< Longest long match, in words. */
+#define LZ4W_LONG_DISTANCE 16384	/*!< Farthest long match, in words. */
+// Costs in sixteenths of a byte: a literal word also takes its share of a token (2 bytes per 15 literals).
+#define LZ4W_LITERAL_COST 34
+#define LZ4W_SHORT_COST 32
+#define LZ4W_LONG_COST 64
+
+/*! \brief Structure with a match: length and distance, in units (bytes for aPLib, words for LZ4W). */
+typedef struct {
+	u32 length;
+	u32 distance;
+} Match;
+
+/*! \brief Structure with the hash chains of the positions already passed. */
+typedef struct {
+	const u8 *data;
+	u32 units;	/**< Length of the data, in units */
+	u8 unit;	/**< Bytes per unit */
+	u32 maxLength;
+	u32 maxDistance;
+	s32 *head;	/**< Last position of every hash */
+	s32 *previous;	/**< Position before with the same hash, for every position */
+} MatchFinder;
+
+/*! \brief Structure with the cheapest way found to reach a position. */
+typedef struct {
+	u32 cost;
+	u32 length;	/**< Units of the last step: 1 for a literal */
+	u32 distance;	/**< Distance of the last step, 0 for a literal (aPLib: a 111 step of a 0 byte is 1, 0) */
+	u8 match;	/**< The last step copies from earlier data */
+} Step;
+
+
+static u32 hashAt(const MatchFinder *finder, u32 position) {
+	const u8 *bytes = finder->data + position * finder->unit;
+	u32 hash = 0;
+	for (u8 i = 0; i < 2 * finder->unit; ++i)
+		hash = hash * 251 + bytes[i];
+	return (hash ^ (hash >> 16)) & (HASH_SIZE - 1);
+}
+
+static u32 equalUnits(const MatchFinder *finder, u32 position, u32 from, u32 limit) {
+	const u8 *a = finder->data + position * finder->unit, *b = finder->data + from * finder->unit;
+	u32 bytes = limit * finder->unit, length = 0;
+	while (length < bytes && a[length] == b[length])
+		++length;
+	return length / finder->unit;
+}
+
+static int openMatchFinder(MatchFinder *finder, const u8 *data, u32 units, u8 unit, u32 maxLength, u32 maxDistance) {
+	finder->data = data;
+	finder->units = units;
+	finder->unit = unit;
+	finder->maxLength = maxLength;
+	finder->maxDistance = maxDistance;
+	finder->head = malloc(sizeof(s32) * HASH_SIZE);
+	finder->previous = malloc(sizeof(s32) * (units + 1));
+	if (finder->head == NULL || finder->previous == NULL)
+		return -1;
+	memset(finder->head, 0xFF, sizeof(s32) * HASH_SIZE);
+	return 0;
+}
+
+static void closeMatchFinder(MatchFinder *finder) {
+	free(finder->head);
+	free(finder->previous);
+}
+
+
+/*! Finds the matches at a position, nearest first, each longer than the one before, then adds the position to the chains. */
+static u32 findMatches(MatchFinder *finder, u32 position, Match *matches) {
+	u32 count = 0, best = 1, hash;
+
+	if (position + 2 > finder->units)
+		return 0;
+	hash = hashAt(finder, position);
+	u32 limit = finder->units - position;
+	if (limit > finder->maxLength)
+		limit = finder->maxLength;
+	s32 from = finder->head[hash];
+	for (u32 tries = 0; from >= 0 && tries < CHAIN_LIMIT && position - (u32)from <= finder->maxDistance; ++tries) {
+		u32 length = equalUnits(finder, position, (u32)from, limit);
+		if (length > best) {
+			best = length;
+			if (count == MAX_MATCHES)
+				--count;
+			matches[count].length = length;
+			matches[count++].distance = position - (u32)from;
+			if (length >= GOOD_LENGTH || length == limit)
+				break;
+		}
+		from = finder->previous[from];
+	}
+	finder->previous[position] = finder->head[hash];
+	finder->head[hash] = (s32)position;
+	return count;
+}
+
+static void relax(Step *steps, u32 to, u32 cost, u32 length, u32 distance, u8 match) {
+	if (cost < steps[to].cost) {
+		steps[to].cost = cost;
+		steps[to].length = length;
+		steps[to].distance = distance;
+		steps[to].match = match;
+	}
+}
+
+
+/*! Follows the cheapest steps back from the end, and turns them around: steps[i] is then the step taken at position i. */
+static void reverseSteps(Step *steps, u32 units) {
+	u32 at = units;
+	Step step = steps[at];
+	while (at > 0) {
+		u32 start = at - step.length;
+		Step before = steps[start];
+		steps[start] = step;
+		steps[start].cost = at;	// where it leads
+		at = start;
+		step = before;
+	}
+}
+
+
+/*! Bits of the gamma code of a value. */
+static u32 gammaBits(u32 value) {
+	u32 bits = 0;
+	while (value > 1) {
+		value >>= 1;
+		bits += 2;
+	}
+	return bits;
+}
+
+static u32 aplibAdjust(u32 distance) {
+	if (distance < APLIB_NEAR || distance >= APLIB_FARTHEST)
+		return 2;
+	return (distance >= APLIB_FAR) ? 1 : 0;
+}
+
+
+/*! \brief Structure with the aPLib output: bytes, and the tag byte bits go to. */
+typedef struct {
+	u8 *out;
+	u32 size;
+	u32 tag;
+	u8 bits;	/**< Bits left in the tag byte */
+} AplibWriter;
+
+static void putBit(AplibWriter *writer, u8 bit) {
+	if (writer->bits == 0) {
+		writer->tag = writer->size++;
+		writer->out[writer->tag] = 0;
+		writer->bits = 8;
+	}
+	--writer->bits;
+	if (bit)
+		writer->out[writer->tag] |= (u8)(1 << writer->bits);
+}
+
+static void putGamma(AplibWriter *writer, u32 value) {
+	s8 top = 31;
+	while (!(value >> top))
+		--top;
+	for (s8 bit = top - 1; bit >= 0; --bit) {
+		putBit(writer, (value >> bit) & 1);
+		putBit(writer, bit > 0);
+	}
+}
+
+
+static u32 packAplib(const u8 *data, u32 size, u8 *packed) {
+	MatchFinder finder = { NULL };
+	Match matches[MAX_MATCHES];
+	Step *steps = malloc(sizeof(Step) * (size + 1));
+	AplibWriter writer = { packed, 0, 0, 0 };
+
+	if (steps == NULL || openMatchFinder(&finder, data, size, 1, UINT32_MAX, UINT32_MAX) != 0) {
+		free(steps);
+		closeMatchFinder(&finder);
+		return 0;
+	}
+	for (u32 i = 0; i <= size; ++i)
+		steps[i].cost = UINT32_MAX;
+	steps[0].cost = 0;
+	relax(steps, 1, 8, 1, 0, FALSE); // The first byte is stored as is.
+	findMatches(&finder, 0, matches);
+
+	for (u32 i = 1; i < size; ++i) {
+		u32 cost = steps[i].cost;
+		relax(steps, i + 1, cost + APLIB_LITERAL_BITS, 1, 0, FALSE);
+		for (u32 distance = 1; distance <= 15 && distance <= i; ++distance)
+			if (data[i - distance] == data[i]) {
+				relax(steps, i + 1, cost + APLIB_SHORT_BYTE_BITS, 1, distance, TRUE);
+				break;
+			}
+		if (data[i] == 0)
+			relax(steps, i + 1, cost + APLIB_SHORT_BYTE_BITS, 1, 0, TRUE);
+
+		u32 count = findMatches(&finder, i, matches), shorter = 1;
+		for (u32 m = 0; m < count; ++m) {
+			u32 distance = matches[m].distance;
+			for (u32 length = shorter + 1; length <= matches[m].length; ++length) {
+				if (length > EXACT_LENGTHS && length < matches[m].length)
+					length = matches[m].length;
+				if (length <= 3 && distance < APLIB_NEAR)
+					relax(steps, i + length, cost + APLIB_SHORT_MATCH_BITS, length, distance, TRUE);
+				else if (length >= aplibAdjust(distance) + 2)
+					relax(steps, i + length, cost + 2 + gammaBits((distance >> 8) + 3) + 8
+						+ gammaBits(length - aplibAdjust(distance)), length, distance, TRUE);
+			}
+			shorter = matches[m].length;
+		}
+	}
+	closeMatchFinder(&finder);
+	reverseSteps(steps, size);
+
+	u32 lastDistance = 0;
+	u8 afterMatch = FALSE;
+	packed[writer.size++] = data[0];
+	for (u32 i = 1; i < size; i = steps[i].cost) {
+		const Step *step = &steps[i];
+		if (!step->match) {
+			putBit(&writer, 0);
+			packed[writer.size++] = data[i];
+			afterMatch = FALSE;
+		}
+		else if (step->length == 1) {
+			putBit(&writer, 1);
+			putBit(&writer, 1);
+			putBit(&writer, 1);
+			for (s8 bit = 3; bit >= 0; --bit)
+				putBit(&writer, (step->distance >> bit) & 1);
+			afterMatch = FALSE;
+		}
+		else if (!afterMatch && step->distance == lastDistance) {
+			putBit(&writer, 1);
+			putBit(&writer, 0);
+			putGamma(&writer, 2);
+			putGamma(&writer, step->length);
+			afterMatch = TRUE;
+		}
+		else if (step->length <= 3 && step->distance < APLIB_NEAR) {
+			putBit(&writer, 1);
+			putBit(&writer, 1);
+			putBit(&writer, 0);
+			packed[writer.size++] = (u8)(step->distance << 1 | (step->length - 2));
+			lastDistance = step->distance;
+			afterMatch = TRUE;
+		}
+		else {
+			putBit(&writer, 1);
+			putBit(&writer, 0);
+			putGamma(&writer, (step->distance >> 8) + (afterMatch ? 2 : 3));
+			packed[writer.size++] = (u8)step->distance;
+			putGamma(&writer, step->length - aplibAdjust(step->distance));
+			lastDistance = step->distance;
+			afterMatch = TRUE;
+		}
+	}
+	putBit(&writer, 1);
+	putBit(&writer, 1);
+	putBit(&writer, 0);
+	packed[writer.size++] = 0;
+	free(steps);
+	return writer.size;
+}
+
+
+static u8 *putWord(u8 *out, u16 word) {
+	out[0] = (u8)(word >> 8);
+	out[1] = (u8)word;
+	return out + 2;
+}
+
+/*! Writes literal-only tokens until at most 'keep' of the literals are left, and returns the first one left. */
+static u8 *putLiterals(u8 **out, u8 *literal, u32 *literals, u32 keep) {
+	while (*literals > keep) {
+		u32 count = (*literals < LZ4W_LITERALS) ? *literals : LZ4W_LITERALS;
+		*(*out)++ = (u8)(count << 4);
+		*(*out)++ = 0;
+		memcpy(*out, literal, count * 2);
+		*out += count * 2;
+		literal += count * 2;
+		*literals -= count;
+	}
+	return literal;
+}
+
+
+static u32 packLz4w(const u8 *data, u32 size, u8 *packed) {
+	MatchFinder finder = { NULL };
+	Match matches[MAX_MATCHES];
+	u32 words = size / 2;
+	Step *steps = malloc(sizeof(Step) * (words + 1));
+
+	if (steps == NULL || openMatchFinder(&finder, data, words, 2, LZ4W_LONG_LENGTH, LZ4W_LONG_DISTANCE) != 0) {
+		free(steps);
+		closeMatchFinder(&finder);
+		return 0;
+	}
+	for (u32 i = 0; i <= words; ++i)
+		steps[i].cost = UINT32_MAX;
+	steps[0].cost = 0;
+
+	for (u32 i = 0; i < words; ++i) {
+		u32 cost = steps[i].cost;
+		relax(steps, i + 1, cost + LZ4W_LITERAL_COST, 1, 0, FALSE);
+		u32 count = findMatches(&finder, i, matches), shorter = 1;
+		for (u32 m = 0; m < count; ++m) {
+			u32 distance = matches[m].distance;
+			for (u32 length = shorter + 1; length <= matches[m].length; ++length) {
+				if (length <= LZ4W_SHORT_LENGTH && distance <= LZ4W_SHORT_DISTANCE)
+					relax(steps, i + length, cost + LZ4W_SHORT_COST, length, distance, TRUE);
+				else if (length >= 3)
+					relax(steps, i + length, cost + LZ4W_LONG_COST, length, distance, TRUE);
+			}
+			shorter = matches[m].length;
+		}
+	}
+	closeMatchFinder(&finder);
+	reverseSteps(steps, words);
+
+	u8 *out = packed, *literal = (u8 *)data;
+	u32 literals = 0;
+	for (u32 i = 0; i < words; i = steps[i].cost) {
+		const Step *step = &steps[i];
+		if (!step->match) {
+			if (literals++ == 0)
+				literal = (u8 *)data + i * 2;
+			continue;
+		}
+		literal = putLiterals(&out, literal, &literals, LZ4W_LITERALS);
+		u8 isShort = step->length <= LZ4W_SHORT_LENGTH && step->distance <= LZ4W_SHORT_DISTANCE;
+		*out++ = (u8)(literals << 4 | (isShort ? step->length - 1 : 0));
+		*out++ = (u8)(isShort ? step->distance - 1 : step->length - 2);
+		memcpy(out, literal, literals * 2);
+		out += literals * 2;
+		if (!isShort)
+			out = putWord(out, (u16)((step->distance - 1) * 2));
+		literals = 0;
+	}
+	putLiterals(&out, literal, &literals, 0);
+	out = putWord(out, 0);	// end of the stream
+	out = putWord(out, 0);	// no byte left
+	free(steps);
+	return (u32)(out - packed);
+}
+
+
+u32 packBound(u32 size) {
+	return size + size / 8 + 64;
+}
+
+
+u32 packData(PackMethod method, const u8 *data, u32 size, u8 *packed) {
+	switch (method) {
+	case PackNone:
+		memcpy(packed, data, size);
+		return size;
+	case PackAplib:
+		return (size > 0) ? packAplib(data, size, packed) : 0;
+	case PackLz4w:
+		return (size > 0 && size % 2 == 0) ? packLz4w(data, size, packed) : 0;
+	}
+	return 0;
+}
+
+
+const char *packMethodName(PackMethod method) {
+	static const char *names[PACK_METHODS] = { "NONE", "APLIB", "FAST" };
+	return ((u32)method < PACK_METHODS) ? names[method] : "?";
+}
@@ -0,0 +1,103 @@
+/*!
+\file PlayerBot.c
+\brief Scripted player file
+\date 10/2026
+
+Scripted player used in place of the controller on the host.
+*/
+
+#include "../inc/PlayerBot.h"
+
+#define REACTION_FRAMES 6	/*!< The scripted player sees an attack coming this many frames before it hits. */
+
+
+/*! Starts holding a button down.
+\param *bot The scripted player.
+\param button The button to hold. Neutral releases all buttons.
+\param frames For how many frames the button is held.
+\return void
+*/
+static void holdButton(PlayerBot *bot, Button button, u8 frames) {
+	bot->button = button;
+	bot->heldFrames = frames;
+}
+
+
+void initializePlayerBot(PlayerBot *bot, u32 seed) {
+	seedRandom(&bot->random, seed);
+	holdButton(bot, Neutral, 0);
+}
+
+
+void playerBotInput(PlayerBot *bot, World *world, SimContext *context, ButtonInput *buttonInput) {
+	EntitySlot player = context->currentPlayer;
+	EntitySlot enemy = facedEntity(world, player);
+	u8 enemyMove = (enemy != ENTITY_NONE) ? world->move[enemy].move : Idling;
+
+	// An enemy attack is about to land: parry, guard or ignore it.
+	if (enemyMove >= A1 && enemyMove <= B3 && entityFrames(world, enemy) == (ATTACK_FRAMES - REACTION_FRAMES)) {
+		switch (randomRange(&bot->random, 4))
+		{
+		case 0: case 1:
+			holdButton(bot, Up, 2);
+			break;
+		case 2:
+			holdButton(bot, Down, REACTION_FRAMES + FOLLOWUP_FRAMES);
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Pick the next button once the current one has been held long enough.
+	if (bot->heldFrames == 0) {
+		u8 frames = 1 + randomRange(&bot->random, 24);
+
+		switch (randomRange(&bot->random, 16))
+		{
+		case 0: case 1: case 2: case 3: case 4: case 5: case 6: case 7:
+			holdButton(bot, A, frames);
+			break;
+		case 8: case 9: case 10:
+			holdButton(bot, B, frames);
+			break;
+		case 11:
+			holdButton(bot, C, 1);
+			break;
+		default:
+			holdButton(bot, Neutral, frames);
+			break;
+		}
+	}
+	--bot->heldFrames;
+
+	buttonInput->isPressed = (bot->button != Neutral) ? TRUE : FALSE;
+	if (bot->button != Neutral)
+		buttonInput->latestButtonPress = bot->button;
+}
+
+
+u32 playerBotHeldFrames(const PlayerBot *bot, World *world, SimContext *context, ButtonInput *buttonInput) {
+	EntitySlot enemy = facedEntity(world, context->currentPlayer);
+	u32 frames = bot->heldFrames;
+
+	if (enemy == ENTITY_NONE)
+		return 0;
+	// The enemy's 'frames' counts up to the one the scripted player reacts at.
+	u8 enemyMove = world->move[enemy].move;
+	if (enemyMove >= A1 && enemyMove <= B3 && entityFrames(world, enemy) <= (ATTACK_FRAMES - REACTION_FRAMES)) {
+		u32 reaction = (ATTACK_FRAMES - REACTION_FRAMES) - entityFrames(world, enemy);
+		if (reaction < frames)
+			frames = reaction;
+	}
+
+	buttonInput->isPressed = (bot->button != Neutral) ? TRUE : FALSE;
+	if (bot->button != Neutral)
+		buttonInput->latestButtonPress = bot->button;
+	return frames;
+}
+
+
+void skipPlayerBot(PlayerBot *bot, u32 frames) {
+	bot->heldFrames -= frames;
+}
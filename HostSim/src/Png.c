@@ -0,0 +1,150 @@
+/*!
+\file Png.c
+\brief Indexed PNG reader file
+\date 10/2026
+
+Chunks, zlib inflate of the IDAT data and the five PNG row filters (see Png.h). CRCs are not checked.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+#include "../inc/Png.h"
+
+#define PNG_INDEXED 3	/*!< Colour type of indexed images. */
+
+
+static u32 bigEndian32(const u8 *bytes) {
+	return ((u32)bytes[0] << 24) | ((u32)bytes[1] << 16) | ((u32)bytes[2] << 8) | bytes[3];
+}
+
+static u8 *readFile(const char *path, long *size) {
+	FILE *file = fopen(path, "rb");
+	u8 *contents = NULL;
+
+	if (file == NULL)
+		return NULL;
+	if (fseek(file, 0, SEEK_END) == 0 && (*size = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0) {
+		contents = malloc((size_t)*size);
+		if (contents != NULL && fread(contents, 1, (size_t)*size, file) != (size_t)*size) {
+			free(contents);
+			contents = NULL;
+		}
+	}
+	fclose(file);
+	return contents;
+}
+
+static u8 paeth(u8 left, u8 up, u8 upLeft) {
+	int estimate = left + up - upLeft;
+	int toLeft = abs(estimate - left), toUp = abs(estimate - up), toUpLeft = abs(estimate - upLeft);
+	if (toLeft <= toUp && toLeft <= toUpLeft)
+		return left;
+	return (toUp <= toUpLeft) ? up : upLeft;
+}
+
+
+/*! Undoes the filter of a row in place. 'previous' is the unfiltered row above, or zeros. */
+static int unfilterRow(u8 filter, u8 *row, const u8 *previous, u32 stride, u32 pixelBytes) {
+	for (u32 i = 0; i < stride; ++i) {
+		u8 left = (i >= pixelBytes) ? row[i - pixelBytes] : 0;
+		u8 upLeft = (i >= pixelBytes) ? previous[i - pixelBytes] : 0;
+		switch (filter) {
+		case 0: break;
+		case 1: row[i] += left; break;
+		case 2: row[i] += previous[i]; break;
+		case 3: row[i] += (u8)((left + previous[i]) >> 1); break;
+		case 4: row[i] += paeth(left, previous[i], upLeft); break;
+		default: return -1;
+		}
+	}
+	return 0;
+}
+
+
+int loadIndexedPng(IndexedImage *image, const char *path) {
+	long size = 0;
+	u8 *file = readFile(path, &size), *data = NULL, *raw = NULL;
+	u32 dataSize = 0, bitDepth = 0;
+	int result = -1;
+
+	memset(image, 0, sizeof(IndexedImage));
+	if (file == NULL)
+		return -1;
+	if (size < 8 || memcmp(file, "\211PNG\r\n\032\n", 8) != 0)
+		goto done;
+	data = malloc((size_t)size);
+	if (data == NULL)
+		goto done;
+
+	for (long at = 8; at + 12 <= size; ) {
+		u32 length = bigEndian32(file + at);
+		const u8 *type = file + at + 4, *body = file + at + 8;
+		if (length > (u32)(size - at - 12))
+			goto done;
+		if (memcmp(type, "IHDR", 4) == 0 && length >= 13) {
+			image->width = bigEndian32(body);
+			image->height = bigEndian32(body + 4);
+			bitDepth = body[8];
+			if (body[9] != PNG_INDEXED || (bitDepth != 1 && bitDepth != 2 && bitDepth != 4 && bitDepth != 8) || body[12] != 0)
+				goto done;
+		}
+		else if (memcmp(type, "PLTE", 4) == 0) {
+			image->colors = (u16)((length / 3 < PNG_MAX_COLORS) ? length / 3 : PNG_MAX_COLORS);
+			memcpy(image->palette, body, image->colors * 3u);
+		}
+		else if (memcmp(type, "IDAT", 4) == 0) {
+			memcpy(data + dataSize, body, length);
+			dataSize += length;
+		}
+		else if (memcmp(type, "IEND", 4) == 0)
+			break;
+		at += 12 + (long)length;
+	}
+	if (image->width == 0 || image->height == 0 || image->colors == 0)
+		goto done;
+
+	// Every row: its filter byte, then its packed pixels, most significant bits first.
+	u32 stride = (image->width * bitDepth + 7) / 8;
+	uLongf rawSize = (uLongf)(stride + 1) * image->height;
+	raw = malloc(rawSize);
+	image->pixels = malloc((size_t)image->width * image->height);
+	if (raw == NULL || image->pixels == NULL || uncompress(raw, &rawSize, data, dataSize) != Z_OK
+		|| rawSize != (uLongf)(stride + 1) * image->height)
+		goto done;
+
+	u8 *previous = calloc(stride, 1);
+	if (previous == NULL)
+		goto done;
+	for (u32 y = 0; y < image->height; ++y) {
+		u8 *row = raw + (size_t)y * (stride + 1);
+		if (unfilterRow(row[0], row + 1, previous, stride, 1) != 0) {
+			free(previous);
+			goto done;
+		}
+		for (u32 x = 0; x < image->width; ++x) {
+			u32 bit = x * bitDepth;
+			u8 byte = row[1 + bit / 8];
+			image->pixels[(size_t)y * image->width + x] = (u8)((byte >> (8 - bitDepth - bit % 8)) & ((1u << bitDepth) - 1));
+		}
+		memcpy(previous, row + 1, stride);
+	}
+	free(previous);
+	result = 0;
+
+done:
+	free(file);
+	free(data);
+	free(raw);
+	if (result != 0)
+		freeIndexedImage(image);
+	return result;
+}
+
+
+void freeIndexedImage(IndexedImage *image) {
+	free(image->pixels);
+	image->pixels = NULL;
+}
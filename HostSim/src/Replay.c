@@ -0,0 +1,345 @@
+/*!
+\file Replay.c
+\brief Match replay file
+\date 10/2026
+
+Records, plays back and archives matches (see Replay.h for the formats).
+*/
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../inc/Replay.h"
+
+#define MAX_RUN_BYTES 6	/*!< Input byte and a u32 as LEB128. */
+
+
+static void writeLittleEndian(u8 *bytes, uint64_t value, u8 size) {
+	for (u8 i = 0; i < size; ++i)
+		bytes[i] = (u8)(value >> (8 * i));
+}
+
+static uint64_t readLittleEndian(const u8 *bytes, u8 size) {
+	uint64_t value = 0;
+	for (u8 i = 0; i < size; ++i)
+		value |= (uint64_t)bytes[i] << (8 * i);
+	return value;
+}
+
+static u8 inputByte(const ButtonInput *buttonInput) {
+	return (u8)((buttonInput->isPressed ? 0x80 : 0) | (buttonInput->latestButtonPress & 0x7F));
+}
+
+
+/*! Makes room for extra more bytes. */
+static int reserveReplay(ReplayWriter *replay, u32 extra) {
+	if (replay->size + extra <= replay->capacity)
+		return 0;
+	u32 capacity = replay->capacity ? replay->capacity * 2 : 256;
+	while (capacity < replay->size + extra)
+		capacity *= 2;
+	u8 *data = realloc(replay->data, capacity);
+	if (data == NULL)
+		return -1;
+	replay->data = data;
+	replay->capacity = capacity;
+	return 0;
+}
+
+static int writeRun(ReplayWriter *replay) {
+	u32 length = replay->runLength;
+
+	if (length == 0)
+		return 0;
+	if (reserveReplay(replay, MAX_RUN_BYTES) != 0)
+		return -1;
+	replay->data[replay->size++] = replay->runInput;
+	while (length >= 0x80) {
+		replay->data[replay->size++] = (u8)(length | 0x80);
+		length >>= 7;
+	}
+	replay->data[replay->size++] = (u8)length;
+	return 0;
+}
+
+
+void beginReplay(ReplayWriter *replay, u8 numAllies, u16 difficulty, u32 seed) {
+	replay->info.numAllies = numAllies;
+	replay->info.difficulty = difficulty;
+	replay->info.seed = seed;
+	replay->info.frames = 0;
+	replay->info.outcome = MatchPlaying;
+	replay->info.hash = 0;
+	replay->size = REPLAY_HEADER_SIZE;
+	replay->runLength = 0;
+}
+
+
+int recordReplayFrame(ReplayWriter *replay, const ButtonInput *buttonInput) {
+	u8 input = inputByte(buttonInput);
+
+	if (replay->runLength == 0 || input != replay->runInput || replay->runLength == 0xFFFFFFFF) {
+		if (writeRun(replay) != 0)
+			return -1;
+		replay->runInput = input;
+		replay->runLength = 0;
+	}
+	++replay->runLength;
+	++replay->info.frames;
+	return 0;
+}
+
+
+int endReplay(ReplayWriter *replay, MatchOutcome outcome, WorldHash hash) {
+	if (reserveReplay(replay, 0) != 0 || writeRun(replay) != 0)
+		return -1;
+	replay->runLength = 0;
+	replay->info.outcome = outcome;
+	replay->info.hash = hash;
+
+	memcpy(replay->data, "GRPL", 4);
+	replay->data[4] = REPLAY_VERSION;
+	replay->data[5] = replay->info.numAllies;
+	writeLittleEndian(replay->data + 6, replay->info.difficulty, 2);
+	writeLittleEndian(replay->data + 8, replay->info.seed, 4);
+	writeLittleEndian(replay->data + 12, replay->info.frames, 4);
+	replay->data[16] = (u8)outcome;
+	writeLittleEndian(replay->data + 17, hash, 8);
+	return 0;
+}
+
+
+void freeReplayWriter(ReplayWriter *replay) {
+	free(replay->data);
+	memset(replay, 0, sizeof(ReplayWriter));
+}
+
+
+MatchResult recordMatch(const MatchSetup *setup, ReplayWriter *replay) {
+	World world;
+	SimContext context;
+	PlayerBot bot;
+	ButtonInput buttonInput = { FALSE, Neutral };
+	MatchResult result;
+	u32 seed = matchSeed(setup->seed, MATCH_WORLD_STREAM);
+
+	memset(&world, 0, sizeof(World));
+	initializeMatch(&world, &context, setup->numAllies, seed);
+	initializePlayerBot(&bot, setup->seed);
+	beginReplay(replay, setup->numAllies, setup->difficulty, seed);
+
+	for (result.frames = 1; result.frames <= MATCH_FRAME_LIMIT; ++result.frames) {
+		context.difficultyAIaccumulator += setup->difficulty;
+		playerBotInput(&bot, &world, &context, &buttonInput);
+		if (recordReplayFrame(replay, &buttonInput) != 0) {
+			result.outcome = MatchTimedOut;
+			result.hash = 0;
+			return result;
+		}
+		updateWorld(&world, &context, &buttonInput);
+
+		result.outcome = matchOutcome(&world, &context);
+		if (result.outcome != MatchPlaying)
+			break;
+	}
+
+	if (result.outcome == MatchPlaying) {
+		result.frames = MATCH_FRAME_LIMIT;
+		result.outcome = MatchTimedOut;
+	}
+	result.hash = simulationHash(&world, &context);
+	if (endReplay(replay, result.outcome, result.hash) != 0)
+		result.outcome = MatchTimedOut;
+	return result;
+}
+
+
+int openReplay(ReplayReader *replay, const u8 *data, size_t size) {
+	if (size < REPLAY_HEADER_SIZE || memcmp(data, "GRPL", 4) != 0 || data[4] != REPLAY_VERSION)
+		return -1;
+	replay->info.numAllies = data[5];
+	replay->info.difficulty = (u16)readLittleEndian(data + 6, 2);
+	replay->info.seed = (u32)readLittleEndian(data + 8, 4);
+	replay->info.frames = (u32)readLittleEndian(data + 12, 4);
+	replay->info.outcome = (MatchOutcome)data[16];
+	replay->info.hash = readLittleEndian(data + 17, 8);
+	if (replay->info.numAllies < 1 || replay->info.numAllies > MAX_ALLIES || replay->info.outcome > MatchTimedOut)
+		return -1;
+	replay->next = data + REPLAY_HEADER_SIZE;
+	replay->end = data + size;
+	replay->input.isPressed = FALSE;
+	replay->input.latestButtonPress = Neutral;
+	replay->runLeft = 0;
+	replay->frame = 0;
+	return 0;
+}
+
+
+u8 nextReplayFrame(ReplayReader *replay, ButtonInput *buttonInput) {
+	while (replay->runLeft == 0) {
+		u32 length = 0;
+		u8 byte, shift = 0;
+
+		if (replay->next >= replay->end)
+			return FALSE;
+		byte = *replay->next++;
+		replay->input.isPressed = (byte & 0x80) ? TRUE : FALSE;
+		replay->input.latestButtonPress = (Button)(byte & 0x7F);
+		do {
+			if (replay->next >= replay->end || shift > 28) { // Cut short or corrupt
+				replay->next = replay->end;
+				return FALSE;
+			}
+			byte = *replay->next++;
+			length |= (u32)(byte & 0x7F) << shift;
+			shift += 7;
+		} while (byte & 0x80);
+		replay->runLeft = length;
+	}
+	--replay->runLeft;
+	++replay->frame;
+	*buttonInput = replay->input;
+	return TRUE;
+}
+
+
+MatchResult playReplay(ReplayReader *replay, World *world, SimContext *context) {
+	ButtonInput buttonInput;
+	MatchResult result = { MatchPlaying, 0, 0 };
+
+	memset(world, 0, sizeof(World));
+	initializeMatch(world, context, replay->info.numAllies, replay->info.seed);
+
+	while (nextReplayFrame(replay, &buttonInput)) {
+		context->difficultyAIaccumulator += replay->info.difficulty;
+		updateWorld(world, context, &buttonInput);
+		++result.frames;
+
+		result.outcome = matchOutcome(world, context);
+		if (result.outcome != MatchPlaying)
+			break;
+	}
+	if (result.outcome == MatchPlaying && result.frames >= MATCH_FRAME_LIMIT)
+		result.outcome = MatchTimedOut;
+	result.hash = simulationHash(world, context);
+	return result;
+}
+
+
+int createReplayArchive(ReplayArchiveWriter *archive, const char *path) {
+	u8 header[REPLAY_ARCHIVE_HEADER_SIZE];
+
+	memset(archive, 0, sizeof(ReplayArchiveWriter));
+	archive->file = fopen(path, "wb");
+	if (archive->file == NULL)
+		return -1;
+	memset(header, 0, sizeof(header)); // Written for real by finishReplayArchive.
+	if (fwrite(header, 1, sizeof(header), archive->file) != sizeof(header)) {
+		fclose(archive->file);
+		archive->file = NULL;
+		return -1;
+	}
+	archive->position = REPLAY_ARCHIVE_HEADER_SIZE;
+	return 0;
+}
+
+
+int addArchiveReplay(ReplayArchiveWriter *archive, const u8 *data, u32 size) {
+	if (archive->count + 1 >= archive->capacity) { // One more for the index offset
+		u32 capacity = archive->capacity ? archive->capacity * 2 : 1024;
+		uint64_t *offsets = realloc(archive->offsets, capacity * sizeof(uint64_t));
+		if (offsets == NULL)
+			return -1;
+		archive->offsets = offsets;
+		archive->capacity = capacity;
+	}
+	if (fwrite(data, 1, size, archive->file) != size)
+		return -1;
+	archive->offsets[archive->count++] = archive->position;
+	archive->position += size;
+	return 0;
+}
+
+
+int finishReplayArchive(ReplayArchiveWriter *archive) {
+	u8 bytes[REPLAY_ARCHIVE_HEADER_SIZE];
+	int result = 0;
+
+	if (archive->offsets == NULL && (archive->offsets = malloc(sizeof(uint64_t))) == NULL)
+		result = -1;
+	else {
+		archive->offsets[archive->count] = archive->position;
+		for (u32 i = 0; i <= archive->count && result == 0; ++i) {
+			writeLittleEndian(bytes, archive->offsets[i], 8);
+			if (fwrite(bytes, 1, 8, archive->file) != 8)
+				result = -1;
+		}
+	}
+
+	memset(bytes, 0, sizeof(bytes));
+	memcpy(bytes, "GRPA", 4);
+	writeLittleEndian(bytes + 4, REPLAY_ARCHIVE_VERSION, 4);
+	writeLittleEndian(bytes + 8, archive->count, 4);
+	writeLittleEndian(bytes + 16, archive->position, 8);
+	if (result != 0 || fseek(archive->file, 0, SEEK_SET) != 0 || fwrite(bytes, 1, sizeof(bytes), archive->file) != sizeof(bytes))
+		result = -1;
+	if (fclose(archive->file) != 0)
+		result = -1;
+	free(archive->offsets);
+	memset(archive, 0, sizeof(ReplayArchiveWriter));
+	return result;
+}
+
+
+int openReplayArchive(ReplayArchive *archive, const char *path) {
+	struct stat status;
+	int file = open(path, O_RDONLY);
+	void *map;
+
+	memset(archive, 0, sizeof(ReplayArchive));
+	if (file < 0)
+		return -1;
+	if (fstat(file, &status) != 0 || status.st_size < REPLAY_ARCHIVE_HEADER_SIZE) {
+		close(file);
+		return -1;
+	}
+	map = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file); // The mapping keeps the file open.
+	if (map == MAP_FAILED)
+		return -1;
+	archive->map = map;
+	archive->size = (size_t)status.st_size;
+
+	uint64_t indexOffset = readLittleEndian(archive->map + 16, 8);
+	archive->count = (u32)readLittleEndian(archive->map + 8, 4);
+	if (memcmp(archive->map, "GRPA", 4) != 0 || readLittleEndian(archive->map + 4, 4) != REPLAY_ARCHIVE_VERSION
+		|| indexOffset < REPLAY_ARCHIVE_HEADER_SIZE || indexOffset > archive->size
+		|| (archive->size - indexOffset) / 8 < (uint64_t)archive->count + 1) {
+		closeReplayArchive(archive);
+		return -1;
+	}
+	archive->index = archive->map + indexOffset;
+	return 0;
+}
+
+
+int openArchivedReplay(const ReplayArchive *archive, u32 index, ReplayReader *replay) {
+	if (index >= archive->count)
+		return -1;
+	uint64_t begin = readLittleEndian(archive->index + 8 * (size_t)index, 8);
+	uint64_t end = readLittleEndian(archive->index + 8 * ((size_t)index + 1), 8);
+	if (begin < REPLAY_ARCHIVE_HEADER_SIZE || begin > end || end > (uint64_t)(archive->index - archive->map))
+		return -1;
+	return openReplay(replay, archive->map + begin, (size_t)(end - begin));
+}
+
+
+void closeReplayArchive(ReplayArchive *archive) {
+	if (archive->map != NULL)
+		munmap((void *)archive->map, archive->size);
+	memset(archive, 0, sizeof(ReplayArchive));
+}
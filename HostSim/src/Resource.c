@@ -0,0 +1,568 @@
+/*!
+\file Resource.c
+\brief rescomp resource file
+\date 10/2026
+
+.res files, and the assembly rescomp 1.5 writes for each resource (see Resource.h).
+*/
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../inc/Resource.h"
+#include "../inc/Png.h"
+#include "../inc/TileImage.h"
+#include "../inc/SpriteSheet.h"
+#include "../inc/Wav.h"
+#include "../inc/Pack.h"
+
+#define MAX_LINE 2048	/*!< Longest line of a .res file. */
+#define MAX_WORDS 8	/*!< Most words of a line. */
+#define SOUND_ALIGNMENT 256	/*!< Alignment and size multiple of samples and music: the Z80 reads them 256 bytes at a time. */
+#define PALETTE_BYTES (TILE_PALETTE_COLORS * 2)
+#define FLIPS 4	/*!< Sprites of a frame are written as is, flipped horizontally, vertically and both. */
+
+static const char *flipSuffixes[FLIPS] = { "", "_h", "_v", "_hv" };
+
+
+static int fail(const Resource *resource, const char *message) {
+	fprintf(stderr, "%s: %s (%s)\n", resource->name, message, resource->path);
+	return -1;
+}
+
+
+int parseCompression(const char *text) {
+	static const char *names[] = { "-1", "BEST", "AUTO", "0", "NONE", "1", "APLIB", "2", "FAST", "LZ4W" };
+	static const s8 values[] = { COMPRESSION_BEST, COMPRESSION_BEST, COMPRESSION_BEST, PackNone, PackNone, PackAplib, PackAplib, PackLz4w, PackLz4w, PackLz4w };
+	for (u32 i = 0; i < sizeof(values); ++i) {
+		const char *a = names[i], *b = text;
+		while (*a != '\0' && toupper((unsigned char)*b) == *a)
+			++a, ++b;
+		if (*a == '\0' && *b == '\0')
+			return values[i];
+	}
+	return -2;
+}
+
+
+/*! Splits a line into words; a word in quotes may hold spaces. Returns the number of words. */
+static u32 splitLine(char *line, char *words[], u32 most) {
+	u32 count = 0;
+	while (count < most) {
+		while (isspace((unsigned char)*line))
+			++line;
+		if (*line == '\0')
+			break;
+		if (*line == '"') {
+			words[count++] = ++line;
+			while (*line != '\0' && *line != '"')
+				++line;
+		}
+		else {
+			words[count++] = line;
+			while (*line != '\0' && !isspace((unsigned char)*line))
+				++line;
+		}
+		if (*line != '\0')
+			*line++ = '\0';
+	}
+	return count;
+}
+
+
+/*! Reads the columns of a line after the name and file. Returns a message if they are wrong, NULL if not. */
+static const char *readColumns(Resource *resource, char *words[], u32 count) {
+	int compression = PackNone;
+
+	switch (resource->type) {
+	case ResourceImage:
+		if (count > 4)
+			return "IMAGE lines are: IMAGE name file [compression]";
+		if (count > 3)
+			compression = parseCompression(words[3]);
+		break;
+	case ResourceSprite:
+		if (count < 5 || count > 8)
+			return "SPRITE lines are: SPRITE name file width height [compression [time [collision]]]";
+		resource->width = (u16)strtoul(words[3], NULL, 10);
+		resource->height = (u16)strtoul(words[4], NULL, 10);
+		if (resource->width == 0 || resource->height == 0 || resource->width > 32 || resource->height > 32)
+			return "sprite frames are 1 to 32 tiles wide and high";
+		if (count > 5)
+			compression = parseCompression(words[5]);
+		resource->time = (count > 6) ? (u16)strtoul(words[6], NULL, 10) : 0;
+		if (count > 7 && strcmp(words[7], "NONE") != 0)
+			return "sprite collision boxes are not supported: NONE only";
+		break;
+	case ResourceWav:
+		if (count < 4 || count > 5)
+			return "WAV lines are: WAV name file driver [rate]";
+		if (strcmp(words[3], "XGM") != 0)
+			return "only the XGM driver is supported";
+		break;
+	case ResourceXgm:
+		if (count != 3)
+			return "XGM lines are: XGM name file";
+		break;
+	case ResourceSpriteDelta:
+		if (count < 5 || count > 6)
+			return "SPRITE_DELTA lines are: SPRITE_DELTA name file width height [gap]";
+		resource->width = (u16)strtoul(words[3], NULL, 10);
+		resource->height = (u16)strtoul(words[4], NULL, 10);
+		if (resource->width == 0 || resource->height == 0 || resource->width > 32 || resource->height > 32)
+			return "sprite frames are 1 to 32 tiles wide and high";
+		resource->gap = (count > 5) ? (u16)strtoul(words[5], NULL, 10) : SPRITE_DELTA_GAP;
+		break;
+	}
+	if (compression == -2)
+		return "unknown compression";
+	resource->compression = (s8)compression;
+	return NULL;
+}
+
+
+int readResourceFile(Resource **resources, u32 *count, const char *path) {
+	static const char *types[] = { "IMAGE", "SPRITE", "WAV", "XGM", "SPRITE_DELTA" };
+	char line[MAX_LINE], directory[RESOURCE_PATH];
+	FILE *file = fopen(path, "r");
+	u32 capacity = 0, number = 0;
+	u16 group = 0;
+	u8 inGroup = FALSE;
+
+	*resources = NULL;
+	*count = 0;
+	if (file == NULL) {
+		fprintf(stderr, "cannot read %s\n", path);
+		return -1;
+	}
+	snprintf(directory, sizeof(directory), "%s", path);
+	char *slash = strrchr(directory, '/');
+	*(slash != NULL ? slash + 1 : directory) = '\0';
+
+	while (fgets(line, sizeof(line), file) != NULL) {
+		char *words[MAX_WORDS];
+		u32 columns = splitLine(line, words, MAX_WORDS);
+		++number;
+		if (columns == 0) {
+			group += inGroup;
+			inGroup = FALSE;
+			continue;
+		}
+		if (strncmp(words[0], "//", 2) == 0)
+			continue;
+
+		Resource resource;
+		const char *error = NULL;
+		memset(&resource, 0, sizeof(resource));
+		resource.type = (ResourceType)(sizeof(types) / sizeof(types[0]));
+		for (u32 t = 0; t < sizeof(types) / sizeof(types[0]); ++t)
+			if (strcmp(words[0], types[t]) == 0)
+				resource.type = (ResourceType)t;
+		if (resource.type == (ResourceType)(sizeof(types) / sizeof(types[0])))
+			error = "unsupported resource type";
+		else if (columns < 3)
+			error = "a resource has a type, a name and a file";
+		else if (strlen(words[1]) >= sizeof(resource.name) || strlen(directory) + strlen(words[2]) >= sizeof(resource.path))
+			error = "name or file too long";
+		else {
+			snprintf(resource.name, sizeof(resource.name), "%s", words[1]);
+			snprintf(resource.path, sizeof(resource.path), "%s%s", (words[2][0] != '/') ? directory : "", words[2]);
+			error = readColumns(&resource, words, columns);
+		}
+		if (error != NULL) {
+			fprintf(stderr, "%s:%u: %s\n", path, number, error);
+			fclose(file);
+			free(*resources);
+			*resources = NULL;
+			*count = 0;
+			return -1;
+		}
+
+		if (*count == capacity) {
+			capacity = (capacity == 0) ? 16 : capacity * 2;
+			Resource *grown = realloc(*resources, sizeof(Resource) * capacity);
+			if (grown == NULL) {
+				fclose(file);
+				free(*resources);
+				*resources = NULL;
+				*count = 0;
+				return -1;
+			}
+			*resources = grown;
+		}
+		resource.group = group;
+		resource.line = number;
+		(*resources)[(*count)++] = resource;
+		inGroup = TRUE;
+	}
+	fclose(file);
+	return 0;
+}
+
+
+void resourceHeaderGuard(char *guard, size_t size, const char *assemblyPath) {
+	const char *base = strrchr(assemblyPath, '/');
+	base = (base != NULL) ? base + 1 : assemblyPath;
+	size_t length = 0;
+	for (; base[length] != '\0' && base[length] != '.' && length + 1 < size; ++length)
+		guard[length] = (char)toupper((unsigned char)base[length]);
+	guard[length] = '\0';
+}
+
+
+void writeAssemblyLabel(FILE *out, const char *name, const char *suffix) {
+	fprintf(out, "    .align 2\n%s%s:\n", name, suffix);
+}
+
+void writeAssemblyWords(FILE *out, const u8 *bytes, u32 size) {
+	for (u32 i = 0; i < size / 2; ++i)
+		fprintf(out, "%s0x%04X%s", (i % 8 == 0) ? "    dc.w    " : "", (bytes[2 * i] << 8) | bytes[2 * i + 1],
+			(i % 8 == 7 || i == size / 2 - 1) ? "\n" : ", ");
+}
+
+void writeAssemblyBytes(FILE *out, const u8 *bytes, u32 size) {
+	for (u32 i = 0; i < size; ++i)
+		fprintf(out, "%s0x%02X%s", (i % 16 == 0) ? "    dc.b    " : "", bytes[i], (i % 16 == 15 || i == size - 1) ? "\n" : ", ");
+}
+
+
+/*! Writes data under a label, packed with a compression (the smallest way for COMPRESSION_BEST). Returns the method. */
+static PackMethod writePacked(FILE *out, const char *name, const char *suffix, const u8 *data, u32 size, s8 compression) {
+	PackMethod method = PackNone;
+	u32 packedSize = size;
+	u8 *packed = malloc(packBound(size)), *best = malloc(packBound(size));
+
+	for (u8 m = PackAplib; m < PACK_METHODS && packed != NULL && best != NULL; ++m) {
+		if (compression != COMPRESSION_BEST && compression != m)
+			continue;
+		u32 bytes = packData((PackMethod)m, data, size, packed);
+		if (bytes != 0 && (bytes < packedSize || compression != COMPRESSION_BEST)) {
+			u8 *swap = best;
+			best = packed;
+			packed = swap;
+			method = (PackMethod)m;
+			packedSize = bytes;
+		}
+	}
+	writeAssemblyLabel(out, name, suffix);
+	if (method == PackNone)
+		writeAssemblyWords(out, data, size);
+	else
+		writeAssemblyBytes(out, best, packedSize);
+	fprintf(out, "\n");
+	free(packed);
+	free(best);
+	return method;
+}
+
+
+static void writePalette(FILE *out, const char *name, const u16 palette[TILE_PALETTE_COLORS]) {
+	u8 bytes[PALETTE_BYTES];
+	for (u8 color = 0; color < TILE_PALETTE_COLORS; ++color) {
+		bytes[2 * color] = (u8)(palette[color] >> 8);
+		bytes[2 * color + 1] = (u8)palette[color];
+	}
+	writeAssemblyLabel(out, name, "_palette_pal");
+	writeAssemblyWords(out, bytes, PALETTE_BYTES);
+	fprintf(out, "\n");
+	writeAssemblyLabel(out, name, "_palette");
+	fprintf(out, "    dc.w    0, %u\n    dc.l    %s_palette_pal\n\n", TILE_PALETTE_COLORS, name);
+}
+
+
+/*! Image: palette, tilemap, tileset. */
+static int writeImage(FILE *out, char *declaration, const Resource *resource) {
+	IndexedImage indexed;
+	TileImage image;
+	const char *name = resource->name;
+
+	if (loadIndexedPng(&indexed, resource->path) != 0)
+		return fail(resource, "cannot read the indexed PNG file");
+	int converted = convertTileImage(&image, &indexed);
+	freeIndexedImage(&indexed);
+	if (converted != 0)
+		return fail(resource, "size not a multiple of 8 pixels, or more than 2048 tiles");
+
+	u32 mapSize = (u32)image.width * image.height * 2u, tilesSize = (u32)image.tileCount * TILE_BYTES;
+	u8 *bytes = malloc((mapSize > tilesSize) ? mapSize : tilesSize);
+	if (bytes == NULL) {
+		freeTileImage(&image);
+		return fail(resource, "out of memory");
+	}
+	writePalette(out, name, image.palette);
+	for (u32 entry = 0; entry < mapSize / 2; ++entry) {
+		bytes[2 * entry] = (u8)(image.map[entry] >> 8);
+		bytes[2 * entry + 1] = (u8)image.map[entry];
+	}
+	PackMethod method = writePacked(out, name, "_tilemap_map", bytes, mapSize, resource->compression);
+	writeAssemblyLabel(out, name, "_tilemap");
+	fprintf(out, "    dc.w    %u\n    dc.w    %u, %u\n    dc.l    %s_tilemap_map\n\n", method, image.width, image.height, name);
+	writeTileBytes(bytes, image.tiles, image.tileCount);
+	method = writePacked(out, name, "_tileset_tiles", bytes, tilesSize, resource->compression);
+	writeAssemblyLabel(out, name, "_tileset");
+	fprintf(out, "    dc.w    %u\n    dc.w    %u\n    dc.l    %s_tileset_tiles\n\n", method, image.tileCount, name);
+	fprintf(out, "    .align 2\n    .global %s\n%s:\n", name, name);
+	fprintf(out, "    dc.l    %s_palette\n    dc.l    %s_tileset\n    dc.l    %s_tilemap\n\n", name, name, name);
+	snprintf(declaration, RESOURCE_DECLARATION, "extern const Image %s;", name);
+	free(bytes);
+	freeTileImage(&image);
+	return 0;
+}
+
+
+/*! Sprite: palette, then for every animation its frames (sprites in every flip, tileset), then the definition. */
+static int writeSprite(FILE *out, char *declaration, const Resource *resource) {
+	IndexedImage indexed;
+	SpriteSheet sheet;
+	char label[RESOURCE_NAME + 64];
+	const char *name = resource->name;
+
+	if (loadIndexedPng(&indexed, resource->path) != 0)
+		return fail(resource, "cannot read the indexed PNG file");
+	int converted = convertSpriteSheet(&sheet, &indexed, resource->width, resource->height);
+	freeIndexedImage(&indexed);
+	if (converted != 0)
+		return fail(resource, "size not a multiple of the frame size");
+	u8 *bytes = malloc((size_t)sheet.tileCount * TILE_BYTES);
+	if (bytes == NULL) {
+		freeSpriteSheet(&sheet);
+		return fail(resource, "out of memory");
+	}
+
+	writePalette(out, name, sheet.palette);
+	for (u16 a = 0; a < sheet.animationCount; ++a) {
+		const SpriteAnimation *animation = &sheet.animations[a];
+		for (u16 f = 0; f < animation->frameCount; ++f) {
+			snprintf(label, sizeof(label), "%s_animation%u_frame%u", name, a, f);
+			// VDPSpriteInf: y, size, x, tiles. Flipped, a sprite moves to the other side of the frame.
+			for (u16 s = 0; s < sheet.spriteCount; ++s) {
+				const HardwareSprite *sprite = &sheet.sprites[s];
+				for (u8 flip = 0; flip < FLIPS; ++flip) {
+					u16 x = (flip & 1) ? (u16)(sheet.width * TILE_SIZE - sprite->x - sprite->width * TILE_SIZE) : sprite->x;
+					u16 y = (flip & 2) ? (u16)(sheet.height * TILE_SIZE - sprite->y - sprite->height * TILE_SIZE) : sprite->y;
+					fprintf(out, "    .align 2\n%s_sprite%u%s:\n", label, s, flipSuffixes[flip]);
+					fprintf(out, "    dc.w    %u, %u, %u, %u\n\n", y, ((sprite->width - 1) << 2) | (sprite->height - 1), x,
+						sprite->width * sprite->height);
+				}
+			}
+			writeAssemblyLabel(out, label, "_sprites");
+			for (u8 flip = 0; flip < FLIPS; ++flip)
+				for (u16 s = 0; s < sheet.spriteCount; ++s)
+					fprintf(out, "    dc.l    %s_sprite%u%s\n", label, s, flipSuffixes[flip]);
+			fprintf(out, "\n");
+			writeTileBytes(bytes, animation->frames[f].tiles, sheet.tileCount);
+			PackMethod method = writePacked(out, label, "_tileset_tiles", bytes, (u32)sheet.tileCount * TILE_BYTES, resource->compression);
+			writeAssemblyLabel(out, label, "_tileset");
+			fprintf(out, "    dc.w    %u\n    dc.w    %u\n    dc.l    %s_tileset_tiles\n\n", method, sheet.tileCount, label);
+			writeAssemblyLabel(out, label, "");
+			fprintf(out, "    dc.w    %u\n    dc.l    %s_sprites\n    dc.l    0\n    dc.l    %s_tileset\n", sheet.spriteCount, label, label);
+			fprintf(out, "    dc.w    %u, %u, %u\n\n", sheet.width * TILE_SIZE, sheet.height * TILE_SIZE, resource->time);
+		}
+
+		// Frames, then the sequence: every frame in turn, to an even number of bytes as rescomp writes it.
+		snprintf(label, sizeof(label), "%s_animation%u", name, a);
+		writeAssemblyLabel(out, label, "_frames");
+		for (u16 f = 0; f < animation->frameCount; ++f)
+			fprintf(out, "    dc.l    %s_frame%u\n", label, f);
+		fprintf(out, "\n");
+		writeAssemblyLabel(out, label, "_sequence");
+		for (u16 f = 0; f < animation->frameCount; f += 2)
+			fprintf(out, "    dc.w    0x%02X%02X\n", f & 0xFF, (f + 1) & 0xFF);
+		fprintf(out, "\n");
+		writeAssemblyLabel(out, label, "");
+		fprintf(out, "    dc.w    %u\n    dc.l    %s_frames\n    dc.w    %u\n    dc.l    %s_sequence\n    dc.w    0\n\n",
+			animation->frameCount, label, animation->frameCount, label);
+	}
+
+	writeAssemblyLabel(out, name, "_animations");
+	for (u16 a = 0; a < sheet.animationCount; ++a)
+		fprintf(out, "    dc.l    %s_animation%u\n", name, a);
+	fprintf(out, "\n    .align 2\n    .global %s\n%s:\n", name, name);
+	fprintf(out, "    dc.l    %s_palette\n    dc.w    %u\n    dc.l    %s_animations\n    dc.w    %u, %u\n\n",
+		name, sheet.animationCount, name, sheet.tileCount, sheet.spriteCount);
+	snprintf(declaration, RESOURCE_DECLARATION, "extern const SpriteDefinition %s;", name);
+	free(bytes);
+	freeSpriteSheet(&sheet);
+	return 0;
+}
+
+
+/*! Sprite deltas: for every animation, the runs of every frame, then its FrameDelta array; then the SpriteDelta. */
+static int writeSpriteDelta(FILE *out, char *declaration, const Resource *resource) {
+	IndexedImage indexed;
+	SpriteSheet sheet;
+	char label[RESOURCE_NAME + 64];
+	const char *name = resource->name;
+
+	if (loadIndexedPng(&indexed, resource->path) != 0)
+		return fail(resource, "cannot read the indexed PNG file");
+	int converted = convertSpriteSheet(&sheet, &indexed, resource->width, resource->height);
+	freeIndexedImage(&indexed);
+	if (converted != 0)
+		return fail(resource, "size not a multiple of the frame size");
+	u16 frames = 1;
+	for (u16 a = 0; a < sheet.animationCount; ++a)
+		if (sheet.animations[a].frameCount > frames)
+			frames = sheet.animations[a].frameCount;
+	u16 (*runs)[2] = malloc(sizeof(runs[0]) * (sheet.tileCount / 2u + 1u) * frames);
+	u16 *runCounts = malloc(sizeof(u16) * frames);
+	if (runs == NULL || runCounts == NULL) {
+		free(runs);
+		free(runCounts);
+		freeSpriteSheet(&sheet);
+		return fail(resource, "out of memory");
+	}
+
+	for (u16 a = 0; a < sheet.animationCount; ++a) {
+		const SpriteAnimation *animation = &sheet.animations[a];
+		for (u16 f = 0; f < animation->frameCount; ++f) {
+			u16 (*frameRuns)[2] = runs + (sheet.tileCount / 2u + 1u) * f;
+			const SpriteFrame *previous = &animation->frames[(f == 0) ? animation->frameCount - 1 : f - 1];
+			runCounts[f] = changedTileRuns(frameRuns, &sheet, previous, &animation->frames[f], resource->gap);
+			if (runCounts[f] == 0)
+				continue;
+			snprintf(label, sizeof(label), "%s_animation%u_frame%u", name, a, f);
+			writeAssemblyLabel(out, label, "_runs");
+			for (u16 r = 0; r < runCounts[f]; ++r)
+				fprintf(out, "    dc.w    %u, %u\n", frameRuns[r][0], frameRuns[r][1]);
+			fprintf(out, "\n");
+		}
+		snprintf(label, sizeof(label), "%s_animation%u", name, a);
+		writeAssemblyLabel(out, label, "_frames");
+		for (u16 f = 0; f < animation->frameCount; ++f) {
+			if (runCounts[f] == 0)
+				fprintf(out, "    dc.w    0\n    dc.l    0\n");
+			else
+				fprintf(out, "    dc.w    %u\n    dc.l    %s_frame%u_runs\n", runCounts[f], label, f);
+		}
+		fprintf(out, "\n");
+	}
+
+	writeAssemblyLabel(out, name, "_animations");
+	for (u16 a = 0; a < sheet.animationCount; ++a)
+		fprintf(out, "    dc.w    %u\n    dc.l    %s_animation%u_frames\n", sheet.animations[a].frameCount, name, a);
+	fprintf(out, "\n    .align 2\n    .global %s\n%s:\n", name, name);
+	fprintf(out, "    dc.w    %u\n    dc.l    %s_animations\n\n", sheet.animationCount, name);
+	snprintf(declaration, RESOURCE_DECLARATION, "extern const SpriteDelta %s;", name);
+	free(runs);
+	free(runCounts);
+	freeSpriteSheet(&sheet);
+	return 0;
+}
+
+
+/*! Samples or music: 256-byte aligned, padded with zeros to a multiple of 256 bytes (samples) or of 2 (music). */
+static void writeSound(FILE *out, char *declaration, const Resource *resource, u8 *data, u32 size, u32 padded) {
+	memset(data + size, 0, padded - size);
+	fprintf(out, "    .align  %u\n    .global %s\n%s:\n", SOUND_ALIGNMENT, resource->name, resource->name);
+	writeAssemblyWords(out, data, padded);
+	fprintf(out, "\n");
+	snprintf(declaration, RESOURCE_DECLARATION, "extern const u8 %s[%u];", resource->name, (resource->type == ResourceWav) ? padded : size);
+}
+
+
+static int writeWav(FILE *out, char *declaration, const Resource *resource) {
+	WavSound sound;
+	if (loadWav(&sound, resource->path) != 0)
+		return fail(resource, "cannot read the PCM WAV file");
+	u32 length = resampledLength(&sound, WAV_XGM_RATE);
+	u32 padded = (length + SOUND_ALIGNMENT - 1) / SOUND_ALIGNMENT * SOUND_ALIGNMENT;
+	s8 *pcm = malloc(padded + 1u);
+	if (pcm == NULL) {
+		freeWav(&sound);
+		return fail(resource, "out of memory");
+	}
+	resampleWav(pcm, &sound, WAV_XGM_RATE);
+	writeSound(out, declaration, resource, (u8 *)pcm, length, padded);
+	free(pcm);
+	freeWav(&sound);
+	return 0;
+}
+
+
+static u8 *readFile(const char *path, long *size) {
+	FILE *file = fopen(path, "rb");
+	u8 *contents = NULL;
+
+	if (file == NULL)
+		return NULL;
+	if (fseek(file, 0, SEEK_END) == 0 && (*size = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0) {
+		contents = malloc((size_t)*size + 1);
+		if (contents != NULL && fread(contents, 1, (size_t)*size, file) != (size_t)*size) {
+			free(contents);
+			contents = NULL;
+		}
+	}
+	fclose(file);
+	return contents;
+}
+
+
+/*! Writes a path in single quotes for the shell. */
+static void quote(char *quoted, size_t size, const char *path) {
+	size_t length = 0;
+	quoted[length++] = '\'';
+	for (; *path != '\0' && length + 5 < size; ++path) {
+		if (*path == '\'') {
+			memcpy(quoted + length, "'\\''", 4);
+			length += 4;
+		}
+		else
+			quoted[length++] = *path;
+	}
+	quoted[length++] = '\'';
+	quoted[length] = '\0';
+}
+
+
+/*! Music: a .xgc file as is, anything else compiled to one by xgmtool in a directory of its own. */
+static int writeXgm(FILE *out, char *declaration, const Resource *resource, const char *xgmtool) {
+	const char *extension = strrchr(resource->path, '.');
+	char directory[] = "/tmp/assetbuildXXXXXX", compiled[sizeof(directory) + 16];
+	long size = 0;
+	u8 *music;
+
+	if (extension != NULL && strcmp(extension, ".xgc") == 0)
+		music = readFile(resource->path, &size);
+	else {
+		char command[3 * RESOURCE_PATH + 128], tool[RESOURCE_PATH + 8], input[RESOURCE_PATH + 8], output[sizeof(compiled) + 8];
+		if (mkdtemp(directory) == NULL)
+			return fail(resource, "cannot make a directory for xgmtool");
+		snprintf(compiled, sizeof(compiled), "%s/music.xgc", directory);
+		quote(tool, sizeof(tool), xgmtool);
+		quote(input, sizeof(input), resource->path);
+		quote(output, sizeof(output), compiled);
+		snprintf(command, sizeof(command), "%s %s %s > /dev/null", tool, input, output);
+		music = (system(command) == 0) ? readFile(compiled, &size) : NULL;
+		unlink(compiled);
+		rmdir(directory);
+		if (music == NULL) {
+			fprintf(stderr, "%s: xgmtool (%s) did not compile %s\n", resource->name, xgmtool, resource->path);
+			return -1;
+		}
+	}
+	if (music == NULL)
+		return fail(resource, "cannot read the music");
+	writeSound(out, declaration, resource, music, (u32)size, (u32)(size + 1) & ~1u);
+	free(music);
+	return 0;
+}
+
+
+int writeResource(FILE *out, char declaration[RESOURCE_DECLARATION], const Resource *resource, const char *xgmtool) {
+	switch (resource->type) {
+	case ResourceImage:
+		return writeImage(out, declaration, resource);
+	case ResourceSprite:
+		return writeSprite(out, declaration, resource);
+	case ResourceWav:
+		return writeWav(out, declaration, resource);
+	case ResourceXgm:
+		return writeXgm(out, declaration, resource, xgmtool);
+	case ResourceSpriteDelta:
+		return writeSpriteDelta(out, declaration, resource);
+	}
+	return fail(resource, "unsupported resource type");
+}
@@ -0,0 +1,276 @@
+/*!
+\file ResourceBuild.c
+\brief Incremental resource build file
+\date 10/2026
+
+Jobs of the resources of .res files, the cache of their outputs by content hash, and the .s and .h files
+(see ResourceBuild.h).
+*/
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../inc/ResourceBuild.h"
+#include "../inc/Resource.h"
+#include "../inc/WorkStealing.h"
+
+#define FNV_OFFSET 0xCBF29CE484222325ULL	/*!< FNV-1a 64-bit offset basis. */
+#define FNV_PRIME 0x100000001B3ULL	/*!< FNV-1a 64-bit prime. */
+#define READ_BLOCK 65536	/*!< Bytes hashed at a time. */
+
+/*! \brief Structure with the job of a resource. */
+typedef struct {
+	const Resource *resource;
+	char *assembly;	/**< Its assembly, from the cache or converted */
+	size_t assemblySize;
+	char declaration[RESOURCE_DECLARATION];	/**< Its line of the .h file */
+	u8 cached;	/**< Taken from the cache */
+	int status;	/**< 0, or -1 if it could not be converted */
+} ResourceJob;
+
+/*! \brief Structure with the jobs of a build, for the workers. */
+typedef struct {
+	ResourceJob *jobs;
+	const BuildOptions *options;
+} BuildContext;
+
+
+static unsigned long long hashBytes(unsigned long long hash, const void *bytes, size_t size) {
+	for (size_t i = 0; i < size; ++i)
+		hash = (hash ^ ((const u8 *)bytes)[i]) * FNV_PRIME;
+	return hash;
+}
+
+
+/*! Hashes what the output of a resource depends on. The path is left out: moving a file converts nothing. */
+static unsigned long long resourceHash(const Resource *resource) {
+	u8 block[READ_BLOCK];
+	u16 fields[] = { RESOURCE_BUILD_VERSION, (u16)resource->type, (u16)(u8)resource->compression, resource->width, resource->height,
+		resource->time, resource->gap };
+	unsigned long long hash = hashBytes(FNV_OFFSET, fields, sizeof(fields));
+	hash = hashBytes(hash, resource->name, strlen(resource->name) + 1);
+
+	FILE *file = fopen(resource->path, "rb");
+	if (file == NULL)
+		return hash;
+	for (size_t read; (read = fread(block, 1, sizeof(block), file)) > 0; )
+		hash = hashBytes(hash, block, read);
+	fclose(file);
+	return hash;
+}
+
+
+/*! Writes the path of a resource in the cache. Returns 0, or -1 if it is too long: the resource is then not cached. */
+static int cachePath(char *path, size_t size, const char *directory, unsigned long long hash) {
+	return (snprintf(path, size, "%s/%016llx", directory, hash) < (int)size) ? 0 : -1;
+}
+
+
+/*! Reads the output of a resource from the cache: its declaration on the first line, then its assembly. */
+static int readCache(ResourceJob *job, const char *path) {
+	FILE *file = fopen(path, "rb");
+	if (file == NULL)
+		return -1;
+	if (fgets(job->declaration, sizeof(job->declaration), file) == NULL || strchr(job->declaration, '\n') == NULL
+		|| fseek(file, 0, SEEK_END) != 0) {
+		fclose(file);
+		return -1;
+	}
+	long end = ftell(file);
+	long start = (long)strlen(job->declaration);
+	*strchr(job->declaration, '\n') = '\0';
+	job->assemblySize = (size_t)(end - start);
+	job->assembly = malloc(job->assemblySize + 1);
+	if (job->assembly == NULL || fseek(file, start, SEEK_SET) != 0
+		|| fread(job->assembly, 1, job->assemblySize, file) != job->assemblySize) {
+		fclose(file);
+		free(job->assembly);
+		job->assembly = NULL;
+		return -1;
+	}
+	job->assembly[job->assemblySize] = '\0';
+	fclose(file);
+	return 0;
+}
+
+
+/*! Writes the output of a resource to the cache, under a name of its own first, so that a reader never sees half of it.
+A path too long for that name is not cached. */
+static void writeCache(const ResourceJob *job, const char *path) {
+	char temporary[RESOURCE_PATH + 32];
+	if (snprintf(temporary, sizeof(temporary), "%s.XXXXXX", path) >= (int)sizeof(temporary))
+		return;
+	int descriptor = mkstemp(temporary);
+	if (descriptor < 0)
+		return;
+	fchmod(descriptor, 0644);
+	FILE *file = fdopen(descriptor, "wb");
+	if (file == NULL) {
+		close(descriptor);
+		unlink(temporary);
+		return;
+	}
+	int written = fprintf(file, "%s\n", job->declaration) > 0 && fwrite(job->assembly, 1, job->assemblySize, file) == job->assemblySize;
+	if (fclose(file) != 0 || !written || rename(temporary, path) != 0)
+		unlink(temporary);
+}
+
+
+static void runJob(ResourceJob *job, const BuildOptions *options) {
+	char path[RESOURCE_PATH + 32];
+	int useCache = options->cacheDirectory != NULL
+		&& cachePath(path, sizeof(path), options->cacheDirectory, resourceHash(job->resource)) == 0;
+
+	if (useCache) {
+		if (readCache(job, path) == 0) {
+			job->cached = TRUE;
+			return;
+		}
+	}
+	FILE *out = open_memstream(&job->assembly, &job->assemblySize);
+	if (out == NULL) {
+		job->status = -1;
+		return;
+	}
+	job->status = writeResource(out, job->declaration, job->resource, options->xgmtool);
+	if (fclose(out) != 0)
+		job->status = -1;
+	if (job->status == 0 && useCache)
+		writeCache(job, path);
+}
+
+static void runJobs(void *argument, u32 worker, u32 begin, u32 end) {
+	BuildContext *context = argument;
+	(void)worker;
+	for (u32 i = begin; i < end; ++i)
+		runJob(&context->jobs[i], context->options);
+}
+
+
+/*! Writes a file if its contents differ from what it holds. Returns 1 if written, 0 if not, -1 if it cannot be. */
+static int updateFile(const char *path, const char *contents, size_t size) {
+	FILE *file = fopen(path, "rb");
+	if (file != NULL) {
+		char *old = malloc(size + 1);
+		size_t read = (old != NULL) ? fread(old, 1, size + 1, file) : 0;
+		int same = old != NULL && read == size && memcmp(old, contents, size) == 0;
+		free(old);
+		fclose(file);
+		if (same)
+			return 0;
+	}
+	file = fopen(path, "wb");
+	if (file == NULL || fwrite(contents, 1, size, file) != size) {
+		if (file != NULL)
+			fclose(file);
+		fprintf(stderr, "cannot write %s\n", path);
+		return -1;
+	}
+	if (fclose(file) != 0) {
+		fprintf(stderr, "cannot write %s\n", path);
+		return -1;
+	}
+	return 1;
+}
+
+
+/*! Writes the .s and .h files of a .res file from the jobs of its resources. */
+static int writeOutputs(BuildStats *stats, const char *resourcePath, const char *outputDirectory, const ResourceJob *jobs, u32 count) {
+	char path[RESOURCE_PATH + 32], guard[RESOURCE_NAME];
+	const char *base = strrchr(resourcePath, '/');
+	base = (base != NULL) ? base + 1 : resourcePath;
+	size_t length = strcspn(base, ".");
+	char *text = NULL;
+	size_t size = 0;
+
+	FILE *out = open_memstream(&text, &size);
+	if (out == NULL)
+		return -1;
+	fprintf(out, ".section .rodata\n\n");
+	for (u32 i = 0; i < count; ++i)
+		fwrite(jobs[i].assembly, 1, jobs[i].assemblySize, out);
+	fclose(out);
+	snprintf(path, sizeof(path), "%s/%.*s.s", outputDirectory, (int)length, base);
+	int written = updateFile(path, text, size);
+	free(text);
+	if (written < 0)
+		return -1;
+	stats->filesWritten += (u32)written;
+
+	resourceHeaderGuard(guard, sizeof(guard), path);
+	out = open_memstream(&text, &size);
+	if (out == NULL)
+		return -1;
+	fprintf(out, "#ifndef __%s_H_\n#define __%s_H_\n\n", guard, guard);
+	for (u32 i = 0; i < count; ++i)
+		fprintf(out, "%s\n", jobs[i].declaration);
+	fprintf(out, "\n#endif // __%s_H_\n", guard);
+	fclose(out);
+	snprintf(path, sizeof(path), "%s/%.*s.h", outputDirectory, (int)length, base);
+	written = updateFile(path, text, size);
+	free(text);
+	if (written < 0)
+		return -1;
+	stats->filesWritten += (u32)written;
+	return 0;
+}
+
+
+int buildResources(BuildStats *stats, const char *resourcePaths[], u32 count, const char *outputDirectory, const BuildOptions *options) {
+	Resource **resources = calloc(count + 1u, sizeof(Resource *));
+	u32 *resourceCounts = calloc(count + 1u, sizeof(u32));
+	ResourceJob *jobs = NULL;
+	int status = -1;
+
+	memset(stats, 0, sizeof(BuildStats));
+	if (resources == NULL || resourceCounts == NULL)
+		goto done;
+	for (u32 i = 0; i < count; ++i) {
+		if (readResourceFile(&resources[i], &resourceCounts[i], resourcePaths[i]) != 0)
+			goto done;
+		stats->resources += resourceCounts[i];
+	}
+	if (options->cacheDirectory != NULL && mkdir(options->cacheDirectory, 0755) != 0 && errno != EEXIST) {
+		fprintf(stderr, "cannot make %s\n", options->cacheDirectory);
+		goto done;
+	}
+
+	// One job per resource, across every file.
+	jobs = calloc(stats->resources + 1u, sizeof(ResourceJob));
+	if (jobs == NULL)
+		goto done;
+	for (u32 i = 0, job = 0; i < count; ++i)
+		for (u32 r = 0; r < resourceCounts[i]; ++r)
+			jobs[job++].resource = &resources[i][r];
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	u32 threads = (options->threads > 0) ? options->threads : (cores > 0) ? (u32)cores : 1;
+	if (threads > MAX_WORKERS)
+		threads = MAX_WORKERS;
+	BuildContext context = { jobs, options };
+	if (runWorkStealing(stats->resources, threads, 1, runJobs, &context, NULL) != 0)
+		goto done;
+
+	for (u32 job = 0; job < stats->resources; ++job) {
+		if (jobs[job].status != 0)
+			goto done;
+		stats->cached += jobs[job].cached;
+	}
+	stats->converted = stats->resources - stats->cached;
+	status = 0;
+	for (u32 i = 0, first = 0; i < count && status == 0; first += resourceCounts[i++])
+		status = writeOutputs(stats, resourcePaths[i], outputDirectory, jobs + first, resourceCounts[i]);
+
+done:
+	for (u32 job = 0; jobs != NULL && job < stats->resources; ++job)
+		free(jobs[job].assembly);
+	free(jobs);
+	for (u32 i = 0; resources != NULL && i < count; ++i)
+		free(resources[i]);
+	free(resources);
+	free(resourceCounts);
+	return status;
+}
@@ -0,0 +1,143 @@
+/*!
+\file Rollback.c
+\brief Rollback driver file
+\date 10/2026
+
+Prediction, rollback and re-simulation of late input, and a loopback link to test them (see Rollback.h).
+*/
+
+#include <string.h>
+
+#include "../inc/Rollback.h"
+
+#define INPUT_SLOT(frame) ((frame) & (ROLLBACK_INPUT_SLOTS - 1))
+
+
+static u8 isConfirmed(const Rollback *rollback, u32 frame) {
+	return frame < rollback->confirmedFrames || rollback->confirmed[INPUT_SLOT(frame)];
+}
+
+
+/*! Returns TRUE if two inputs have the same effect: inputSystem reads the button only while it is pressed. */
+static u8 sameEffect(const ButtonInput *a, const ButtonInput *b) {
+	return a->isPressed == b->isPressed && (!a->isPressed || a->latestButtonPress == b->latestButtonPress);
+}
+
+
+/*! Simulates frame rollback->frame, predicting its input if it has not arrived. */
+static void simulateFrame(Rollback *rollback, EventQueue *events) {
+	ButtonInput *input = &rollback->input[INPUT_SLOT(rollback->frame)];
+	EventQueue eventQueue;
+
+	if (!isConfirmed(rollback, rollback->frame)) {
+		if (rollback->frame == 0) {
+			input->isPressed = FALSE;
+			input->latestButtonPress = Neutral;
+		}
+		else
+			*input = rollback->input[INPUT_SLOT(rollback->frame - 1)];
+	}
+	saveSnapshot(&rollback->snapshots, rollback->frame, &rollback->world, &rollback->context);
+
+	rollback->context.difficultyAIaccumulator += rollback->difficulty;
+	eventQueue = updateWorld(&rollback->world, &rollback->context, input);
+	if (events != NULL)
+		*events = eventQueue;
+	++rollback->frame;
+}
+
+
+void resolveRollback(Rollback *rollback) {
+	u32 target = rollback->frame, frames;
+
+	if (rollback->rollbackFrom == ROLLBACK_NONE)
+		return;
+	frames = target - rollback->rollbackFrom;
+
+	// Cannot fail: inputs are only predicted ROLLBACK_MAX_FRAMES < SNAPSHOT_SLOTS frames ahead.
+	restoreSnapshot(&rollback->snapshots, rollback->rollbackFrom, &rollback->world, &rollback->context);
+	rollback->frame = rollback->rollbackFrom;
+	rollback->rollbackFrom = ROLLBACK_NONE;
+	while (rollback->frame < target)
+		simulateFrame(rollback, NULL);
+
+	++rollback->stats.rollbacks;
+	rollback->stats.resimulatedFrames += frames;
+	if (frames > rollback->stats.longestRollback)
+		rollback->stats.longestRollback = frames;
+}
+
+
+void initializeRollback(Rollback *rollback, u8 numAllies, u16 difficulty, u32 seed) {
+	memset(rollback, 0, sizeof(Rollback));
+	initializeMatch(&rollback->world, &rollback->context, numAllies, seed);
+	rollback->difficulty = difficulty;
+	rollback->rollbackFrom = ROLLBACK_NONE;
+	clearSnapshots(&rollback->snapshots);
+}
+
+
+int addRollbackInput(Rollback *rollback, u32 frame, const ButtonInput *buttonInput) {
+	ButtonInput *input = &rollback->input[INPUT_SLOT(frame)];
+
+	if (isConfirmed(rollback, frame))
+		return 0;
+	if (frame - rollback->confirmedFrames >= ROLLBACK_INPUT_SLOTS)
+		return -1;
+
+	if (frame < rollback->frame && !sameEffect(input, buttonInput)
+		&& (rollback->rollbackFrom == ROLLBACK_NONE || frame < rollback->rollbackFrom))
+		rollback->rollbackFrom = frame;
+	*input = *buttonInput;
+	rollback->confirmed[INPUT_SLOT(frame)] = TRUE;
+
+	// Free the slots of the frames now confirmed in a row, for the frames ROLLBACK_INPUT_SLOTS later.
+	while (rollback->confirmed[INPUT_SLOT(rollback->confirmedFrames)]) {
+		rollback->confirmed[INPUT_SLOT(rollback->confirmedFrames)] = FALSE;
+		++rollback->confirmedFrames;
+	}
+	return 0;
+}
+
+
+int advanceRollback(Rollback *rollback, EventQueue *events) {
+	resolveRollback(rollback);
+	if (rollback->frame >= rollback->confirmedFrames + ROLLBACK_MAX_FRAMES) {
+		++rollback->stats.stalls;
+		return -1;
+	}
+	simulateFrame(rollback, events);
+	return 0;
+}
+
+
+void initializeLoopback(LoopbackLink *link, u32 delay, u32 jitter, u32 seed) {
+	link->delay = delay;
+	link->jitter = jitter;
+	seedRandom(&link->random, seed);
+	link->count = 0;
+}
+
+
+int sendLoopback(LoopbackLink *link, u32 now, u32 frame, const ButtonInput *buttonInput) {
+	if (link->count == LOOPBACK_PACKETS)
+		return -1;
+	LoopbackPacket *packet = &link->packets[link->count++];
+	packet->deliverAt = now + link->delay + ((link->jitter > 0) ? randomRange(&link->random, (u16)(link->jitter + 1)) : 0);
+	packet->frame = frame;
+	packet->input = *buttonInput;
+	return 0;
+}
+
+
+u8 receiveLoopback(LoopbackLink *link, u32 now, u32 *frame, ButtonInput *buttonInput) {
+	for (u32 i = 0; i < link->count; ++i) {
+		if (link->packets[i].deliverAt <= now) {
+			*frame = link->packets[i].frame;
+			*buttonInput = link->packets[i].input;
+			link->packets[i] = link->packets[--link->count]; // Order is not kept, as on a real network.
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
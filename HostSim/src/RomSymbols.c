@@ -0,0 +1,155 @@
+/*!
+\file RomSymbols.c
+\brief ROM symbol table file
+\date 10/2026
+
+Minimal reader of the ELF32 big-endian symbol table (see RomSymbols.h). No libelf needed.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../inc/RomSymbols.h"
+
+#define SHT_SYMTAB 2
+#define SHF_EXECINSTR 0x4
+#define STT_NOTYPE 0
+#define STT_FUNC 2
+#define SECTION_HEADER_SIZE 40
+#define SYMBOL_SIZE 16
+
+
+static u32 bigEndian32(const u8 *bytes) {
+	return ((u32)bytes[0] << 24) | ((u32)bytes[1] << 16) | ((u32)bytes[2] << 8) | bytes[3];
+}
+
+static u16 bigEndian16(const u8 *bytes) {
+	return (u16)((bytes[0] << 8) | bytes[1]);
+}
+
+/*! Orders by address, then by name, so that the order does not depend on qsort. */
+static int compareSymbols(const void *left, const void *right) {
+	const RomSymbol *a = left, *b = right;
+	if (a->address != b->address)
+		return (a->address < b->address) ? -1 : 1;
+	return strcmp(a->name, b->name);
+}
+
+static u8 *readFile(const char *path, long *size) {
+	FILE *file = fopen(path, "rb");
+	u8 *contents = NULL;
+
+	if (file == NULL)
+		return NULL;
+	if (fseek(file, 0, SEEK_END) == 0 && (*size = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0) {
+		contents = malloc((size_t)*size);
+		if (contents != NULL && fread(contents, 1, (size_t)*size, file) != (size_t)*size) {
+			free(contents);
+			contents = NULL;
+		}
+	}
+	fclose(file);
+	return contents;
+}
+
+
+int loadRomSymbols(RomSymbols *symbols, const char *path) {
+	long size = 0;
+	u8 *elf = readFile(path, &size);
+	int result = -1;
+
+	memset(symbols, 0, sizeof(RomSymbols));
+	if (elf == NULL)
+		return -1;
+	// ELF32 (class 1), big-endian (data 2).
+	if (size < 52 || memcmp(elf, "\177ELF", 4) != 0 || elf[4] != 1 || elf[5] != 2)
+		goto done;
+
+	u32 sectionOffset = bigEndian32(elf + 0x20);
+	u16 sectionCount = bigEndian16(elf + 0x30);
+	if ((uint64_t)sectionOffset + (uint64_t)sectionCount * SECTION_HEADER_SIZE > (uint64_t)size)
+		goto done;
+
+	for (u16 section = 0; section < sectionCount; ++section) {
+		const u8 *header = elf + sectionOffset + section * SECTION_HEADER_SIZE;
+		if (bigEndian32(header + 4) != SHT_SYMTAB)
+			continue;
+
+		u32 tableOffset = bigEndian32(header + 0x10), tableSize = bigEndian32(header + 0x14);
+		u32 stringSection = bigEndian32(header + 0x18);
+		if (stringSection >= sectionCount)
+			goto done;
+		const u8 *stringHeader = elf + sectionOffset + stringSection * SECTION_HEADER_SIZE;
+		u32 stringOffset = bigEndian32(stringHeader + 0x10), stringSize = bigEndian32(stringHeader + 0x14);
+		if ((uint64_t)tableOffset + tableSize > (uint64_t)size || (uint64_t)stringOffset + stringSize > (uint64_t)size || stringSize == 0)
+			goto done;
+
+		symbols->names = malloc(stringSize);
+		symbols->symbols = malloc((tableSize / SYMBOL_SIZE + 1) * sizeof(RomSymbol));
+		if (symbols->names == NULL || symbols->symbols == NULL)
+			goto done;
+		memcpy(symbols->names, elf + stringOffset, stringSize);
+		symbols->names[stringSize - 1] = '\0';
+
+		for (u32 entry = 0; entry + SYMBOL_SIZE <= tableSize; entry += SYMBOL_SIZE) {
+			const u8 *symbol = elf + tableOffset + entry;
+			u32 name = bigEndian32(symbol);
+			u8 type = symbol[12] & 0x0F;
+			u16 symbolSection = bigEndian16(symbol + 14);
+
+			if (name == 0 || name >= stringSize || (type != STT_FUNC && type != STT_NOTYPE))
+				continue;
+			if (symbolSection == 0 || symbolSection >= sectionCount)
+				continue; // Undefined, absolute or common
+			if (!(bigEndian32(elf + sectionOffset + symbolSection * SECTION_HEADER_SIZE + 8) & SHF_EXECINSTR))
+				continue;
+			if (symbols->names[name] == '.' || symbols->names[name] == '\0')
+				continue;
+			symbols->symbols[symbols->count].address = bigEndian32(symbol + 4);
+			symbols->symbols[symbols->count].name = symbols->names + name;
+			++symbols->count;
+		}
+		qsort(symbols->symbols, symbols->count, sizeof(RomSymbol), compareSymbols);
+		result = 0;
+		break;
+	}
+
+done:
+	free(elf);
+	if (result != 0)
+		freeRomSymbols(symbols);
+	return result;
+}
+
+
+void freeRomSymbols(RomSymbols *symbols) {
+	free(symbols->symbols);
+	free(symbols->names);
+	memset(symbols, 0, sizeof(RomSymbols));
+}
+
+
+s32 findRomSymbol(const RomSymbols *symbols, u32 address) {
+	s32 low = 0, high = (s32)symbols->count - 1, found = -1;
+
+	while (low <= high) {
+		s32 middle = (low + high) / 2;
+		if (symbols->symbols[middle].address <= address) {
+			found = middle;
+			low = middle + 1;
+		}
+		else
+			high = middle - 1;
+	}
+	return found;
+}
+
+
+s32 findRomSymbolByName(const RomSymbols *symbols, const char *name) {
+	for (u32 i = 0; i < symbols->count; ++i)
+		if (strcmp(symbols->symbols[i].name, name) == 0)
+			return (s32)i;
+	return -1;
+}
@@ -0,0 +1,35 @@
+/*!
+\file Snapshot.c
+\brief Simulation snapshot file
+\date 10/2026
+
+Ring of simulation snapshots (see Snapshot.h).
+*/
+
+#include <string.h>
+
+#include "../inc/Snapshot.h"
+
+
+void clearSnapshots(SnapshotRing *ring) {
+	for (u32 i = 0; i < SNAPSHOT_SLOTS; ++i)
+		ring->slots[i].frame = SNAPSHOT_NONE;
+}
+
+
+void saveSnapshot(SnapshotRing *ring, u32 frame, const World *world, const SimContext *context) {
+	Snapshot *slot = &ring->slots[frame & (SNAPSHOT_SLOTS - 1)];
+	slot->frame = frame;
+	memcpy(&slot->world, world, sizeof(World));
+	memcpy(&slot->context, context, sizeof(SimContext));
+}
+
+
+int restoreSnapshot(const SnapshotRing *ring, u32 frame, World *world, SimContext *context) {
+	const Snapshot *slot = &ring->slots[frame & (SNAPSHOT_SLOTS - 1)];
+	if (slot->frame != frame)
+		return -1;
+	memcpy(world, &slot->world, sizeof(World));
+	memcpy(context, &slot->context, sizeof(SimContext));
+	return 0;
+}
@@ -0,0 +1,114 @@
+/*!
+\file SpriteSheet.c
+\brief Sprite sheet conversion file
+\date 10/2026
+
+rescomp's cutting of sprite sheets into animations, frames and hardware sprites (see SpriteSheet.h).
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../inc/SpriteSheet.h"
+
+
+/*! Tells whether the frame of a sheet at a position in frames has a pixel that is not 0. */
+static u8 frameDrawn(const IndexedImage *image, u32 left, u32 top, u32 width, u32 height) {
+	for (u32 y = top; y < top + height; ++y)
+		for (u32 x = left; x < left + width; ++x)
+			if (image->pixels[(size_t)y * image->width + x] != 0)
+				return TRUE;
+	return FALSE;
+}
+
+
+int convertSpriteSheet(SpriteSheet *sheet, const IndexedImage *image, u16 width, u16 height) {
+	memset(sheet, 0, sizeof(SpriteSheet));
+	if (width == 0 || height == 0 || image->width % (width * TILE_SIZE) != 0 || image->height % (height * TILE_SIZE) != 0)
+		return -1;
+
+	for (u16 color = 0; color < TILE_PALETTE_COLORS; ++color)
+		sheet->palette[color] = vdpColor(image->palette[color]);
+	sheet->width = width;
+	sheet->height = height;
+	sheet->tileCount = (u16)(width * height);
+
+	// The sprites: a grid of 4x4 tiles, narrower in the last column and shorter in the last row.
+	u16 columns = (u16)((width + SPRITE_MAX_TILES - 1) / SPRITE_MAX_TILES);
+	u16 rows = (u16)((height + SPRITE_MAX_TILES - 1) / SPRITE_MAX_TILES);
+	sheet->spriteCount = (u16)(columns * rows);
+	sheet->sprites = malloc(sizeof(HardwareSprite) * sheet->spriteCount);
+	u16 frameColumns = (u16)(image->width / (width * TILE_SIZE));
+	sheet->animationCount = (u16)(image->height / (height * TILE_SIZE));
+	sheet->animations = calloc(sheet->animationCount, sizeof(SpriteAnimation));
+	if (sheet->sprites == NULL || sheet->animations == NULL) {
+		freeSpriteSheet(sheet);
+		return -1;
+	}
+	for (u16 i = 0; i < sheet->spriteCount; ++i) {
+		HardwareSprite *sprite = &sheet->sprites[i];
+		u16 column = i % columns, row = i / columns;
+		sprite->x = (u16)(column * SPRITE_MAX_TILES * TILE_SIZE);
+		sprite->y = (u16)(row * SPRITE_MAX_TILES * TILE_SIZE);
+		sprite->width = (u8)((column < columns - 1) ? SPRITE_MAX_TILES : width - column * SPRITE_MAX_TILES);
+		sprite->height = (u8)((row < rows - 1) ? SPRITE_MAX_TILES : height - row * SPRITE_MAX_TILES);
+	}
+
+	for (u16 a = 0; a < sheet->animationCount; ++a) {
+		SpriteAnimation *animation = &sheet->animations[a];
+		u32 top = (u32)a * height * TILE_SIZE;
+		for (u16 f = 0; f < frameColumns; ++f)
+			if (frameDrawn(image, (u32)f * width * TILE_SIZE, top, width * TILE_SIZE, height * TILE_SIZE))
+				animation->frameCount = (u16)(f + 1);
+		animation->frames = calloc(animation->frameCount + 1u, sizeof(SpriteFrame));
+		if (animation->frames == NULL) {
+			freeSpriteSheet(sheet);
+			return -1;
+		}
+		for (u16 f = 0; f < animation->frameCount; ++f) {
+			Tile *tile = animation->frames[f].tiles = malloc(sizeof(Tile) * sheet->tileCount);
+			if (tile == NULL) {
+				freeSpriteSheet(sheet);
+				return -1;
+			}
+			for (u16 i = 0; i < sheet->spriteCount; ++i) {
+				const HardwareSprite *sprite = &sheet->sprites[i];
+				u32 left = (u32)f * width + sprite->x / TILE_SIZE;
+				for (u8 x = 0; x < sprite->width; ++x)
+					for (u8 y = 0; y < sprite->height; ++y)
+						readTile(tile++, image, left + x, (u32)a * height + sprite->y / TILE_SIZE + y);
+			}
+		}
+	}
+	return 0;
+}
+
+
+void freeSpriteSheet(SpriteSheet *sheet) {
+	for (u16 a = 0; a < sheet->animationCount && sheet->animations != NULL; ++a) {
+		for (u16 f = 0; f < sheet->animations[a].frameCount && sheet->animations[a].frames != NULL; ++f)
+			free(sheet->animations[a].frames[f].tiles);
+		free(sheet->animations[a].frames);
+	}
+	free(sheet->animations);
+	free(sheet->sprites);
+	sheet->animations = NULL;
+	sheet->sprites = NULL;
+	sheet->animationCount = 0;
+}
+
+
+u16 changedTileRuns(u16 runs[][2], const SpriteSheet *sheet, const SpriteFrame *from, const SpriteFrame *to, u16 gap) {
+	u16 count = 0;
+	for (u16 tile = 0; tile < sheet->tileCount; ++tile) {
+		if (memcmp(&from->tiles[tile], &to->tiles[tile], sizeof(Tile)) == 0)
+			continue;
+		if (count > 0 && tile - (runs[count - 1][0] + runs[count - 1][1]) <= gap)
+			runs[count - 1][1] = (u16)(tile + 1 - runs[count - 1][0]);
+		else {
+			runs[count][0] = tile;
+			runs[count++][1] = 1;
+		}
+	}
+	return count;
+}
@@ -0,0 +1,364 @@
+/*!
+\file TileImage.c
+\brief Background tile conversion file
+\date 10/2026
+
+rescomp's tile conversion, and tiles shared across images (see TileImage.h).
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../inc/TileImage.h"
+
+#define MAX_TILES (TILE_INDEX_MASK + 1)	/*!< Tiles a tilemap entry can index. */
+#define NONE UINT32_MAX
+
+/*! Flips in the order rescomp tries them. */
+static const u16 flips[] = { 0, TILE_FLIP_H, TILE_FLIP_V, TILE_FLIP_H | TILE_FLIP_V };
+
+
+/*! Mirrors the 8 pixels of a row. */
+static u32 mirrorRow(u32 row) {
+	row = (row >> 16) | (row << 16);
+	row = ((row >> 8) & 0x00FF00FF) | ((row << 8) & 0xFF00FF00);
+	return ((row >> 4) & 0x0F0F0F0F) | ((row << 4) & 0xF0F0F0F0);
+}
+
+u16 vdpColor(const u8 rgb[3]) {
+	return (u16)(((rgb[2] >> 5) << 9) | ((rgb[1] >> 5) << 5) | ((rgb[0] >> 5) << 1));
+}
+
+
+void readTile(Tile *tile, const IndexedImage *image, u32 tx, u32 ty) {
+	for (u8 y = 0; y < TILE_SIZE; ++y) {
+		const u8 *pixel = image->pixels + (size_t)(ty * TILE_SIZE + y) * image->width + tx * TILE_SIZE;
+		tile->row[y] = 0;
+		for (u8 x = 0; x < TILE_SIZE; ++x)
+			tile->row[y] = (tile->row[y] << 4) | (pixel[x] & 0xF);
+	}
+}
+
+
+void flipTile(Tile *flipped, const Tile *tile, u16 flip) {
+	Tile copy = *tile;
+	for (u8 y = 0; y < TILE_SIZE; ++y) {
+		u32 row = copy.row[(flip & TILE_FLIP_V) ? TILE_SIZE - 1 - y : y];
+		flipped->row[y] = (flip & TILE_FLIP_H) ? mirrorRow(row) : row;
+	}
+}
+
+
+s32 findTile(const Tile *tiles, u32 count, const Tile *tile, u16 *flip) {
+	for (u8 f = 0; f < sizeof(flips) / sizeof(flips[0]); ++f) {
+		Tile flipped;
+		flipTile(&flipped, tile, flips[f]);
+		for (u32 i = 0; i < count; ++i)
+			if (memcmp(&tiles[i], &flipped, sizeof(Tile)) == 0) {
+				*flip = flips[f];
+				return (s32)i;
+			}
+	}
+	return -1;
+}
+
+
+int convertTileImage(TileImage *tileImage, const IndexedImage *image) {
+	memset(tileImage, 0, sizeof(TileImage));
+	if (image->width % TILE_SIZE != 0 || image->height % TILE_SIZE != 0)
+		return -1;
+
+	for (u16 color = 0; color < TILE_PALETTE_COLORS; ++color)
+		tileImage->palette[color] = vdpColor(image->palette[color]);
+	tileImage->width = (u16)(image->width / TILE_SIZE);
+	tileImage->height = (u16)(image->height / TILE_SIZE);
+	tileImage->map = malloc(sizeof(u16) * tileImage->width * tileImage->height);
+	tileImage->tiles = malloc(sizeof(Tile) * MAX_TILES);
+	if (tileImage->map == NULL || tileImage->tiles == NULL) {
+		freeTileImage(tileImage);
+		return -1;
+	}
+
+	for (u16 ty = 0; ty < tileImage->height; ++ty)
+		for (u16 tx = 0; tx < tileImage->width; ++tx) {
+			Tile tile;
+			u16 flip = 0;
+			readTile(&tile, image, tx, ty);
+			s32 index = findTile(tileImage->tiles, tileImage->tileCount, &tile, &flip);
+			if (index < 0) {
+				if (tileImage->tileCount == MAX_TILES) {
+					freeTileImage(tileImage);
+					return -1;
+				}
+				index = tileImage->tileCount++;
+				tileImage->tiles[index] = tile;
+			}
+			tileImage->map[ty * tileImage->width + tx] = (u16)(index | flip);
+		}
+	return 0;
+}
+
+
+void freeTileImage(TileImage *tileImage) {
+	free(tileImage->map);
+	free(tileImage->tiles);
+	tileImage->map = NULL;
+	tileImage->tiles = NULL;
+}
+
+
+void writeTileBytes(u8 *bytes, const Tile *tiles, u32 count) {
+	for (u32 i = 0; i < count; ++i)
+		for (u8 y = 0; y < TILE_SIZE; ++y, bytes += 4) {
+			u32 row = tiles[i].row[y];
+			bytes[0] = (u8)(row >> 24);
+			bytes[1] = (u8)(row >> 16);
+			bytes[2] = (u8)(row >> 8);
+			bytes[3] = (u8)row;
+		}
+}
+
+
+/*! Writes the smallest of the 4 flips of a tile, and returns the flip that gives the tile back from it. */
+static u16 canonicalTile(Tile *canonical, const Tile *tile) {
+	u16 flip = 0;
+	*canonical = *tile;
+	for (u8 f = 1; f < sizeof(flips) / sizeof(flips[0]); ++f) {
+		Tile flipped;
+		flipTile(&flipped, tile, flips[f]);
+		if (memcmp(&flipped, canonical, sizeof(Tile)) < 0) {
+			*canonical = flipped;
+			flip = flips[f];
+		}
+	}
+	return flip;
+}
+
+static u32 hashTile(const Tile *tile) {
+	u32 hash = 2166136261u;
+	for (u8 y = 0; y < TILE_SIZE; ++y)
+		hash = (hash ^ tile->row[y]) * 16777619u;
+	return hash;
+}
+
+
+/*! \brief Structure with the different tiles of all images, up to flips, and each image's tiles among them. */
+typedef struct {
+	Tile *tiles;	/**< Different tiles, in canonical form */
+	u32 count;
+	u32 *slots;	/**< Hash table of tile ids, NONE if empty */
+	u32 slotMask;
+	u32 **id;	/**< For every image, the id of each of its tiles */
+	u16 **flip;	/**< For every image, the flip that gives each of its tiles from its canonical form */
+} TileIds;
+
+
+static u32 tileId(TileIds *ids, const Tile *canonical) {
+	u32 slot = hashTile(canonical) & ids->slotMask;
+	while (ids->slots[slot] != NONE) {
+		if (memcmp(&ids->tiles[ids->slots[slot]], canonical, sizeof(Tile)) == 0)
+			return ids->slots[slot];
+		slot = (slot + 1) & ids->slotMask;
+	}
+	ids->tiles[ids->count] = *canonical;
+	ids->slots[slot] = ids->count;
+	return ids->count++;
+}
+
+static int findTileIds(TileIds *ids, const TileImage images[], u32 count) {
+	u32 total = 0, slots = 1;
+
+	memset(ids, 0, sizeof(TileIds));
+	for (u32 i = 0; i < count; ++i)
+		total += images[i].tileCount;
+	while (slots < 2 * total + 2)
+		slots <<= 1;
+	ids->tiles = malloc(sizeof(Tile) * (total + 1));
+	ids->slots = malloc(sizeof(u32) * slots);
+	ids->id = calloc(count, sizeof(u32 *));
+	ids->flip = calloc(count, sizeof(u16 *));
+	if (ids->tiles == NULL || ids->slots == NULL || ids->id == NULL || ids->flip == NULL)
+		return -1;
+	ids->slotMask = slots - 1;
+	memset(ids->slots, 0xFF, sizeof(u32) * slots);
+
+	for (u32 i = 0; i < count; ++i) {
+		ids->id[i] = malloc(sizeof(u32) * (images[i].tileCount + 1));
+		ids->flip[i] = malloc(sizeof(u16) * (images[i].tileCount + 1));
+		if (ids->id[i] == NULL || ids->flip[i] == NULL)
+			return -1;
+		for (u16 tile = 0; tile < images[i].tileCount; ++tile) {
+			Tile canonical;
+			ids->flip[i][tile] = canonicalTile(&canonical, &images[i].tiles[tile]);
+			ids->id[i][tile] = tileId(ids, &canonical);
+		}
+	}
+	return 0;
+}
+
+static void freeTileIds(TileIds *ids, u32 count) {
+	for (u32 i = 0; ids->id != NULL && i < count; ++i) {
+		free(ids->id[i]);
+		free(ids->flip[i]);
+	}
+	free(ids->id);
+	free(ids->flip);
+	free(ids->tiles);
+	free(ids->slots);
+}
+
+
+/*! Counts the tiles two images have in common. 'mark' has an entry per tile id, none of them equal to 'stamp'. */
+static u32 sharedTiles(const TileIds *ids, const TileImage images[], u32 a, u32 b, u32 *mark, u32 stamp) {
+	u32 shared = 0;
+	for (u16 tile = 0; tile < images[a].tileCount; ++tile)
+		mark[ids->id[a][tile]] = stamp;
+	for (u16 tile = 0; tile < images[b].tileCount; ++tile)
+		shared += mark[ids->id[b][tile]] == stamp;
+	return shared;
+}
+
+
+/*! Orders the images so that each one shares many tiles with the one before: starts with the two that share the most,
+	then adds the image that shares the most with either end of the chain. 'line' has room for 2 * count images. */
+static void chainImages(u32 *chain, u32 *line, u8 *chained, const u32 *shared, u32 count) {
+	u32 head = count, tail = count;
+
+	line[head] = 0;
+	if (count > 1) {
+		line[++tail] = 1;
+		for (u32 a = 0; a < count; ++a)
+			for (u32 b = a + 1; b < count; ++b)
+				if (shared[a * count + b] > shared[line[head] * count + line[tail]]) {
+					line[head] = a;
+					line[tail] = b;
+				}
+	}
+	memset(chained, 0, count);
+	chained[line[head]] = chained[line[tail]] = 1;
+
+	while (tail - head + 1 < count) {
+		u32 best = NONE, bestShared = 0;
+		u8 atHead = FALSE;
+		for (u32 i = 0; i < count; ++i) {
+			if (chained[i])
+				continue;
+			if (best == NONE || shared[line[tail] * count + i] > bestShared) {
+				best = i;
+				bestShared = shared[line[tail] * count + i];
+				atHead = FALSE;
+			}
+			if (shared[line[head] * count + i] > bestShared) {
+				best = i;
+				bestShared = shared[line[head] * count + i];
+				atHead = TRUE;
+			}
+		}
+		chained[best] = 1;
+		if (atHead)
+			line[--head] = best;
+		else
+			line[++tail] = best;
+	}
+	memcpy(chain, line + head, sizeof(u32) * count);
+}
+
+
+int poolTileImages(TilePool *pool, TileImage images[], u32 count) {
+	TileIds ids;
+	u32 total = 0, *shared = NULL, *chain = NULL, *line = NULL, *mark = NULL, *sharedAt = NULL, *poolIndex = NULL;
+	u16 *poolFlip = NULL;
+	u8 *chained = NULL;
+	int result = -1;
+
+	memset(pool, 0, sizeof(TilePool));
+	if (findTileIds(&ids, images, count) != 0)
+		goto done;
+	for (u32 i = 0; i < count; ++i)
+		total += images[i].tileCount;
+	shared = calloc((size_t)count * count + 1, sizeof(u32));
+	chain = malloc(sizeof(u32) * (count + 1));
+	line = malloc(sizeof(u32) * (2 * count + 1));
+	chained = malloc(count + 1);
+	mark = malloc(sizeof(u32) * (ids.count + 1));
+	sharedAt = malloc(sizeof(u32) * (ids.count + 1));
+	poolIndex = malloc(sizeof(u32) * (ids.count + 1));
+	poolFlip = malloc(sizeof(u16) * (ids.count + 1));
+	pool->tiles = malloc(sizeof(Tile) * (total + 1));
+	pool->first = malloc(sizeof(u32) * (count + 1));
+	if (shared == NULL || chain == NULL || line == NULL || chained == NULL || mark == NULL || sharedAt == NULL || poolIndex == NULL || poolFlip == NULL
+		|| pool->tiles == NULL || pool->first == NULL)
+		goto done;
+
+	memset(mark, 0xFF, sizeof(u32) * ids.count);
+	for (u32 a = 0; a < count; ++a)
+		for (u32 b = a + 1; b < count; ++b)
+			shared[a * count + b] = shared[b * count + a] = sharedTiles(&ids, images, a, b, mark, a * count + b);
+	if (count > 0)
+		chainImages(chain, line, chained, shared, count);
+
+	// Each image: the tiles it shares with the one before (at the end of the pool already), its own, the ones it shares with the next.
+	memset(mark, 0xFF, sizeof(u32) * ids.count);
+	memset(sharedAt, 0xFF, sizeof(u32) * ids.count);
+	u32 before = 0;
+	for (u32 c = 0; c < count; ++c) {
+		TileImage *image = &images[chain[c]];
+		const u32 *id = ids.id[chain[c]];
+		const u16 *flip = ids.flip[chain[c]];
+		u32 first = pool->count - before, after = 0;
+
+		if (c + 1 < count)
+			for (u16 tile = 0; tile < images[chain[c + 1]].tileCount; ++tile)
+				mark[ids.id[chain[c + 1]][tile]] = c;
+		for (u8 pass = 0; pass < 2; ++pass)
+			for (u16 tile = 0; tile < image->tileCount; ++tile) {
+				u32 tileId = id[tile];
+				u8 next = mark[tileId] == c;
+				if (sharedAt[tileId] == c || next != pass)
+					continue;
+				if (next) {
+					sharedAt[tileId] = c + 1;
+					++after;
+				}
+				poolIndex[tileId] = pool->count;
+				poolFlip[tileId] = flip[tile];
+				pool->tiles[pool->count++] = image->tiles[tile];
+			}
+
+		// A tile is its canonical form flipped by 'flip'; the pool has that form flipped by 'poolFlip'.
+		for (u32 entry = 0; entry < (u32)image->width * image->height; ++entry) {
+			u16 tile = image->map[entry] & TILE_INDEX_MASK;
+			u32 tileId = id[tile];
+			u16 mapFlip = (image->map[entry] ^ flip[tile] ^ poolFlip[tileId]) & (TILE_FLIP_H | TILE_FLIP_V);
+			image->map[entry] = (u16)((image->map[entry] & ~(TILE_INDEX_MASK | TILE_FLIP_H | TILE_FLIP_V))
+				| (poolIndex[tileId] - first) | mapFlip);
+		}
+		memcpy(image->tiles, pool->tiles + first, sizeof(Tile) * image->tileCount);
+		pool->first[chain[c]] = first;
+		before = after;
+	}
+	result = 0;
+
+done:
+	freeTileIds(&ids, count);
+	free(shared);
+	free(chain);
+	free(line);
+	free(chained);
+	free(mark);
+	free(sharedAt);
+	free(poolIndex);
+	free(poolFlip);
+	if (result != 0)
+		freeTilePool(pool);
+	return result;
+}
+
+
+void freeTilePool(TilePool *pool) {
+	free(pool->tiles);
+	free(pool->first);
+	pool->tiles = NULL;
+	pool->first = NULL;
+}
@@ -0,0 +1,128 @@
+/*!
+\file Unpack68k.c
+\brief Console unpacker file
+\date 10/2026
+
+Calls SGDK's unpackers in the ROM from the host, as C code on the console would (see Unpack68k.h).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../inc/Unpack68k.h"
+#include "../inc/RomSymbols.h"
+
+#define CARTRIDGE_SIZE 0x400000	/*!< Cartridge address space. */
+#define RAM_ADDRESS 0xFF0000	/*!< Work RAM, where the data is unpacked. */
+#define STACK_ADDRESS 0xFFFF00	/*!< Stack pointer when the unpacker is called. */
+#define RETURN_ADDRESS 0xFFFFF0	/*!< Return address of the call: the unpacker is done once it gets there. */
+#define CYCLE_LIMIT 100000000ULL	/*!< An unpacker taking longer is stuck. */
+
+/*! SGDK's unpacker of every method: unpacker(src, dest), which return the size unpacked. */
+static const char *unpackerNames[PACK_METHODS] = { NULL, "aplib_unpack", "lz4w_unpack" };
+
+
+static u8 *readFile(const char *path, long *size) {
+	FILE *file = fopen(path, "rb");
+	u8 *contents = NULL;
+
+	if (file == NULL)
+		return NULL;
+	if (fseek(file, 0, SEEK_END) == 0 && (*size = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0) {
+		contents = malloc((size_t)*size);
+		if (contents != NULL && fread(contents, 1, (size_t)*size, file) != (size_t)*size) {
+			free(contents);
+			contents = NULL;
+		}
+	}
+	fclose(file);
+	return contents;
+}
+
+
+int openUnpacker(Unpacker *unpacker, const char *romPath, const char *symbolsPath) {
+	RomSymbols symbols;
+	long size = 0;
+	u8 *rom = readFile(romPath, &size);
+
+	memset(unpacker, 0, sizeof(Unpacker));
+	if (rom == NULL)
+		return -1;
+	unpacker->machine = malloc(sizeof(MegaDrive));
+	unpacker->rom = calloc(CARTRIDGE_SIZE, 1);
+	if (unpacker->machine == NULL || unpacker->rom == NULL || size >= CARTRIDGE_SIZE || loadRomSymbols(&symbols, symbolsPath) != 0) {
+		free(rom);
+		closeUnpacker(unpacker);
+		return -1;
+	}
+	memcpy(unpacker->rom, rom, (size_t)size);
+	unpacker->romSize = (u32)(size + 1) & ~1u;
+	free(rom);
+
+	u8 found = FALSE;
+	for (u8 method = 0; method < PACK_METHODS; ++method) {
+		s32 symbol = (unpackerNames[method] != NULL) ? findRomSymbolByName(&symbols, unpackerNames[method]) : -1;
+		unpacker->entry[method] = (symbol >= 0) ? symbols.symbols[symbol].address : 0;
+		found |= symbol >= 0;
+	}
+	freeRomSymbols(&symbols);
+	if (!found) {
+		closeUnpacker(unpacker);
+		return -1;
+	}
+	return 0;
+}
+
+
+void closeUnpacker(Unpacker *unpacker) {
+	free(unpacker->machine);
+	free(unpacker->rom);
+	unpacker->machine = NULL;
+	unpacker->rom = NULL;
+}
+
+
+static void push32(MegaDrive *machine, u32 value) {
+	Cpu68k *cpu = &machine->cpu;
+	cpu->a[7] -= 4;
+	cpu->bus.write16(cpu->bus.context, cpu->a[7], (u16)(value >> 16));
+	cpu->bus.write16(cpu->bus.context, cpu->a[7] + 2, (u16)value);
+}
+
+
+s32 unpackOnConsole(Unpacker *unpacker, PackMethod method, const u8 *packed, u32 size, u8 *data, u32 *cycles) {
+	MegaDrive *machine = unpacker->machine;
+	u32 source = unpacker->romSize;
+
+	*cycles = 0;
+	if ((u32)method >= PACK_METHODS || unpacker->entry[method] == 0 || size > CARTRIDGE_SIZE - source)
+		return -1;
+	memcpy(unpacker->rom + source, packed, size);
+	powerOnMegaDrive(machine, unpacker->rom, source + size, NULL, NULL);
+	memset(machine->ram, 0, sizeof(machine->ram));
+
+	// unpacker(source, RAM): interrupts masked, arguments and return address on the stack.
+	Cpu68k *cpu = &machine->cpu;
+	cpu->sr = CPU_FLAG_S | 0x0700;
+	cpu->a[7] = STACK_ADDRESS;
+	push32(machine, RAM_ADDRESS);
+	push32(machine, source);
+	push32(machine, RETURN_ADDRESS);
+	cpu->pc = unpacker->entry[method];
+	cpu->stopped = FALSE;
+
+	unsigned long long start = cpu->cycles;
+	while (cpu->pc != RETURN_ADDRESS) {
+		if (cpu->cycles - start > CYCLE_LIMIT)
+			return -1;
+		stepMegaDrive(machine);
+	}
+	*cycles = (u32)(cpu->cycles - start);
+
+	u32 unpacked = cpu->d[0];
+	if (unpacked > UNPACK_CAPACITY)
+		return -1;
+	memcpy(data, machine->ram, unpacked);
+	return (s32)unpacked;
+}
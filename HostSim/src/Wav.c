@@ -0,0 +1,131 @@
+/*!
+\file Wav.c
+\brief WAV sound conversion file
+\date 10/2026
+
+RIFF chunks of PCM WAV files, and resampling by the mean of every span of source samples (see Wav.h).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../inc/Wav.h"
+
+#define WAV_PCM 1	/*!< Format tag of uncompressed samples. */
+
+
+static u32 littleEndian32(const u8 *bytes) {
+	return bytes[0] | ((u32)bytes[1] << 8) | ((u32)bytes[2] << 16) | ((u32)bytes[3] << 24);
+}
+
+static u16 littleEndian16(const u8 *bytes) {
+	return (u16)(bytes[0] | (bytes[1] << 8));
+}
+
+static u8 *readFile(const char *path, long *size) {
+	FILE *file = fopen(path, "rb");
+	u8 *contents = NULL;
+
+	if (file == NULL)
+		return NULL;
+	if (fseek(file, 0, SEEK_END) == 0 && (*size = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0) {
+		contents = malloc((size_t)*size);
+		if (contents != NULL && fread(contents, 1, (size_t)*size, file) != (size_t)*size) {
+			free(contents);
+			contents = NULL;
+		}
+	}
+	fclose(file);
+	return contents;
+}
+
+
+int loadWav(WavSound *sound, const char *path) {
+	long size = 0;
+	u8 *file = readFile(path, &size);
+	const u8 *format = NULL, *data = NULL;
+	u32 dataSize = 0;
+
+	memset(sound, 0, sizeof(WavSound));
+	if (file == NULL)
+		return -1;
+	if (size < 12 || memcmp(file, "RIFF", 4) != 0 || memcmp(file + 8, "WAVE", 4) != 0) {
+		free(file);
+		return -1;
+	}
+	for (long at = 12; at + 8 <= size; ) {
+		u32 chunkSize = littleEndian32(file + at + 4);
+		if (chunkSize > (u32)(size - at - 8))
+			chunkSize = (u32)(size - at - 8);
+		if (memcmp(file + at, "fmt ", 4) == 0 && chunkSize >= 16)
+			format = file + at + 8;
+		else if (memcmp(file + at, "data", 4) == 0) {
+			data = file + at + 8;
+			dataSize = chunkSize;
+		}
+		at += 8 + ((chunkSize + 1) & ~1u);
+	}
+
+	u16 channels = (format != NULL) ? littleEndian16(format + 2) : 0;
+	u16 bits = (format != NULL) ? littleEndian16(format + 14) : 0;
+	if (format == NULL || data == NULL || littleEndian16(format) != WAV_PCM || channels == 0 || (bits != 8 && bits != 16)) {
+		free(file);
+		return -1;
+	}
+	sound->rate = littleEndian32(format + 4);
+	sound->count = dataSize / (channels * (bits / 8u));
+	sound->samples = malloc(sizeof(s16) * (sound->count + 1u));
+	if (sound->samples == NULL || sound->rate == 0) {
+		free(file);
+		freeWav(sound);
+		return -1;
+	}
+
+	// 8-bit samples are unsigned, 16-bit ones signed: both become 16-bit signed, then the mean of the channels.
+	for (u32 i = 0; i < sound->count; ++i) {
+		s32 sum = 0;
+		for (u16 channel = 0; channel < channels; ++channel) {
+			const u8 *sample = data + ((size_t)i * channels + channel) * (bits / 8u);
+			sum += (bits == 8) ? (sample[0] - 128) * 256 : (s16)littleEndian16(sample);
+		}
+		sound->samples[i] = (s16)(sum / channels);
+	}
+	free(file);
+	return 0;
+}
+
+
+void freeWav(WavSound *sound) {
+	free(sound->samples);
+	sound->samples = NULL;
+	sound->count = 0;
+}
+
+
+u32 resampledLength(const WavSound *sound, u32 rate) {
+	return (u32)((unsigned long long)sound->count * rate / sound->rate);
+}
+
+
+void resampleWav(s8 *pcm, const WavSound *sound, u32 rate) {
+	u32 length = resampledLength(sound, rate);
+	double step = (double)sound->rate / rate;
+
+	for (u32 i = 0; i < length; ++i) {
+		// The source samples from the nearest one to where this sample starts to the nearest one to where the next starts.
+		u32 first = (u32)(i * step + 0.5), last = (u32)((i + 1) * step + 0.5);
+		if (first >= sound->count)
+			first = sound->count - 1;
+		if (last > sound->count)
+			last = sound->count;
+		if (last <= first)
+			last = first + 1;
+		s32 sum = 0;
+		for (u32 j = first; j < last; ++j)
+			sum += sound->samples[j];
+		s32 divisor = (s32)(last - first) * 256;
+		s32 value = (sum >= 0) ? sum / divisor : -((divisor - 1 - sum) / divisor);
+		pcm[i] = (s8)((value > 127) ? 127 : (value < -128) ? -128 : value);
+	}
+}
@@ -0,0 +1,176 @@
+/*!
+\file WorkStealing.c
+\brief Work-stealing scheduler file
+\date 10/2026
+
+Lock-free work-stealing scheduler for numbered jobs.
+*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+
+#include "../inc/WorkStealing.h"
+
+/*! \brief Remaining jobs of one worker, packed as (begin << 32) | end.
+
+	Each range sits on its own cache line, so workers taking their own jobs do not slow each other down.
+*/
+typedef struct {
+	_Alignas(64) _Atomic uint64_t range;
+} WorkerRange;
+
+/*! \brief Everything the worker threads share. */
+typedef struct {
+	WorkerRange ranges[MAX_WORKERS];
+	u32 threadCount;
+	u32 chunk;
+	WorkFunction *work;
+	void *argument;
+	WorkerStats *stats;
+} Scheduler;
+
+/*! \brief Argument of one worker thread. */
+typedef struct {
+	Scheduler *scheduler;
+	u32 worker;
+	WorkerStats stats;
+} Worker;
+
+
+static uint64_t packRange(u32 begin, u32 end) {
+	return ((uint64_t)begin << 32) | end;
+}
+
+
+/*! Takes the next chunk of jobs from the front of a worker's own range.
+\param *range Range of the worker.
+\param chunk Maximum number of jobs to take.
+\param *begin Written with the first job taken.
+\param *end Written with one past the last job taken.
+\return 1 (TRUE) if jobs were taken.
+*/
+static u8 takeFront(WorkerRange *range, u32 chunk, u32 *begin, u32 *end) {
+	uint64_t old = atomic_load_explicit(&range->range, memory_order_acquire);
+
+	for (;;) {
+		u32 first = (u32)(old >> 32), last = (u32)old;
+		if (first >= last)
+			return FALSE;
+
+		u32 next = (last - first > chunk) ? first + chunk : last;
+		if (atomic_compare_exchange_weak_explicit(&range->range, &old, packRange(next, last), memory_order_acq_rel, memory_order_acquire)) {
+			*begin = first;
+			*end = next;
+			return TRUE;
+		}
+	}
+}
+
+
+/*! Steals the back half of another worker's range (all of it when a single job is left).
+\param *range Range of the victim.
+\param *begin Written with the first job stolen.
+\param *end Written with one past the last job stolen.
+\return 1 (TRUE) if jobs were stolen.
+*/
+static u8 stealBack(WorkerRange *range, u32 *begin, u32 *end) {
+	uint64_t old = atomic_load_explicit(&range->range, memory_order_acquire);
+
+	for (;;) {
+		u32 first = (u32)(old >> 32), last = (u32)old;
+		if (first >= last)
+			return FALSE;
+
+		u32 middle = first + (last - first) / 2;
+		if (atomic_compare_exchange_weak_explicit(&range->range, &old, packRange(first, middle), memory_order_acq_rel, memory_order_acquire)) {
+			*begin = middle;
+			*end = last;
+			return TRUE;
+		}
+	}
+}
+
+
+uint64_t monotonicNanoseconds() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+
+static void *workerThread(void *argument) {
+	Worker *self = argument;
+	Scheduler *scheduler = self->scheduler;
+	WorkerRange *own = &scheduler->ranges[self->worker];
+	u32 begin, end;
+
+	for (;;) {
+		while (takeFront(own, scheduler->chunk, &begin, &end)) {
+			uint64_t start = monotonicNanoseconds();
+			scheduler->work(scheduler->argument, self->worker, begin, end);
+			self->stats.busyNanoseconds += monotonicNanoseconds() - start;
+			self->stats.jobs += end - begin;
+			self->stats.chunks++;
+		}
+
+		// Out of jobs: visit the other workers, starting with the next one.
+		u8 stole = FALSE;
+		for (u32 i = 1; i < scheduler->threadCount && !stole; ++i) {
+			u32 victim = (self->worker + i) % scheduler->threadCount;
+			if (stealBack(&scheduler->ranges[victim], &begin, &end)) {
+				// Publish the stolen jobs, so that others can steal from them in turn.
+				atomic_store_explicit(&own->range, packRange(begin, end), memory_order_release);
+				self->stats.steals++;
+				stole = TRUE;
+			}
+		}
+
+		// Every range was empty. Jobs in flight belong to the worker that took them.
+		if (!stole)
+			return NULL;
+	}
+}
+
+
+int runWorkStealing(u32 jobCount, u32 threadCount, u32 chunk, WorkFunction *work, void *argument, WorkerStats *stats) {
+	Scheduler scheduler;
+	Worker workers[MAX_WORKERS];
+	pthread_t threads[MAX_WORKERS];
+	u32 i, started;
+
+	if (threadCount == 0 || threadCount > MAX_WORKERS)
+		return -1;
+
+	scheduler.threadCount = threadCount;
+	scheduler.chunk = (chunk > 0) ? chunk : 1;
+	scheduler.work = work;
+	scheduler.argument = argument;
+
+	// Equal shares to start with.
+	for (i = 0; i < threadCount; ++i) {
+		u32 begin = (u32)((uint64_t)jobCount * i / threadCount);
+		u32 end = (u32)((uint64_t)jobCount * (i + 1) / threadCount);
+		atomic_store(&scheduler.ranges[i].range, packRange(begin, end));
+		workers[i].scheduler = &scheduler;
+		workers[i].worker = i;
+		memset(&workers[i].stats, 0, sizeof(WorkerStats));
+	}
+
+	for (started = 0; started < threadCount; ++started)
+		if (pthread_create(&threads[started], NULL, workerThread, &workers[started]) != 0)
+			break;
+
+	// Started workers still finish every job by stealing from the missing ones.
+	for (i = 0; i < started; ++i)
+		pthread_join(threads[i], NULL);
+
+	if (stats != NULL)
+		for (i = 0; i < threadCount; ++i)
+			stats[i] = workers[i].stats;
+
+	return (started == 0) ? -1 : 0;
+}
@@ -0,0 +1,419 @@
+/*!
+\file WorldBatch.c
+\brief Batched world file
+\date 10/2026
+
+Runs combatSystem on many worlds at once (see WorldBatch.h).
+The SSE2 and AVX2 kernels are compiled with target attributes and picked at run time,
+so the host build needs no special compiler flags.
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BATCH_X86 1
+#endif
+
+#include "../inc/WorldBatch.h"
+
+#define FIELD_COUNT 11	/*!< Number of component field arrays (mask to generation). */
+#define LANE_COUNT 4	/*!< Number of per-world u16 arrays (currentPlayer to finished). */
+#define LANE_FINISHED 0xFFFF	/*!< Value of 'finished' once combatSystem returned for a world. */
+
+#if ENTITY_BITS > 16
+#error Entity slots are stored as u16 in a WorldBatch.
+#endif
+
+
+int createWorldBatch(WorldBatch *batch, u32 worlds) {
+	u32 stride = (worlds + BATCH_ALIGNMENT - 1) / BATCH_ALIGNMENT * BATCH_ALIGNMENT;
+	size_t fieldSize = (size_t)ENTITY_COUNT * stride;
+	u16 *arrays[FIELD_COUNT + LANE_COUNT];
+
+	size_t size = (FIELD_COUNT * fieldSize + LANE_COUNT * (size_t)stride) * sizeof(u16) + stride * sizeof(u32);
+
+	memset(batch, 0, sizeof(WorldBatch));
+	batch->memory = aligned_alloc(64, (size + 63) / 64 * 64);
+	if (batch->memory == NULL)
+		return -1;
+	memset(batch->memory, 0, size);
+
+	arrays[0] = batch->memory;
+	for (u32 i = 1; i < FIELD_COUNT + LANE_COUNT; ++i)
+		arrays[i] = arrays[i - 1] + ((i <= FIELD_COUNT) ? fieldSize : stride);
+
+	batch->worlds = worlds;
+	batch->stride = stride;
+	batch->mask = arrays[0];
+	batch->points = arrays[1];
+	batch->staggered = arrays[2];
+	batch->frames = arrays[3];
+	batch->facing = arrays[4];
+	batch->move = arrays[5];
+	batch->spriteData = arrays[6];
+	batch->isActive = arrays[7];
+	batch->memberId = arrays[8];
+	batch->facingGeneration = arrays[9];
+	batch->generation = arrays[10];
+	batch->currentPlayer = arrays[11];
+	batch->eventSFX = arrays[12];
+	batch->difficultyAIaccumulator = arrays[13];
+	batch->finished = arrays[14];
+	batch->randomAI = (u32 *)(batch->finished + stride); // stride is a multiple of 16: stays aligned
+	return 0;
+}
+
+
+void destroyWorldBatch(WorldBatch *batch) {
+	free(batch->memory);
+	memset(batch, 0, sizeof(WorldBatch));
+}
+
+
+void copyWorldBatch(WorldBatch *destination, const WorldBatch *source) {
+	memcpy(destination->memory, source->memory, (FIELD_COUNT * ENTITY_COUNT + LANE_COUNT) * (size_t)source->stride * sizeof(u16) + source->stride * sizeof(u32));
+}
+
+
+void storeWorldInBatch(WorldBatch *batch, u32 index, const World *world, const SimContext *context) {
+	for (u32 entity = 0, i = index; entity < ENTITY_COUNT; ++entity, i += batch->stride) {
+		batch->mask[i] = world->mask[entity];
+		batch->points[i] = world->health[entity].points;
+		batch->staggered[i] = world->health[entity].staggered;
+		batch->frames[i] = world->timing[entity].frames;
+		batch->facing[i] = world->timing[entity].facing;
+		batch->move[i] = world->move[entity].move;
+		batch->spriteData[i] = (u16)world->sprite[entity].spriteData;
+		batch->isActive[i] = world->teamMember[entity].isActive;
+		batch->memberId[i] = world->teamMember[entity].id;
+		batch->facingGeneration[i] = world->timing[entity].facingGeneration;
+		batch->generation[i] = world->generation[entity];
+	}
+	batch->currentPlayer[index] = context->currentPlayer;
+	batch->eventSFX[index] = context->eventSFX;
+	batch->randomAI[index] = context->randomAI.state;
+	batch->difficultyAIaccumulator[index] = context->difficultyAIaccumulator;
+}
+
+
+void loadWorldFromBatch(const WorldBatch *batch, u32 index, World *world, SimContext *context) {
+	for (u32 entity = 0, i = index; entity < ENTITY_COUNT; ++entity, i += batch->stride) {
+		world->mask[entity] = batch->mask[i];
+		world->health[entity].points = batch->points[i];
+		world->health[entity].staggered = (u8)batch->staggered[i];
+		world->timing[entity].frames = batch->frames[i];
+		world->timing[entity].facing = batch->facing[i];
+		world->move[entity].move = batch->move[i];
+		world->sprite[entity].spriteData = (SpriteSheet)batch->spriteData[i];
+		world->teamMember[entity].isActive = batch->isActive[i];
+		world->teamMember[entity].id = batch->memberId[i];
+		world->timing[entity].facingGeneration = (u8)batch->facingGeneration[i];
+		world->generation[entity] = (u8)batch->generation[i];
+	}
+	context->currentPlayer = (EntitySlot)batch->currentPlayer[index];
+	context->eventSFX = (u8)batch->eventSFX[index];
+	context->randomAI.state = batch->randomAI[index];
+	rebuildEntitySets(world);
+	context->difficultyAIaccumulator = batch->difficultyAIaccumulator[index];
+}
+
+
+BatchKernel bestBatchKernel() {
+#ifdef BATCH_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return BatchKernelAVX2;
+	if (__builtin_cpu_supports("sse2"))
+		return BatchKernelSSE2;
+#endif
+	return BatchKernelScalar;
+}
+
+
+const char *batchKernelName(BatchKernel kernel) {
+	switch (kernel)
+	{
+	case BatchKernelSSE2:
+		return "sse2";
+	case BatchKernelAVX2:
+		return "avx2";
+	case BatchKernelScalar: default:
+		return "scalar";
+	}
+}
+
+
+/*! Same as isAttacking in Systems.c, for a move value. */
+static u8 isAttackingMove(u16 move) {
+	switch (move)
+	{
+	case Idling: case Guarding: case Parrying: case Staggered: case Dying:
+		return FALSE;
+	default:
+		return TRUE;
+	}
+}
+
+
+/*! Same as DealDamage in Systems.c, for one hit point value of the batch. */
+static void dealBatchDamage(u16 *points, u16 damage, u8 isFatal) {
+	if (*points > damage)
+		*points -= damage;
+	else
+		*points = (isFatal) ? 0 : 1;
+}
+
+
+/*! Resolves the rest of combatSystem for one entity of one world, once its frame count was increased.
+
+	Only needed when the entity lands an attack or finishes dying this frame, which is rare,
+	so this is plain scalar code mirroring combatSystem line by line.
+\param *batch The batch.
+\param entity Entity slot being processed.
+\param lane Which world of the batch.
+\return void
+*/
+static void resolveLane(WorldBatch *batch, u32 entity, u32 lane) {
+	u32 stride = batch->stride;
+	u32 self = entity * stride + lane;
+
+	// If an attack lands this frame
+	if (batch->frames[self] == ATTACK_FRAMES && isAttackingMove(batch->move[self])) {
+		u32 target = batch->facing[self] * stride + lane;
+		if (batch->mask[target] == COMPONENT_NONE || batch->generation[target] != batch->facingGeneration[self])
+			return; // Opponent destroyed since: nobody to hit (see facedEntity).
+
+		// Guarding
+		if (batch->move[target] == Guarding) {
+			batch->eventSFX[lane] = SFX_PARRYGUARD;
+			if (batch->frames[target] > (PARRY_FRAMES / 2))
+				dealBatchDamage(&batch->points[target], (batch->move[self] == B1) ? 2 : 1, FALSE);
+			return;
+		}
+
+		// Parrying
+		if (batch->move[target] == Parrying && batch->frames[target] < PARRY_FRAMES) {
+			batch->eventSFX[lane] = SFX_PARRYGUARD;
+			batch->staggered[self] = STAGGERED_FRAMES + 8;
+			batch->move[self] = Staggered;
+			batch->frames[self] = 0;
+			return;
+		}
+
+		// Clean hit
+		dealBatchDamage(&batch->points[target], 4, TRUE);
+		batch->eventSFX[lane] = SFX_HIT;
+		if (batch->points[target] == 0) {
+			batch->frames[target] = 0;
+			batch->move[target] = Dying;
+		}
+		else {
+			batch->move[target] = Staggered;
+			batch->staggered[target] = STAGGERED_FRAMES;
+		}
+	}
+
+	// Character finished dying animation -> switch char / end game
+	if (batch->move[self] == Dying && batch->frames[self] == DEATH_FRAMES) {
+		u16 currentPlayer = batch->currentPlayer[lane];
+		u32 player = currentPlayer * stride + lane;
+
+		batch->finished[lane] = LANE_FINISHED; // Don't loop over entities anymore.
+		if (entity == currentPlayer || entity == 0)
+			return;
+
+		u8 faced = batch->mask[self] != COMPONENT_NONE && batch->facing[player] == entity
+			&& batch->facingGeneration[player] == batch->generation[self];
+		if (batch->mask[self] != COMPONENT_NONE)
+			batch->generation[self] = (batch->generation[self] + 1) & 0xFF;
+		batch->mask[self] = COMPONENT_NONE;
+		if (!faced)
+			return;
+		u32 enemy = entity;
+		while (--enemy > 0 && (batch->mask[enemy * stride + lane] == COMPONENT_NONE
+			|| (batch->mask[enemy * stride + lane] & COMPONENT_TEAMMEMBER)));
+		batch->facing[player] = enemy;
+		batch->facingGeneration[player] = batch->generation[enemy * stride + lane];
+		u32 next = enemy * stride + lane;
+		batch->move[next] = Idling;
+		batch->frames[next] = 0;
+		batch->facing[next] = currentPlayer;
+		batch->facingGeneration[next] = batch->generation[player];
+	}
+}
+
+
+/*! Runs combatSystem one world at a time. Reference for the vector kernels. */
+static void combatBatchScalar(WorldBatch *batch) {
+	for (u32 entity = 0; entity < ENTITY_COUNT; ++entity) {
+		for (u32 lane = 0; lane < batch->worlds; ++lane) {
+			u32 i = entity * batch->stride + lane;
+			if (batch->finished[lane])
+				continue;
+
+			if (batch->staggered[i] > 0)
+				batch->staggered[i]--;
+
+			// If move finished, set character as idle.
+			if ((isAttackingMove(batch->move[i]) && batch->frames[i] > (ATTACK_FRAMES + FOLLOWUP_FRAMES))
+				|| (batch->move[i] == Parrying && batch->frames[i] > (PARRY_FRAMES + FOLLOWUP_FRAMES))
+				|| (batch->move[i] == Staggered && batch->staggered[i] == 0)) {
+				batch->move[i] = Idling;
+				batch->frames[i] = 0;
+			}
+
+			// If idle, don't increase frame count.
+			if (batch->move[i] == Idling || batch->move[i] == Staggered)
+				continue;
+			batch->frames[i]++;
+
+			if (batch->frames[i] == ATTACK_FRAMES || batch->frames[i] == DEATH_FRAMES)
+				resolveLane(batch, entity, i - entity * batch->stride);
+		}
+	}
+}
+
+
+#ifdef BATCH_X86
+
+/*! Runs combatSystem on 8 worlds per instruction.
+
+	Per entity slot: stagger countdown, idle transitions and frame counting are done for all worlds with SSE2.
+	Worlds that land an attack or finish dying are then resolved one by one with resolveLane.
+	All values are small enough (moves below 16) for the signed comparisons SSE2 offers,
+	except frames, which are compared unsigned with saturating subtraction.
+*/
+__attribute__((target("sse2")))
+static void combatBatchSSE2(WorldBatch *batch) {
+	const __m128i one = _mm_set1_epi16(1), zero = _mm_setzero_si128(), ones = _mm_cmpeq_epi16(zero, zero);
+	const __m128i parrying = _mm_set1_epi16(Parrying), staggered = _mm_set1_epi16(Staggered);
+	const __m128i dying = _mm_set1_epi16(Dying), lastAttack = _mm_set1_epi16(B3);
+	const __m128i attackEnd = _mm_set1_epi16(ATTACK_FRAMES + FOLLOWUP_FRAMES), parryEnd = _mm_set1_epi16(PARRY_FRAMES + FOLLOWUP_FRAMES);
+	const __m128i attackLands = _mm_set1_epi16(ATTACK_FRAMES), deathEnds = _mm_set1_epi16(DEATH_FRAMES);
+
+	u16 *finished = batch->finished, *staggeredOf = batch->staggered, *moveOf = batch->move, *framesOf = batch->frames;
+	const u32 stride = batch->stride;
+
+	for (u32 entity = 0; entity < ENTITY_COUNT; ++entity) {
+		for (u32 lane = 0; lane < stride; lane += 8) {
+			u32 i = entity * stride + lane;
+			__m128i done = _mm_load_si128((const __m128i *)&finished[lane]);
+			__m128i oldStaggered = _mm_load_si128((const __m128i *)&staggeredOf[i]);
+			__m128i oldMove = _mm_load_si128((const __m128i *)&moveOf[i]);
+			__m128i oldFrames = _mm_load_si128((const __m128i *)&framesOf[i]);
+
+			__m128i st = _mm_subs_epu16(oldStaggered, one);
+			// Not attacking: Idling, or Guarding up to Dying (7-10)
+			__m128i passive = _mm_or_si128(_mm_cmpeq_epi16(oldMove, zero),
+				_mm_and_si128(_mm_cmpgt_epi16(oldMove, lastAttack), _mm_cmpgt_epi16(_mm_add_epi16(dying, one), oldMove)));
+			__m128i attacking = _mm_xor_si128(passive, ones);
+
+			// If move finished, set character as idle. (a > b unsigned is a -sat b != 0)
+			__m128i idle = _mm_andnot_si128(_mm_cmpeq_epi16(_mm_subs_epu16(oldFrames, attackEnd), zero), attacking);
+			idle = _mm_or_si128(idle, _mm_andnot_si128(_mm_cmpeq_epi16(_mm_subs_epu16(oldFrames, parryEnd), zero), _mm_cmpeq_epi16(oldMove, parrying)));
+			idle = _mm_or_si128(idle, _mm_and_si128(_mm_cmpeq_epi16(oldMove, staggered), _mm_cmpeq_epi16(st, zero)));
+			__m128i mv = _mm_andnot_si128(idle, oldMove);
+			__m128i fr = _mm_andnot_si128(idle, oldFrames);
+
+			// If idle, don't increase frame count.
+			__m128i running = _mm_xor_si128(_mm_or_si128(_mm_cmpeq_epi16(mv, zero), _mm_cmpeq_epi16(mv, staggered)), ones);
+			fr = _mm_sub_epi16(fr, running);
+
+			// Worlds that are already finished keep their values.
+			st = _mm_or_si128(_mm_andnot_si128(done, st), _mm_and_si128(done, oldStaggered));
+			mv = _mm_or_si128(_mm_andnot_si128(done, mv), _mm_and_si128(done, oldMove));
+			fr = _mm_or_si128(_mm_andnot_si128(done, fr), _mm_and_si128(done, oldFrames));
+			_mm_store_si128((__m128i *)&staggeredOf[i], st);
+			_mm_store_si128((__m128i *)&moveOf[i], mv);
+			_mm_store_si128((__m128i *)&framesOf[i], fr);
+
+			__m128i rare = _mm_or_si128(_mm_and_si128(attacking, _mm_cmpeq_epi16(fr, attackLands)),
+				_mm_and_si128(_mm_cmpeq_epi16(mv, dying), _mm_cmpeq_epi16(fr, deathEnds)));
+			rare = _mm_andnot_si128(done, _mm_and_si128(rare, running));
+			u32 bits = (u32)_mm_movemask_epi8(rare) & 0x5555;
+			while (bits) {
+				resolveLane(batch, entity, lane + (__builtin_ctz(bits) >> 1));
+				bits &= bits - 1;
+			}
+		}
+	}
+}
+
+
+/*! Runs combatSystem on 16 worlds per instruction. Same steps as combatBatchSSE2. */
+__attribute__((target("avx2")))
+static void combatBatchAVX2(WorldBatch *batch) {
+	const __m256i one = _mm256_set1_epi16(1), zero = _mm256_setzero_si256(), ones = _mm256_cmpeq_epi16(zero, zero);
+	const __m256i parrying = _mm256_set1_epi16(Parrying), staggered = _mm256_set1_epi16(Staggered);
+	const __m256i dying = _mm256_set1_epi16(Dying), lastAttack = _mm256_set1_epi16(B3);
+	const __m256i attackEnd = _mm256_set1_epi16(ATTACK_FRAMES + FOLLOWUP_FRAMES), parryEnd = _mm256_set1_epi16(PARRY_FRAMES + FOLLOWUP_FRAMES);
+	const __m256i attackLands = _mm256_set1_epi16(ATTACK_FRAMES), deathEnds = _mm256_set1_epi16(DEATH_FRAMES);
+
+	u16 *finished = batch->finished, *staggeredOf = batch->staggered, *moveOf = batch->move, *framesOf = batch->frames;
+	const u32 stride = batch->stride;
+
+	for (u32 entity = 0; entity < ENTITY_COUNT; ++entity) {
+		for (u32 lane = 0; lane < stride; lane += 16) {
+			u32 i = entity * stride + lane;
+			__m256i done = _mm256_load_si256((const __m256i *)&finished[lane]);
+			__m256i oldStaggered = _mm256_load_si256((const __m256i *)&staggeredOf[i]);
+			__m256i oldMove = _mm256_load_si256((const __m256i *)&moveOf[i]);
+			__m256i oldFrames = _mm256_load_si256((const __m256i *)&framesOf[i]);
+
+			__m256i st = _mm256_subs_epu16(oldStaggered, one);
+			__m256i passive = _mm256_or_si256(_mm256_cmpeq_epi16(oldMove, zero),
+				_mm256_and_si256(_mm256_cmpgt_epi16(oldMove, lastAttack), _mm256_cmpgt_epi16(_mm256_add_epi16(dying, one), oldMove)));
+			__m256i attacking = _mm256_xor_si256(passive, ones);
+
+			__m256i idle = _mm256_andnot_si256(_mm256_cmpeq_epi16(_mm256_subs_epu16(oldFrames, attackEnd), zero), attacking);
+			idle = _mm256_or_si256(idle, _mm256_andnot_si256(_mm256_cmpeq_epi16(_mm256_subs_epu16(oldFrames, parryEnd), zero), _mm256_cmpeq_epi16(oldMove, parrying)));
+			idle = _mm256_or_si256(idle, _mm256_and_si256(_mm256_cmpeq_epi16(oldMove, staggered), _mm256_cmpeq_epi16(st, zero)));
+			__m256i mv = _mm256_andnot_si256(idle, oldMove);
+			__m256i fr = _mm256_andnot_si256(idle, oldFrames);
+
+			__m256i running = _mm256_xor_si256(_mm256_or_si256(_mm256_cmpeq_epi16(mv, zero), _mm256_cmpeq_epi16(mv, staggered)), ones);
+			fr = _mm256_sub_epi16(fr, running);
+
+			st = _mm256_blendv_epi8(st, oldStaggered, done);
+			mv = _mm256_blendv_epi8(mv, oldMove, done);
+			fr = _mm256_blendv_epi8(fr, oldFrames, done);
+			_mm256_store_si256((__m256i *)&staggeredOf[i], st);
+			_mm256_store_si256((__m256i *)&moveOf[i], mv);
+			_mm256_store_si256((__m256i *)&framesOf[i], fr);
+
+			__m256i rare = _mm256_or_si256(_mm256_and_si256(attacking, _mm256_cmpeq_epi16(fr, attackLands)),
+				_mm256_and_si256(_mm256_cmpeq_epi16(mv, dying), _mm256_cmpeq_epi16(fr, deathEnds)));
+			rare = _mm256_andnot_si256(done, _mm256_and_si256(rare, running));
+			u32 bits = (u32)_mm256_movemask_epi8(rare) & 0x55555555;
+			while (bits) {
+				resolveLane(batch, entity, lane + (__builtin_ctz(bits) >> 1));
+				bits &= bits - 1;
+			}
+		}
+	}
+}
+
+#endif // BATCH_X86
+
+
+void combatSystemBatch(WorldBatch *batch, BatchKernel kernel) {
+	memset(batch->finished, 0, batch->stride * sizeof(u16));
+
+	switch (kernel)
+	{
+#ifdef BATCH_X86
+	case BatchKernelSSE2:
+		combatBatchSSE2(batch);
+		break;
+	case BatchKernelAVX2:
+		combatBatchAVX2(batch);
+		break;
+#endif
+	case BatchKernelScalar: default:
+		combatBatchScalar(batch);
+		break;
+	}
+}
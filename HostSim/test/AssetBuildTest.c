@@ -0,0 +1,477 @@
+/*!
+\file AssetBuildTest.c
+\brief Test of the resource build
+\date 10/2026
+
+Builds images.res and sprites.res, and compares the .s files, as gas assembles them, with the objects rescomp's .s
+files became (Gemu/out/res/images.o and sprites.o): the same bytes, the same labels at the same places, the same
+pointers. Only palette entries past the PLTE chunk of the PNG files differ: rescomp writes whatever its buffer held.
+Then:
+- Building again converts nothing and writes nothing; changing one input file converts that resource only.
+- Sprite sheets main.c draws with the tiles of another sheet have the same pixels as that sheet.
+- WAV resources: as many samples as rescomp, at the same places, most the same or one step away.
+- XGM resources: a compiled .xgc file is written as rescomp writes music; without xgmtool, a .vgm file fails the build.
+
+Usage: assetbuildtest "Resource Compilation" Gemu/out/res
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Png.h"
+#include "Resource.h"
+#include "ResourceBuild.h"
+
+#define RODATA_SECTION ".rodata"
+#define RELOCATIONS_SECTION ".rela.rodata"
+#define MAX_LINE 4096
+
+/*! \brief Structure with a label, or a pointer to one. */
+typedef struct {
+	char *name;
+	u32 offset;
+} Label;
+
+/*! \brief Structure with the .rodata section of an object, or of a .s file as gas would assemble it. */
+typedef struct {
+	u8 *bytes;
+	u32 size;
+	Label *labels;	/**< Sorted by name */
+	u32 labelCount;
+	Label *pointers;	/**< Offset of every pointer and the label it points to, by offset */
+	u32 pointerCount;
+	u32 *targets;	/**< Objects: offset every pointer points to */
+} Section;
+
+static char *directory;	/*!< Work directory of the test. */
+
+
+static int fail(const char *message, const char *detail) {
+	printf("FAIL: %s (%s)\n", message, detail);
+	return 1;
+}
+
+
+static u8 *readFile(const char *path, long *size) {
+	FILE *file = fopen(path, "rb");
+	u8 *contents = NULL;
+
+	if (file == NULL)
+		return NULL;
+	if (fseek(file, 0, SEEK_END) == 0 && (*size = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0) {
+		contents = malloc((size_t)*size + 1);
+		if (contents != NULL && fread(contents, 1, (size_t)*size, file) != (size_t)*size) {
+			free(contents);
+			contents = NULL;
+		}
+	}
+	fclose(file);
+	return contents;
+}
+
+static int writeFile(const char *path, const void *contents, size_t size) {
+	FILE *file = fopen(path, "wb");
+	if (file == NULL)
+		return -1;
+	size_t written = fwrite(contents, 1, size, file);
+	return (fclose(file) == 0 && written == size) ? 0 : -1;
+}
+
+
+static int compareLabels(const void *a, const void *b) {
+	return strcmp(((const Label *)a)->name, ((const Label *)b)->name);
+}
+
+static const Label *findLabel(const Section *section, const char *name) {
+	Label key = { (char *)name, 0 };
+	return bsearch(&key, section->labels, section->labelCount, sizeof(Label), compareLabels);
+}
+
+static void addLabel(Label **labels, u32 *count, const char *name, size_t length, u32 offset) {
+	if ((*count & (*count - 1)) == 0)
+		*labels = realloc(*labels, sizeof(Label) * (*count == 0 ? 1 : *count * 2));
+	(*labels)[*count].name = strndup(name, length);
+	(*labels)[(*count)++].offset = offset;
+}
+
+
+static u32 bigEndian32(const u8 *bytes) {
+	return ((u32)bytes[0] << 24) | ((u32)bytes[1] << 16) | ((u32)bytes[2] << 8) | bytes[3];
+}
+
+static u16 bigEndian16(const u8 *bytes) {
+	return (u16)((bytes[0] << 8) | bytes[1]);
+}
+
+
+/*! Reads the .rodata section of a 68000 ELF object: bytes, named symbols, and where its relocations point. */
+static int readObject(Section *section, const char *path) {
+	long size = 0;
+	u8 *elf = readFile(path, &size);
+	memset(section, 0, sizeof(Section));
+	if (elf == NULL || size < 52 || memcmp(elf, "\177ELF", 4) != 0)
+		return fail("not an ELF object", path);
+
+	const u8 *headers = elf + bigEndian32(elf + 0x20);
+	u16 count = bigEndian16(elf + 0x30);
+	const u8 *names = elf + bigEndian32(headers + bigEndian16(elf + 0x32) * 40 + 16);
+	const u8 *rodata = NULL, *symbols = NULL, *relocations = NULL;
+	u16 rodataIndex = 0;
+	for (u16 i = 0; i < count; ++i) {
+		const u8 *header = headers + i * 40;
+		const char *name = (const char *)names + bigEndian32(header);
+		if (strcmp(name, RODATA_SECTION) == 0) {
+			rodata = header;
+			rodataIndex = i;
+		}
+		else if (strcmp(name, RELOCATIONS_SECTION) == 0)
+			relocations = header;
+		else if (bigEndian32(header + 4) == 2)
+			symbols = header;
+	}
+	if (rodata == NULL || symbols == NULL)
+		return fail("no .rodata or symbols", path);
+	section->size = bigEndian32(rodata + 20);
+	section->bytes = malloc(section->size + 1u);
+	memcpy(section->bytes, elf + bigEndian32(rodata + 16), section->size);
+
+	const u8 *symbol = elf + bigEndian32(symbols + 16);
+	const char *strings = (const char *)elf + bigEndian32(headers + bigEndian32(symbols + 24) * 40 + 16);
+	u32 symbolCount = bigEndian32(symbols + 20) / 16;
+	for (u32 i = 0; i < symbolCount; ++i, symbol += 16)
+		if (bigEndian16(symbol + 14) == rodataIndex && strings[bigEndian32(symbol)] != '\0')
+			addLabel(&section->labels, &section->labelCount, strings + bigEndian32(symbol), strlen(strings + bigEndian32(symbol)),
+				bigEndian32(symbol + 4));
+	qsort(section->labels, section->labelCount, sizeof(Label), compareLabels);
+
+	// R_68K_32 relocations: symbol value (0 for the section symbol) plus addend.
+	u32 relocationCount = (relocations != NULL) ? bigEndian32(relocations + 20) / 12 : 0;
+	section->pointers = malloc(sizeof(Label) * (relocationCount + 1u));
+	section->targets = malloc(sizeof(u32) * (relocationCount + 1u));
+	for (u32 i = 0; i < relocationCount; ++i) {
+		const u8 *relocation = elf + bigEndian32(relocations + 16) + i * 12;
+		const u8 *target = elf + bigEndian32(symbols + 16) + (bigEndian32(relocation + 4) >> 8) * 16;
+		section->pointers[i].name = NULL;
+		section->pointers[i].offset = bigEndian32(relocation);
+		section->targets[i] = bigEndian32(target + 4) + bigEndian32(relocation + 8);
+	}
+	section->pointerCount = relocationCount;
+	free(elf);
+	return 0;
+}
+
+
+/*! Lays out a .s file as gas would: .align, labels, and dc.b, dc.w and dc.l of numbers or labels. */
+static int readAssembly(Section *section, const char *path) {
+	char line[MAX_LINE];
+	FILE *file = fopen(path, "r");
+	u32 capacity = 0x10000;
+
+	memset(section, 0, sizeof(Section));
+	if (file == NULL)
+		return fail("cannot read", path);
+	section->bytes = calloc(capacity, 1);
+	while (fgets(line, sizeof(line), file) != NULL) {
+		char *at = line;
+		while (*at == ' ' || *at == '\t')
+			++at;
+		if (at == line && strchr(line, ':') != NULL) {
+			addLabel(&section->labels, &section->labelCount, line, (size_t)(strchr(line, ':') - line), section->size);
+			continue;
+		}
+		u32 width = (strncmp(at, "dc.b", 4) == 0) ? 1 : (strncmp(at, "dc.w", 4) == 0) ? 2 : (strncmp(at, "dc.l", 4) == 0) ? 4 : 0;
+		if (strncmp(at, ".align", 6) == 0) {
+			u32 alignment = (u32)strtoul(at + 6, NULL, 10);
+			section->size = (section->size + alignment - 1) / alignment * alignment;
+		}
+		if (width == 0)
+			continue;
+		for (char *value = strtok(at + 4, ", \t\r\n"); value != NULL; value = strtok(NULL, ", \t\r\n")) {
+			if (section->size + 4 > capacity) {
+				section->bytes = realloc(section->bytes, capacity * 2);
+				memset(section->bytes + capacity, 0, capacity);
+				capacity *= 2;
+			}
+			unsigned long number = 0;
+			if ((value[0] < '0' || value[0] > '9') && value[0] != '-')
+				addLabel(&section->pointers, &section->pointerCount, value, strlen(value), section->size);
+			else
+				number = strtoul(value, NULL, 0);
+			for (u32 i = 0; i < width; ++i)
+				section->bytes[section->size + i] = (u8)(number >> (8 * (width - 1 - i)));
+			section->size += width;
+		}
+	}
+	fclose(file);
+	qsort(section->labels, section->labelCount, sizeof(Label), compareLabels);
+	return 0;
+}
+
+
+static void freeSection(Section *section) {
+	for (u32 i = 0; i < section->labelCount; ++i)
+		free(section->labels[i].name);
+	for (u32 i = 0; section->targets == NULL && i < section->pointerCount; ++i)
+		free(section->pointers[i].name);
+	free(section->labels);
+	free(section->pointers);
+	free(section->targets);
+	free(section->bytes);
+}
+
+
+/*! Compares a .s file built from a .res file with the object of the .s file rescomp built from it. */
+static int compareWithRescomp(const char *resourcePath, const char *assemblyPath, const char *objectPath) {
+	Section built, object;
+	Resource *resources;
+	u32 count;
+
+	if (readResourceFile(&resources, &count, resourcePath) != 0 || readAssembly(&built, assemblyPath) != 0 || readObject(&object, objectPath) != 0)
+		return 1;
+	if (built.size != object.size)
+		return fail("size differs from rescomp", assemblyPath);
+	for (u32 i = 0; i < object.labelCount; ++i) {
+		const Label *label = findLabel(&built, object.labels[i].name);
+		if (label == NULL || label->offset != object.labels[i].offset)
+			return fail("label missing or somewhere else", object.labels[i].name);
+	}
+	if (built.labelCount != object.labelCount)
+		return fail("labels rescomp does not have", assemblyPath);
+	if (built.pointerCount != object.pointerCount)
+		return fail("number of pointers differs from rescomp", assemblyPath);
+	for (u32 i = 0; i < object.pointerCount; ++i) {
+		const Label *target = findLabel(&built, built.pointers[i].name);
+		if (built.pointers[i].offset != object.pointers[i].offset || target == NULL || target->offset != object.targets[i])
+			return fail("pointer differs from rescomp", built.pointers[i].name);
+	}
+
+	// Palette entries past the PLTE chunk are left out.
+	for (u32 r = 0; r < count; ++r) {
+		char name[RESOURCE_NAME + 16];
+		IndexedImage image;
+		snprintf(name, sizeof(name), "%s_palette_pal", resources[r].name);
+		const Label *palette = findLabel(&built, name);
+		if (palette == NULL || loadIndexedPng(&image, resources[r].path) != 0)
+			return fail("no palette", resources[r].name);
+		for (u32 color = image.colors; color < 16; ++color)
+			memcpy(built.bytes + palette->offset + 2 * color, object.bytes + palette->offset + 2 * color, 2);
+		freeIndexedImage(&image);
+	}
+	if (memcmp(built.bytes, object.bytes, built.size) != 0)
+		return fail("data differs from rescomp", assemblyPath);
+	printf("%s: %u resources, %u labels, %u pointers, %u bytes as rescomp builds them\n", resourcePath, count, built.labelCount,
+		built.pointerCount, built.size);
+	freeSection(&built);
+	freeSection(&object);
+	free(resources);
+	return 0;
+}
+
+
+static int build(BuildStats *stats, const char *resourcePath, const char *resourcePath2, const char *xgmtool) {
+	char cache[RESOURCE_PATH];
+	const char *paths[] = { resourcePath, resourcePath2 };
+	BuildOptions options = { cache, xgmtool, 0 };
+	snprintf(cache, sizeof(cache), "%s/cache", directory);
+	return buildResources(stats, paths, (resourcePath2 != NULL) ? 2 : 1, directory, &options);
+}
+
+
+static int expectBuild(const BuildStats *stats, u32 converted, u32 cached, u32 filesWritten, const char *what) {
+	if (stats->converted != converted || stats->cached != cached || stats->filesWritten != filesWritten) {
+		printf("FAIL: %s: %u converted, %u from the cache, %u files written; expected %u, %u, %u\n", what, stats->converted,
+			stats->cached, stats->filesWritten, converted, cached, filesWritten);
+		return 1;
+	}
+	printf("%s: %u converted, %u from the cache, %u files written\n", what, converted, cached, filesWritten);
+	return 0;
+}
+
+
+/*! Copies a file into the work directory. */
+static int copyFile(const char *from, const char *name) {
+	char path[RESOURCE_PATH];
+	long size = 0;
+	u8 *contents = readFile(from, &size);
+	snprintf(path, sizeof(path), "%s/%s", directory, name);
+	int status = (contents != NULL) ? writeFile(path, contents, (size_t)size) : -1;
+	free(contents);
+	return status;
+}
+
+
+/*! Two images from copies of their PNG files: changing one converts that one again, and only the .s file changes. */
+static int checkIncremental(const char *resources) {
+	char from[RESOURCE_PATH], path[RESOURCE_PATH];
+	const char *lines = "IMAGE a_image \"a.png\" NONE\nIMAGE b_image \"b.png\" NONE\n";
+	BuildStats stats;
+
+	if (snprintf(from, sizeof(from), "%s/image/forest1_image.png", resources) >= (int)sizeof(from))
+		return fail("path too long", resources);
+	if (copyFile(from, "a.png") != 0)
+		return fail("cannot copy", from);
+	if (snprintf(from, sizeof(from), "%s/image/greatHall0_image.png", resources) >= (int)sizeof(from))
+		return fail("path too long", resources);
+	if (copyFile(from, "b.png") != 0)
+		return fail("cannot copy", from);
+	snprintf(path, sizeof(path), "%s/two.res", directory);
+	if (writeFile(path, lines, strlen(lines)) != 0)
+		return fail("cannot write", path);
+	if (build(&stats, path, NULL, "") != 0 || expectBuild(&stats, 2, 0, 2, "two images") != 0)
+		return 1;
+	if (snprintf(from, sizeof(from), "%s/image/greatHall1_image.png", resources) >= (int)sizeof(from))
+		return fail("path too long", resources);
+	if (copyFile(from, "b.png") != 0)
+		return fail("cannot copy", from);
+	return (build(&stats, path, NULL, "") != 0 || expectBuild(&stats, 1, 1, 1, "one image changed") != 0);
+}
+
+
+/*! Sprite sheets that sheetTiles in main.c draws with the tiles of another: the same pixels, in other colors. */
+static int checkPaletteVariants(const char *resources) {
+	static const char *variants[][2] = { { "mockPlayer2.png", "mockPlayer.png" } };
+	char path[RESOURCE_PATH];
+	IndexedImage variant, sheet;
+
+	for (u32 i = 0; i < sizeof(variants) / sizeof(variants[0]); ++i) {
+		if (snprintf(path, sizeof(path), "%s/sprite/%s", resources, variants[i][0]) >= (int)sizeof(path))
+			return fail("path too long", resources);
+		if (loadIndexedPng(&variant, path) != 0)
+			return fail("cannot read", path);
+		if (snprintf(path, sizeof(path), "%s/sprite/%s", resources, variants[i][1]) >= (int)sizeof(path))
+			return fail("path too long", resources);
+		if (loadIndexedPng(&sheet, path) != 0)
+			return fail("cannot read", path);
+		if (variant.width != sheet.width || variant.height != sheet.height
+			|| memcmp(variant.pixels, sheet.pixels, (size_t)sheet.width * sheet.height) != 0)
+			return fail("not the same tiles in other colors", variants[i][0]);
+		printf("%s: the tiles of %s in other colors\n", variants[i][0], variants[i][1]);
+		freeIndexedImage(&variant);
+		freeIndexedImage(&sheet);
+	}
+	return 0;
+}
+
+
+/*! Sound effects: where rescomp put them, as many samples, each at most a step away on average. */
+static int checkSounds(const char *resources, const char *objects) {
+	static const char *names[] = { "hit_sfx", "parry_sfx", "swing_sfx" };
+	static const char *files[] = { "hit.wav", "parry.wav", "swing.wav" };
+	char path[RESOURCE_PATH], line[RESOURCE_PATH * 2];
+	Section built, object;
+	BuildStats stats;
+
+	snprintf(path, sizeof(path), "%s/sfx.res", directory);
+	FILE *file = fopen(path, "w");
+	if (file == NULL)
+		return fail("cannot write", path);
+	for (u32 i = 0; i < 3; ++i) {
+		snprintf(line, sizeof(line), "WAV %s \"%s/audio/%s\" XGM\n", names[i], resources, files[i]);
+		fputs(line, file);
+	}
+	fclose(file);
+	if (build(&stats, path, NULL, "") != 0)
+		return fail("cannot build", path);
+	snprintf(path, sizeof(path), "%s/sfx.s", directory);
+	snprintf(line, sizeof(line), "%s/audio.o", objects);
+	if (readAssembly(&built, path) != 0 || readObject(&object, line) != 0)
+		return 1;
+	for (u32 i = 0; i < 3; ++i) {
+		const Label *mine = findLabel(&built, names[i]), *theirs = findLabel(&object, names[i]);
+		if (mine == NULL || theirs == NULL || mine->offset != theirs->offset)
+			return fail("sound somewhere else than with rescomp", names[i]);
+		u32 end = (i < 2) ? findLabel(&built, names[i + 1])->offset : built.size;
+		if (i == 2 && built.size > object.size)
+			return fail("more samples than rescomp", names[i]);
+		u32 difference = 0;
+		for (u32 at = mine->offset; at < end; ++at)
+			difference += (u32)abs((s8)built.bytes[at] - (s8)object.bytes[at]);
+		if (difference >= end - mine->offset)
+			return fail("samples differ from rescomp by more than a step on average", names[i]);
+		printf("%s: %u samples, %.2f steps from rescomp on average\n", names[i], end - mine->offset, (double)difference / (end - mine->offset));
+	}
+	freeSection(&built);
+	freeSection(&object);
+	return 0;
+}
+
+
+/*! Music: compiled music written as rescomp writes it; music to compile fails the build when xgmtool cannot run. */
+static int checkMusic(const char *resources, const char *objects) {
+	char path[RESOURCE_PATH], line[RESOURCE_PATH * 2];
+	Section built, object;
+	BuildStats stats;
+
+	snprintf(path, sizeof(path), "%s/audio.o", objects);
+	if (readObject(&object, path) != 0)
+		return 1;
+	const Label *music = findLabel(&object, "heldonlyonce_music");
+	if (music == NULL)
+		return fail("no music", path);
+	u32 size = object.size - music->offset;
+	snprintf(path, sizeof(path), "%s/music.xgc", directory);
+	if (writeFile(path, object.bytes + music->offset, size) != 0)
+		return fail("cannot write", path);
+	snprintf(path, sizeof(path), "%s/music.res", directory);
+	const char *lines = "XGM heldonlyonce_music \"music.xgc\"\n";
+	if (writeFile(path, lines, strlen(lines)) != 0 || build(&stats, path, NULL, "") != 0)
+		return fail("cannot build", path);
+	snprintf(path, sizeof(path), "%s/music.s", directory);
+	if (readAssembly(&built, path) != 0)
+		return 1;
+	if (built.size != size || memcmp(built.bytes, object.bytes + music->offset, size) != 0)
+		return fail("music differs from rescomp", path);
+
+	snprintf(path, sizeof(path), "%s/vgm.res", directory);
+	snprintf(line, sizeof(line), "XGM heldonlyonce_music \"%s/audio/heldonlyonce.vgm\"\n", resources);
+	if (writeFile(path, line, strlen(line)) != 0)
+		return fail("cannot write", path);
+	if (build(&stats, path, NULL, "/nonexistent/xgmtool") == 0)
+		return fail("music built without xgmtool", path);
+	snprintf(path, sizeof(path), "%s/vgm.s", directory);
+	if (access(path, F_OK) == 0)
+		return fail("output written by a failed build", path);
+	printf("music written as rescomp writes it, and not without xgmtool\n");
+	freeSection(&built);
+	freeSection(&object);
+	return 0;
+}
+
+
+int main(int argc, char **argv) {
+	char work[] = "/tmp/assetbuildtestXXXXXX", resources[RESOURCE_PATH], images[RESOURCE_PATH], sprites[RESOURCE_PATH], path[RESOURCE_PATH], object[RESOURCE_PATH];
+	BuildStats stats;
+
+	if (argc != 3) {
+		fprintf(stderr, "usage: %s \"Resource Compilation\" Gemu/out/res\n", argv[0]);
+		return 1;
+	}
+	// Sound effects and music are built from .res files in the work directory, which name their input by absolute path.
+	if (realpath(argv[1], resources) == NULL)
+		return fail("no such directory", argv[1]);
+	if (snprintf(images, sizeof(images), "%s/images.res", resources) >= (int)sizeof(images)
+		|| snprintf(sprites, sizeof(sprites), "%s/sprites.res", resources) >= (int)sizeof(sprites))
+		return fail("path too long", resources);
+	directory = mkdtemp(work);
+	if (directory == NULL)
+		return fail("cannot make a work directory", work);
+
+	int failed = build(&stats, images, sprites, "") != 0 || expectBuild(&stats, 12, 0, 4, "images and sprites") != 0;
+	for (u32 i = 0; i < 2 && !failed; ++i) {
+		const char *name = (i == 0) ? "images" : "sprites";
+		snprintf(path, sizeof(path), "%s/%s.s", directory, name);
+		snprintf(object, sizeof(object), "%s/%s.o", argv[2], name);
+		failed = compareWithRescomp((i == 0) ? images : sprites, path, object);
+	}
+	failed = failed || build(&stats, images, sprites, "") != 0 || expectBuild(&stats, 0, 12, 0, "built again") != 0;
+	failed = failed || checkIncremental(resources) || checkPaletteVariants(resources) || checkSounds(resources, argv[2]) || checkMusic(resources, argv[2]);
+
+	snprintf(path, sizeof(path), "rm -rf '%s'", directory);
+	if (system(path) != 0)
+		printf("cannot remove %s\n", directory);
+	return failed;
+}
@@ -0,0 +1,247 @@
+/*!
+\file AssetCookerTest.c
+\brief Test of the asset cooker
+\date 10/2026
+
+For every IMAGE of images.res:
+- convertTileImage gives the tiles, tilemap and palette of the images.s rescomp built (palette entries past the
+  PLTE chunk of the PNG file left out: rescomp writes whatever its buffer held).
+- packData with aPLib and LZ4W gives data that SGDK's unpackers in the ROM, run on the 68000 interpreter,
+  unpack back to the tileset and the tilemap.
+Then with every image in one pool of shared tiles: each image draws the same pixels as before, from its window of the pool,
+and the pool is smaller than the tilesets. Last, data made to reach what the backgrounds do not: long runs, no repeats,
+far matches, a single byte.
+
+Usage: assetcookertest images.res images.s rom.bin rom.out
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Png.h"
+#include "TileImage.h"
+#include "Pack.h"
+#include "Unpack68k.h"
+
+#define MAX_IMAGES 16	/*!< Most images of images.res. */
+#define MAX_WORDS 0x8000	/*!< Most words under a label of images.s. */
+#define FAR_DATA 40000	/*!< Bytes of the far match data: past aPLib's farthest distance class (32000). */
+
+static char *assembly;	/*!< images.s */
+static TileImage images[MAX_IMAGES], original[MAX_IMAGES];
+static u8 raw[UNPACK_CAPACITY], packed[UNPACK_CAPACITY * 2], unpacked[UNPACK_CAPACITY];
+static Unpacker unpacker;
+
+
+static int fail(const char *message, const char *detail) {
+	printf("FAIL: %s (%s)\n", message, detail);
+	return 1;
+}
+
+
+/*! Reads the words under a label of images.s. Returns their number, 0 if there is no such label. */
+static u32 readWords(const char *label, u16 *words) {
+	char pattern[320];
+	u32 count = 0;
+
+	snprintf(pattern, sizeof(pattern), "\n%s:", label);
+	const char *at = strstr(assembly, pattern);
+	if (at == NULL)
+		return 0;
+	at = strchr(at + 1, '\n');
+	while (at != NULL && count < MAX_WORDS) {
+		while (*at == '\n' || *at == '\r' || *at == ' ' || *at == '\t')
+			++at;
+		if (strncmp(at, "dc.w", 4) != 0)
+			break;
+		for (at += 4; *at != '\n' && *at != '\r' && *at != '\0'; ) {
+			char *end;
+			unsigned long value = strtoul(at, &end, 16);
+			if (end == at) {
+				++at;
+				continue;
+			}
+			words[count++] = (u16)value;
+			at = end;
+		}
+	}
+	return count;
+}
+
+
+/*! Compares a converted image with what rescomp wrote for it. */
+static int compareWithRescomp(const char *name, const TileImage *image, const IndexedImage *indexed) {
+	static u16 words[MAX_WORDS];
+	char label[320];
+	u8 bytes[TILE_BYTES];
+
+	snprintf(label, sizeof(label), "%s_tileset_tiles", name);
+	if (readWords(label, words) != image->tileCount * TILE_BYTES / 2u)
+		return fail("number of tiles differs from rescomp", name);
+	for (u32 tile = 0; tile < image->tileCount; ++tile) {
+		writeTileBytes(bytes, &image->tiles[tile], 1);
+		for (u32 i = 0; i < TILE_BYTES / 2; ++i)
+			if (words[tile * TILE_BYTES / 2 + i] != (bytes[2 * i] << 8 | bytes[2 * i + 1]))
+				return fail("tile differs from rescomp", name);
+	}
+
+	snprintf(label, sizeof(label), "%s_tilemap_map", name);
+	if (readWords(label, words) != (u32)image->width * image->height)
+		return fail("tilemap size differs from rescomp", name);
+	for (u32 entry = 0; entry < (u32)image->width * image->height; ++entry)
+		if (words[entry] != image->map[entry])
+			return fail("tilemap entry differs from rescomp", name);
+
+	snprintf(label, sizeof(label), "%s_palette_pal", name);
+	if (readWords(label, words) != TILE_PALETTE_COLORS)
+		return fail("no palette", name);
+	for (u16 color = 0; color < TILE_PALETTE_COLORS && color < indexed->colors; ++color)
+		if (words[color] != image->palette[color])
+			return fail("palette differs from rescomp", name);
+	return 0;
+}
+
+
+/*! Packs data with both methods (aPLib only for an odd size), and checks that the console unpacks it back. */
+static int roundTrip(const u8 *data, u32 size, const char *name) {
+	for (u8 method = PackAplib; method < PACK_METHODS; ++method) {
+		if (method == PackLz4w && size % 2 != 0)
+			continue;
+		u32 cycles, bytes = packData((PackMethod)method, data, size, packed);
+		if (bytes == 0 || bytes > packBound(size))
+			return fail("not packed", name);
+		if (unpackOnConsole(&unpacker, (PackMethod)method, packed, bytes, unpacked, &cycles) != (s32)size
+			|| memcmp(unpacked, data, size) != 0)
+			return fail((method == PackAplib) ? "aPLib data not unpacked back" : "LZ4W data not unpacked back", name);
+	}
+	return 0;
+}
+
+
+/*! Draws the pixel of an image at a position, from its tilemap and tiles. */
+static u8 pixelAt(const TileImage *image, const Tile *tiles, u32 x, u32 y) {
+	u16 entry = image->map[(y / TILE_SIZE) * image->width + x / TILE_SIZE];
+	Tile tile;
+	flipTile(&tile, &tiles[entry & TILE_INDEX_MASK], entry & (TILE_FLIP_H | TILE_FLIP_V));
+	return (u8)((tile.row[y % TILE_SIZE] >> (4 * (TILE_SIZE - 1 - x % TILE_SIZE))) & 0xF);
+}
+
+
+/*! Checks that every image draws the same pixels from its window of the pool as from its own tiles. */
+static int checkPool(u32 count) {
+	TilePool pool;
+	u32 tiles = 0;
+
+	for (u32 i = 0; i < count; ++i)
+		tiles += images[i].tileCount;
+	if (poolTileImages(&pool, images, count) != 0)
+		return fail("pool not made", "out of memory");
+	for (u32 i = 0; i < count; ++i) {
+		if (pool.first[i] + images[i].tileCount > pool.count)
+			return fail("window past the end of the pool", "");
+		for (u32 y = 0; y < original[i].height * TILE_SIZE; ++y)
+			for (u32 x = 0; x < original[i].width * TILE_SIZE; ++x)
+				if (pixelAt(&images[i], pool.tiles + pool.first[i], x, y) != pixelAt(&original[i], original[i].tiles, x, y))
+					return fail("image drawn differently from the pool", "");
+		if (memcmp(images[i].tiles, pool.tiles + pool.first[i], sizeof(Tile) * images[i].tileCount) != 0)
+			return fail("tileset is not its window of the pool", "");
+	}
+	if (pool.count >= tiles)
+		return fail("no tile shared across images", "");
+	printf("%u images: %u tiles, %u in the pool\n", count, tiles, pool.count);
+	freeTilePool(&pool);
+	return 0;
+}
+
+
+/*! Data the backgrounds do not have: long runs, no repeats, far matches, a single byte, an odd size. */
+static int checkEdgeCases() {
+	u32 seed = 2018;
+
+	memset(raw, 0, sizeof(raw));
+	if (roundTrip(raw, 20000, "long run of zeros") != 0)
+		return 1;
+	for (u32 i = 0; i < sizeof(raw); ++i) {
+		seed = seed * 1103515245u + 12345u;
+		raw[i] = (u8)(seed >> 16);
+	}
+	if (roundTrip(raw, 4000, "no repeats") != 0 || roundTrip(raw, 1, "single byte") != 0)
+		return 1;
+	// Blocks of random bytes, each one again 33000 bytes later, and short runs in between.
+	memcpy(raw + 33000, raw, FAR_DATA - 33000);
+	for (u32 i = 0; i < FAR_DATA; i += 700)
+		memset(raw + i, raw[i], 9);
+	if (roundTrip(raw, FAR_DATA, "far matches") != 0)
+		return 1;
+	if (packData(PackLz4w, raw, 3, packed) != 0)
+		return fail("LZ4W packed an odd size", "3 bytes");
+	return 0;
+}
+
+
+int main(int argc, char **argv) {
+	char line[1024], directory[1024], path[2048];
+	u32 count = 0;
+
+	if (argc != 5) {
+		fprintf(stderr, "usage: %s images.res images.s rom.bin rom.out\n", argv[0]);
+		return 1;
+	}
+	FILE *resources = fopen(argv[1], "r"), *file = fopen(argv[2], "rb");
+	if (resources == NULL || file == NULL || openUnpacker(&unpacker, argv[3], argv[4]) != 0)
+		return fail("cannot read", "arguments");
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	assembly = calloc((size_t)size + 1, 1);
+	if (assembly == NULL || fread(assembly, 1, (size_t)size, file) != (size_t)size)
+		return fail("cannot read", argv[2]);
+	fclose(file);
+	snprintf(directory, sizeof(directory), "%s", argv[1]);
+	char *slash = strrchr(directory, '/');
+	*(slash != NULL ? slash + 1 : directory) = '\0';
+
+	while (fgets(line, sizeof(line), resources) != NULL && count < MAX_IMAGES) {
+		char name[256], file[512];
+		IndexedImage indexed;
+		if (sscanf(line, "IMAGE %255s \"%511[^\"]\"", name, file) != 2)
+			continue;
+		snprintf(path, sizeof(path), "%s%s", directory, file);
+		if (loadIndexedPng(&indexed, path) != 0 || convertTileImage(&images[count], &indexed) != 0)
+			return fail("cannot convert", path);
+		if (compareWithRescomp(name, &images[count], &indexed) != 0)
+			return 1;
+		freeIndexedImage(&indexed);
+
+		writeTileBytes(raw, images[count].tiles, images[count].tileCount);
+		if (roundTrip(raw, images[count].tileCount * TILE_BYTES, name) != 0)
+			return 1;
+		for (u32 entry = 0; entry < (u32)images[count].width * images[count].height; ++entry) {
+			raw[2 * entry] = (u8)(images[count].map[entry] >> 8);
+			raw[2 * entry + 1] = (u8)images[count].map[entry];
+		}
+		if (roundTrip(raw, images[count].width * images[count].height * 2u, name) != 0)
+			return 1;
+
+		// Keep the tiles and tilemap rescomp gives, to compare with once pooled.
+		original[count] = images[count];
+		original[count].map = malloc(sizeof(u16) * images[count].width * images[count].height);
+		original[count].tiles = malloc(sizeof(Tile) * (images[count].tileCount + 1u));
+		if (original[count].map == NULL || original[count].tiles == NULL)
+			return fail("out of memory", name);
+		memcpy(original[count].map, images[count].map, sizeof(u16) * images[count].width * images[count].height);
+		memcpy(original[count].tiles, images[count].tiles, sizeof(Tile) * images[count].tileCount);
+		++count;
+	}
+	fclose(resources);
+	if (count == 0)
+		return fail("no IMAGE", argv[1]);
+	printf("%u images as rescomp converts them, unpacked back by the console\n", count);
+
+	if (checkPool(count) != 0 || checkEdgeCases() != 0)
+		return 1;
+	printf("edge cases unpacked back by the console\n");
+	closeUnpacker(&unpacker);
+	return 0;
+}
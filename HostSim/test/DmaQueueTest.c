@@ -0,0 +1,167 @@
+/*!
+\file DmaQueueTest.c
+\brief Test of the DMA queue
+\date 10/2026
+
+Checks the order nextDma sends requests in (by priority, then as made), the budget, the deferral of what does not fit,
+the split of a request larger than the budget over frames, and the counts. Then streams the courtyard (sizes of
+res/images.s, as StageStreamTest) over the forest with the stage taking what the sprites leave, for the NTSC and PAL
+budgets: the vertical interrupt sends the sprite table of both sprites, both sprites start a new animation, sent
+whole, every 5 frames, and send 30 changed tiles in the others. No frame may send more than its budget.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "DmaQueue.h"
+#include "StageStream.h"
+
+#define FRAME_BYTES 4608	/*!< Bytes of a whole sprite frame: 144 tiles. */
+#define DELTA_BYTES 960	/*!< Bytes of a frame delta: 30 tiles. */
+#define PALETTE_BYTES 32	/*!< Bytes of a palette. */
+#define SPRITE_TABLE_BYTES 144	/*!< Bytes of the sprite table of both sprites: 9 hardware sprites each. */
+
+static const StreamImage courtyard[STREAM_PLANES] = { { 402, 30, 80 }, { 413, 13, 80 } };
+
+
+static int fail(const char *message, u32 number) {
+	printf("FAIL: %s (%u)\n", message, number);
+	return 1;
+}
+
+
+/*! Takes every request of the frame, and checks they come in the order of 'tags'. */
+static int expectSent(DmaQueue *queue, const u8 tags[], u8 count) {
+	DmaRequest request;
+	u8 sent = 0;
+
+	while (nextDma(queue, &request)) {
+		if (sent == count || request.tag != tags[sent])
+			return fail("request sent out of order", request.tag);
+		++sent;
+	}
+	return sent != count ? fail("request not sent", sent) : 0;
+}
+
+
+/*! Streams the courtyard with sprite traffic. Returns the frames it took, 0 on failure. */
+static u32 streamStage(u16 budget, u32 *overrunFrames) {
+	TileRange area = { 16, 1296 }, shown = { 16, 946 };
+	StageStream stream;
+	StreamChunk chunk;
+	DmaQueue queue;
+	u32 frame;
+	u16 bytes;
+
+	if (!planStageStream(&stream, area, shown, courtyard))
+		return fail("courtyard not planned", budget), 0;
+	initializeDmaQueue(&queue);
+	for (frame = 0; !isStreamDone(&stream); ++frame) {
+		DmaRequest request;
+		u16 sprite = (frame % 5 == 0) ? FRAME_BYTES : DELTA_BYTES;
+		startDmaFrame(&queue, budget);
+		spendDma(&queue, DmaInterrupt, SPRITE_TABLE_BYTES);
+		requestDma(&queue, DmaSpriteFrame, sprite, 0);
+		requestDma(&queue, DmaSpriteFrame, sprite, 1);
+		if (frame % 30 == 0)
+			requestDma(&queue, DmaPalette, PALETTE_BYTES, 0);
+		while (nextDma(&queue, &request));
+		while ((bytes = nextStreamChunk(&stream, TRUE, dmaBytesLeft(&queue), &chunk)) > 0)
+			spendDma(&queue, DmaStage, bytes);
+		if (queue.spent > budget)
+			return fail("frame over its budget", frame), 0;
+		if (frame > 1000)
+			return fail("stage never streamed", budget), 0;
+	}
+	if (queue.sentBytes[DmaStage] == 0 || queue.deferredBytes[DmaStage] != 0 || queue.sentBytes[DmaInterrupt] != frame * SPRITE_TABLE_BYTES)
+		return fail("stage bytes miscounted", queue.sentBytes[DmaStage]), 0;
+	*overrunFrames = queue.overrunFrames;
+	return frame;
+}
+
+
+int main() {
+	DmaQueue queue;
+	DmaRequest request;
+
+	if (DMA_BUDGET_NTSC != 6560 || DMA_BUDGET_PAL != 17015)
+		return fail("budgets", DMA_BUDGET_NTSC);
+
+	// By priority, then in the order made.
+	initializeDmaQueue(&queue);
+	startDmaFrame(&queue, DMA_BUDGET_NTSC);
+	requestDma(&queue, DmaPalette, PALETTE_BYTES, 10);
+	requestDma(&queue, DmaSpriteFrame, DELTA_BYTES, 0);
+	requestDma(&queue, DmaPalette, PALETTE_BYTES, 11);
+	requestDma(&queue, DmaSpriteFrame, DELTA_BYTES, 1);
+	const u8 ordered[] = { 0, 1, 10, 11 };
+	if (expectSent(&queue, ordered, 4) != 0)
+		return 1;
+	if (queue.overrunFrames != 0 || dmaBytesLeft(&queue) != DMA_BUDGET_NTSC - 2 * DELTA_BYTES - 2 * PALETTE_BYTES)
+		return fail("bytes left", dmaBytesLeft(&queue));
+	if (nextDma(&queue, &request))
+		return fail("request sent twice", request.tag);
+
+	// Two whole frames: the second waits, the palette after it still fits.
+	startDmaFrame(&queue, DMA_BUDGET_NTSC);
+	requestDma(&queue, DmaSpriteFrame, FRAME_BYTES, 0);
+	requestDma(&queue, DmaSpriteFrame, FRAME_BYTES, 1);
+	requestDma(&queue, DmaPalette, PALETTE_BYTES, 10);
+	const u8 deferred[] = { 0, 10 };
+	if (expectSent(&queue, deferred, 2) != 0)
+		return 1;
+	if (queue.deferredBytes[DmaSpriteFrame] != FRAME_BYTES || queue.overrunFrames != 1)
+		return fail("deferral not counted", queue.deferredBytes[DmaSpriteFrame]);
+	if (queue.sentBytes[DmaSpriteFrame] != 2 * DELTA_BYTES + FRAME_BYTES || queue.sentBytes[DmaPalette] != 3 * PALETTE_BYTES)
+		return fail("bytes sent miscounted", queue.sentBytes[DmaSpriteFrame]);
+
+	// The next frame asks for the second again.
+	startDmaFrame(&queue, DMA_BUDGET_NTSC);
+	requestDma(&queue, DmaSpriteFrame, FRAME_BYTES, 1);
+	const u8 again[] = { 1 };
+	if (expectSent(&queue, again, 1) != 0 || queue.overrunFrames != 1)
+		return 1;
+
+	// Larger than the budget: split, a part a frame, never over the budget. What the interrupt sent comes off first.
+	u16 rest = FRAME_BYTES, parts = 0;
+	while (rest > 0) {
+		startDmaFrame(&queue, 1000);
+		spendDma(&queue, DmaInterrupt, 100);
+		requestDma(&queue, DmaSpriteFrame, rest, 0);
+		requestDma(&queue, DmaPalette, PALETTE_BYTES, 10);
+		if (!nextDma(&queue, &request) || request.tag != 0 || request.bytes % DMA_SPLIT_BYTES != 0)
+			return fail("part of a request larger than the budget", rest);
+		if (rest > 900 && request.bytes != 896)
+			return fail("part not what is left of the budget", request.bytes);
+		rest -= request.bytes;
+		++parts;
+		while (nextDma(&queue, &request));
+		if (queue.spent > queue.budget)
+			return fail("split request over the budget", queue.spent);
+	}
+	if (parts != 6 || queue.overrunFrames != 6 || queue.sentBytes[DmaSpriteFrame] != 2 * DELTA_BYTES + 3 * FRAME_BYTES)
+		return fail("request larger than the budget", parts);
+
+	// Full queue: the request past DMA_REQUESTS waits.
+	startDmaFrame(&queue, DMA_BUDGET_NTSC);
+	for (u8 i = 0; i < DMA_REQUESTS; ++i)
+		if (!requestDma(&queue, DmaPalette, PALETTE_BYTES, i))
+			return fail("request refused", i);
+	if (requestDma(&queue, DmaPalette, PALETTE_BYTES, DMA_REQUESTS) || queue.overrunFrames != 7)
+		return fail("request past a full queue", DMA_REQUESTS);
+	while (nextDma(&queue, &request));
+	if (queue.frames != 10 || queue.deferredBytes[DmaPalette] != 6 * PALETTE_BYTES)
+		return fail("frames or deferred palettes miscounted", queue.frames);
+	printf("requests sent by priority within the budget, the others deferred\n");
+
+	// The stage takes what is left.
+	u32 ntscOverruns, palOverruns;
+	u32 ntsc = streamStage(DMA_BUDGET_NTSC, &ntscOverruns), pal = streamStage(DMA_BUDGET_PAL, &palOverruns);
+	if (ntsc == 0 || pal == 0)
+		return 1;
+	printf("courtyard streamed with sprite traffic: NTSC %u frames (%u over budget), PAL %u frames (%u over budget)\n", ntsc,
+		ntscOverruns, pal, palOverruns);
+	if (ntscOverruns == 0 || palOverruns != 0)
+		return fail("whole frames of both sprites deferred on NTSC only", ntscOverruns);
+	return 0;
+}
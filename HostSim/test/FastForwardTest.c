@@ -0,0 +1,131 @@
+/*!
+\file FastForwardTest.c
+\brief Test of the fast-forward of matches
+\date 10/2026
+
+Plays matches with the scripted player twice, in lockstep: frame by frame, and jumping over the frames
+quietFrames and playerBotHeldFrames find. After every jump, both must be in the same state (World, SimContext
+and scripted player, byte for byte), and every frame jumped over must have had the EventQueue fastForward returned, with no command.
+Then fastForwardMatch must give the results of playMatch.
+Built with frame counting (fastforwardtest) and with timers (fastforwardtest_wheel, ECS_TIMER_WHEEL).
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FastForward.h"
+#include "Match.h"
+
+#define MATCHES 500	/*!< Matches played, every difficulty with 1 to MAX_ALLIES allies. */
+#define DIFFICULTY_LEVELS 5	/*!< Number of DIFF_* levels. */
+
+/*! \brief Everything a match played with the scripted player changes. */
+typedef struct {
+	World world;
+	SimContext context;
+	PlayerBot bot;
+	ButtonInput input;
+} Simulation;
+
+static const u16 difficulties[DIFFICULTY_LEVELS] = { DIFF_EASY, DIFF_NORMAL, DIFF_HARD, DIFF_NIGHTMARE, DIFF_PERFECT };
+static const char *difficultyNames[DIFFICULTY_LEVELS] = { "easy", "normal", "hard", "nightmare", "perfect" };
+static Simulation stepped, skipped;	/*!< The same match, frame by frame and fast-forwarded. */
+
+
+static int fail(const char *message, u32 number) {
+	printf("FAIL: %s (%u)\n", message, number);
+	return 1;
+}
+
+
+static void startSimulation(Simulation *simulation, const MatchSetup *setup) {
+	memset(simulation, 0, sizeof(Simulation));
+	initializeMatch(&simulation->world, &simulation->context, setup->numAllies, matchSeed(setup->seed, MATCH_WORLD_STREAM));
+	initializePlayerBot(&simulation->bot, setup->seed);
+	simulation->input.isPressed = FALSE;
+	simulation->input.latestButtonPress = Neutral;
+}
+
+
+static EventQueue stepSimulation(Simulation *simulation, u16 difficulty) {
+	simulation->context.difficultyAIaccumulator += difficulty;
+	playerBotInput(&simulation->bot, &simulation->world, &simulation->context, &simulation->input);
+	return updateWorld(&simulation->world, &simulation->context, &simulation->input);
+}
+
+
+static u8 sameEvents(const EventQueue *a, const EventQueue *b) {
+	if (a->commands != b->commands)
+		return FALSE;
+	for (u8 i = 0; i < a->commands; ++i)
+		if (a->command[i].type != b->command[i].type || a->command[i].sprite != b->command[i].sprite || a->command[i].value != b->command[i].value)
+			return FALSE;
+	return TRUE;
+}
+
+
+/*! Plays a match both ways, and adds its number of frames and of frames jumped over to frames[]. */
+static int testMatch(const MatchSetup *setup, u32 *frames) {
+	startSimulation(&stepped, setup);
+	startSimulation(&skipped, setup);
+
+	for (u32 frame = 1; frame <= MATCH_FRAME_LIMIT; ++frame) {
+		u32 quiet = playerBotHeldFrames(&skipped.bot, &skipped.world, &skipped.context, &skipped.input);
+		if (quiet > MATCH_FRAME_LIMIT + 1 - frame)
+			quiet = MATCH_FRAME_LIMIT + 1 - frame;
+		quiet = quietFrames(&skipped.world, &skipped.context, &skipped.input, setup->difficulty, quiet);
+		if (quiet > 0) {
+			skipPlayerBot(&skipped.bot, quiet);
+			EventQueue events = fastForward(&skipped.world, &skipped.context, setup->difficulty, quiet);
+			for (u32 i = 0; i < quiet; ++i) {
+				EventQueue steppedEvents = stepSimulation(&stepped, setup->difficulty);
+				if (events.commands != 0 || !sameEvents(&steppedEvents, &events))
+					return fail("frame jumped over had other events", frame + i);
+				if (matchOutcome(&stepped.world, &stepped.context) != MatchPlaying)
+					return fail("match ended in a frame jumped over", frame + i);
+			}
+			if (memcmp(&stepped, &skipped, sizeof(Simulation)) != 0)
+				return fail("state differs after jumping over frames", frame);
+			frame += quiet;
+			frames[1] += quiet;
+			if (frame > MATCH_FRAME_LIMIT)
+				break;
+		}
+
+		EventQueue steppedEvents = stepSimulation(&stepped, setup->difficulty);
+		EventQueue skippedEvents = stepSimulation(&skipped, setup->difficulty);
+		if (!sameEvents(&steppedEvents, &skippedEvents) || memcmp(&stepped, &skipped, sizeof(Simulation)) != 0)
+			return fail("state differs after a frame", frame);
+		++frames[0];
+		if (matchOutcome(&stepped.world, &stepped.context) != MatchPlaying)
+			break;
+	}
+	frames[0] += frames[1];
+
+	MatchResult expected = playMatch(setup), result = fastForwardMatch(setup);
+	if (result.outcome != expected.outcome || result.frames != expected.frames || result.hash != expected.hash)
+		return fail("fastForwardMatch result differs from playMatch", setup->seed);
+	return 0;
+}
+
+
+int main() {
+	u32 frames[DIFFICULTY_LEVELS][2];
+
+	memset(frames, 0, sizeof(frames));
+	for (u32 match = 0; match < MATCHES; ++match) {
+		u32 level = match % DIFFICULTY_LEVELS;
+		MatchSetup setup = { (u8)(1 + match / DIFFICULTY_LEVELS % MAX_ALLIES), difficulties[level], matchSeed(17, match) };
+		u32 played[2] = { 0, 0 };
+		if (testMatch(&setup, played) != 0)
+			return 1;
+		frames[level][0] += played[0];
+		frames[level][1] += played[1];
+	}
+
+	printf("difficulty     frames  jumped over\n");
+	for (u32 level = 0; level < DIFFICULTY_LEVELS; ++level)
+		printf("%-10s  %9u  %10.1f%%\n", difficultyNames[level], frames[level][0], 100.0 * frames[level][1] / frames[level][0]);
+	printf("%u matches: same state after every jump as frame by frame\n", MATCHES);
+	return 0;
+}
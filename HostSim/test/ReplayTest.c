@@ -0,0 +1,167 @@
+/*!
+\file ReplayTest.c
+\brief Round-trip test of replays and replay archives
+\date 10/2026
+
+Records matches with the scripted player and plays them back through updateWorld:
+every replay must end the same way, on the same frame, in the same state (simulationHash).
+Also checks run lengths that need several LEB128 bytes, corrupt replays,
+and random access to an archive of the recorded replays.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Replay.h"
+
+#define MATCHES 200	/*!< Matches recorded. */
+
+
+static int fail(const char *message, u32 number) {
+	printf("FAIL: %s (%u)\n", message, number);
+	return 1;
+}
+
+
+/*! Long runs, a change every frame, and a button held with and without isPressed. */
+static int testRuns() {
+	static const u32 lengths[] = { 1, 1, 127, 128, 16383, 16384, 3000000, 1, 2 };
+	ReplayWriter writer;
+	ReplayReader reader;
+	ButtonInput input;
+	u32 frames = 0;
+
+	memset(&writer, 0, sizeof(ReplayWriter));
+	beginReplay(&writer, 2, DIFF_HARD, 0xDEADBEEF);
+	for (u32 run = 0; run < sizeof(lengths) / sizeof(lengths[0]); ++run) {
+		input.isPressed = run & 1;
+		input.latestButtonPress = (Button)(run % (Select + 1));
+		for (u32 i = 0; i < lengths[run]; ++i)
+			if (recordReplayFrame(&writer, &input) != 0)
+				return fail("out of memory", run);
+		frames += lengths[run];
+	}
+	if (endReplay(&writer, MatchTimedOut, 0x0123456789ABCDEFULL) != 0)
+		return fail("out of memory", 0);
+	if (writer.size > REPLAY_HEADER_SIZE + 9 * 5)
+		return fail("runs not run-length encoded", writer.size);
+
+	if (openReplay(&reader, writer.data, writer.size) != 0)
+		return fail("header not read back", 0);
+	if (reader.info.numAllies != 2 || reader.info.difficulty != DIFF_HARD || reader.info.seed != 0xDEADBEEF
+		|| reader.info.frames != frames || reader.info.outcome != MatchTimedOut || reader.info.hash != 0x0123456789ABCDEFULL)
+		return fail("header differs", 0);
+	for (u32 run = 0; run < sizeof(lengths) / sizeof(lengths[0]); ++run) {
+		for (u32 i = 0; i < lengths[run]; ++i) {
+			if (!nextReplayFrame(&reader, &input))
+				return fail("replay ends early in run", run);
+			if (input.isPressed != (run & 1) || input.latestButtonPress != (Button)(run % (Select + 1)))
+				return fail("input differs in run", run);
+		}
+	}
+	if (nextReplayFrame(&reader, &input))
+		return fail("replay too long", reader.frame);
+
+	// Cut in the middle of a run length: must stop, not read past the end.
+	if (openReplay(&reader, writer.data, writer.size - 1) != 0)
+		return fail("cut replay rejected", 0);
+	while (nextReplayFrame(&reader, &input))
+		;
+	if (reader.frame >= frames)
+		return fail("cut replay read in full", reader.frame);
+	writer.data[0] = 'X';
+	if (openReplay(&reader, writer.data, writer.size) == 0)
+		return fail("bad magic accepted", 0);
+
+	freeReplayWriter(&writer);
+	return 0;
+}
+
+
+/*! Records matches, plays them back from memory and from an archive. */
+static int testMatches() {
+	static const u16 difficulties[] = { DIFF_EASY, DIFF_NORMAL, DIFF_HARD, DIFF_NIGHTMARE, DIFF_PERFECT };
+	static u8 *replays[MATCHES];
+	static u32 sizes[MATCHES];
+	static MatchResult results[MATCHES];
+	char path[] = "/tmp/replaytestXXXXXX";
+	ReplayWriter writer;
+	ReplayArchiveWriter archiveWriter;
+	ReplayArchive archive;
+	ReplayReader reader;
+	World world;
+	SimContext context;
+	int file = mkstemp(path);
+
+	if (file < 0)
+		return fail("cannot create a temporary file", 0);
+	close(file);
+	memset(&writer, 0, sizeof(ReplayWriter));
+	for (u32 match = 0; match < MATCHES; ++match) {
+		MatchSetup setup;
+		setup.numAllies = 1 + match % MAX_ALLIES;
+		setup.difficulty = difficulties[match % 5];
+		setup.seed = matchSeed(2018, match);
+
+		results[match] = recordMatch(&setup, &writer);
+		MatchResult played = playMatch(&setup);
+		if (played.outcome != results[match].outcome || played.frames != results[match].frames || played.hash != results[match].hash)
+			return fail("recordMatch plays differently from playMatch", match);
+		if ((replays[match] = malloc(writer.size)) == NULL)
+			return fail("out of memory", match);
+		memcpy(replays[match], writer.data, writer.size);
+		sizes[match] = writer.size;
+
+		if (openReplay(&reader, replays[match], sizes[match]) != 0)
+			return fail("replay not readable", match);
+		MatchResult replayed = playReplay(&reader, &world, &context);
+		if (replayed.outcome != results[match].outcome || replayed.frames != results[match].frames
+			|| replayed.hash != results[match].hash || reader.info.frames != results[match].frames
+			|| reader.info.hash != results[match].hash)
+			return fail("replay desyncs", match);
+	}
+	freeReplayWriter(&writer);
+
+	if (createReplayArchive(&archiveWriter, path) != 0)
+		return fail("cannot create archive", 0);
+	for (u32 match = 0; match < MATCHES; ++match)
+		if (addArchiveReplay(&archiveWriter, replays[match], sizes[match]) != 0)
+			return fail("cannot add replay", match);
+	if (finishReplayArchive(&archiveWriter) != 0 || openReplayArchive(&archive, path) != 0)
+		return fail("cannot write archive", 0);
+	if (archive.count != MATCHES)
+		return fail("archive count differs", archive.count);
+
+	// Random order: each replay is found through the index alone.
+	for (u32 i = 0; i < MATCHES; ++i) {
+		u32 match = (i * 7919) % MATCHES;
+		if (openArchivedReplay(&archive, match, &reader) != 0)
+			return fail("archived replay not readable", match);
+		if ((size_t)(reader.end - (reader.next - REPLAY_HEADER_SIZE)) != sizes[match]
+			|| memcmp(reader.next - REPLAY_HEADER_SIZE, replays[match], sizes[match]) != 0)
+			return fail("archived replay differs", match);
+		MatchResult replayed = playReplay(&reader, &world, &context);
+		if (replayed.outcome != results[match].outcome || replayed.frames != results[match].frames
+			|| replayed.hash != results[match].hash)
+			return fail("archived replay desyncs", match);
+	}
+	if (openArchivedReplay(&archive, MATCHES, &reader) == 0)
+		return fail("index past the end accepted", MATCHES);
+
+	closeReplayArchive(&archive);
+	unlink(path);
+	for (u32 match = 0; match < MATCHES; ++match)
+		free(replays[match]);
+	return 0;
+}
+
+
+int main() {
+	if (testRuns() != 0 || testMatches() != 0)
+		return 1;
+	printf("replays: %d matches recorded and played back identically\n", MATCHES);
+	return 0;
+}
@@ -0,0 +1,144 @@
+/*!
+\file RollbackTest.c
+\brief Test of snapshots and of the rollback driver
+\date 10/2026
+
+A remote player (the scripted player on its own copy of the match) sends its input
+through a LoopbackLink with several delays and jitters. Once the real input of every frame up to a frame
+has arrived, the local state after that frame must be the remote one, byte for byte.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Match.h"
+#include "Rollback.h"
+
+#define FRAME_LIMIT 3000	/*!< Frames played per match at most. */
+
+/*! \brief Delay and jitter of one link. The last ones are longer than ROLLBACK_MAX_FRAMES, so the driver stalls. */
+static const u32 links[][2] = { { 0, 0 }, { 1, 0 }, { 3, 2 }, { 5, 3 }, { 8, 0 }, { 2, 6 }, { 7, 7 }, { 12, 4 } };
+
+static Rollback rollback;	/*!< Local driver. */
+static Snapshot remoteStates[FRAME_LIMIT + 1];	/*!< State of the remote match after each frame. */
+
+
+static int fail(const char *message, u32 number) {
+	printf("FAIL: %s (%u)\n", message, number);
+	return 1;
+}
+
+
+static int testSnapshots() {
+	static SnapshotRing ring;
+	World world, restored;
+	SimContext context, restoredContext;
+
+	memset(&world, 0, sizeof(World));
+	initializeMatch(&world, &context, 2, 1234);
+	clearSnapshots(&ring);
+	if (restoreSnapshot(&ring, 0, &restored, &restoredContext) == 0)
+		return fail("empty slot restored", 0);
+	for (u32 frame = 0; frame < SNAPSHOT_SLOTS + 3; ++frame) {
+		ButtonInput input = { TRUE, (Button)(A + frame % 3) };
+		saveSnapshot(&ring, frame, &world, &context);
+		updateWorld(&world, &context, &input);
+	}
+	if (restoreSnapshot(&ring, 2, &restored, &restoredContext) == 0)
+		return fail("overwritten frame restored", 2);
+	if (restoreSnapshot(&ring, SNAPSHOT_SLOTS + 2, &restored, &restoredContext) != 0)
+		return fail("last frame not restored", SNAPSHOT_SLOTS + 2);
+
+	// Simulating the last frame again from its snapshot gives the same state.
+	ButtonInput input = { TRUE, (Button)(A + (SNAPSHOT_SLOTS + 2) % 3) };
+	updateWorld(&restored, &restoredContext, &input);
+	if (memcmp(&restored, &world, sizeof(World)) != 0 || memcmp(&restoredContext, &context, sizeof(SimContext)) != 0)
+		return fail("restored state simulates differently", SNAPSHOT_SLOTS + 2);
+	return 0;
+}
+
+
+/*! Plays one match over a link, and adds the number of states compared to *compared. */
+static int testLink(u32 delay, u32 jitter, u32 match, u32 *compared) {
+	static const u16 difficulties[] = { DIFF_EASY, DIFF_NORMAL, DIFF_HARD, DIFF_NIGHTMARE, DIFF_PERFECT };
+	MatchSetup setup = { (u8)(1 + match % MAX_ALLIES), difficulties[match % 5], matchSeed(14, match) };
+	u32 worldSeed = matchSeed(setup.seed, MATCH_WORLD_STREAM);
+	PlayerBot bot;
+	LoopbackLink link;
+	ButtonInput input = { FALSE, Neutral };
+	Snapshot local;
+	u32 remoteFrames = 0, checked = 0, frame;
+	u8 ended = FALSE;
+
+	memset(&remoteStates[0].world, 0, sizeof(World));
+	initializeMatch(&remoteStates[0].world, &remoteStates[0].context, setup.numAllies, worldSeed);
+	initializePlayerBot(&bot, setup.seed);
+	initializeRollback(&rollback, setup.numAllies, setup.difficulty, worldSeed);
+	initializeLoopback(&link, delay, jitter, match);
+
+	for (u32 now = 0; ; ++now) {
+		// The remote player plays one frame and sends its input, until the match ends.
+		if (!ended) {
+			Snapshot *next = &remoteStates[remoteFrames + 1];
+			*next = remoteStates[remoteFrames];
+			next->context.difficultyAIaccumulator += setup.difficulty;
+			playerBotInput(&bot, &next->world, &next->context, &input);
+			updateWorld(&next->world, &next->context, &input);
+			if (sendLoopback(&link, now, remoteFrames, &input) != 0)
+				return fail("link full", now);
+			++remoteFrames;
+			ended = remoteFrames == FRAME_LIMIT || matchOutcome(&next->world, &next->context) != MatchPlaying;
+		}
+
+		while (receiveLoopback(&link, now, &frame, &input))
+			if (addRollbackInput(&rollback, frame, &input) != 0)
+				return fail("input rejected", frame);
+		if (rollback.frame < remoteFrames)
+			advanceRollback(&rollback, NULL);
+		else
+			resolveRollback(&rollback);
+
+		// States after frames that all have their real input are final: check those not checked yet.
+		if (rollback.rollbackFrom == ROLLBACK_NONE) {
+			u32 last = (rollback.confirmedFrames < rollback.frame) ? rollback.confirmedFrames : rollback.frame;
+			for (; checked <= last; ++checked) {
+				if (checked == rollback.frame) {
+					local.world = rollback.world;
+					local.context = rollback.context;
+				}
+				else if (restoreSnapshot(&rollback.snapshots, checked, &local.world, &local.context) != 0)
+					return fail("snapshot missing", checked);
+				if (memcmp(&remoteStates[checked].world, &local.world, sizeof(World)) != 0
+					|| memcmp(&remoteStates[checked].context, &local.context, sizeof(SimContext)) != 0)
+					return fail("local state differs from remote", checked);
+				++*compared;
+			}
+		}
+		if (ended && checked > remoteFrames)
+			break;
+	}
+	if (rollback.stats.longestRollback > ROLLBACK_MAX_FRAMES)
+		return fail("rolled back too far", rollback.stats.longestRollback);
+	if (delay + jitter > 0 && rollback.stats.rollbacks == 0)
+		return fail("late input never rolled back", match);
+	return 0;
+}
+
+
+int main() {
+	if (testSnapshots() != 0)
+		return 1;
+	for (u32 i = 0; i < sizeof(links) / sizeof(links[0]); ++i) {
+		u32 compared = 0, rollbacks = 0, resimulated = 0, stalls = 0;
+		for (u32 match = 0; match < 10; ++match) {
+			if (testLink(links[i][0], links[i][1], match, &compared) != 0)
+				return 1;
+			rollbacks += rollback.stats.rollbacks;
+			resimulated += rollback.stats.resimulatedFrames;
+			stalls += rollback.stats.stalls;
+		}
+		printf("delay %2u jitter %u: %6u states compared, %5u rollbacks, %6u frames simulated again, %5u stalls\n",
+			links[i][0], links[i][1], compared, rollbacks, resimulated, stalls);
+	}
+	return 0;
+}
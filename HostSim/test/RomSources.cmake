@@ -0,0 +1,65 @@
+# Checks that Gemu/out/rom.bin was built from the Gemu sources in the tree.
+#
+#   cmake -DGEMU_DIR=MegaDriveGOTY2018/Gemu -P HostSim/test/RomSources.cmake
+#   cmake -DGEMU_DIR=MegaDriveGOTY2018/Gemu -DWRITE=ON -P HostSim/test/RomSources.cmake
+#
+# Gemu/out/rom.sources lists the SHA-256 of every source the ROM was built from (main.c, inc, src and the resources
+# rescomp wrote in res), with Windows line endings made Unix ones. The check fails when a source was changed, added or
+# removed since. Rebuild the ROM with COMPILE.bat, then write the list again with -DWRITE=ON in the same commit.
+
+cmake_minimum_required(VERSION 3.13)
+
+if(NOT GEMU_DIR)
+  message(FATAL_ERROR "Usage: cmake -DGEMU_DIR=<Gemu directory> [-DWRITE=ON] -P RomSources.cmake")
+endif()
+get_filename_component(GEMU_DIR ${GEMU_DIR} ABSOLUTE)
+set(list_file ${GEMU_DIR}/out/rom.sources)
+
+file(GLOB_RECURSE sources RELATIVE ${GEMU_DIR}
+  ${GEMU_DIR}/main.c ${GEMU_DIR}/inc/* ${GEMU_DIR}/src/* ${GEMU_DIR}/res/*)
+list(SORT sources)
+set(current "")
+foreach(source ${sources})
+  file(READ ${GEMU_DIR}/${source} text)
+  string(REPLACE "\r\n" "\n" text "${text}")
+  string(SHA256 hash "${text}")
+  string(APPEND current "${hash}  ${source}\n")
+endforeach()
+
+if(WRITE)
+  file(WRITE ${list_file} "${current}")
+  message(STATUS "Wrote ${list_file}")
+  return()
+endif()
+
+if(NOT EXISTS ${list_file})
+  message(FATAL_ERROR "${list_file} is missing: write it with -DWRITE=ON right after building the ROM")
+endif()
+file(READ ${list_file} recorded)
+string(REPLACE "\r\n" "\n" recorded "${recorded}")
+if(recorded STREQUAL current)
+  message(STATUS "rom.bin was built from the sources in the tree")
+  return()
+endif()
+
+# Name the sources that differ, then fail.
+string(REPLACE "\n" ";" recorded_lines "${recorded}")
+string(REPLACE "\n" ";" current_lines "${current}")
+list(REMOVE_ITEM recorded_lines "")
+list(REMOVE_ITEM current_lines "")
+foreach(line ${current_lines})
+  list(FIND recorded_lines "${line}" found)
+  if(found EQUAL -1)
+    string(SUBSTRING "${line}" 66 -1 source)
+    message(STATUS "changed or added since the ROM was built: ${source}")
+  endif()
+endforeach()
+foreach(line ${recorded_lines})
+  list(FIND current_lines "${line}" found)
+  string(SUBSTRING "${line}" 66 -1 source)
+  if(found EQUAL -1 AND NOT EXISTS ${GEMU_DIR}/${source})
+    message(STATUS "removed since the ROM was built: ${source}")
+  endif()
+endforeach()
+message(FATAL_ERROR "rom.bin is older than its sources: rebuild it with COMPILE.bat, "
+  "then run this script with -DWRITE=ON and refresh HostSim/test/RomCycles.txt")
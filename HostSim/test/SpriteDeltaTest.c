@@ -0,0 +1,386 @@
+/*!
+\file SpriteDeltaTest.c
+\brief Test of the sprite frame deltas
+\date 10/2026
+
+Builds the SpriteDelta of the game's sprite sheets from the PNG files, as assetbuild does for deltas.res, and checks
+frameDelta on it. Then plays matches with the scripted player, stepping the animations of both sprites as the sprite
+engine does (a frame every 5 updates, from frame 0 on a new animation or sheet), and uploads every frame drawn into
+the VRAM of its resident set as sendDmaQueue in main.c, through a DMA queue with the NTSC budget: after every upload,
+the set must hold the frame. A frame deferred is asked for again the next frame, from the frame its set holds.
+Counts the tiles sent, against the whole frames the sprite engine would send, and writes them to the report given as
+second argument.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Match.h"
+#include "PlayerBot.h"
+#include "SpriteResidency.h"
+#include "SpriteDelta.h"
+#include "DmaQueue.h"
+// The game's SpriteSheet (Components.h) names its sheets: HostSim's converted sheet takes another name here.
+#define SpriteSheet ConvertedSheet
+#include "SpriteSheet.h"
+#undef SpriteSheet
+
+#define SPRITE_TILES 384	/*!< Sprite tiles of SPR_init's default, as in main.c. */
+#define MATCHES 40	/*!< Matches played, 1 to MAX_ALLIES allies. */
+#define FRAME_TIME 5	/*!< Updates a frame is shown: the time of sprites.res. */
+#define TILESETS 2	/*!< Sheets with tiles of their own: mockPlayer.png, mockEnemy.png. */
+#define MAX_GAP 4	/*!< Largest gap reported. */
+
+static const char *pngNames[TILESETS] = { "mockPlayer.png", "mockEnemy.png" };
+static const u8 sheetTileset[SPRITE_SHEETS] = { mockPlayer1, mockPlayer1, mockEnemy };	/*!< As in main.c. */
+static const u8 tilesetSheet[SPRITE_SHEETS] = { 0, 0, 1 };	/*!< Index in pngNames of the tiles of every sheet. */
+static const u16 sheetTiles[SPRITE_SHEETS] = { 144, 144, 144 };
+static const TileRange spriteArea = { 1024, SPRITE_TILES };
+
+/*! \brief Structure with a SpriteDelta and the tables it points to. */
+typedef struct {
+	SpriteDelta delta;
+	AnimationDelta *animations;
+	FrameDelta *frames;
+	TileRun *runs;
+	u32 tiles;	/*!< Tiles of every delta. */
+} BuiltDelta;
+
+/*! \brief Structure with what the sprite engine draws for a sprite: its sheet, animation and frame. */
+typedef struct {
+	SpriteSheet sheet;
+	u16 animation;
+	u16 frame;
+	u16 timer;
+} DrawnSprite;
+
+/*! \brief Structure with the tiles sent in matches. */
+typedef struct {
+	u32 uploads;	/*!< Frames sent into VRAM. */
+	u32 wholeTiles;	/*!< Tiles the sprite engine sends: every frame whole. */
+	u32 tiles;	/*!< Tiles uploadSpriteFrame sends. */
+	u32 dmas;	/*!< DMA transfers uploadSpriteFrame starts. */
+	u32 wholeFrames;	/*!< Uploads without a delta. */
+	u32 attackWhole;	/*!< Tiles the sprite engine sends in attack animations (A1 to B3). */
+	u32 attackTiles;	/*!< Tiles uploadSpriteFrame sends in attack animations. */
+} UploadCount;
+
+/*! \brief Structure with the upload a sprite requested this frame. */
+typedef struct {
+	u8 set;	/*!< Its resident set. */
+	u16 runs;	/*!< Runs to send (see frameDelta). */
+	const TileRun *run;	/*!< The runs. */
+} PendingUpload;
+
+
+static int fail(const char *message, u32 number) {
+	printf("FAIL: %s (%u)\n", message, number);
+	return 1;
+}
+
+
+/*! Builds the deltas of a sheet as writeSpriteDelta in Resource.c: every frame from the one before it. */
+static int buildDelta(BuiltDelta *built, const ConvertedSheet *sheet, u16 gap) {
+	u32 frames = 0;
+	for (u16 a = 0; a < sheet->animationCount; ++a)
+		frames += sheet->animations[a].frameCount;
+	built->animations = malloc(sizeof(AnimationDelta) * sheet->animationCount);
+	built->frames = malloc(sizeof(FrameDelta) * frames);
+	built->runs = malloc(sizeof(TileRun) * (sheet->tileCount / 2u + 1u) * frames);
+	u16 (*runs)[2] = malloc(sizeof(runs[0]) * (sheet->tileCount / 2u + 1u));
+	if (built->animations == NULL || built->frames == NULL || built->runs == NULL || runs == NULL) {
+		free(runs);
+		return fail("out of memory", frames);
+	}
+
+	FrameDelta *frame = built->frames;
+	TileRun *run = built->runs;
+	built->tiles = 0;
+	for (u16 a = 0; a < sheet->animationCount; ++a) {
+		const SpriteAnimation *animation = &sheet->animations[a];
+		built->animations[a].numFrame = animation->frameCount;
+		built->animations[a].frames = frame;
+		for (u16 f = 0; f < animation->frameCount; ++f, ++frame) {
+			const SpriteFrame *previous = &animation->frames[(f == 0) ? animation->frameCount - 1 : f - 1];
+			frame->runs = changedTileRuns(runs, sheet, previous, &animation->frames[f], gap);
+			frame->run = run;
+			for (u16 r = 0; r < frame->runs; ++r, ++run) {
+				run->first = runs[r][0];
+				run->count = runs[r][1];
+				built->tiles += run->count;
+			}
+		}
+	}
+	built->delta.numAnimation = sheet->animationCount;
+	built->delta.animations = built->animations;
+	free(runs);
+	return 0;
+}
+
+
+static void freeDelta(BuiltDelta *built) {
+	free(built->animations);
+	free(built->frames);
+	free(built->runs);
+}
+
+
+/*! Checks the runs of every delta: in order, apart, covering every changed tile, and with gap 0 only those. */
+static int checkRuns(const ConvertedSheet *sheet, const BuiltDelta *built, u16 gap) {
+	for (u16 a = 0; a < sheet->animationCount; ++a) {
+		const SpriteAnimation *animation = &sheet->animations[a];
+		for (u16 f = 0; f < animation->frameCount; ++f) {
+			const FrameDelta *frame = &built->delta.animations[a].frames[f];
+			const Tile *from = animation->frames[(f == 0) ? animation->frameCount - 1 : f - 1].tiles;
+			const Tile *to = animation->frames[f].tiles;
+			u16 next = 0;
+			for (u16 r = 0; r < frame->runs; ++r) {
+				const TileRun *run = &frame->run[r];
+				if (run->count == 0 || run->first < next + ((r > 0) ? gap + 1 : 0) || run->first + run->count > sheet->tileCount)
+					return fail("runs out of order, empty or joinable", a * 100 + f);
+				for (u16 t = next; t < run->first; ++t)
+					if (memcmp(&from[t], &to[t], sizeof(Tile)) != 0)
+						return fail("changed tile outside the runs", t);
+				for (u16 t = run->first; gap == 0 && t < run->first + run->count; ++t)
+					if (memcmp(&from[t], &to[t], sizeof(Tile)) == 0)
+						return fail("unchanged tile sent with gap 0", t);
+				next = run->first + run->count;
+			}
+			for (u16 t = next; t < sheet->tileCount; ++t)
+				if (memcmp(&from[t], &to[t], sizeof(Tile)) != 0)
+					return fail("changed tile outside the runs", t);
+		}
+	}
+	return 0;
+}
+
+
+/*! Checks frameDelta: deltas only to the next frame of the same animation. */
+static int checkFrameDelta(const SpriteDelta *delta) {
+	const TileRun *run = NULL;
+	const AnimationDelta *attack = &delta->animations[A1];
+	u16 last = attack->numFrame - 1;
+
+	if (frameDelta(delta, A1, DELTA_WHOLE, A1, 0, &run) != DELTA_WHOLE)
+		return fail("delta over an empty set", 0);
+	if (frameDelta(delta, Idling, 0, A1, 0, &run) != DELTA_WHOLE)
+		return fail("delta across animations", 0);
+	if (frameDelta(delta, A1, 2, A1, 2, &run) != 0)
+		return fail("frame in VRAM sent again", 2);
+	if (frameDelta(delta, A1, 0, A1, 2, &run) != DELTA_WHOLE)
+		return fail("delta over a skipped frame", 2);
+	if (frameDelta(delta, A1, 1, A1, 2, &run) != attack->frames[2].runs || run != attack->frames[2].run)
+		return fail("delta of the next frame", 2);
+	if (frameDelta(delta, A1, last, A1, 0, &run) != attack->frames[0].runs || (attack->frames[0].runs > 0 && run != attack->frames[0].run))
+		return fail("delta from the last frame to the first", last);
+	if (frameDelta(delta, delta->numAnimation, 0, delta->numAnimation, 1, &run) != DELTA_WHOLE)
+		return fail("delta of an animation out of range", delta->numAnimation);
+	return 0;
+}
+
+
+/*! Requests the upload of the frame a sprite draws into its set, as requestSpriteFrames does. */
+static void requestFrame(DmaQueue *queue, PendingUpload *upload, u16 shown[2], const BuiltDelta *built, const ConvertedSheet *sheet,
+	const DrawnSprite *drawn, u8 sprite) {
+	u16 tiles = 0;
+
+	upload->runs = frameDelta(&built->delta, shown[0], shown[1], drawn->animation, drawn->frame, &upload->run);
+	if (upload->runs == 0) { // the same tiles as the frame in VRAM: it becomes that frame
+		shown[0] = drawn->animation;
+		shown[1] = drawn->frame;
+		return;
+	}
+	if (upload->runs == DELTA_WHOLE)
+		tiles = sheet->tileCount;
+	else
+		for (u16 r = 0; r < upload->runs; ++r)
+			tiles += upload->run[r].count;
+	requestDma(queue, DmaSpriteFrame, tiles * STREAM_TILE_BYTES, sprite);
+}
+
+
+/*! Brings a set to the frame a sprite draws, as uploadSpriteFrame does, and counts the tiles. */
+static int uploadFrame(Tile *vram, u16 shown[2], const PendingUpload *upload, const ConvertedSheet *sheet, const DrawnSprite *drawn,
+	UploadCount *count) {
+	const Tile *tiles = sheet->animations[drawn->animation].frames[drawn->frame].tiles;
+	u8 attack = drawn->animation >= A1 && drawn->animation <= B3;
+
+	++count->uploads;
+	if (upload->runs == DELTA_WHOLE) {
+		memcpy(vram, tiles, sizeof(Tile) * sheet->tileCount);
+		++count->wholeFrames;
+		++count->dmas;
+		count->tiles += sheet->tileCount;
+		if (attack)
+			count->attackTiles += sheet->tileCount;
+	}
+	else
+		for (u16 r = 0; r < upload->runs; ++r) {
+			const TileRun *run = &upload->run[r];
+			memcpy(&vram[run->first], &tiles[run->first], sizeof(Tile) * run->count);
+			++count->dmas;
+			count->tiles += run->count;
+			if (attack)
+				count->attackTiles += run->count;
+		}
+	shown[0] = drawn->animation;
+	shown[1] = drawn->frame;
+	return memcmp(vram, tiles, sizeof(Tile) * sheet->tileCount) != 0 ? fail("VRAM not the frame drawn", drawn->frame) : 0;
+}
+
+
+/*! Plays a match, drawing both sprites into the VRAM of their resident sets through a DMA queue with the NTSC budget. */
+static int playDeltas(const MatchSetup *setup, const ConvertedSheet sheets[TILESETS], const BuiltDelta deltas[TILESETS], DmaQueue *queue,
+	UploadCount *count) {
+	static World world;
+	static SimContext context;
+	static Tile vram[RESIDENT_SETS][SPRITE_TILES];
+	SpriteResidency residency;
+	PlayerBot bot;
+	ButtonInput input = { FALSE, Neutral };
+	DrawnSprite drawn[RESIDENT_SPRITES], engine[RESIDENT_SPRITES];
+	PendingUpload upload[RESIDENT_SPRITES];
+	DmaRequest request;
+	u16 shown[RESIDENT_SETS][2];
+	u16 used[RESIDENT_SPRITES];
+
+	initializeMatch(&world, &context, setup->numAllies, matchSeed(setup->seed, MATCH_WORLD_STREAM));
+	initializePlayerBot(&bot, setup->seed);
+	spriteSheetsInUse(&world, used);
+	if (!planSpriteResidency(&residency, spriteArea, sheetTileset, sheetTiles, SPRITE_SHEETS, used))
+		return fail("game sheets do not fit", setup->numAllies);
+	for (u8 i = 0; i < RESIDENT_SETS; ++i)
+		shown[i][1] = DELTA_WHOLE;
+	for (u8 i = 0; i < RESIDENT_SPRITES; ++i) {
+		drawn[i] = (DrawnSprite) { context.renderedSpriteSheet[i], Idling, 0, FRAME_TIME };
+		engine[i] = (DrawnSprite) { context.renderedSpriteSheet[i], Idling, DELTA_WHOLE, 0 };
+	}
+
+	for (u32 frame = 0; frame < MATCH_FRAME_LIMIT && matchOutcome(&world, &context) == MatchPlaying; ++frame) {
+		context.difficultyAIaccumulator += setup->difficulty;
+		playerBotInput(&bot, &world, &context, &input);
+		EventQueue events = updateWorld(&world, &context, &input);
+		// updateAnim: a sheet with other tiles restarts the animation (SPR_setDefinition), a new animation starts at frame 0.
+		for (u8 i = 0; i < events.commands; ++i) {
+			RenderCommand command = events.command[i];
+			DrawnSprite *sprite = &drawn[command.sprite];
+			if (command.type == RenderSpriteSheet) {
+				if (sheetTileset[command.value] != sheetTileset[sprite->sheet])
+					sprite->frame = 0, sprite->timer = FRAME_TIME;
+				sprite->sheet = command.value;
+			}
+			else if (command.type == RenderAnimation && command.value != sprite->animation)
+				sprite->animation = command.value, sprite->frame = 0, sprite->timer = FRAME_TIME;
+		}
+		// SPR_update steps the animations, then sendDmaQueue sends the frames drawn that fit.
+		startDmaFrame(queue, DMA_BUDGET_NTSC);
+		for (u8 i = 0; i < RESIDENT_SPRITES; ++i) {
+			DrawnSprite *sprite = &drawn[i];
+			u8 tiles = tilesetSheet[sprite->sheet];
+			if (--sprite->timer == 0) {
+				sprite->frame = (sprite->frame + 1 == sheets[tiles].animations[sprite->animation].frameCount) ? 0 : sprite->frame + 1;
+				sprite->timer = FRAME_TIME;
+			}
+			// The sprite engine would send the whole frame whenever it changes.
+			if (sheetTileset[engine[i].sheet] != sheetTileset[sprite->sheet] || engine[i].animation != sprite->animation
+				|| engine[i].frame != sprite->frame) {
+				count->wholeTiles += sheets[tiles].tileCount;
+				if (sprite->animation >= A1 && sprite->animation <= B3)
+					count->attackWhole += sheets[tiles].tileCount;
+				engine[i] = *sprite;
+			}
+			upload[i].set = findResidentSet(&residency, i, sheetTileset[sprite->sheet]);
+			if (upload[i].set == RESIDENT_NONE)
+				return fail("sheet drawn without a resident set", sprite->sheet);
+			requestFrame(queue, &upload[i], shown[upload[i].set], &deltas[tiles], &sheets[tiles], sprite, i);
+		}
+		while (nextDma(queue, &request)) {
+			u8 i = request.tag, tiles = tilesetSheet[drawn[i].sheet];
+			if (uploadFrame(vram[upload[i].set], shown[upload[i].set], &upload[i], &sheets[tiles], &drawn[i], count) != 0)
+				return 1;
+		}
+	}
+	return 0;
+}
+
+
+static void writeCount(FILE *out, const UploadCount *count, const DmaQueue *queue) {
+	fprintf(out, "%u matches: %u frames uploaded, %u whole (%u DMA transfers)\n", MATCHES, count->uploads, count->wholeFrames, count->dmas);
+	fprintf(out, "  tiles sent: %u of %u whole (%u%%), %u KB of %u KB\n", count->tiles, count->wholeTiles,
+		(u32)(100ull * count->tiles / count->wholeTiles), count->tiles * STREAM_TILE_BYTES / 1024, count->wholeTiles * STREAM_TILE_BYTES / 1024);
+	fprintf(out, "  attack animations: %u of %u whole (%u%%)\n", count->attackTiles, count->attackWhole,
+		(u32)(100ull * count->attackTiles / count->attackWhole));
+	fprintf(out, "  DMA queue, NTSC budget of %u bytes: %u of %u frames over it, %u bytes of sprite frames deferred\n", DMA_BUDGET_NTSC,
+		queue->overrunFrames, queue->frames, queue->deferredBytes[DmaSpriteFrame]);
+}
+
+
+int main(int argc, char **argv) {
+	ConvertedSheet sheets[TILESETS];
+	BuiltDelta deltas[TILESETS];
+	char path[4096];
+	FILE *report = (argc > 2) ? fopen(argv[2], "w") : NULL;
+
+	if (argc < 2)
+		return fail("usage: spritedeltatest <sprite directory> [report]", 0);
+	for (u8 t = 0; t < TILESETS; ++t) {
+		IndexedImage image;
+		snprintf(path, sizeof(path), "%s/%s", argv[1], pngNames[t]);
+		if (loadIndexedPng(&image, path) != 0)
+			return fail("cannot read the sprite sheet", t);
+		int converted = convertSpriteSheet(&sheets[t], &image, 12, 12);
+		freeIndexedImage(&image);
+		if (converted != 0 || sheets[t].tileCount != sheetTiles[t])
+			return fail("sprite sheet not made of 12x12 tile frames", t);
+	}
+
+	// Runs for every gap: fewer DMA transfers against more tiles.
+	for (u16 gap = 0; gap <= MAX_GAP; ++gap) {
+		u32 tiles = 0, whole = 0, runs = 0;
+		for (u8 t = 0; t < TILESETS; ++t) {
+			if (buildDelta(&deltas[t], &sheets[t], gap) != 0 || checkRuns(&sheets[t], &deltas[t], gap) != 0)
+				return 1;
+			tiles += deltas[t].tiles;
+			for (u16 a = 0; a < sheets[t].animationCount; ++a) {
+				whole += sheets[t].animations[a].frameCount * sheets[t].tileCount;
+				for (u16 f = 0; f < sheets[t].animations[a].frameCount; ++f)
+					runs += deltas[t].delta.animations[a].frames[f].runs;
+			}
+			freeDelta(&deltas[t]);
+		}
+		printf("gap %u: every frame from the one before, %u tiles in %u runs, of %u tiles whole\n", gap, tiles, runs, whole);
+		if (report != NULL)
+			fprintf(report, "gap %u: every frame from the one before, %u tiles in %u runs, of %u tiles whole\n", gap, tiles, runs, whole);
+	}
+
+	// The game's deltas: SPRITE_DELTA_GAP, as deltas.res.
+	for (u8 t = 0; t < TILESETS; ++t)
+		if (buildDelta(&deltas[t], &sheets[t], SPRITE_DELTA_GAP) != 0 || checkFrameDelta(&deltas[t].delta) != 0)
+			return 1;
+	printf("deltas only to the next frame of an animation\n");
+
+	UploadCount count = { 0 };
+	DmaQueue queue;
+	initializeDmaQueue(&queue);
+	for (u32 match = 0; match < MATCHES; ++match) {
+		MatchSetup setup = { (u8)(1 + match % MAX_ALLIES), DIFF_NORMAL, match };
+		if (playDeltas(&setup, sheets, deltas, &queue, &count) != 0)
+			return 1;
+	}
+	writeCount(stdout, &count, &queue);
+	if (report != NULL) {
+		writeCount(report, &count, &queue);
+		fclose(report);
+	}
+	if (count.attackWhole == 0)
+		return fail("no attack played", MATCHES);
+	if (count.tiles >= count.wholeTiles)
+		return fail("deltas send as much as whole frames", count.tiles);
+
+	for (u8 t = 0; t < TILESETS; ++t) {
+		freeDelta(&deltas[t]);
+		freeSpriteSheet(&sheets[t]);
+	}
+	return 0;
+}
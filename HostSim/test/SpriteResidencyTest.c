@@ -0,0 +1,175 @@
+/*!
+\file SpriteResidencyTest.c
+\brief Test of the sprite residency plan
+\date 10/2026
+
+Plans the resident sets of the game's sprite sheets (maxNumTile of res/sprites.h's definitions, tilesets as sheetTiles
+in main.c) for matches with 1 to MAX_ALLIES allies, and checks that every set lies in the sprite tiles, apart from
+the others and from the tiles initSpriteEngine leaves to the sprite engine. Then plays matches with the scripted player: every sprite sheet renderSystem sends must have a set for
+its sprite, so that updateAnim never resets the sprite engine. Sheets that would not fit must fail the plan.
+Writes the VRAM of every resident set to the report given as argument.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Match.h"
+#include "PlayerBot.h"
+#include "SpriteResidency.h"
+
+#define SPRITE_TILES 384	/*!< Sprite tiles of SPR_init's default, as in main.c. */
+#define SPRITE_ENGINE_TILES 16	/*!< Least sprite tiles left to the sprite engine, as in main.c. */
+#define SPRITE_AREA_FIRST 1024	/*!< First of the sprite tiles. The plan only depends on it by offset. */
+#define MATCHES 40	/*!< Matches played, 1 to MAX_ALLIES allies. */
+
+static const char *sheetNames[SPRITE_SHEETS] = { "mockPlayer1", "mockPlayer2", "mockEnemy" };
+static const char *spriteNames[RESIDENT_SPRITES] = { "player", "enemy" };
+static const u8 sheetTileset[SPRITE_SHEETS] = { mockPlayer1, mockPlayer1, mockEnemy };	/*!< mockPlayer2 has the tiles of mockPlayer. */
+static const u16 sheetTiles[SPRITE_SHEETS] = { 144, 144, 144 };	/*!< maxNumTile of mockPlayer_sprite, mockPlayer2_sprite, mockEnemy_sprite. */
+static const TileRange spriteArea = { SPRITE_AREA_FIRST, SPRITE_TILES - SPRITE_ENGINE_TILES };	/*!< As planResidentSprites. */
+
+
+static int fail(const char *message, u32 number) {
+	printf("FAIL: %s (%u)\n", message, number);
+	return 1;
+}
+
+
+/*! Checks a plan: sets inside the area and apart, large enough, one for every sheet drawn. */
+static int checkPlan(const SpriteResidency *residency, const u8 tilesets[], const u16 drawn[RESIDENT_SPRITES]) {
+	u16 used = 0;
+	for (u8 i = 0; i < residency->sets; ++i) {
+		const ResidentSet *set = &residency->set[i];
+		if (set->tiles.first < residency->area.first || set->tiles.first + set->tiles.count > residency->area.first + residency->area.count)
+			return fail("set outside the sprite tiles", i);
+		for (u8 j = 0; j < i; ++j)
+			if (set->tiles.first < residency->set[j].tiles.first + residency->set[j].tiles.count
+				&& residency->set[j].tiles.first < set->tiles.first + set->tiles.count)
+				return fail("sets overlap", i);
+		used += set->tiles.count;
+	}
+	if (used != residency->used)
+		return fail("tiles used miscounted", used);
+	// SPR_init takes the last vramSize sprite tiles (see initSpriteEngine).
+	u16 engineFirst = residency->area.first + SPRITE_TILES - (SPRITE_TILES - used);
+	for (u8 i = 0; i < residency->sets; ++i)
+		if (residency->set[i].tiles.first + residency->set[i].tiles.count > engineFirst)
+			return fail("set in the tiles of the sprite engine", i);
+	for (u8 sprite = 0; sprite < RESIDENT_SPRITES; ++sprite)
+		for (u8 sheet = 0; sheet < SPRITE_SHEETS; ++sheet) {
+			if (!(drawn[sprite] & (1 << sheet)))
+				continue;
+			u8 set = findResidentSet(residency, sprite, tilesets[sheet]);
+			if (set == RESIDENT_NONE)
+				return fail("sheet drawn without a resident set", sheet);
+			if (residency->set[set].tiles.count < sheetTiles[sheet])
+				return fail("set smaller than the frames of its sheet", sheet);
+		}
+	return 0;
+}
+
+
+/*! Writes the VRAM of every resident set. */
+static void writeReport(FILE *out, const SpriteResidency *residency, u8 allies) {
+	fprintf(out, "%u allies: %u resident sets, %u of %u sprite tiles (%u bytes)\n", allies, residency->sets, residency->used,
+		residency->area.count, residency->used * STREAM_TILE_BYTES);
+	for (u8 i = 0; i < residency->sets; ++i) {
+		const ResidentSet *set = &residency->set[i];
+		fprintf(out, "  %-6s tiles %4u-%4u  %3u tiles  %5u bytes  sheets:", spriteNames[set->sprite], set->tiles.first,
+			set->tiles.first + set->tiles.count - 1, set->tiles.count, set->tiles.count * STREAM_TILE_BYTES);
+		for (u8 sheet = 0; sheet < SPRITE_SHEETS; ++sheet)
+			if (sheetTileset[sheet] == set->tileset)
+				fprintf(out, " %s", sheetNames[sheet]);
+		fprintf(out, "\n");
+	}
+}
+
+
+/*! Plays a match, and counts the sprite sheet changes: palette only, other resident tiles, or not resident. */
+static int playResident(const MatchSetup *setup, u32 changes[3]) {
+	static World world;
+	static SimContext context;
+	SpriteResidency residency;
+	PlayerBot bot;
+	ButtonInput input = { FALSE, Neutral };
+	SpriteSheet shown[RESIDENT_SPRITES];
+	u16 drawn[RESIDENT_SPRITES];
+
+	initializeMatch(&world, &context, setup->numAllies, matchSeed(setup->seed, MATCH_WORLD_STREAM));
+	initializePlayerBot(&bot, setup->seed);
+	spriteSheetsInUse(&world, drawn);
+	if (!planSpriteResidency(&residency, spriteArea, sheetTileset, sheetTiles, SPRITE_SHEETS, drawn))
+		return fail("game sheets do not fit", setup->numAllies);
+	memcpy(shown, context.renderedSpriteSheet, sizeof(shown));
+
+	for (u32 frame = 0; frame < MATCH_FRAME_LIMIT && matchOutcome(&world, &context) == MatchPlaying; ++frame) {
+		context.difficultyAIaccumulator += setup->difficulty;
+		playerBotInput(&bot, &world, &context, &input);
+		EventQueue events = updateWorld(&world, &context, &input);
+		for (u8 i = 0; i < events.commands && events.command[i].type == RenderSpriteSheet; ++i) {
+			RenderCommand command = events.command[i];
+			if (findResidentSet(&residency, command.sprite, sheetTileset[command.value]) == RESIDENT_NONE)
+				++changes[2];
+			else
+				++changes[(sheetTileset[command.value] == sheetTileset[shown[command.sprite]]) ? 0 : 1];
+			shown[command.sprite] = command.value;
+		}
+	}
+	return changes[2] != 0 ? fail("sprite sheet change without a resident set", setup->seed) : 0;
+}
+
+
+int main(int argc, char **argv) {
+	static World world;
+	static SimContext context;
+	SpriteResidency residency;
+	u16 drawn[RESIDENT_SPRITES];
+	FILE *report = (argc > 1) ? fopen(argv[1], "w") : NULL;
+
+	// The game's sheets, for every number of allies.
+	for (u8 allies = 1; allies <= MAX_ALLIES; ++allies) {
+		initializeMatch(&world, &context, allies, 1);
+		spriteSheetsInUse(&world, drawn);
+		if (drawn[0] != ((allies > 1) ? 3 : 1) << mockPlayer1 || drawn[1] != 1 << mockEnemy)
+			return fail("sheets in use", allies);
+		if (!planSpriteResidency(&residency, spriteArea, sheetTileset, sheetTiles, SPRITE_SHEETS, drawn))
+			return fail("game sheets do not fit", allies);
+		if (checkPlan(&residency, sheetTileset, drawn) != 0)
+			return 1;
+		if (residency.sets != 2 || residency.used != 288)
+			return fail("palette variants not sharing their set", allies);
+		writeReport(stdout, &residency, allies);
+		if (report != NULL)
+			writeReport(report, &residency, allies);
+	}
+	if (report != NULL)
+		fclose(report);
+
+	// If mockPlayer2 had tiles of its own: three sets, which fit in 432 tiles but not in the sprite tiles.
+	const u8 ownTilesets[SPRITE_SHEETS] = { mockPlayer1, mockPlayer2, mockEnemy };
+	const u16 both[RESIDENT_SPRITES] = { 1 << mockPlayer1 | 1 << mockPlayer2, 1 << mockEnemy };
+	if (planSpriteResidency(&residency, spriteArea, ownTilesets, sheetTiles, SPRITE_SHEETS, both))
+		return fail("sets planned beyond the sprite tiles", residency.used);
+	const TileRange larger = { SPRITE_AREA_FIRST, 432 };
+	if (!planSpriteResidency(&residency, larger, ownTilesets, sheetTiles, SPRITE_SHEETS, both) || checkPlan(&residency, ownTilesets, both) != 0)
+		return fail("three sets not planned in 432 tiles", residency.sets);
+	// A sheet drawn by both sprites has a set for each.
+	const u16 shared[RESIDENT_SPRITES] = { 1 << mockPlayer2, 1 << mockPlayer2 | 1 << mockEnemy };
+	if (!planSpriteResidency(&residency, larger, sheetTileset, sheetTiles, SPRITE_SHEETS, shared) || residency.sets != 3
+		|| checkPlan(&residency, sheetTileset, shared) != 0)
+		return fail("sheet drawn by both sprites", residency.sets);
+	printf("sets beyond the sprite tiles refused\n");
+
+	// Matches: every sheet change finds its set.
+	u32 changes[3] = { 0, 0, 0 };
+	for (u32 match = 0; match < MATCHES; ++match) {
+		MatchSetup setup = { (u8)(1 + match % MAX_ALLIES), DIFF_NORMAL, match };
+		if (playResident(&setup, changes) != 0)
+			return 1;
+	}
+	if (changes[0] == 0)
+		return fail("no character switch played", MATCHES);
+	printf("%u matches: %u sprite sheet changes by palette, %u to other resident tiles, %u resetting the sprite engine\n", MATCHES,
+		changes[0], changes[1], changes[2]);
+	return 0;
+}
@@ -0,0 +1,126 @@
+/*!
+\file StageStreamTest.c
+\brief Test of the stage streaming plan
+\date 10/2026
+
+Streams the three stages one after the other (forest, courtyard, great hall, with the sizes of their images in res/images.s)
+into a simulated VRAM, for stage tile areas from just large enough for the forest to large enough for two stages.
+Each frame takes chunks within STREAM_BYTES_PER_FRAME. While the stage is on screen, no chunk may write its tiles
+or a tilemap. Once done, every tile of the next stage must be in VRAM at its tileBase, inside the area, and every
+row of its tilemaps drawn once.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "StageStream.h"
+
+#define STAGES 3	/*!< Forest, courtyard, great hall. */
+#define VRAM_TILES 2048	/*!< Tiles of the simulated VRAM. */
+#define MAX_ROWS 32	/*!< Most rows of a tilemap. */
+#define AREA_FIRST 16	/*!< First tile of the stage tile area (TILE_USERINDEX). */
+#define SHOWN 0xFFFFFFFFUL	/*!< Marks a tile of the stage on screen in the simulated VRAM. */
+
+/*! Plane A and plane B images of each stage, as main.c draws them. */
+static const StreamImage stages[STAGES][STREAM_PLANES] = {
+	{ { 302, 30, 80 }, { 644, 30, 80 } },	// forest1, forest0
+	{ { 402, 30, 80 }, { 413, 13, 80 } },	// courtyard0, courtyard1
+	{ { 101, 30, 80 }, { 466, 30, 80 } },	// greatHall0, greatHall1
+};
+static const u16 areaSizes[] = { 946, 1000, 1200, 1296, 1761 };
+static u32 vram[VRAM_TILES];	/*!< For each tile, the plane and tile of the next stage in it (plane << 16 | tile + 1), or SHOWN. */
+static u8 rowsDrawn[STREAM_PLANES][MAX_ROWS];
+
+
+static int fail(const char *message, u32 number) {
+	printf("FAIL: %s (%u)\n", message, number);
+	return 1;
+}
+
+
+/*! Writes a chunk into the simulated VRAM. Returns 0, or 1 if it writes what is on screen. */
+static int upload(const StreamChunk *chunk, u8 hidden) {
+	if (chunk->type == StreamRows) {
+		if (!hidden)
+			return fail("tilemap drawn with the stage on screen", chunk->first);
+		for (u16 row = chunk->first; row < chunk->first + chunk->count; ++row)
+			++rowsDrawn[chunk->plane][row];
+		return 0;
+	}
+	for (u16 tile = 0; tile < chunk->count; ++tile) {
+		u32 *slot = &vram[chunk->destination + tile];
+		if (*slot == SHOWN && !hidden)
+			return fail("tile of the stage on screen overwritten", chunk->destination + tile);
+		*slot = (u32)chunk->plane << 16 | (chunk->first + tile + 1);
+	}
+	return 0;
+}
+
+
+/*! Streams a stage next to the one shown, and counts the frames with it on screen and with a black screen. */
+static int streamStage(TileRange area, TileRange *shown, const StreamImage images[STREAM_PLANES], u32 frames[2]) {
+	StageStream stream;
+	StreamChunk chunk;
+
+	memset(vram, 0, sizeof(vram));
+	memset(rowsDrawn, 0, sizeof(rowsDrawn));
+	for (u16 tile = shown->first; tile < shown->first + shown->count; ++tile)
+		vram[tile] = SHOWN;
+	if (!planStageStream(&stream, area, *shown, images))
+		return fail("stage does not fit", area.count);
+	if (stream.tiles.first < area.first || stream.tiles.first + stream.tiles.count > area.first + area.count)
+		return fail("stage outside of the area", stream.tiles.first);
+
+	// With the stage on screen, until the stream waits for a black screen; then until it is done.
+	for (u8 hidden = FALSE; hidden <= TRUE; ++hidden)
+		for (u32 frame = 0; !isStreamDone(&stream); ++frame) {
+			u16 budget = STREAM_BYTES_PER_FRAME, bytes;
+			while ((bytes = nextStreamChunk(&stream, hidden, budget, &chunk)) > 0) {
+				if (bytes > budget)
+					return fail("chunk over the budget", bytes);
+				budget -= bytes;
+				if (upload(&chunk, hidden) != 0)
+					return 1;
+			}
+			if (budget == STREAM_BYTES_PER_FRAME) {
+				if (hidden)
+					return fail("stream stuck with a black screen", frame);
+				break;
+			}
+			++frames[hidden];
+			if (frame > VRAM_TILES)
+				return fail("stream does not end", frame);
+		}
+
+	for (u8 plane = 0; plane < STREAM_PLANES; ++plane) {
+		for (u16 tile = 0; tile < images[plane].tiles; ++tile)
+			if (vram[stream.tileBase[plane] + tile] != ((u32)plane << 16 | (tile + 1u)))
+				return fail("tile missing", stream.tileBase[plane] + tile);
+		for (u16 row = 0; row < MAX_ROWS; ++row)
+			if (rowsDrawn[plane][row] != (row < images[plane].rows))
+				return fail("tilemap row not drawn once", row);
+	}
+	*shown = stream.tiles;
+	return 0;
+}
+
+
+int main() {
+	for (u32 size = 0; size < sizeof(areaSizes) / sizeof(areaSizes[0]); ++size) {
+		TileRange area = { AREA_FIRST, areaSizes[size] };
+		TileRange shown = { AREA_FIRST, stages[0][0].tiles + stages[0][1].tiles };
+		u32 frames[2] = { 0, 0 };
+
+		for (u32 stage = 1; stage < STAGES; ++stage)
+			if (streamStage(area, &shown, stages[stage], frames) != 0)
+				return 1;
+		printf("area of %4u tiles: %2u frames streaming on screen, %2u with a black screen\n", area.count, frames[0], frames[1]);
+	}
+
+	StageStream stream;
+	TileRange area = { AREA_FIRST, 900 }, shown = { AREA_FIRST, 0 };
+	if (planStageStream(&stream, area, shown, stages[0]))
+		return fail("planned a stage larger than the area", area.count);
+	printf("stages streamed without overwriting the screen\n");
+	return 0;
+}
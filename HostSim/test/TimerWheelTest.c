@@ -0,0 +1,174 @@
+/*!
+\file TimerWheelTest.c
+\brief Test of the entity timers of combatSystem
+\date 10/2026
+
+Built twice: with frame counting (timerwheeltest_counting) and with timers (timerwheeltest_wheel, ECS_TIMER_WHEEL).
+Both play the same matches with the scripted player, and run the same scripted world of duelling pairs for long enough
+that 'frames' of held guards wraps around. After every frame, the hash of the simulation (which covers every component
+but the sprite sheets) and the EventQueue go into a digest per match and per world. The counting build writes the digests
+to a file, the timer build compares its own with them. Both also check worldHash against fullWorldHash after every frame.
+
+Usage: timerwheeltest_<build> -o file | -c file
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Match.h"
+
+#define MATCHES 300	/*!< Matches played. */
+#define WORLD_FRAMES 200000	/*!< Frames run by the scripted world. More than 0x10000, twice. */
+#define START_CHANCE 8	/*!< In the scripted world, an idle entity starts a move with a chance of 1 in this, every frame. */
+#define GUARD_HOLDERS 2	/*!< In the scripted world, the last entities before the player never release a guard. */
+#define WORLD_PLAYER (ENTITY_COUNT - 2)	/*!< Current player of the scripted world. */
+
+static World scripted;	/*!< The scripted world. */
+
+
+static int fail(const char *message, u32 number) {
+	printf("FAIL: %s (%u)\n", message, number);
+	return 1;
+}
+
+
+/*! Adds a value to a digest. */
+static WorldHash digest(WorldHash sum, WorldHash value) {
+	return (sum ^ value) * 0x100000001B3ULL;
+}
+
+
+/*! Adds the outcome of a frame to a digest. */
+static WorldHash digestFrame(WorldHash sum, const World *world, const SimContext *context, const EventQueue *events) {
+	sum = digest(sum, simulationHash(world, context));
+	sum = digest(sum, events->commands);
+	for (u8 i = 0; i < events->commands; ++i)
+		sum = digest(sum, (WorldHash)events->command[i].type << 16 | (WorldHash)events->command[i].sprite << 8 | events->command[i].value);
+	return sum;
+}
+
+
+/*! Plays a match, and writes its number of frames compared and its digest to *line. */
+static int digestMatch(u32 match, char *line) {
+	static const u16 difficulties[] = { DIFF_EASY, DIFF_NORMAL, DIFF_HARD, DIFF_NIGHTMARE, DIFF_PERFECT };
+	MatchSetup setup = { (u8)(1 + match % MAX_ALLIES), difficulties[match % 5], matchSeed(16, match) };
+	World world;
+	SimContext context;
+	PlayerBot bot;
+	ButtonInput input = { FALSE, Neutral };
+	WorldHash sum = 0;
+	u32 frame;
+
+	memset(&world, 0, sizeof(World));
+	initializeMatch(&world, &context, setup.numAllies, matchSeed(setup.seed, MATCH_WORLD_STREAM));
+	initializePlayerBot(&bot, setup.seed);
+	for (frame = 1; frame <= MATCH_FRAME_LIMIT; ++frame) {
+		context.difficultyAIaccumulator += setup.difficulty;
+		playerBotInput(&bot, &world, &context, &input);
+		EventQueue events = updateWorld(&world, &context, &input);
+		if (worldHash(&world) != fullWorldHash(&world))
+			return fail("world hash differs from full hash", frame);
+		sum = digestFrame(sum, &world, &context, &events);
+		if (matchOutcome(&world, &context) != MatchPlaying)
+			break;
+	}
+	sprintf(line, "match %u: %u frames, digest %016llx\n", match, frame, sum);
+	return 0;
+}
+
+
+/*! Creates an enemy character facing its partner, and has the partner face it back. */
+static void spawnDuellist(World *world) {
+	EntitySlot entity = createEnemyChar(world, mockEnemy);
+	setFacing(world, entity, entity ^ 1);
+	setFacing(world, entity ^ 1, entity);
+	refreshEntityHash(world, entity);
+	refreshEntityHash(world, entity ^ 1);
+}
+
+
+/*! Runs the scripted world, and writes its digest to *line.
+
+	Like scalebench, but dying entities finish dying before they are replaced, so that combatSystem ends frames early:
+	when an enemy of the player, the player itself or slot 0 finishes. The player faces itself after its enemy died;
+	the script has it face its partner again. */
+static int digestWorld(char *line) {
+	static const u8 moves[] = { A1, B1, Guarding, Parrying };
+	SimContext context;
+	RandomStream random;
+	WorldHash sum = 0;
+	u32 wraps = 0;
+
+	memset(&scripted, 0, sizeof(World));
+	destroyAllEntities(&scripted);
+	for (u32 i = 0; i < ENTITY_COUNT; ++i)
+		spawnDuellist(&scripted);
+	context.currentPlayer = WORLD_PLAYER;
+	context.eventSFX = 0;
+	context.difficultyAIaccumulator = 0;
+	seedRandom(&context.randomAI, 2018);
+	seedRandom(&random, 16);
+
+	for (u32 frame = 1; frame <= WORLD_FRAMES; ++frame) {
+		for (EntitySlot entity = 0; entity < ENTITY_COUNT; ++entity) {
+			u8 move = scripted.move[entity].move;
+			if (move == Dying && entityFrames(&scripted, entity) > DEATH_FRAMES) {
+				destroyEntity(&scripted, entity);
+				spawnDuellist(&scripted);
+			}
+			else if (move == Guarding && entityFrames(&scripted, entity) > ATTACK_FRAMES && entity < WORLD_PLAYER - GUARD_HOLDERS) {
+				scripted.move[entity].move = Idling;
+				setEntityFrames(&scripted, entity, 0);
+				refreshBusyEntity(&scripted, entity);
+			}
+			else if (move == Idling && entityStaggered(&scripted, entity) == 0 && randomRange(&random, START_CHANCE) == 0) {
+				scripted.move[entity].move = moves[randomRange(&random, 4)];
+				setEntityFrames(&scripted, entity, 0);
+				refreshBusyEntity(&scripted, entity);
+			}
+		}
+		setFacing(&scripted, WORLD_PLAYER, WORLD_PLAYER + 1);
+		refreshEntityHash(&scripted, WORLD_PLAYER);
+
+		combatSystem(&scripted, &context);
+		EventQueue events = renderSystem(&scripted, &context);
+		if (worldHash(&scripted) != fullWorldHash(&scripted))
+			return fail("scripted world hash differs from full hash", frame);
+		sum = digestFrame(sum, &scripted, &context, &events);
+		for (EntitySlot entity = WORLD_PLAYER - GUARD_HOLDERS; entity < WORLD_PLAYER; ++entity)
+			wraps += scripted.move[entity].move == Guarding && entityFrames(&scripted, entity) == 0;
+	}
+	if (wraps == 0)
+		return fail("no held guard wrapped 'frames' around", WORLD_FRAMES);
+	sprintf(line, "world: %u frames, digest %016llx\n", WORLD_FRAMES, sum);
+	return 0;
+}
+
+
+int main(int argc, char **argv) {
+	char line[128], expected[128];
+	u8 compare = argc == 3 && strcmp(argv[1], "-c") == 0;
+	FILE *file = NULL;
+
+	if (argc == 3 && (compare || strcmp(argv[1], "-o") == 0))
+		file = fopen(argv[2], compare ? "r" : "w");
+	if (file == NULL) {
+		fprintf(stderr, "usage: %s -o file | -c file\n", argv[0]);
+		return 1;
+	}
+
+	for (u32 test = 0; test <= MATCHES; ++test) {
+		if (((test < MATCHES) ? digestMatch(test, line) : digestWorld(line)) != 0)
+			return 1;
+		if (!compare)
+			fputs(line, file);
+		else if (fgets(expected, sizeof(expected), file) == NULL || strcmp(line, expected) != 0) {
+			printf("FAIL: %sexpected %s", line, expected);
+			return 1;
+		}
+	}
+	fclose(file);
+	printf("%u matches and a scripted world of %u frames: %s\n", MATCHES, WORLD_FRAMES,
+		compare ? "same as with frame counting" : "digests written");
+	return 0;
+}
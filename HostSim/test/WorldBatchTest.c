@@ -0,0 +1,215 @@
+/*!
+\file WorldBatchTest.c
+\brief Differential test of combatSystemBatch
+\date 10/2026
+
+Runs combatSystem and every combatSystemBatch kernel the CPU supports on the same worlds
+and fails on the first field that differs.
+Worlds are random valid states, biased towards the frame counts where moves change,
+and states sampled every frame from real matches.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Match.h"
+#include "WorldBatch.h"
+
+#define RANDOM_WORLDS 1021	/*!< Worlds per random round. Not a multiple of BATCH_ALIGNMENT, to test padding. */
+#define RANDOM_ROUNDS 200	/*!< Number of random rounds. */
+#define RANDOM_FRAMES 4	/*!< Combat frames run on the worlds of each random round. */
+#define MATCH_WORLDS 4000	/*!< Number of states sampled from matches. */
+
+static u32 randomState = 0x0BA7C4ED;	/*!< State of the xorshift generator writing the random worlds. */
+static World worlds[MATCH_WORLDS];	/*!< Worlds of the current round, run through combatSystem. */
+static SimContext contexts[MATCH_WORLDS];	/*!< Contexts of the current round. */
+
+
+static u32 nextTestRandom() {
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+
+/*! Returns a frame count, mostly near the values combatSystem compares against. */
+static u16 randomFrames() {
+	switch (nextTestRandom() % 8)
+	{
+	case 0:
+		return (u16)nextTestRandom();
+	case 1:
+		return 0xFFFF;
+	default:
+		return (u16)(nextTestRandom() % 36);
+	}
+}
+
+
+static void writeRandomWorld(World *world, SimContext *context) {
+	memset(world, 0, sizeof(World));
+	for (EntitySlot entity = 0; entity < ENTITY_COUNT; ++entity) {
+		world->mask[entity] = (nextTestRandom() % 4) ? (u16)(nextTestRandom() & 0x1F) : COMPONENT_NONE;
+		world->health[entity].points = nextTestRandom() % 8 ? nextTestRandom() % 6 : nextTestRandom() & 31;
+		world->health[entity].staggered = (u8)((nextTestRandom() % 2) ? nextTestRandom() % 3 : nextTestRandom() % 26);
+		world->timing[entity].frames = randomFrames();
+		world->timing[entity].facing = nextTestRandom() % ENTITY_COUNT;
+		world->timing[entity].facingGeneration = (u8)(nextTestRandom() % 4 ? 0 : 1); // Sometimes a destroyed opponent
+		world->generation[entity] = (u8)(nextTestRandom() % 4 ? 0 : 0xFF);
+		world->move[entity].move = nextTestRandom() % (Dying + 1);
+		world->sprite[entity].spriteData = (SpriteSheet)(nextTestRandom() % 3);
+		world->teamMember[entity].isActive = nextTestRandom() & 1;
+		world->teamMember[entity].id = nextTestRandom() & 7;
+	}
+	context->currentPlayer = (EntitySlot)(nextTestRandom() % ENTITY_COUNT);
+	context->eventSFX = (u8)(nextTestRandom() % 3 ? 0 : SFX_SWING);
+	context->randomAI.state = nextTestRandom();
+	context->difficultyAIaccumulator = (u16)nextTestRandom();
+	rebuildEntitySets(world);
+}
+
+
+/*! Plays matches and keeps the state after every input/AI step, right before combatSystem would run.
+
+	Also checks that every live character faces a slot of the world, through the deaths of reserve characters,
+	which combatSystem destroys without bringing the next enemy.
+\return 0 if every facing was valid and a reserve character died, otherwise 1.
+*/
+static int sampleMatches(u32 count) {
+	World world;
+	SimContext context;
+	PlayerBot bot;
+	ButtonInput buttonInput = { FALSE, Neutral };
+	u32 sampled = 0, reserveDeaths = 0;
+
+	for (u32 match = 0; sampled < count; ++match) {
+		memset(&world, 0, sizeof(World));
+		initializeMatch(&world, &context, (u8)(1 + match % MAX_ALLIES), match);
+		initializePlayerBot(&bot, matchSeed(7, match));
+
+		for (u32 frame = 0; frame < MATCH_FRAME_LIMIT && sampled < count; ++frame) {
+			context.difficultyAIaccumulator += DIFF_NORMAL;
+			playerBotInput(&bot, &world, &context, &buttonInput);
+
+			context.eventSFX = 0;
+			inputSystem(&world, &context, &buttonInput);
+			context.difficultyAIaccumulator = AISystem(&world, &context, context.difficultyAIaccumulator);
+			if (nextTestRandom() % 8 == 0) { // Keep one frame in 8, so that samples spread over many matches.
+				worlds[sampled] = world;
+				contexts[sampled] = context;
+				++sampled;
+			}
+			u16 reserve[ENTITY_COUNT];
+			for (EntitySlot entity = 0; entity < ENTITY_COUNT; ++entity)
+				reserve[entity] = (entity != context.currentPlayer) ? world.mask[entity] : COMPONENT_NONE;
+			combatSystem(&world, &context);
+			renderSystem(&world, &context);
+			for (EntitySlot entity = 0; entity < ENTITY_COUNT; ++entity) {
+				if (world.mask[entity] != COMPONENT_NONE && world.timing[entity].facing >= ENTITY_COUNT) {
+					printf("match %u frame %u: entity %u faces slot %u\n", match, frame, entity, world.timing[entity].facing);
+					return 1;
+				}
+				if ((reserve[entity] & COMPONENT_TEAMMEMBER) && world.mask[entity] == COMPONENT_NONE)
+					++reserveDeaths;
+			}
+			if (matchOutcome(&world, &context) != MatchPlaying)
+				break;
+		}
+	}
+	if (reserveDeaths == 0) {
+		printf("no reserve character died in the sampled matches\n");
+		return 1;
+	}
+	printf("reserve characters dead: %u\n", reserveDeaths);
+	return 0;
+}
+
+
+/*! Compares a world with a world of the batch, field by field.
+\return 0 if equal, otherwise 1 after printing the first difference.
+*/
+static int compareWorld(const WorldBatch *batch, u32 index, const World *expected, const SimContext *expectedContext, const char *kernel) {
+	World world;
+	SimContext context;
+
+	loadWorldFromBatch(batch, index, &world, &context);
+	for (EntitySlot entity = 0; entity < ENTITY_COUNT; ++entity) {
+		if (world.mask[entity] != expected->mask[entity]
+			|| world.health[entity].points != expected->health[entity].points
+			|| world.health[entity].staggered != expected->health[entity].staggered
+			|| world.timing[entity].frames != expected->timing[entity].frames
+			|| world.timing[entity].facing != expected->timing[entity].facing
+			|| world.timing[entity].facingGeneration != expected->timing[entity].facingGeneration
+			|| world.generation[entity] != expected->generation[entity]
+			|| world.move[entity].move != expected->move[entity].move
+			|| world.sprite[entity].spriteData != expected->sprite[entity].spriteData
+			|| world.teamMember[entity].isActive != expected->teamMember[entity].isActive
+			|| world.teamMember[entity].id != expected->teamMember[entity].id) {
+			printf("%s: world %u entity %u differs from combatSystem\n", kernel, index, entity);
+			return 1;
+		}
+	}
+	if (context.currentPlayer != expectedContext->currentPlayer || context.eventSFX != expectedContext->eventSFX
+		|| context.randomAI.state != expectedContext->randomAI.state
+		|| context.difficultyAIaccumulator != expectedContext->difficultyAIaccumulator) {
+		printf("%s: world %u context differs from combatSystem\n", kernel, index);
+		return 1;
+	}
+	return 0;
+}
+
+
+/*! Runs combatSystem and every supported kernel for a few frames on worlds[0..count[, and compares after every frame. */
+static int testWorlds(u32 count, u32 frameCount) {
+	static World expected[MATCH_WORLDS];
+	static SimContext expectedContext[MATCH_WORLDS];
+	BatchKernel best = bestBatchKernel();
+	int failures = 0;
+
+	for (BatchKernel kernel = BatchKernelScalar; kernel <= best; ++kernel) {
+		WorldBatch batch;
+		if (createWorldBatch(&batch, count) != 0) {
+			printf("out of memory\n");
+			return 1;
+		}
+		for (u32 index = 0; index < count; ++index) {
+			expected[index] = worlds[index];
+			expectedContext[index] = contexts[index];
+			storeWorldInBatch(&batch, index, &worlds[index], &contexts[index]);
+		}
+
+		for (u32 frame = 0; frame < frameCount && failures == 0; ++frame) {
+			for (u32 index = 0; index < count; ++index)
+				combatSystem(&expected[index], &expectedContext[index]);
+			combatSystemBatch(&batch, kernel);
+			for (u32 index = 0; index < count && failures == 0; ++index)
+				failures += compareWorld(&batch, index, &expected[index], &expectedContext[index], batchKernelName(kernel));
+		}
+		destroyWorldBatch(&batch);
+	}
+	return failures;
+}
+
+
+int main() {
+	int failures = 0;
+
+	printf("kernels up to %s\n", batchKernelName(bestBatchKernel()));
+
+	for (u32 round = 0; round < RANDOM_ROUNDS && failures == 0; ++round) {
+		for (u32 index = 0; index < RANDOM_WORLDS; ++index)
+			writeRandomWorld(&worlds[index], &contexts[index]);
+		failures += testWorlds(RANDOM_WORLDS, RANDOM_FRAMES);
+	}
+	printf("random worlds: %s\n", failures ? "FAILED" : "ok");
+
+	if (failures == 0) {
+		failures += sampleMatches(MATCH_WORLDS);
+		failures += testWorlds(MATCH_WORLDS, 40);
+		printf("match worlds: %s\n", failures ? "FAILED" : "ok");
+	}
+
+	return failures ? 1 : 0;
+}
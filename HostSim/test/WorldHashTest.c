@@ -0,0 +1,125 @@
+/*!
+\file WorldHashTest.c
+\brief Test of the incremental world hash
+\date 10/2026
+
+Plays matches with the scripted player and, after every frame, compares the hash the World keeps
+(updated by the systems as they write components) with fullWorldHash, computed from the components.
+Also checks that every simulated field of every entity changes the hash.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Match.h"
+
+#define MATCHES 300	/*!< Matches played. */
+
+
+static int fail(const char *message, u32 number) {
+	printf("FAIL: %s (%u)\n", message, number);
+	return 1;
+}
+
+
+/*! Plays a match and checks world.hash after every frame. Adds the number of frames to *frames. */
+static int testMatch(u32 match, u32 *frames) {
+	static const u16 difficulties[] = { DIFF_EASY, DIFF_NORMAL, DIFF_HARD, DIFF_NIGHTMARE, DIFF_PERFECT };
+	MatchSetup setup = { (u8)(1 + match % MAX_ALLIES), difficulties[match % 5], matchSeed(15, match) };
+	World world;
+	SimContext context;
+	PlayerBot bot;
+	ButtonInput input = { FALSE, Neutral };
+
+	memset(&world, 0x5A, sizeof(World)); // initializeMatch must not depend on a cleared World for the hash.
+	memset(&world.mask, 0, sizeof(world.mask));
+	initializeMatch(&world, &context, setup.numAllies, matchSeed(setup.seed, MATCH_WORLD_STREAM));
+	initializePlayerBot(&bot, setup.seed);
+	if (world.hash != fullWorldHash(&world))
+		return fail("hash of the starting state differs", match);
+
+	for (u32 frame = 1; frame <= MATCH_FRAME_LIMIT; ++frame) {
+		context.difficultyAIaccumulator += setup.difficulty;
+		playerBotInput(&bot, &world, &context, &input);
+		updateWorld(&world, &context, &input);
+		++*frames;
+		if (world.hash != fullWorldHash(&world))
+			return fail("incremental hash differs from full hash", frame);
+		if (matchOutcome(&world, &context) != MatchPlaying)
+			break;
+	}
+
+	// Same for a state written without the functions of Entities.h.
+	WorldHash hash = world.hash;
+	rebuildEntitySets(&world);
+	if (world.hash != hash)
+		return fail("rebuildEntitySets changed the hash", match);
+	return 0;
+}
+
+
+/*! Changes each field of each entity of a started match, and checks that the hash tells. */
+static int testFields() {
+	World world, changed;
+	SimContext context, changedContext;
+
+	memset(&world, 0, sizeof(World));
+	initializeMatch(&world, &context, MAX_ALLIES, 2018);
+	for (EntitySlot entity = 0; entity < ENTITY_COUNT; ++entity) {
+		for (u8 field = 0; field < 10; ++field) {
+			changed = world;
+			switch (field)
+			{
+			case 0: changed.health[entity].points ^= 1; break;
+			case 1: changed.health[entity].staggered ^= 1; break;
+			case 2: changed.timing[entity].frames ^= 1; break;
+			case 3: changed.timing[entity].facing ^= 1; break;
+			case 4: changed.move[entity].move ^= 1; break;
+			case 5: changed.teamMember[entity].isActive ^= 1; break;
+			case 6: changed.teamMember[entity].id ^= 1; break;
+			case 7: changed.mask[entity] ^= COMPONENT_MOVE; break;
+			case 8: changed.timing[entity].facingGeneration ^= 1; break;
+			default: changed.generation[entity] ^= 1; break;
+			}
+			if (fullWorldHash(&changed) == world.hash)
+				return fail("field not hashed", entity * 10 + field);
+			refreshEntityHash(&changed, entity);
+			if (changed.hash != fullWorldHash(&changed))
+				return fail("refreshEntityHash missed a field", entity * 10 + field);
+		}
+	}
+
+	// The sprite sheet is only drawn.
+	changed = world;
+	changed.sprite[0].spriteData = mockPlayer2;
+	if (fullWorldHash(&changed) != world.hash)
+		return fail("sprite sheet hashed", 0);
+
+	changed = world;
+	changedContext = context;
+	nextRandom(&changedContext.randomAI);
+	if (simulationHash(&changed, &changedContext) == simulationHash(&world, &context))
+		return fail("random stream not hashed", 0);
+	changedContext = context;
+	changedContext.difficultyAIaccumulator++;
+	if (simulationHash(&changed, &changedContext) == simulationHash(&world, &context))
+		return fail("AI accumulator not hashed", 0);
+	changedContext = context;
+	changedContext.currentPlayer++;
+	if (simulationHash(&changed, &changedContext) == simulationHash(&world, &context))
+		return fail("current player not hashed", 0);
+	return 0;
+}
+
+
+int main() {
+	u32 frames = 0;
+
+	if (testFields() != 0)
+		return 1;
+	for (u32 match = 0; match < MATCHES; ++match)
+		if (testMatch(match, &frames) != 0)
+			return 1;
+	printf("%u matches, %u frames: incremental hash equal to full hash after every frame\n", MATCHES, frames);
+	return 0;
+}
@@ -1,2 +1,16 @@
+@REM COMPILE.bat builds the ROM with the packed component layout.
+@REM COMPILE.bat aligned builds it with the word-aligned, bitfield-free layout (ECS_UNPACKED_COMPONENTS, see inc\Components.h).
+@REM Add profile to show the 68000 cycles of updateWorld and the size of World in game (PROFILE_UPDATE, see main.c).
+@REM Add systems to record per-system histograms in systemProfile, readable from RAM in a debugger (PROFILE_SYSTEMS, see inc\Profile.h).
+@REM Add cycles to keep startGame, updateWorld, checkProgression and updateAnim out of line (no LTO), so that romprofile (HostSim/RomProfile.c) reports each of them.
+@REM Needs an SGDK whose makefile.gen adds EXTRA_FLAGS to the compiler flags. Otherwise add the flags there by hand.
+set EXTRA_FLAGS=
+:options
+if "%1"=="aligned" set EXTRA_FLAGS=%EXTRA_FLAGS% -DECS_UNPACKED_COMPONENTS
+if "%1"=="profile" set EXTRA_FLAGS=%EXTRA_FLAGS% -DPROFILE_UPDATE
+if "%1"=="systems" set EXTRA_FLAGS=%EXTRA_FLAGS% -DPROFILE_SYSTEMS
+if "%1"=="cycles" set EXTRA_FLAGS=%EXTRA_FLAGS% -fno-lto -fno-inline-functions-called-once
+shift
+if not "%1"=="" goto options
 %GDK_WIN%\bin\make -f %GDK_WIN%\makefile.gen
 pause
\ No newline at end of file
@@ -5,6 +5,16 @@
 \date 06/2018
 
 Components file of the ECS architecture. No .c file needed.
+
+Two layouts of the components exist, selected at compile time. Systems read and write both the same way.
+- Default: packed structures with bitfields, to save work RAM.
+- ECS_UNPACKED_COMPONENTS defined: no packing and no bitfields, so that every field
+	is read and written with plain loads and stores. See also World in Entities.h.
+	On the console (COMPILE.bat aligned), this is the word-aligned layout: the 68000 cannot read a word
+	at an odd address, so with pack(1) GCC reads 'frames' byte by byte, and every bitfield costs
+	a read, shifts and masks. Component structures are padded to even sizes, so indexing an array is
+	a shift instead of a multiplication. World grows by that padding and by the bitfields made whole bytes:
+	a profile build (COMPILE.bat aligned profile) shows its size.
 */
 
 #ifndef ECS_COMPONENTS_H_
@@ -12,7 +22,53 @@ Components file of the ECS architecture. No .c file needed.
 
 #include "types.h"
 
-#pragma pack(1)
+#ifndef ECS_UNPACKED_COMPONENTS
+#pragma pack(push, 1)
+#endif
+
+/*! \brief Maximum number of entities in game world.
+
+	Define it when compiling to change the capacity, e.g. -DENTITY_COUNT=10000 for large host simulations.
+	The console build keeps the default.
+*/
+#ifndef ENTITY_COUNT
+#define ENTITY_COUNT 20
+#endif
+
+/*! \brief Number of bits needed to store an entity slot. Only as wide as ENTITY_COUNT requires.*/
+#if ENTITY_COUNT <= 16
+#define ENTITY_BITS 4
+#elif ENTITY_COUNT <= 32
+#define ENTITY_BITS 5
+#elif ENTITY_COUNT <= 64
+#define ENTITY_BITS 6
+#elif ENTITY_COUNT <= 128
+#define ENTITY_BITS 7
+#elif ENTITY_COUNT <= 255
+#define ENTITY_BITS 8
+#elif ENTITY_COUNT <= 0xFFFF
+#define ENTITY_BITS 16
+#elif ENTITY_COUNT <= 0xFFFFFF
+#define ENTITY_BITS 24
+#else
+#error ENTITY_COUNT must be below 2^24.
+#endif
+
+/*! \brief Type of an entity slot, and ENTITY_NONE, the largest value of the type, which is never a slot.
+
+	u8 up to 255 entities, so the console build and its callers are unchanged.
+	Entity slot values that can be ENTITY_NONE, e.g. return values, use this type.
+*/
+#if ENTITY_BITS <= 8
+typedef u8 EntitySlot;
+#define ENTITY_NONE 0xFF
+#elif ENTITY_BITS <= 16
+typedef u16 EntitySlot;
+#define ENTITY_NONE 0xFFFF
+#else
+typedef u32 EntitySlot;
+#define ENTITY_NONE 0xFFFFFFFF
+#endif
 
 /*! \brief Enumeration with every character sprite sheet.*/
 typedef enum {
@@ -21,6 +77,8 @@ typedef enum {
 	mockEnemy,	/**< Red enemy character  */
 } SpriteSheet;
 
+#define SPRITE_SHEETS 3	/*!< Number of sprite sheets in the SpriteSheet enumeration. */
+
 /*! \brief Structure with health points and time staggered.
 
 	Character dies when hit points reaches 0.
@@ -29,7 +87,11 @@ typedef enum {
 	When greater than 0, character remains staggered until value reaches 0.
 */
 typedef struct {
+#ifndef ECS_UNPACKED_COMPONENTS
 	u8 points : 5;	/**< Hit points  */
+#else
+	u8 points;
+#endif
 	u8 staggered;	/**< How many frames character remains staggered  */
 } Health;
 
@@ -38,22 +100,44 @@ typedef struct {
 	When a character is idle, 'frames' is 0.
 	'frames' increments at every frame when animation is playing.
 	'facing' is a reference to the enemy, so as to know whom to interact with in combat system.
+	'facingGeneration' tells whether the enemy in that slot is still the same one (see facedEntity in Entities.h).
 */
 typedef struct {
 	u16 frames;	/**< Number of frames animation has played for  */
-	u8 facing : 4; /**< Entity slot of current opponent  */
+#ifndef ECS_UNPACKED_COMPONENTS
+	EntitySlot facing : ENTITY_BITS; /**< Entity slot of current opponent  */
+#else
+	EntitySlot facing;
+#endif
+	u8 facingGeneration;	/**< Generation of the opponent's slot when it was faced  */
 } Timing;
 
-/*! \brief Structure with data on current action and corresponding animation. */
+/*! \brief Structure with the current action of a character.
+
+	The combat system reads it every frame, so it holds nothing else. Its animation is in CharacterSprite.
+*/
 typedef struct {
-	SpriteSheet spriteData;		/**< Entity slot of current opponent  */
+#ifndef ECS_UNPACKED_COMPONENTS
 	u8 move : 4;		/**< ID signifying type of attack character is executing. Uses AttackType enum in Systems.h  */
+#else
+	u8 move;
+#endif
 } Move;
 
+/*! \brief Structure with the sprite sheet animating a character. Only read when rendering. */
+typedef struct {
+	SpriteSheet spriteData;		/**< Sprite sheet of the character  */
+} CharacterSprite;
+
 /*! \brief Structure with data if the entity is playable and currently controlled */
 typedef struct {
+#ifndef ECS_UNPACKED_COMPONENTS
 	u8 isActive : 1;	/**< Set to 1 (TRUE) if player controls the character currently */
 	u8 id : 3;	/**< Player party counter. Range: 1-4  */
+#else
+	u8 isActive;
+	u8 id;
+#endif
 } TeamMember;
 
 
@@ -70,4 +154,10 @@ typedef enum {
 	COMPONENT_TEAMMEMBER = 1 << 4,
 } Component;
 
+#define COMPONENT_TYPES 5	/*!< Number of component types in the Component enumeration (excluding COMPONENT_NONE). */
+
+#ifndef ECS_UNPACKED_COMPONENTS
+#pragma pack(pop)
+#endif
+
 #endif // !ECS_COMPONENTS_H_
\ No newline at end of file
@@ -0,0 +1,126 @@
+/*!
+\file DmaQueue.h
+\brief DMA queue header file
+\date 10/2026
+
+Schedules the uploads of a frame into the time DMA has during VBlank, by priority: what SGDK's vertical interrupt
+already sent first, then the frames of the resident sprites (see SpriteDelta.h), then the sprite palettes, then the
+stage being streamed (see StageStream.h), which takes whatever is left. Only schedules: main.c makes a request for every
+upload it needs, then sends the ones nextDma gives. No frame sends more than its budget. A request that does not fit in
+what is left is deferred: it is not sent, and main.c asks for it again the next frame. A request larger than the whole
+budget could never fit: it is split instead, a part every frame, and main.c asks for the rest the next frame.
+Counts the bytes deferred and the frames that asked for more than the budget.
+
+The budget is what DMA moves to VRAM during the lines of VBlank, less the lines the CPU work of SGDK's vertical interrupt
+(XGM, joypad) and the return of VDP_waitVSync take. That reserve is an estimate on the safe side, not a measure.
+What the interrupt uploads (sprite table, palette fades) is counted in the budget as DmaInterrupt.
+*/
+
+#ifndef DMA_QUEUE_H_
+#define DMA_QUEUE_H_
+
+#include "types.h"
+
+#define DMA_LINE_BYTES 205	/*!< Bytes DMA moves to VRAM in a line of VBlank, 320 pixels wide (H40). */
+#define DMA_VBLANK_LINES_NTSC 38	/*!< Lines of VBlank in a frame of 224 lines: 262 - 224. */
+#define DMA_VBLANK_LINES_PAL 89	/*!< Lines of VBlank in a frame of 224 lines: 313 - 224. */
+#define DMA_RESERVED_LINES 6	/*!< Lines of VBlank gone before main.c uploads: CPU work of SGDK's vertical interrupt and the return of VDP_waitVSync. */
+#define DMA_BUDGET_NTSC ((DMA_VBLANK_LINES_NTSC - DMA_RESERVED_LINES) * DMA_LINE_BYTES)	/*!< Bytes of a frame, NTSC: 6560. */
+#define DMA_BUDGET_PAL ((DMA_VBLANK_LINES_PAL - DMA_RESERVED_LINES) * DMA_LINE_BYTES)	/*!< Bytes of a frame, PAL: 17015. */
+#define DMA_REQUESTS 8	/*!< Most requests of a frame. */
+#define DMA_SPLIT_BYTES 32	/*!< Bytes the parts of a split request are a multiple of: a tile, or a palette. */
+
+/*! \brief Enumeration with the priorities of uploads, first sent first. */
+typedef enum {
+	DmaInterrupt,	/**< Sent by SGDK's vertical interrupt before main.c uploads: counted with spendDma */
+	DmaSpriteFrame,	/**< Tiles of the frame a resident sprite draws */
+	DmaPalette,	/**< Palette of a sprite sheet */
+	DmaStage,	/**< Chunks of the stage being streamed, within what is left */
+	DMA_PRIORITIES	/**< Number of priorities */
+} DmaPriority;
+
+/*! \brief Structure with a request for an upload.
+	\param bytes Bytes to send
+	\param priority Priority (see DmaPriority)
+	\param tag What to send, for the caller: the sprite for DmaSpriteFrame and DmaPalette
+*/
+typedef struct {
+	u16 bytes;
+	u8 priority;
+	u8 tag;
+} DmaRequest;
+
+/*! \brief Structure with the requests of a frame, and counts over every frame.
+	\param request[] Requests of the frame, in the order they were made
+	\param requests Number of requests
+	\param taken Bit i set once request[i] was sent or deferred
+	\param budget Bytes of the frame
+	\param spent Bytes sent this frame
+	\param overrun 1 (TRUE) if the frame asked for more than its budget
+	\param frames Frames started
+	\param overrunFrames Frames that asked for more than their budget
+	\param sentBytes[] Bytes sent, by priority
+	\param deferredBytes[] Bytes deferred, by priority. A request deferred twice counts twice. The stage is never deferred: it waits in its stream.
+*/
+typedef struct {
+	DmaRequest request[DMA_REQUESTS];
+	u8 requests;
+	u8 taken;
+	u16 budget;
+	u16 spent;
+	u8 overrun;
+	u32 frames;
+	u32 overrunFrames;
+	u32 sentBytes[DMA_PRIORITIES];
+	u32 deferredBytes[DMA_PRIORITIES];
+} DmaQueue;
+
+
+/*! \brief Empties a queue and its counts.
+	\param *queue The queue.
+	\return void
+*/
+void initializeDmaQueue(DmaQueue *queue);
+
+/*! \brief Starts the requests of a frame. Requests the previous frame did not send are dropped: ask for them again.
+	\param *queue The queue.
+	\param budget Bytes DMA may send this frame (DMA_BUDGET_NTSC or DMA_BUDGET_PAL).
+	\return void
+*/
+void startDmaFrame(DmaQueue *queue, u16 budget);
+
+/*! \brief Requests an upload this frame.
+	\param *queue The queue.
+	\param priority Priority (see DmaPriority).
+	\param bytes Bytes to send.
+	\param tag What to send, given back by nextDma.
+	\return 1 (TRUE) if queued, 0 (FALSE) if the queue is full: the upload is deferred.
+*/
+u8 requestDma(DmaQueue *queue, DmaPriority priority, u16 bytes, u8 tag);
+
+/*! \brief Takes the next request to send, by priority, then in the order they were made.
+
+	Call it until it returns 0, and send each request it gives. A request that does not fit in what is left of the
+	budget is deferred, and the next one is tried. A request larger than the budget is split: it gets what is left, in
+	multiples of DMA_SPLIT_BYTES, and the caller asks for the rest the next frame.
+	\param *queue The queue.
+	\param *request Written with the request to send. Its bytes are less than requested if it was split.
+	\return 1 (TRUE) if a request is to be sent, 0 (FALSE) once every request was taken.
+*/
+u8 nextDma(DmaQueue *queue, DmaRequest *request);
+
+/*! \brief Returns the bytes left in the budget of the frame, for uploads that take what is left (DmaStage).
+	\param *queue The queue.
+	\return Bytes left.
+*/
+u16 dmaBytesLeft(const DmaQueue *queue);
+
+/*! \brief Counts bytes sent outside of the requests: within dmaBytesLeft, or already sent (DmaInterrupt).
+	\param *queue The queue.
+	\param priority Priority they were sent with.
+	\param bytes Bytes sent.
+	\return void
+*/
+void spendDma(DmaQueue *queue, DmaPriority priority, u16 bytes);
+
+#endif // !DMA_QUEUE_H_
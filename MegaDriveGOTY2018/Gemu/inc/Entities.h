@@ -10,65 +10,462 @@ Entities header file of the ECS architecture.
 #ifndef ECS_ENTITIES_H_
 #define ECS_ENTITIES_H_
 
-#pragma pack(1)
-
 #include "Components.h"
 
+#ifndef ECS_UNPACKED_COMPONENTS
+#pragma pack(push, 1)
+#endif
+#include "Random.h"
 
-/*! \brief Maximum number of entities in game world.*/
-#define ENTITY_COUNT 20
 
+/*! \brief Number of 32-bit words in a set with one bit per entity slot.*/
+#define ENTITY_WORDS ((ENTITY_COUNT + 31) / 32)
 
-/*! \brief Entity slot of the currently controlled player character.
+/*! \brief Flag for nextEntityWith, next to the component flags: entities that are busy.
 
-	Variable that keeps track of the entity slot belonging to the currently controlled player character.
-	This avoid looping through all entities when only two entities are active in-game.
-	A variable currentEnemy is not needed
-	because current player entity will
-	reference current enemy entity slot through Timing structure, 'facing' variable. 
+	An entity is busy while its move is not Idling or while it is staggered.
+	Entities that are not busy are left unchanged by the combat system, so it only visits busy ones.
+	*/
+#define ENTITY_BUSY (1 << COMPONENT_TYPES)
+
+/*! \brief Reference to an entity that can tell whether the entity still exists.
+
+	The low ENTITY_HANDLE_SHIFT bits are the entity slot, the byte above them the generation of the slot when the handle was made.
+	Destroying an entity increments the generation of its slot, so older handles stop resolving
+	even after the slot is reused (see entityOfHandle).
+	16 bits with the default capacity, 32 bits for worlds of more than 255 entities.
+	*/
+#if ENTITY_BITS <= 8
+typedef u16 EntityHandle;
+#define ENTITY_HANDLE_SHIFT 8
+#else
+typedef u32 EntityHandle;
+#define ENTITY_HANDLE_SHIFT 24
+#endif
+
+/*! \brief Alignment of the component arrays the combat system reads every frame (see World).
+
+	A cache line on the host, with ECS_UNPACKED_COMPONENTS. Nothing on the console, which has no cache.
+	*/
+#if defined(ECS_UNPACKED_COMPONENTS) && !defined(__m68k__)
+#define HOT_COMPONENTS __attribute__((aligned(64)))
+#else
+#define HOT_COMPONENTS
+#endif
+
+
+/*! \brief Define ECS_WORLD_HASH to keep a hash of the game state in every World (see refreshEntityHash).
+
+	The host builds define it (CMakeLists.txt), to compare simulations frame by frame: replays, rollback.
+	The console build does not: refreshEntityHash then does nothing, and World keeps its size.
+	*/
+#ifdef ECS_WORLD_HASH
+typedef unsigned long long WorldHash;	/*!< 64-bit hash of game state. */
+#else
+#define refreshEntityHash(world, entity) ((void)0)
+#define refreshEntityFrame(world, entity) ((void)0)
+#endif
+
+
+/*! \brief Define ECS_TIMER_WHEEL to have combatSystem keep 'frames' and 'staggered' with timers instead of counting them.
+
+	Every frame, combatSystem counts 'frames' up for each entity whose move is not Idling or Staggered,
+	and 'staggered' down for each staggered entity, but only acts when a count reaches a few values:
+	an attack hits, a move, a stagger or a death animation ends. With timers, a World keeps the frame a count started
+	(or ends) at instead of the count, and schedules on a timer wheel the next frame combatSystem has to act on each entity.
+	combatSystem then only visits the entities with a timer due: its cost follows the number of events, not of busy entities.
+	Read and write 'frames' and 'staggered' with entityFrames, setEntityFrames, entityStaggered and setEntityStaggered,
+	which are the components themselves without ECS_TIMER_WHEEL.
+	Host only: CMakeLists.txt builds scalebench_wheel_<count> and the timerwheel test with it. The console build counts.
+	*/
+#ifdef ECS_TIMER_WHEEL
+#define TIMER_SLOTS 256	/*!< Number of frames in one turn of the timer wheel. Power of two. */
+#define TIMER_NEVER 0xFFFFFFFFUL	/*!< Due frame of an entity without timer. */
+#define TIMER_EPOCH 0x10000UL	/*!< First clock value, so that a frame a count of up to 0xFFFF started at is never below 0. */
+
+/*! \brief Progress of combatSystem through the current frame, for the entity it visits (see EntityTimers). */
+typedef enum {
+	TimerStarted,	/**< A frame started, no entity visited yet. */
+	TimerVisiting,	/**< Visiting the entity, which has not counted yet. */
+	TimerStaggerCounted,	/**< Its 'staggered' counted. */
+	TimerFrameCounted,	/**< Its 'frames' counted too. */
+	TimerVisited	/**< Visit over. Also between frames. */
+} TimerPhase;
+
+/*! \brief Structure with the timers of the entities of a World, with ECS_TIMER_WHEEL.
+
+	An entity is running while its move is neither Idling nor Staggered: 'frames' is then clock - frameStart[].
+	An entity is counting while 'staggered' is above 0: 'staggered' is then staggerEnd[] - clock.
+	Otherwise the component holds the value, as without timers.
+	During a frame of combatSystem, entities after the cursor (and the cursor, until it counted) count one less:
+	as when counting, they have not been visited yet.
+
+	Every busy entity has a timer: the next frame combatSystem has to visit it at, in the list of wheel slot
+	'frame % TIMER_SLOTS'. When a frame starts, the timers due move from the list of its slot to a queue, which
+	combatSystem empties in ascending slot order, as it visits entities when counting.
+
+\param clock Number of frames combatSystem started, from TIMER_EPOCH. Wraps around after some 800 days at 60 frames a second.
+\param cursor Entity slot combatSystem visits, ENTITY_COUNT between frames.
+\param phase How far the visit of the cursor went. See TimerPhase.
+\param running[] The set of running entity slots, as an entity set of World.
+\param counting[] The set of counting entity slots.
+\param queued[] The set of entity slots in the queue.
+\param frameStart[] For each running entity slot, the frame its 'frames' was 0 at.
+\param staggerEnd[] For each counting entity slot, the frame its 'staggered' reaches 0 at.
+\param due[] For each entity slot, the frame of its timer, or TIMER_NEVER.
+\param next[] For each entity slot with a timer in the wheel, the next one in the list of its wheel slot, or ENTITY_NONE.
+\param previous[] For each entity slot with a timer in the wheel, the previous one in the list of its wheel slot, or ENTITY_NONE.
+\param slot[] For each wheel slot, the first entity slot of its list, or ENTITY_NONE.
+\param queue[] Entity slots due in the current frame, as a binary heap with the lowest slot first.
+\param queueLength Number of entity slots in the queue.
+\param runningKeys With ECS_WORLD_HASH, the sum of frameKey of the running entity slots.
+\param runningStarts With ECS_WORLD_HASH, the sum of frameKey times frameStart[] of the running entity slots.
+\param countingKeys With ECS_WORLD_HASH, the sum of staggerKey of the counting entity slots.
+\param countingEnds With ECS_WORLD_HASH, the sum of staggerKey times staggerEnd[] of the counting entity slots.
 */
-u8 currentPlayer;
+typedef struct {
+	u32 clock;
+	EntitySlot cursor;
+	u8 phase;
+	u32 running[ENTITY_WORDS];
+	u32 counting[ENTITY_WORDS];
+	u32 queued[ENTITY_WORDS];
+	u32 frameStart[ENTITY_COUNT];
+	u32 staggerEnd[ENTITY_COUNT];
+	u32 due[ENTITY_COUNT];
+	EntitySlot next[ENTITY_COUNT];
+	EntitySlot previous[ENTITY_COUNT];
+	EntitySlot slot[TIMER_SLOTS];
+	EntitySlot queue[ENTITY_COUNT];
+	u32 queueLength;
+#ifdef ECS_WORLD_HASH
+	WorldHash runningKeys;
+	WorldHash runningStarts;
+	WorldHash countingKeys;
+	WorldHash countingEnds;
+#endif
+} EntityTimers;
+
+/*! \brief TRUE if an entity slot is in an entity set: an array of 32-bit words, bit 'entity % 32' of word 'entity / 32'. */
+#define entityInSet(set, entity) (((set)[(entity) >> 5] >> ((entity) & 31)) & 1)
+#else
+#define entityFrames(world, entity) ((world)->timing[entity].frames)
+#define entityStaggered(world, entity) ((world)->health[entity].staggered)
+#define setEntityFrames(world, entity, value) ((world)->timing[entity].frames = (value))
+#define setEntityStaggered(world, entity, value) ((world)->health[entity].staggered = (value))
+#define refreshEntityTimer(world, entity) ((void)0)
+#endif
+
 
 /*! \brief Structure of current game world state.
 
 	The game world contains for each component an array of components of length of maximum entities in game.
-	Since the game contains 4 components, 4 arrays are needed.
+	Since the game contains 5 components, 5 arrays are needed.
 	mask refers to component masks. See Components.h
+	The hot components, read by the combat system every frame, come first, each array starting a cache line
+	(see HOT_COMPONENTS). The cold ones, only read when rendering or switching characters, come last.
 
 \param mask[] An array of component masks, one for each entity.
+\param entitySet[][] For each component type, the set of entity slots that have it (bit 'entity % 32' of word 'entity / 32'),
+	followed by the set of busy entities (see ENTITY_BUSY). Systems use them to visit only the entities they need (see nextEntityWith).
+	Kept up to date by setComponents and refreshBusyEntity.
+\param generation[] For each entity slot, the number of times an entity in it was destroyed, modulo 256. See EntityHandle.
+\param nextFree[] For each unused entity slot, the next unused slot in the free list, or ENTITY_NONE at its end.
+\param previousFree[] For each unused entity slot, the previous unused slot in the free list, or ENTITY_NONE at its start.
+	Together with nextFree, this lets setComponents take any slot out of the list in constant time.
+\param firstFree The first unused entity slot in the free list, or ENTITY_NONE if the world is full.
 \param health[] An array of Health components, one for each entity.
 \param timing[] An array of Timing components, one for each entity.
 \param move[] An array of Move components, one for each entity.
+\param sprite[] An array of CharacterSprite components, one for each entity.
 \param teamMember[] An array of TeamMember components, one for each entity
+\param entityHash[] With ECS_WORLD_HASH, for each entity slot, its hash as of the last refreshEntityHash (see entitySlotHash).
+\param hash With ECS_WORLD_HASH, the hash of the game state: the sum of entityHash[]. See worldHash.
+\param timers With ECS_TIMER_WHEEL, the timers of the entities. See EntityTimers.
 */
 typedef struct {
 	u16 mask[ENTITY_COUNT];
+	u32 entitySet[COMPONENT_TYPES + 1][ENTITY_WORDS];
+	u8 generation[ENTITY_COUNT];
+	EntitySlot nextFree[ENTITY_COUNT];
+	EntitySlot previousFree[ENTITY_COUNT];
+	EntitySlot firstFree;
 
-	Health health[ENTITY_COUNT];
-	Timing timing[ENTITY_COUNT];
-	Move move[ENTITY_COUNT];
+	Health health[ENTITY_COUNT] HOT_COMPONENTS;
+	Timing timing[ENTITY_COUNT] HOT_COMPONENTS;
+	Move move[ENTITY_COUNT] HOT_COMPONENTS;
+
+	CharacterSprite sprite[ENTITY_COUNT];
 	TeamMember teamMember[ENTITY_COUNT];
 
+#ifdef ECS_WORLD_HASH
+	WorldHash entityHash[ENTITY_COUNT];
+	WorldHash hash;
+#endif
+#ifdef ECS_TIMER_WHEEL
+	EntityTimers timers;
+#endif
 } World;
 
+/*! \brief Structure of per-simulation state that is not component data.
+
+	Every system receives this structure alongside the World it updates,
+	so that several worlds can be simulated at the same time (e.g. on several host threads).
+	Give each World its own SimContext.
+
+\param currentPlayer Entity slot of the currently controlled player character.
+	This avoid looping through all entities when only two entities are active in-game.
+	A variable currentEnemy is not needed because current player entity will
+	reference current enemy entity slot through Timing structure, 'facing' variable.
+\param eventSFX The ID of the sound effect to be played this frame.
+	If value is 0, no sound effect is played this frame.
+	Various events may set it to a sound effect ID. The ID is retrieved by the renderSystem
+	and sent as a return value as part of EventQueue structure. Then it is set to 0 for the next game update.
+\param randomAI Random numbers for the AI, seeded by initializeMatch.
+	The same seed gives the same AI decisions on the console and on the host.
+\param difficultyAIaccumulator Accumulating value that if high enough, enemy AI will act.
+	Every frame, the difficulty value will be added to this number.
+	If the number is less than 100, AI will not act on that frame.
+	That means on easy, AI will on average act once every 100/3 = 33.3th frame.
+\param renderedSpriteSheet[] Sprite sheets of the current player character and of its enemy, as of the last renderSystem call.
+\param renderedAnimation[] Their animations, as of the last renderSystem call.
+	renderSystem only sends the changes from these. initializeMatch sets them to the starting game state.
+*/
+typedef struct {
+	EntitySlot currentPlayer;
+	u8 eventSFX;
+	RandomStream randomAI;
+	u16 difficultyAIaccumulator;
+	SpriteSheet renderedSpriteSheet[2];
+	u8 renderedAnimation[2];
+} SimContext;
+
 /*! \brief Finds the next unused entity slot.
 
 	This function is used to find entity slots where we can safely write data without overwriting current data.
+	It reads the head of the free list, so it runs in constant time. The slot stays free until its mask is set.
+	After destroyAllEntities slots are handed out in ascending order; after that, the most recently destroyed slot comes first.
 	\param *world The game state as a World structure.
-	\return Next empty entity slot value.
+	\return Next empty entity slot value, or ENTITY_NONE if every slot is used.
 */
-u8 nextEmptyEntitySlot(World *world);
+EntitySlot nextEmptyEntitySlot(World *world);
+
+/*! \brief Sets the component mask of an entity slot and updates the component sets of the world.
+
+	Every change of a component mask goes through this function.
+	Setting the mask of an unused slot takes it out of the free list. Setting it to COMPONENT_NONE
+	puts the slot back at the head of the free list and increments its generation. Both run in constant time.
+	\param *world The game state as a World structure.
+	\param entity The entity slot.
+	\param mask The new component mask. COMPONENT_NONE flags the slot as unused.
+	\return void
+*/
+void setComponents(World *world, EntitySlot entity, u16 mask);
+
+/*! \brief Updates whether an entity is busy (see ENTITY_BUSY). Call after changing its move or 'staggered'.
+
+	Also refreshes the timer (see refreshEntityTimer) and the hash (see refreshEntityHash) of the entity,
+	so writes it follows need no other call.
+	\param *world The game state as a World structure.
+	\param entity The entity slot.
+	\return void
+*/
+void refreshBusyEntity(World *world, EntitySlot entity);
+
+#ifdef ECS_TIMER_WHEEL
+/*! \brief Reads 'frames' of an entity. Without ECS_TIMER_WHEEL, world->timing[entity].frames.
+	\param *world The game state as a World structure.
+	\param entity The entity slot.
+	\return The number of frames its move has played for.
+*/
+u16 entityFrames(const World *world, EntitySlot entity);
+
+/*! \brief Writes 'frames' of an entity. Without ECS_TIMER_WHEEL, world->timing[entity].frames = frames.
+
+	Like a write to the component, follow it with refreshBusyEntity or refreshEntityHash.
+	\param *world The game state as a World structure.
+	\param entity The entity slot.
+	\param frames The number of frames its move has played for.
+	\return void
+*/
+void setEntityFrames(World *world, EntitySlot entity, u16 frames);
+
+/*! \brief Reads 'staggered' of an entity. Without ECS_TIMER_WHEEL, world->health[entity].staggered.
+	\param *world The game state as a World structure.
+	\param entity The entity slot.
+	\return The number of frames it remains staggered.
+*/
+u8 entityStaggered(const World *world, EntitySlot entity);
+
+/*! \brief Writes 'staggered' of an entity. Without ECS_TIMER_WHEEL, world->health[entity].staggered = staggered.
+
+	Like a write to the component, follow it with refreshBusyEntity.
+	\param *world The game state as a World structure.
+	\param entity The entity slot.
+	\param staggered The number of frames it remains staggered.
+	\return void
+*/
+void setEntityStaggered(World *world, EntitySlot entity, u8 staggered);
+
+/*! \brief Starts or stops the counts of an entity after its move changed, and schedules its next timer.
+
+	A running entity whose move became Idling or Staggered gets its 'frames' written back to its Timing component,
+	and the other way around. refreshBusyEntity calls it. Does nothing without ECS_TIMER_WHEEL.
+	\param *world The game state as a World structure.
+	\param entity The entity slot.
+	\return void
+*/
+void refreshEntityTimer(World *world, EntitySlot entity);
+
+/*! \brief Removes every timer and sets the clock to TIMER_EPOCH. destroyAllEntities calls it.
+	\param *world The game state as a World structure.
+	\return void
+*/
+void clearEntityTimers(World *world);
+#endif
+
+#ifdef ECS_WORLD_HASH
+/*! \brief Multiplier of 'frames' of an entity slot in its hash. Odd, so that every change of 'frames' changes the hash.
+	\param entity The entity slot.
+	\return The multiplier.
+*/
+WorldHash frameKey(EntitySlot entity);
+
+/*! \brief Multiplier of 'staggered' of an entity slot in its hash. Odd, so that every change of 'staggered' changes the hash.
+	\param entity The entity slot.
+	\return The multiplier.
+*/
+WorldHash staggerKey(EntitySlot entity);
+
+/*! \brief Hashes the simulated state of an entity slot: its components (but the sprite sheet), mask and generation.
+	\param *world The game state as a World structure.
+	\param entity The entity slot.
+	\return The hash. Differs from slot to slot for the same components.
+*/
+WorldHash entitySlotHash(const World *world, EntitySlot entity);
+
+/*! \brief Updates the hash of the world after components of an entity changed.
+
+	world->hash is the sum of the hashes of every slot, so an update replaces one term: one hash of a few fields,
+	whatever ENTITY_COUNT is. Call after every write to the components of an entity that refreshBusyEntity
+	or setComponents does not follow (e.g. 'frames', 'points', 'facing'). Does nothing without ECS_WORLD_HASH.
+	With ECS_TIMER_WHEEL, the counts kept by timers are not in entityHash[] but in sums of EntityTimers (see worldHash).
+	\param *world The game state as a World structure.
+	\param entity The entity slot.
+	\return void
+*/
+void refreshEntityHash(World *world, EntitySlot entity);
+
+/*! \brief Updates the hash of the world after 'frames' of an entity went up by one, and nothing else changed.
+
+	The same as refreshEntityHash, without reading the other components: 'frames' counts in the hash
+	as 'frames' times a constant of the slot, outside of the mix of the other components (see entitySlotHash).
+	\param *world The game state as a World structure.
+	\param entity The entity slot. Less than ENTITY_COUNT.
+	\return void
+*/
+void refreshEntityFrame(World *world, EntitySlot entity);
+
+/*! \brief Computes world->hash and every entityHash[] again from the components.
+
+	Only needed after writing a World without the functions of this file; rebuildEntitySets and destroyAllEntities call it.
+	\param *world The game state as a World structure.
+	\return void
+*/
+void rehashWorld(World *world);
+
+/*! \brief Reads the hash of the world: world->hash, plus with ECS_TIMER_WHEEL the counts kept by timers. Constant time.
+
+	Between frames, the same with and without ECS_TIMER_WHEEL.
+	\param *world The game state as a World structure.
+	\return The hash.
+*/
+WorldHash worldHash(const World *world);
+
+/*! \brief Hashes the whole world from its components, without the hashes it keeps. The check of worldHash.
+	\param *world The game state as a World structure.
+	\return The value worldHash returns if every write was followed by refreshEntityHash.
+*/
+WorldHash fullWorldHash(const World *world);
+
+/*! \brief Hashes the state of a simulation, to compare it with another frame by frame. Constant time.
+
+	Combines worldHash with the SimContext fields that last from one frame to the next (not eventSFX).
+	\param *world The game state as a World structure.
+	\param *context The simulation state belonging to the world.
+	\return The hash.
+*/
+WorldHash simulationHash(const World *world, const SimContext *context);
+#endif
+
+/*! \brief Recomputes every entity set, the free list and the hash (see rehashWorld) of the world from its masks and components.
+
+	Only needed after writing a World without the functions above, e.g. when copying one in from another layout.
+	With ECS_TIMER_WHEEL, the timers are kept: the counts of running and counting entities are read from them.
+	\param *world The game state as a World structure.
+	\return void
+*/
+void rebuildEntitySets(World *world);
+
+/*! \brief Finds the next entity slot, in ascending order, that has every component of a mask.
+
+	Skips other slots without reading them, using the entity sets of the world. Visit all matching entities with:
+	for (entity = nextEntityWith(world, mask, 0); entity < ENTITY_COUNT; entity = nextEntityWith(world, mask, entity + 1))
+	Entities added to the set while visiting are visited too if they come after the current one.
+	\param *world The game state as a World structure.
+	\param mask The components the entity must have, optionally with ENTITY_BUSY. Must not be COMPONENT_NONE.
+	\param entity First entity slot to consider.
+	\return The entity slot found, or ENTITY_COUNT if there is none.
+*/
+EntitySlot nextEntityWith(World *world, u16 mask, EntitySlot entity);
+
+/*! \brief Makes a handle to the entity in a slot, valid until that entity is destroyed.
+	\param *world The game state as a World structure.
+	\param entity The entity slot.
+	\return The handle.
+*/
+EntityHandle entityHandle(World *world, EntitySlot entity);
+
+/*! \brief Finds the entity slot of a handle.
+
+	Costs one comparison of the generation and one of the mask, so stale references are cheap to detect.
+	\param *world The game state as a World structure.
+	\param handle A handle made by entityHandle.
+	\return The entity slot, or ENTITY_NONE if the entity was destroyed since the handle was made.
+*/
+EntitySlot entityOfHandle(World *world, EntityHandle handle);
+
+/*! \brief Has an entity face an opponent, and remembers the generation of the opponent's slot.
+
+	Like a write to the component, follow it with refreshEntityHash.
+	\param *world The game state as a World structure.
+	\param entity The entity slot.
+	\param opponent The entity slot of the opponent.
+	\return void
+*/
+void setFacing(World *world, EntitySlot entity, EntitySlot opponent);
+
+/*! \brief Finds the opponent an entity faces. Read 'facing' through it wherever a system acts on the opponent.
+	\param *world The game state as a World structure.
+	\param entity The entity slot.
+	\return The entity slot of the opponent, or ENTITY_NONE if the opponent was destroyed since the entity faced it.
+*/
+EntitySlot facedEntity(World *world, EntitySlot entity);
 
 /*! \brief Flags an entity slot as unused.
+
+	Handles to the entity stop resolving (see entityOfHandle). Destroying an unused slot does nothing.
 	\param *world The game state as a World structure.
 	\param entity The entity slot to flag as unused.
 	\return void.
 */
-void destroyEntity(World *world, u8 entity);
+void destroyEntity(World *world, EntitySlot entity);
 
 /*! \brief Flags all entity slots as unused.
 
 	Run this function once before using a World structure for anything.
+	It also builds the free list, so that the following creations use the slots in ascending order,
+	and with ECS_TIMER_WHEEL clears the timers (see clearEntityTimers).
 	\param *world The game state as a World structure.
 	\return void
 */
@@ -77,20 +474,26 @@ void destroyAllEntities(World *world);
 /*! \brief Creates a player character.
 
 	Creating a player character involves assigning component data suitable for a player character.
+	The first player character (memberID 0) becomes the current player character of the context.
 	\param *world The game state as a World structure.
+	\param *context The simulation state belonging to the world.
 	\param spriteCharacter The animation spritesheet to use with this entity.
 	\param memberID Set to 0 if 1st character, 1 if 2nd character, ...
-	\return entity Number of entity slot written to.
+	\return entity Number of entity slot written to, or ENTITY_NONE if every slot is used.
 */
-u8 createPlayerChar(World *world, SpriteSheet spriteCharacter, u8 memberID);
+EntitySlot createPlayerChar(World *world, SimContext *context, SpriteSheet spriteCharacter, u8 memberID);
 
 /*! \brief Creates an enemy character.
 
 	Creating an enemy character involves assigning component data suitable for an enemy character.
 	\param *world The game state as a World structure.
 	\param spriteCharacter The animation spritesheet to use with this entity.
-	\return entity Number of entity slot written to.
+	\return entity Number of entity slot written to, or ENTITY_NONE if every slot is used.
 */
-u8 createEnemyChar(World *world, SpriteSheet spriteCharacter);
+EntitySlot createEnemyChar(World *world, SpriteSheet spriteCharacter);
+
+#ifndef ECS_UNPACKED_COMPONENTS
+#pragma pack(pop)
+#endif
 
 #endif /* ECS_ENTITIES_H_ */
@@ -10,7 +10,9 @@ Model header file containing the ECS architecture.
 #ifndef  _MODEL_H_
 #define _MODEL_H_
 
-#pragma pack(1)
+#ifndef ECS_UNPACKED_COMPONENTS
+#pragma pack(push, 1)
+#endif
 
 #include "Systems.h"
 
@@ -20,19 +22,45 @@ Model header file containing the ECS architecture.
 #define DIFF_NIGHTMARE 23  /*!< Difficulty values define how often enemies will act. Will react every 4 frames on average. */
 #define DIFF_PERFECT 97  /*!< Difficulty values define how often enemies will act. Will react every frame. */
 
-/*! \brief Accumulating value that if high enough, enemy AI will act.
+#define MAX_ENEMIES 12  /*!< Game will spawn this number of enemies.*/
+#define MAX_ALLIES 4   /*!< Maximum allowed allies.*/
 
-	Every frame, the difficulty value will be added to this number.
-	If the number is less than 100, AI will not act on that frame.
-	That means on easy, AI will on average act once every 100/3 = 33.3th frame.
-*/
-u16 difficultyAIaccumulator;
+#define DEFAULT_PLAYER_HEALTH 25	/*!< HP of each player character. Enemy default is 10. */
+#define BOSS_HEALTH 25	/*!< HP of the last enemy (entity slot 0). */
 
 /*! \brief Runs all systems once with given controller input.
 	\param *world The game state as a World structure.
+	\param *context The simulation state belonging to the world.
 	\param *buttonInput The input state as a ButtonInput structure.
 	\return EventQueue structure with which animations and sound effects to play.
 */
-static EventQueue updateWorld(World *w, ButtonInput *buttonInput);
+EventQueue updateWorld(World *w, SimContext *context, ButtonInput *buttonInput);
+
+/*! \brief Fills the world with the starting game state.
+
+	Creates MAX_ENEMIES enemies followed by the given number of player characters.
+	Slot 0 is the last enemy (boss) and slot MAX_ENEMIES is the first player character.
+	Used by the engine when a game starts, and by the host build to set up matches.
+	\param *world The game state as a World structure.
+	\param *context The simulation state belonging to the world. Reset as well.
+	\param numAllies Number of player characters. Range: 1-MAX_ALLIES
+	\param seed Seed of the AI's random numbers. A match with the same seed and input plays out the same.
+	\return void
+*/
+void initializeMatch(World *world, SimContext *context, u8 numAllies, u32 seed);
+
+/*! \brief Finds the sprite sheets each sprite of the engine may draw, from the characters in the world.
+
+	The engine draws the current player character (sprite 0), which can switch to any team member, and the enemy
+	it faces (sprite 1), which can be any other character. main.c keeps the tiles of all of them in VRAM.
+	\param *world The game state as a World structure.
+	\param drawn[] Written with, for sprite 0 and sprite 1, bit 'sheet' set for every SpriteSheet it may draw.
+	\return void
+*/
+void spriteSheetsInUse(World *world, u16 drawn[2]);
+
+#ifndef ECS_UNPACKED_COMPONENTS
+#pragma pack(pop)
+#endif
 
 #endif // ! _MODEL_H_
@@ -0,0 +1,79 @@
+/*!
+\file Profile.h
+\brief System profiling header file
+\date 10/2026
+
+Optional timing of every system run by updateWorld. Only compiled in with PROFILE_SYSTEMS defined
+(CMake: framebench_profile, console: COMPILE.bat systems). Otherwise PROFILE_SYSTEM runs the system and nothing else.
+
+Times go into fixed-size histograms in the global systemProfile, without allocation.
+The host benchmark prints them. On the console, read systemProfile from RAM with the debugger of the emulator.
+One World at a time: the histograms are shared, so profile builds should not simulate on several threads.
+*/
+
+#ifndef ECS_PROFILE_H_
+#define ECS_PROFILE_H_
+
+#include "types.h"
+
+/*! \brief Enumeration with every system timed by updateWorld. */
+typedef enum {
+	ProfileInput,	/**< inputSystem */
+	ProfileAI,	/**< AISystem */
+	ProfileCombat,	/**< combatSystem */
+	ProfileRender,	/**< renderSystem */
+	PROFILED_SYSTEMS	/**< Number of timed systems */
+} ProfiledSystem;
+
+/*! \brief Number of histogram buckets. Bucket b counts the runs that took from 2^b to 2^(b+1)-1 ticks (bucket 0 also counts 0). */
+#define PROFILE_BUCKETS 24
+
+/*! \brief 68000 cycles in one frame (262 lines of 488 cycles, NTSC). The console clock wraps around every frame. */
+#define PROFILE_FRAME_CYCLES (262UL * 488)
+
+/*! \brief Structure with the timing histograms of every system.
+
+	Ticks are 68000 cycles on the console (approximated from the VDP HV counter),
+	and time stamp counter ticks on x86 hosts (nanoseconds on other hosts).
+
+\param histogram[][] For each system, the number of runs per bucket. See PROFILE_BUCKETS.
+\param runs[] For each system, the number of runs.
+\param totalTicks[] For each system, the sum of the ticks of all runs.
+*/
+typedef struct {
+	u32 histogram[PROFILED_SYSTEMS][PROFILE_BUCKETS];
+	u32 runs[PROFILED_SYSTEMS];
+	unsigned long long totalTicks[PROFILED_SYSTEMS];
+} SystemProfile;
+
+#ifdef PROFILE_SYSTEMS
+
+extern SystemProfile systemProfile;	/*!< Histograms of every system run since the last resetSystemProfile. */
+
+/*! \brief Reads the clock the profile uses.
+	\return Current time, in ticks.
+*/
+u32 profileClock();
+
+/*! \brief Adds one run of a system to its histogram.
+	\param system The system that ran.
+	\param start profileClock() when the system started.
+	\return void
+*/
+void recordSystemTime(ProfiledSystem system, u32 start);
+
+/*! \brief Empties every histogram.
+	\return void
+*/
+void resetSystemProfile();
+
+/*! \brief Runs a statement that calls a system, and adds its time to the histogram of the system. */
+#define PROFILE_SYSTEM(system, statement) do { u32 profileStart = profileClock(); statement; recordSystemTime(system, profileStart); } while (0)
+
+#else
+
+#define PROFILE_SYSTEM(system, statement) statement
+
+#endif // PROFILE_SYSTEMS
+
+#endif // !ECS_PROFILE_H_
@@ -0,0 +1,65 @@
+/*!
+\file Random.h
+\brief Random number header file
+\date 10/2026
+
+Deterministic random numbers for the model. Each simulation owns its stream,
+so a match plays out the same on the console and on the host when given the same seed.
+*/
+
+#ifndef ECS_RANDOM_H_
+#define ECS_RANDOM_H_
+
+#include "types.h"
+
+/*! \brief State of a 32-bit xorshift generator.
+
+	Needs only shifts and exclusive or, which the 68000 does without multiplying or dividing.
+	The state is never 0.
+*/
+typedef struct {
+	u32 state;	/**< Current state of the generator */
+} RandomStream;
+
+/*! \brief Starts a stream from a seed. Any seed is valid, including 0.
+	\param *stream The stream.
+	\param seed Seed value. Equal seeds give equal streams.
+	\return void
+*/
+void seedRandom(RandomStream *stream, u32 seed);
+
+/*! \brief Derives an independent stream from a parent stream, e.g. one per match of a parallel run.
+
+	The parent is left unchanged, so children can be derived in any order and on any thread.
+	\param *parent The stream to derive from.
+	\param *child Written with the derived stream.
+	\param index Which child. Different indices give unrelated streams.
+	\return void
+*/
+void splitRandom(const RandomStream *parent, RandomStream *child, u32 index);
+
+/*! \brief Returns the next 16-bit random value.
+	\param *stream The stream.
+	\return A value from 0 to 65535.
+*/
+u16 nextRandom(RandomStream *stream);
+
+/*! \brief Returns a random value from 0 to range - 1, without dividing.
+
+	The 16-bit random value is scaled by multiplying with range and keeping the upper 16 bits,
+	which is one MULU instruction on the 68000 instead of a DIVU.
+	\param *stream The stream.
+	\param range Number of possible values. Must be at least 1.
+	\return A value from 0 to range - 1.
+*/
+u16 randomRange(RandomStream *stream, u16 range);
+
+/*! \brief Writes the next 'count' random values of the stream, e.g. for a whole batch of worlds or frames.
+	\param *stream The stream.
+	\param *values Written with the values, in the order nextRandom would return them.
+	\param count Number of values to write.
+	\return void
+*/
+void fillRandom(RandomStream *stream, u16 *values, u16 count);
+
+#endif // !ECS_RANDOM_H_
@@ -0,0 +1,68 @@
+/*!
+\file SpriteDelta.h
+\brief Sprite frame delta header file
+\date 10/2026
+
+The tiles that change from each frame of an animation to the next, so that the sprite engine's VRAM for a sprite
+(see SpriteResidency.h) is brought to the next frame by sending those tiles only, instead of the whole frame.
+HostSim's assetbuild writes a SpriteDelta for a sprite sheet from a SPRITE_DELTA line (Resource Compilation/deltas.res).
+Only frames that follow each other in an animation, the last one followed by the first, have a delta: any other
+change of frame sends the whole frame.
+*/
+
+#ifndef SPRITE_DELTA_H_
+#define SPRITE_DELTA_H_
+
+#include "types.h"
+
+#define DELTA_WHOLE 0xFFFF	/*!< Returned by frameDelta when the whole frame must be sent. */
+
+/*! \brief Structure with consecutive tiles of a frame to send.
+	\param first First tile, in the order of the frame's tileset
+	\param count Number of tiles
+*/
+typedef struct {
+	u16 first;
+	u16 count;
+} TileRun;
+
+/*! \brief Structure with the tiles that change from the previous frame of the animation to a frame.
+	\param runs Number of runs
+	\param run The runs, by first tile
+*/
+typedef struct {
+	u16 runs;
+	const TileRun *run;
+} FrameDelta;
+
+/*! \brief Structure with the deltas of the frames of an animation.
+	\param numFrame Number of frames, as in the Animation
+	\param frames Delta of every frame
+*/
+typedef struct {
+	u16 numFrame;
+	const FrameDelta *frames;
+} AnimationDelta;
+
+/*! \brief Structure with the deltas of every animation of a sprite sheet.
+	\param numAnimation Number of animations, as in the SpriteDefinition
+	\param animations Deltas of every animation
+*/
+typedef struct {
+	u16 numAnimation;
+	const AnimationDelta *animations;
+} SpriteDelta;
+
+
+/*! \brief Finds the tiles to send to draw a frame over the frame in VRAM.
+	\param *delta The deltas of the sprite sheet.
+	\param shownAnimation Animation of the frame in VRAM.
+	\param shownFrame Frame in VRAM, or DELTA_WHOLE if VRAM holds no frame of this sheet.
+	\param animation Animation of the frame to draw.
+	\param frame Frame to draw.
+	\param **run Written with the runs to send, unless the whole frame must be.
+	\return Number of runs (0 if the frame is in VRAM, or has the same tiles), or DELTA_WHOLE to send the whole frame.
+*/
+u16 frameDelta(const SpriteDelta *delta, u16 shownAnimation, u16 shownFrame, u16 animation, u16 frame, const TileRun **run);
+
+#endif // !SPRITE_DELTA_H_
@@ -0,0 +1,69 @@
+/*!
+\file SpriteResidency.h
+\brief Sprite residency header file
+\date 10/2026
+
+Plans where the tiles of every sprite sheet in use stay in VRAM, so that a sprite changes sheet by pointing at other
+tiles instead of resetting the sprite engine. Only plans: main.c gives the sprites their VRAM tile index.
+
+The sprite engine uploads the tiles of the frame it draws (up to maxNumTile of the sheet), not the whole sheet, which
+would not fit in VRAM. A resident set is the room for that frame: one per sprite and tileset it may draw. Sheets that
+differ only in colors share their tileset, and so their resident set. Sets do not overlap, so a sheet drawn again
+still holds its last frame, and the sprite drawing another sheet never overwrites it.
+*/
+
+#ifndef SPRITE_RESIDENCY_H_
+#define SPRITE_RESIDENCY_H_
+
+#include "StageStream.h"
+
+#define RESIDENT_SPRITES 2	/*!< Sprites of the engine: the player character and the enemy it faces. */
+#define RESIDENT_SETS 8	/*!< Most resident sets. */
+#define RESIDENT_NONE 0xFF	/*!< No resident set. */
+
+/*! \brief Structure with a resident set: VRAM tiles kept for one sprite to draw one tileset.
+	\param sprite Sprite drawing it
+	\param tileset Tileset: the first sheet that has it
+	\param tiles Its VRAM tiles
+*/
+typedef struct {
+	u8 sprite;
+	u8 tileset;
+	TileRange tiles;
+} ResidentSet;
+
+/*! \brief Structure with the resident sets of a stage.
+	\param set[] The resident sets, by sprite, then tileset
+	\param sets Number of resident sets
+	\param used VRAM tiles of every set
+	\param area The VRAM tiles the sets may use
+*/
+typedef struct {
+	ResidentSet set[RESIDENT_SETS];
+	u8 sets;
+	u16 used;
+	TileRange area;
+} SpriteResidency;
+
+
+/*! \brief Plans the resident sets of a stage, from the start of an area.
+	\param *residency The residency to plan.
+	\param area The VRAM tiles sprites may use.
+	\param sheetTileset[] For every sheet, its tileset: the first sheet with the same tiles (itself if none).
+	\param sheetTiles[] For every sheet, the tiles of its largest frame.
+	\param sheets Number of sheets. At most 16.
+	\param drawn[] For every sprite, bit 'sheet' set for every sheet it may draw.
+	\return 1 (TRUE) if planned, 0 (FALSE) if the sets do not fit in the area or are too many.
+*/
+u8 planSpriteResidency(SpriteResidency *residency, TileRange area, const u8 sheetTileset[], const u16 sheetTiles[], u8 sheets,
+	const u16 drawn[RESIDENT_SPRITES]);
+
+/*! \brief Finds the resident set a sprite draws a sheet from.
+	\param *residency The residency.
+	\param sprite The sprite.
+	\param tileset The tileset of the sheet.
+	\return Index of the set in residency->set, or RESIDENT_NONE if the sheet was not planned for that sprite.
+*/
+u8 findResidentSet(const SpriteResidency *residency, u8 sprite, u8 tileset);
+
+#endif // !SPRITE_RESIDENCY_H_
@@ -0,0 +1,115 @@
+/*!
+\file StageStream.h
+\brief Stage streaming header file
+\date 10/2026
+
+Plans the upload of the next stage's backgrounds into VRAM a little every frame, instead of all at once with
+interrupts disabled. Only plans: main.c uploads the chunks (tiles by DMA, tilemap rows) right after VBlank.
+
+The stage tiles alternate between the two ends of the stage tile area: when the current stage starts at the low end,
+the next one ends at the high end, and the other way around. The tiles of the next stage that do not share VRAM with
+the current one are uploaded while the current stage is still on screen. The others, and the tilemaps, which are drawn
+over the current ones, wait for the screen to be black (faded out).
+*/
+
+#ifndef STAGE_STREAM_H_
+#define STAGE_STREAM_H_
+
+#include "types.h"
+
+#define STREAM_PLANES 2	/*!< Background images of a stage: plane A and plane B. */
+#define STREAM_PARTS (STREAM_PLANES * 4)	/*!< Most parts of a stream: tiles before, on and after the current stage, and tilemap, per plane. */
+#define STREAM_TILE_BYTES 32	/*!< Bytes of a tile in VRAM. */
+#define STREAM_BYTES_PER_FRAME 4096	/*!< Bytes uploaded after each VBlank in StageStreamTest. main.c gives the stage what the DMA queue leaves (see DmaQueue.h). */
+
+/*! \brief Enumeration with the kinds of parts of a stream. */
+typedef enum {
+	StreamTiles,	/**< Tiles of an image, to upload to VRAM tile indexes */
+	StreamRows	/**< Rows of the tilemap of an image, to draw on its plane */
+} StreamPartType;
+
+/*! \brief Structure with a range of VRAM tile indexes.
+	\param first First tile index
+	\param count Number of tiles
+*/
+typedef struct {
+	u16 first;
+	u16 count;
+} TileRange;
+
+/*! \brief Structure with what a stage's image needs in VRAM.
+	\param tiles Number of tiles of its tileset
+	\param rows Number of rows of its tilemap
+	\param rowBytes Bytes written to draw a row of its tilemap
+*/
+typedef struct {
+	u16 tiles;
+	u16 rows;
+	u16 rowBytes;
+} StreamImage;
+
+/*! \brief Structure with a part of a stream, or a chunk of it to upload now.
+	\param type Tiles or tilemap rows (see StreamPartType)
+	\param plane Which image: 0 for plane A, 1 for plane B
+	\param hidden 1 (TRUE) if it must wait for the screen to be black
+	\param first First tile of the tileset, or first row of the tilemap
+	\param count Number of tiles or rows
+	\param destination VRAM tile index of the first tile. Same as first for rows.
+*/
+typedef struct {
+	u8 type : 4;
+	u8 plane : 3;
+	u8 hidden : 1;
+	u16 first;
+	u16 count;
+	u16 destination;
+} StreamChunk;
+
+/*! \brief Structure with the upload of a stage, in the order of its parts.
+	\param part[] The parts: tiles that can be uploaded now first, then the others, then the tilemaps
+	\param parts Number of parts
+	\param current Part being uploaded
+	\param done Tiles or rows of the current part already uploaded
+	\param rowBytes[] Bytes to draw a row of the tilemap of each image
+	\param tiles The VRAM tiles of the stage, once uploaded
+	\param tileBase[] VRAM tile index of the first tile of each image: add it to the tilemap entries
+*/
+typedef struct {
+	StreamChunk part[STREAM_PARTS];
+	u8 parts;
+	u8 current;
+	u16 done;
+	u16 rowBytes[STREAM_PLANES];
+	TileRange tiles;
+	u16 tileBase[STREAM_PLANES];
+} StageStream;
+
+
+/*! \brief Plans the upload of a stage's images.
+	\param *stream The stream to plan.
+	\param area The VRAM tiles stages may use.
+	\param shown The VRAM tiles of the stage on screen.
+	\param images[] The images of plane A and plane B of the next stage.
+	\return 1 (TRUE) if planned, 0 (FALSE) if the stage does not fit in the area.
+*/
+u8 planStageStream(StageStream *stream, TileRange area, TileRange shown, const StreamImage images[STREAM_PLANES]);
+
+/*! \brief Takes the next chunk to upload within a byte budget.
+
+	Call it until it returns 0, and upload each chunk in order.
+	Returns 0 when the stream is done, when the next chunk does not fit in the budget, or when it waits for a black screen.
+	\param *stream The stream.
+	\param hidden 1 (TRUE) if the screen is black.
+	\param budget Bytes left to upload this frame.
+	\param *chunk Written with the chunk to upload.
+	\return Bytes of the chunk, 0 if none.
+*/
+u16 nextStreamChunk(StageStream *stream, u8 hidden, u16 budget, StreamChunk *chunk);
+
+/*! \brief Returns 1 (TRUE) once every chunk of the stream was taken.
+	\param *stream The stream.
+	\return 1 (TRUE) if done.
+*/
+u8 isStreamDone(const StageStream *stream);
+
+#endif // !STAGE_STREAM_H_
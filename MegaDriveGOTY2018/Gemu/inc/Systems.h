@@ -11,7 +11,9 @@ Systems header file of the ECS architecture.
 #ifndef ECS_SYSTEMS_H_
 #define ECS_SYSTEMS_H_
 
-#pragma pack(1)
+#ifndef ECS_UNPACKED_COMPONENTS
+#pragma pack(push, 1)
+#endif
 
 #include "Entities.h"
 
@@ -34,19 +36,6 @@ Systems header file of the ECS architecture.
 #define SFX_PARRYGUARD 65	 /*!< ID for parry and guard sound effect*/
 #define SFX_SWING 66		/*!< ID for swing sound effect*/
 
-	/*! \brief The ID of the sound effect to be played this frame
-		
-		If value is 0, no sound effect is played this frame.
-		Value is initially 0. Various events may set it to a sound effect ID.
-		The ID is retrieved by the renderSystem and sent as a return value as part of EventQueue structure.
-		Then this value will be set to 0 for the next game update.
-	*/
-u8 eventSFX;
-
-/*! \brief Every frame the SGDK kit provides a random value for the AI to use.*/
-u16 randSGDK;
-
-
 /*! \brief Enumeration with various buttons*/
 typedef enum {
 	Neutral,	/**< unused  */
@@ -72,15 +61,36 @@ typedef struct {
 } ButtonInput;
 
 
-/*! \brief Structure with audio to play and graphic to draw
-	\param spriteSheet[] Which spritesheet file to read (see SpriteSheet)
-	\param animation[] Which animation to play from spritesheet
-	\param sfx Sound effect ID to play (is 0 when no sound is to be played)
+#define RENDER_COMMANDS 5	/*!< Most render commands in a frame: two sprite sheets, two animations and a sound effect. */
+
+/*! \brief Enumeration with the kinds of render commands. */
+typedef enum {
+	RenderSpriteSheet,	/**< Draw a sprite from another sprite sheet (value: SpriteSheet) */
+	RenderAnimation,	/**< Play another animation on a sprite (value: animation, same as AttackType) */
+	RenderSFX	/**< Play a sound effect (value: sound effect ID) */
+} RenderCommandType;
+
+/*! \brief Structure with one change to what is drawn or played.
+	\param type What changes (see RenderCommandType)
+	\param sprite Which sprite: 0 for the current player character, 1 for the enemy it faces. 0 for sound effects.
+	\param value The new sprite sheet, animation or sound effect ID
+*/
+typedef struct {
+	u8 type : 4;
+	u8 sprite : 4;
+	u8 value;
+} RenderCommand;
+
+/*! \brief Structure with audio to play and graphic changes to draw in a frame.
+
+	Only holds what changed since the previous frame (see renderSystem): nothing, most frames.
+	Sprite sheet commands come first, then animation commands, then the sound effect.
+	\param command[] The commands, in the order to apply them
+	\param commands Number of commands
 */
 typedef struct {
-	SpriteSheet spriteSheet[2];
-	u8 animation[2];
-	u8 sfx : 7;
+	RenderCommand command[RENDER_COMMANDS];
+	u8 commands;
 } EventQueue;
 
 
@@ -106,44 +116,54 @@ typedef enum {
 	If the game state allows it, the player character may act by the specified input.
 
 	\param *world The game state as a World structure.
+	\param *context The simulation state belonging to the world.
 	\param *buttonInput The input state as a ButtonInput structure.
 	\return void
 */
-void inputSystem(World *world, ButtonInput *buttonInput);
+void inputSystem(World *world, SimContext *context, ButtonInput *buttonInput);
 
 /*! \brief System that may make enemy act depending on game state.
 
 	This system will make the enemy character act as opposition to the player.
 	The difficulty changes not what decision is made, only how active the enemy is.
 	At perfect difficulty level, the AI will react at every single frame.
-	Only this system uses randSGDK, a randomly generated value.
+	Only this system uses randomAI of the context, drawing one value each time the AI acts.
 	It should be emphasized that the AI is not built through test-driven development. Therefore it has no unit-tests.
 
 	\param *world The game state as a World structure.
+	\param *context The simulation state belonging to the world.
 	\param difficulty The difficulty as given by the engine.
 	\return Potentially modified difficultyAIaccumulator value.
 */
-u16 AISystem(World *world, u16 difficulty);
+u16 AISystem(World *world, SimContext *context, u16 difficulty);
 
 /*! \brief System that enact consequences to character actions.
 
 	This system is built by unit-testing. 	Refer to use cases in appendix to view all logic encompassed by this function.
 	Encompasses logic of guarding, parrying, dying, hitting.
+	Only busy entities (see ENTITY_BUSY) are visited, in ascending slot order.
 
 	\param *world The game state as a World structure.
+	\param *context The simulation state belonging to the world.
 	\return void
 */
-void combatSystem(World *world);
+void combatSystem(World *world, SimContext *context);
 
 
 /*! \brief System that compiles animation and sfx data to return to engine.
 
 	This system reads the game state and collects data such as which animations and sound effects to play,
-	and returns them in the EventQueue structure.
+	and returns them in the EventQueue structure: only the sprite sheets and animations that differ
+	from the ones it returned the frame before (kept in the context), and the sound effect if any.
 
 	\param *world The game state as a World structure.
+	\param *context The simulation state belonging to the world.
 	\return EventQueue structure with which animations and sound effects to play.
 */
-EventQueue renderSystem(World *world);
+EventQueue renderSystem(World *world, SimContext *context);
+
+#ifndef ECS_UNPACKED_COMPONENTS
+#pragma pack(pop)
+#endif
 
 #endif /* ECS_SYSTEMS_H_ */
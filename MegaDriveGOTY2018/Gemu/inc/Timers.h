@@ -0,0 +1,69 @@
+/*!
+\file Timers.h
+\brief Entity timer header file
+\date 10/2026
+
+Timers of the busy entities, with ECS_TIMER_WHEEL defined (see EntityTimers in Entities.h).
+The functions of Entities.h start and stop the counts and schedule the timers. combatSystem runs a frame with the ones below:
+startTimerFrame, then nextTimedEntity until it returns ENTITY_COUNT, or stopTimerFrame if the frame ends early.
+Each visit calls countTimedStagger before anything else, and countTimedFrame where it would count 'frames'.
+*/
+
+#ifndef ECS_TIMERS_H_
+#define ECS_TIMERS_H_
+
+#include "Systems.h"
+
+#ifdef ECS_TIMER_WHEEL
+
+/*! \brief Starts a frame: advances the clock, and queues the timers due.
+	\param *world The game state as a World structure.
+	\return void
+*/
+void startTimerFrame(World *world);
+
+/*! \brief Ends the visit of the previous entity, if any, and finds the next entity to visit in this frame.
+
+	Timers scheduled for this frame after the cursor while visiting (e.g. by another entity's hit) are visited too.
+	\param *world The game state as a World structure.
+	\return The entity slot, or ENTITY_COUNT once the frame is over.
+*/
+EntitySlot nextTimedEntity(World *world);
+
+/*! \brief Counts 'staggered' of the entity visited, which ends a stagger due this frame.
+	\param *world The game state as a World structure.
+	\param entity The entity slot visited.
+	\return void
+*/
+void countTimedStagger(World *world, EntitySlot entity);
+
+/*! \brief Counts 'frames' of the entity visited. The entity must be running.
+	\param *world The game state as a World structure.
+	\param entity The entity slot visited.
+	\return void
+*/
+void countTimedFrame(World *world, EntitySlot entity);
+
+/*! \brief Ends a frame at the entity visited. Entities after it do not count in this frame, as if combatSystem returned early.
+	\param *world The game state as a World structure.
+	\return void
+*/
+void stopTimerFrame(World *world);
+
+/*! \brief Counts the next frames in which no timer is due. Between frames only.
+	\param *world The game state as a World structure.
+	\param limit Count no further than this.
+	\return The number of frames, up to limit.
+*/
+u32 quietTimerFrames(const World *world, u32 limit);
+
+/*! \brief Runs frames in which no timer is due at once: only advances the clock. Between frames only.
+	\param *world The game state as a World structure.
+	\param frames Number of frames. No timer may be due in any of them.
+	\return void
+*/
+void skipTimerFrames(World *world, u32 frames);
+
+#endif
+
+#endif /* ECS_TIMERS_H_ */
@@ -17,6 +17,8 @@ Model header file of the ECS architecture.
 #include "..\res\sprites.h"
 #include "..\res\images.h"
 #include "..\res\audio.h"
+#include "SpriteDelta.h"
+#include "..\res\deltas.h"
 
 /*! \brief Enumeration with screens, each governing different input responses*/
 typedef enum {
@@ -25,6 +27,14 @@ typedef enum {
 	InGame	/**< Game screen  */
 } Screen;
 
+/*! \brief Enumeration with the steps of a change of stage, while the game waits */
+typedef enum {
+	TransitionNone,	/**< No change of stage: the game runs */
+	TransitionFadingOut,	/**< Fading out the stage on screen */
+	TransitionHidden,	/**< Screen black: uploading the rest of the next stage */
+	TransitionFadingIn	/**< Fading in the next stage */
+} StageTransition;
+
 
 /*! \brief Transition into start screen, showing the splash art.
 	\return void
@@ -53,6 +63,8 @@ void initializeModel();
 
 
 /*! \brief Prepares music, background and sprite engine.
+
+	The first stage streams in through the DMA queue on a black screen, as the next stages do (see prepareStage).
 \return void
 */
 void initializeMegaDrive();
@@ -82,7 +94,41 @@ void joyHandler(u16 joy, u16 changed, u16 state);
 void spawnSprites(u8 setPAL);
 
 
-/*! \brief Reads EventQueue and displays correct animations. Can also play SFX.
+/*! \brief Loads the palette of the sprite sheet of a character sprite, PAL2 for the player and PAL3 for the enemy.
+	\parameter sprite 0 for the player sprite, 1 for the enemy sprite.
+	\parameter setPAL Set to 1 (TRUE) to send it to the VDP too, in the next VBlank (see sendDmaQueue). Otherwise only the fade palette gets it.
+	\return void
+*/
+void setSpritePalette(u8 sprite, u8 setPAL);
+
+
+/*! \brief Keeps VRAM tiles for every sprite sheet the sprites may draw this match (see SpriteResidency.h).
+
+	Plans them at the start of the sprite tiles, at the end of the user tiles, from the characters of the world. If they
+	fit, spawnSprites gives each sprite the tiles of its sheet, and a change of sheet only points the sprite at other tiles.
+	Planned once per match: the world holds the characters of every stage from the start, so the plan covers them all.
+	If a set per sheet does not fit, each sprite gets a single set for the largest frame it draws, which a change of
+	sheet then uploads whole.
+\return void
+*/
+void planResidentSprites();
+
+
+/*! \brief Starts the sprite engine in the sprite tiles the resident sets leave (see planResidentSprites).
+
+	Sprites that are not resident (only if not even a set per sprite fits) get their frames uploaded there, apart from
+	the tiles of the resident sets.
+\return void
+*/
+void initSpriteEngine();
+
+
+/*! \brief Applies the render commands of the EventQueue: changes sprite sheets and animations, plays SFX.
+
+	The EventQueue only holds what changed since the previous frame, so most frames this does nothing.
+	A sprite sheet with the same tiles in other colors (see sheetTiles in main.c) only loads its palette.
+	A sprite sheet with other tiles kept in VRAM (see planResidentSprites) is set on the sprite, which points at them.
+	Any other sprite sheet resets the sprite engine, and then sets the animations of both sprites again.
 \return void
 */
 void updateAnim();
@@ -94,12 +140,101 @@ void updateAnim();
 void setBackground(const Image PlanA_img, const Image PlanB_img);
 
 
+/*! \brief Starts streaming the images of the next stage into VRAM (see StageStream.h).
+
+	Plans where its tiles go, away from the tiles of the stage on screen. uploadStageChunks then sends them a chunk per frame.
+	Only images with uncompressed tilesets and tilemaps stream: startStageTransition draws the others at once.
+	\param *planA Image of plane A of the next stage.
+	\param *planB Image of plane B of the next stage.
+	\return void
+*/
+void prepareStage(const Image *planA, const Image *planB);
+
+
+/*! \brief Uploads the next chunks of the stage being streamed, within what the DMA queue has left this frame.
+
+	The chunks that would show on screen wait for the fade out of a stage transition.
+	\return void
+*/
+void uploadStageChunks();
+
+
+/*! \brief Requests the upload of the frame every resident sprite draws, if not in its VRAM yet (see SpriteDelta.h).
+
+	Only the tiles that changed from the frame in VRAM when the sprite went on to the next frame of its animation,
+	and the whole frame otherwise. A whole frame larger than the DMA budget goes in parts (see nextDma): this asks
+	for the rest of it. Sprites that are not resident are uploaded by the sprite engine (see spendInterruptDma).
+	\return void
+*/
+void requestSpriteFrames();
+
+
+/*! \brief Uploads the frame requestSpriteFrames requested for a sprite, and keeps it as the frame in its VRAM.
+
+	If the DMA queue split the request, sends the next part of the frame, and the set holds no frame until the last.
+	\parameter i 0 for the player sprite, 1 for the enemy sprite.
+	\parameter bytes Bytes the DMA queue gave the request.
+	\return void
+*/
+void uploadSpriteFrame(u8 i, u16 bytes);
+
+
+/*! \brief Counts in the DMA budget what SGDK's vertical interrupt uploaded this VBlank, before sendDmaQueue.
+
+	The sprite table entries of both sprites, the frames the sprite engine uploaded for sprites that are not resident,
+	and a step of a palette fade.
+	\return void
+*/
+void spendInterruptDma();
+
+
+/*! \brief Sends the uploads of the frame through the DMA queue, within the bytes DMA moves during VBlank (see DmaQueue.h).
+
+	What the vertical interrupt sent comes off the budget first (see spendInterruptDma). Then sprite frames, then the
+	sprite palettes setSpritePalette queued, then the stage being streamed with what is left. An upload that does not
+	fit waits for the next frame, which requests it again. Called right after VBlank starts.
+	\return void
+*/
+void sendDmaQueue();
+
+
+/*! \brief Starts the change to the next stage: fades out while its last chunks are uploaded.
+
+	If the stage could not be streamed, changes it at once instead, with interrupts disabled.
+	\param *planA Image of plane A of the next stage.
+	\param *planB Image of plane B of the next stage.
+	\return void
+*/
+void startStageTransition(const Image *planA, const Image *planB);
+
+
+/*! \brief Advances the change of stage by a frame. Once the stage is uploaded, swaps the palettes and fades in.
+	\return void
+*/
+void advanceStageTransition();
+
+
 /*! \brief Reads game state to potentially trigger Game Over or a background change.
 
 	Every frame, this checks whether the player character has won or been defeated.
+	When the last enemy of a stage comes up, the next stage starts streaming into VRAM.
 	If the right number of enemies has been defeated, this will pause the game and change backgrounds.
 	\return void
 */
 void checkProgression();
 
+
+#ifdef PROFILE_UPDATE
+#define PROFILE_FRAMES 64	/*!< Number of frames showUpdateCycles averages over. */
+
+/*! \brief Shows how long updateWorld takes, in 68000 cycles, and the size of World. Only in profile builds (COMPILE.bat profile).
+
+	Called every frame with the time updateWorld took. Every PROFILE_FRAMES frames, draws the average
+	on the top left of the screen, so that the packed and the word-aligned layouts (COMPILE.bat aligned) can be compared.
+	\param subTicks Time updateWorld took this frame, in SGDK timer subticks.
+	\return void
+*/
+void showUpdateCycles(u32 subTicks);
+#endif
+
 #endif // !MAIN_H
@@ -85,8 +85,13 @@ typedef short s16;
 /**
  *  \typedef s32
  *      32 bits signed integer (equivalent to long).
+ *      On LP64 hosts (host build of the model) long is 64 bits, so int is used instead.
  */
+#if defined(__LP64__)
+typedef int s32;
+#else
 typedef long s32;
+#endif
 
 /**
  *  \typedef u8
@@ -101,8 +106,13 @@ typedef unsigned short u16;
 /**
  *  \typedef u32
  *      32 bits unsigned integer (equivalent to unsigned long).
+ *      On LP64 hosts (host build of the model) long is 64 bits, so unsigned int is used instead.
  */
+#if defined(__LP64__)
+typedef unsigned int u32;
+#else
 typedef unsigned long u32;
+#endif
 
 /**
  *  \typedef vs8
@@ -8,27 +8,57 @@ Engine file of the project. Contains entry point in main().
 */
 
 #include "inc\main.h"
-#include "src\Model.c"
+#include "inc\Model.h"
+#include "inc\StageStream.h"
+#include "inc\SpriteResidency.h"
+#include "inc\SpriteDelta.h"
+#include "inc\DmaQueue.h"
 
 
-#define MAX_ENEMIES 12  /*!< Game will spawn this number of enemies.*/
-#define MAX_ALLIES 4   /*!< Maximum allowed allies.*/
-
 #define GOTO_COURTYARD 7	/*!< Entity slot index of last enemy in forest area before moving on to courtyard area. */ 
 #define GOTO_GREAT_HALL 3	/*!< Entity slot index of last enemy in courtyard area before moving on to mansion interior area.*/
+#define STAGE_FADE_FRAMES 20	/*!< Frames of the fade out and fade in between stages. */
+#define SPRITE_TILES 384	/*!< VRAM tiles of the sprites (default of SPR_init), after the stage tiles at the end of the user tiles. */
+#define SPRITE_ENGINE_TILES 16	/*!< Least of SPRITE_TILES the resident sets leave to the sprite engine: SPR_init takes 0 for its default. */
 
 
-#define DEFAULT_PLAYER_HEALTH 25	/*!< HP of each player character. Enemy default is 10. */
-
 Sprite* sprites[2];		/*!< Pointer of sprites */
 SpriteSheet currentSpriteSheet[2];		/*!<  Spritesheet of player and enemy characters.  */
+u8 currentAnimation[2];		/*!<  Animation of player and enemy characters.  */
 u16 palette[64];	/*!< A seperate palette used for fade effects. */
 Screen currentScreen;	/*!< Keeps track of which screen is currently in use. */
 World ECSWorld;	/*!< Game state by World structure. */
-EventQueue globalQueue;		/*!<  Model writes here which SFX and animations to play. */
+SimContext ECSContext;	/*!< Simulation state belonging to ECSWorld (current player, SFX, AI values). */
+EventQueue globalQueue;		/*!<  Model writes here which SFX to play, and which animations and sprite sheets changed. */
 ButtonInput buttonInput;		/*!<  Input function writes here what buttons were pressed. */
 u8 AILevel;		/*!<  Game difficulty here is set by difficulty select screen. */
 u8 numAllies;			/*!<  Number of allies in-game is set by difficulty select screen. */
+TileRange stageTiles;	/*!< VRAM tiles of the stage on screen. */
+const Image *stageImages[STREAM_PLANES];	/*!< Images of the stage last streamed, NULL before the first. */
+StageStream stageStream;	/*!< Upload of stageImages into VRAM. */
+u8 stageFits;	/*!< 1 (TRUE) if stageStream could be planned. Otherwise the stage is drawn at once, as before. */
+StageTransition stageTransition;	/*!< Progress of the change of stage. The model waits until it is over. */
+
+/*! Sprite definition of every SpriteSheet for its tiles and animations, and for its palette. Sheets that differ only
+in colors share the tiles of the first: mockPlayer2.png is mockPlayer.png with another palette. */
+const SpriteDefinition *const sheetTiles[] = { &mockPlayer_sprite, &mockPlayer_sprite, &mockEnemy_sprite };
+const SpriteDefinition *const sheetPalette[] = { &mockPlayer_sprite, &mockPlayer2_sprite, &mockEnemy_sprite };
+const Vect2D_s16 spritePosition[2] = { { 100, 125 }, { 110, 100 } };	/*!< Where the player and enemy sprites are drawn. */
+u8 sheetTileset[SPRITE_SHEETS];	/*!< For every SpriteSheet, the first sheet with the same sheetTiles. */
+u8 residentTileset[SPRITE_SHEETS];	/*!< For every SpriteSheet, the tileset of its resident set: sheetTileset, or 0 if each sprite has a single set. */
+SpriteResidency spriteResidency;	/*!< VRAM tiles of every sprite sheet the sprites may draw this match. */
+u8 spritesResident;	/*!< 1 (TRUE) if spriteResidency could be planned. Otherwise a change of tiles resets the sprite engine, as before. */
+const SpriteDelta *const sheetDelta[] = { &mockPlayer_delta, &mockPlayer_delta, &mockEnemy_delta };	/*!< Frame deltas of every SpriteSheet, as sheetTiles. */
+u8 spriteSet[2];	/*!< Resident set each sprite draws, or RESIDENT_NONE if the sprite engine uploads its frames. */
+u16 setAnimation[RESIDENT_SETS];	/*!< Animation of the frame in the VRAM of every resident set. */
+u16 setFrame[RESIDENT_SETS];	/*!< Frame in the VRAM of every resident set, or DELTA_WHOLE if it holds none. */
+u16 spriteRuns[2];	/*!< Runs of tiles each sprite needs sent this frame (see frameDelta), DELTA_WHOLE for the whole frame. */
+const TileRun *spriteRun[2];	/*!< The runs of spriteRuns. */
+const TileSet *partTiles[2];	/*!< Tiles of the last whole frame each sprite sent, in parts if larger than the DMA budget. */
+u16 partSent[2];	/*!< Tiles of partTiles already sent, while the rest waits for the next frame. */
+const AnimationFrame *engineFrame[2];	/*!< Frame the sprite engine last uploaded, for sprites that are not resident. */
+u8 palettesQueued;	/*!< Bit i set while the palette of sprite i waits to be sent. */
+DmaQueue dmaQueue;	/*!< Uploads of the frame during VBlank, by priority. */
 
 int main() {
 	currentScreen = StartScreen;
@@ -155,13 +185,23 @@ void startGame() {
 
 	while (currentScreen == InGame)
 	{
-		randSGDK = random(); // AI uses random values from SGDK.
-		difficultyAIaccumulator += AILevel;
-		globalQueue = updateWorld(&ECSWorld, &buttonInput);
-		checkProgression(); // inquires game state to cause events
-		updateAnim(); // move sprites
+		if (stageTransition == TransitionNone) {
+			ECSContext.difficultyAIaccumulator += AILevel;
+#ifdef PROFILE_UPDATE
+			startTimer(0);
+			globalQueue = updateWorld(&ECSWorld, &ECSContext, &buttonInput);
+			showUpdateCycles(getTimer(0, FALSE));
+#else
+			globalQueue = updateWorld(&ECSWorld, &ECSContext, &buttonInput);
+#endif
+			checkProgression(); // inquires game state to cause events
+			updateAnim(); // move sprites
+		}
+		else
+			advanceStageTransition(); // the game waits while the stage changes, as it did during the fades
 		SPR_update(); // draw current screen
 		VDP_waitVSync(); // wait for refresh
+		sendDmaQueue(); // during VBlank
 	}
 
 	SYS_reset(); // Soft reset.
@@ -176,23 +216,11 @@ void initializeModel() {
 	// so that's why enemy1 is slot 0 in ECS and slot 1 in drawing order.
 	currentSpriteSheet[0] = mockPlayer1;
 	currentSpriteSheet[1] = mockEnemy;
+	currentAnimation[0] = currentAnimation[1] = Idling;
 
-	// Always clear slots for entities before creating them.
-	destroyAllEntities(&ECSWorld);
-
-	u8 i;
-	for (i = 0; i < MAX_ENEMIES; ++i)
-		createEnemyChar(&ECSWorld, currentSpriteSheet[1]);
-	ECSWorld.health[0].points = 25; // Last enemy gets extra health because he's a boss.
-
-	for (i = 0; i < numAllies; ++i)
-		if (i % 2)
-			createPlayerChar(&ECSWorld, mockPlayer2, i);
-		else
-			createPlayerChar(&ECSWorld, mockPlayer1, i);
-
-	for (i = 0; i < numAllies; ++i)
-		ECSWorld.health[MAX_ENEMIES + i].points = 25; // MAX_ENEMIES is also the index of first player character.
+	// The seed is the only random value taken from SGDK. The AI draws the rest from ECSContext.randomAI,
+	// so the match can be replayed on the host from this seed and the button presses.
+	initializeMatch(&ECSWorld, &ECSContext, numAllies, random());
 }
 
 
@@ -208,17 +236,35 @@ void initializeMegaDrive() {
 	// start music
 	XGM_startPlay(rosenroede_music);
 
-	SPR_init(0, 0, 0); // 0 here means default values. Space for 40 sprites will be allocated.
-
-	setBackground(forest1_image, forest0_image);
+	planResidentSprites();
+	initSpriteEngine(); // Space for 40 sprites will be allocated.
+	initializeDmaQueue(&dmaQueue);
+	palettesQueued = 0;
+
+	// The first stage streams in through the DMA queue as the others do, on a black screen: advanceStageTransition
+	// fades in once it is uploaded. Nothing is on screen yet, so every tile of the stage area is free.
+	stageImages[0] = stageImages[1] = NULL;
+	stageTiles.first = TILE_USERINDEX;
+	stageTiles.count = 0;
+	prepareStage(&forest1_image, &forest0_image);
+	if (stageFits) {
+		VDP_setPaletteColors(0, (u16*)palette_black, 64); // Sets all palette to black
+		SYS_enableInts(); // VDP process done, re-enable interrupts
+		stageTransition = TransitionHidden;
+	}
+	else {
+		setBackground(forest1_image, forest0_image);
+		stageTransition = TransitionNone;
+	}
 
 	// init sprite
 	spawnSprites(FALSE); // also prepares sprite palettes
-	SPR_setAnim(sprites[0], 0);
-	SPR_setAnim(sprites[1], 0);
+	SPR_setAnim(sprites[0], currentAnimation[0]);
+	SPR_setAnim(sprites[1], currentAnimation[1]);
 	SPR_update();
 
-	VDP_fadeIn(0, (4 * 16) - 1, palette, 20, FALSE); // fade in
+	if (!stageFits)
+		VDP_fadeIn(0, (4 * 16) - 1, palette, 20, FALSE); // fade in
 }
 
 
@@ -226,12 +272,14 @@ void initializeMegaDrive() {
 void gameOver() {
 	VDP_resetScreen();
 
-	if (ECSWorld.health[currentPlayer].points == 0)
+	if (ECSWorld.health[ECSContext.currentPlayer].points == 0)
 		VDP_drawText("GAME OVER", 16, 5);
 	else
 		VDP_drawText("STAGE CLEAR!", 13, 5);
 
 	spawnSprites(TRUE);
+	VDP_waitVSync();
+	sendDmaQueue(); // the game loop no longer runs: send the sprite palettes and frames spawnSprites queued now
 
 	waitMs(5 * 1000); // Let 5 seconds pass
 	JOY_waitPressBtnTime(5 * 1000); // Wait 5 more seconds or press button
@@ -298,67 +346,125 @@ void joyHandler(u16 joy, u16 changed, u16 state) {
 
 
 void spawnSprites(u8 setPAL) {
-	SpriteDefinition pickedSprite;
+	u8 i;
 
-	// Select correct player character
-	switch (currentSpriteSheet[0])
-	{
-	case mockPlayer1:
-		pickedSprite = mockPlayer_sprite;
-		sprites[0] = SPR_addSprite(&mockPlayer_sprite, fix32ToInt(FIX32(100)), fix32ToInt(FIX32(125)), TILE_ATTR(PAL2, TRUE, FALSE, FALSE));
-		break;
+	// The sprites are new, so VRAM holds no frame they know of.
+	for (i = 0; i < RESIDENT_SETS; ++i)
+		setFrame[i] = DELTA_WHOLE;
+	partSent[0] = partSent[1] = 0;
+	engineFrame[0] = engineFrame[1] = NULL;
+
+	// Player character on PAL2, enemy on PAL3. Resident sprites draw from the VRAM tiles of their sheet,
+	// which sendDmaQueue keeps up to date instead of the sprite engine.
+	for (i = 0; i < 2; ++i) {
+		u8 set = spritesResident ? findResidentSet(&spriteResidency, i, residentTileset[currentSpriteSheet[i]]) : RESIDENT_NONE;
+		spriteSet[i] = set;
+		if (set != RESIDENT_NONE)
+			sprites[i] = SPR_addSpriteEx(sheetTiles[currentSpriteSheet[i]], spritePosition[i].x, spritePosition[i].y,
+				TILE_ATTR_FULL(PAL2 + i, TRUE, FALSE, FALSE, spriteResidency.set[set].tiles.first), 0,
+				SPR_FLAG_AUTO_VISIBILITY | SPR_FLAG_AUTO_SPRITE_ALLOC);
+		else
+			sprites[i] = SPR_addSprite(sheetTiles[currentSpriteSheet[i]], spritePosition[i].x, spritePosition[i].y,
+				TILE_ATTR(PAL2 + i, TRUE, FALSE, FALSE));
+		setSpritePalette(i, setPAL);
+	}
+}
 
-	case mockPlayer2:
-		pickedSprite = mockPlayer2_sprite;
-		sprites[0] = SPR_addSprite(&mockPlayer2_sprite, fix32ToInt(FIX32(100)), fix32ToInt(FIX32(125)), TILE_ATTR(PAL2, TRUE, FALSE, FALSE));
-		break;
 
-	default:
-		break;
+
+void planResidentSprites() {
+	TileRange area = { TILE_USERINDEX + TILE_USERLENGTH - SPRITE_TILES, SPRITE_TILES - SPRITE_ENGINE_TILES };
+	u16 sheetTileCount[SPRITE_SHEETS];
+	u16 drawn[RESIDENT_SPRITES];
+	u8 sheet;
+
+	for (sheet = 0; sheet < SPRITE_SHEETS; ++sheet) {
+		for (sheetTileset[sheet] = 0; sheetTiles[sheetTileset[sheet]] != sheetTiles[sheet]; ++sheetTileset[sheet]);
+		sheetTileCount[sheet] = sheetTiles[sheet]->maxNumTile;
+	}
+	spriteSheetsInUse(&ECSWorld, drawn);
+	memcpy(residentTileset, sheetTileset, SPRITE_SHEETS);
+	spritesResident = planSpriteResidency(&spriteResidency, area, residentTileset, sheetTileCount, SPRITE_SHEETS, drawn);
+	if (!spritesResident) {
+		// A set per sheet does not fit: a single set per sprite, for the largest frame it draws, still keeps its uploads in the DMA queue.
+		memset(residentTileset, 0, SPRITE_SHEETS);
+		spritesResident = planSpriteResidency(&spriteResidency, area, residentTileset, sheetTileCount, SPRITE_SHEETS, drawn);
 	}
+}
 
-	// Load player palette into sprite engine
-	if (setPAL)
-		VDP_setPalette(PAL2, pickedSprite.palette->data);
-	memcpy(&palette[32], pickedSprite.palette->data, 16 * 2);
 
-	// Select the correct enemy sprite
-	switch (currentSpriteSheet[1])
-	{
-	case mockEnemy:
-		pickedSprite = mockEnemy_sprite;
-		sprites[1] = SPR_addSprite(&mockEnemy_sprite, fix32ToInt(FIX32(110)), fix32ToInt(FIX32(100)), TILE_ATTR(PAL3, TRUE, FALSE, FALSE));
-		break;
 
-	default:
-		break;
-	}
+void initSpriteEngine() {
+	// SPR_init keeps the last vramSize user tiles for the sprite engine: the ones after the resident sets.
+	SPR_init(0, SPRITE_TILES - (spritesResident ? spriteResidency.used : 0), 0);
+}
+
+
+
+void setSpritePalette(u8 sprite, u8 setPAL) {
+	const u16 *colors = sheetPalette[currentSpriteSheet[sprite]]->palette->data;
 
-	// Load enemy palette into sprite engine
 	if (setPAL)
-		VDP_setPalette(PAL3, pickedSprite.palette->data);
-	memcpy(&palette[48], pickedSprite.palette->data, 16 * 2);
+		palettesQueued |= 1 << sprite;
+	memcpy(&palette[32 + 16 * sprite], colors, 16 * 2);
 }
 
 
 
 void updateAnim() {
-	// If spritesheet changed, reset sprite engine.
-	if (globalQueue.spriteSheet[0] != currentSpriteSheet[0] || globalQueue.spriteSheet[1] != currentSpriteSheet[1]) {
-		currentSpriteSheet[0] = globalQueue.spriteSheet[0];
-		currentSpriteSheet[1] = globalQueue.spriteSheet[1];
-		SPR_reset();
-		SPR_clear();
-		spawnSprites(TRUE);
+	u8 i = 0;
+
+	// If spritesheet changed, reset sprite engine once for both sprites. Sprite sheet commands come first.
+	// A sheet with the same tiles in other colors (a character switch) only needs its palette: no tiles are sent.
+	// A sheet with other tiles kept in VRAM (see planResidentSprites) only needs the sprite to point at them.
+	if (globalQueue.commands > 0 && globalQueue.command[0].type == RenderSpriteSheet) {
+		u8 newTiles = FALSE;
+		u8 recolored = 0;
+		for (; i < globalQueue.commands && globalQueue.command[i].type == RenderSpriteSheet; ++i) {
+			RenderCommand command = globalQueue.command[i];
+			if (sheetTiles[command.value] != sheetTiles[currentSpriteSheet[command.sprite]]) {
+				u8 set = spritesResident ? findResidentSet(&spriteResidency, command.sprite, residentTileset[command.value]) : RESIDENT_NONE;
+				if (set == RESIDENT_NONE)
+					newTiles = TRUE;
+				else {
+					if (set == spriteSet[command.sprite])
+						setFrame[set] = DELTA_WHOLE; // a single set for every sheet: it holds a frame of the other tiles
+					spriteSet[command.sprite] = set;
+					SPR_setDefinition(sprites[command.sprite], sheetTiles[command.value]);
+					SPR_setVRAMTileIndex(sprites[command.sprite], spriteResidency.set[set].tiles.first);
+					SPR_setAnim(sprites[command.sprite], currentAnimation[command.sprite]);
+				}
+			}
+			currentSpriteSheet[command.sprite] = command.value;
+			recolored |= 1 << command.sprite;
+		}
+		if (newTiles) {
+			SPR_reset();
+			SPR_clear();
+			spawnSprites(TRUE);
+			SPR_setAnim(sprites[0], currentAnimation[0]);
+			SPR_setAnim(sprites[1], currentAnimation[1]);
+		}
+		else {
+			if (recolored & 1)
+				setSpritePalette(0, TRUE);
+			if (recolored & 2)
+				setSpritePalette(1, TRUE);
+		}
 	}
 
-	// Pick animation according to current move.
-	SPR_setAnim(sprites[0], globalQueue.animation[0]);
-	SPR_setAnim(sprites[1], globalQueue.animation[1]);
+	for (; i < globalQueue.commands; ++i) {
+		RenderCommand command = globalQueue.command[i];
 
-	// Play SFX
-	if (globalQueue.sfx != 0)
-		XGM_startPlayPCM(globalQueue.sfx, 1, SOUND_PCM_CH2);
+		// Pick animation according to current move.
+		if (command.type == RenderAnimation) {
+			currentAnimation[command.sprite] = command.value;
+			SPR_setAnim(sprites[command.sprite], command.value);
+		}
+		// Play SFX
+		else if (command.type == RenderSFX)
+			XGM_startPlayPCM(command.value, 1, SOUND_PCM_CH2);
+	}
 }
 
 
@@ -377,6 +483,8 @@ void setBackground(const Image PlanA_img, const Image PlanB_img) {
 	ind += PlanB_img.tileset->numTile;
 
 	SYS_enableInts(); // VDP process done, re-enable interrupts
+	stageTiles.first = TILE_USERINDEX;
+	stageTiles.count = ind - TILE_USERINDEX;
 
 	// prepare tile palettes
 	memcpy(&palette[0], PlanA_img.palette->data, 16 * 2);
@@ -385,50 +493,262 @@ void setBackground(const Image PlanA_img, const Image PlanB_img) {
 
 
 
+void prepareStage(const Image *planA, const Image *planB) {
+	TileRange area = { TILE_USERINDEX, TILE_USERLENGTH - SPRITE_TILES };
+	StreamImage images[STREAM_PLANES];
+	u8 i;
+
+	stageImages[0] = planA;
+	stageImages[1] = planB;
+	stageFits = TRUE;
+	for (i = 0; i < STREAM_PLANES; ++i) {
+		images[i].tiles = stageImages[i]->tileset->numTile;
+		images[i].rows = stageImages[i]->map->h;
+		images[i].rowBytes = stageImages[i]->map->w * 2;
+		if (stageImages[i]->tileset->compression != COMPRESSION_NONE || stageImages[i]->map->compression != COMPRESSION_NONE)
+			stageFits = FALSE; // Only uncompressed tiles can be sent to VRAM by DMA straight from ROM, and tilemap rows drawn from it.
+	}
+	if (stageFits)
+		stageFits = planStageStream(&stageStream, area, stageTiles, images);
+	if (!stageFits)
+		stageStream.parts = stageStream.current = 0; // Nothing to upload
+}
+
+
+
+void uploadStageChunks() {
+	u16 bytes;
+	StreamChunk chunk;
+
+	if (stageImages[0] == NULL)
+		return;
+
+	while ((bytes = nextStreamChunk(&stageStream, stageTransition == TransitionHidden, dmaBytesLeft(&dmaQueue), &chunk)) > 0) {
+		const Image *image = stageImages[chunk.plane];
+		spendDma(&dmaQueue, DmaStage, bytes);
+		if (chunk.type == StreamTiles)
+			VDP_loadTileData(image->tileset->tiles + chunk.first * (STREAM_TILE_BYTES / 4), chunk.destination, chunk.count, TRUE);
+		else
+			VDP_setMapEx(chunk.plane ? PLAN_B : PLAN_A, image->map,
+				TILE_ATTR_FULL(chunk.plane ? PAL1 : PAL0, FALSE, FALSE, FALSE, stageStream.tileBase[chunk.plane]),
+				0, chunk.first, 0, chunk.first, image->map->w, chunk.count);
+	}
+}
+
+
+
+void requestSpriteFrames() {
+	u8 i;
+	u16 r, tiles;
+
+	for (i = 0; i < 2; ++i) {
+		u8 set = spriteSet[i];
+		const Sprite *sprite = sprites[i];
+
+		if (set == RESIDENT_NONE)
+			continue;
+		spriteRuns[i] = frameDelta(sheetDelta[currentSpriteSheet[i]], setAnimation[set], setFrame[set], sprite->animInd, sprite->frameInd,
+			&spriteRun[i]);
+		if (spriteRuns[i] == 0) { // the frame is in VRAM, or has the same tiles as the one in VRAM
+			setAnimation[set] = sprite->animInd;
+			setFrame[set] = sprite->frameInd;
+			continue;
+		}
+		if (spriteRuns[i] != DELTA_WHOLE) {
+			for (r = 0, tiles = 0; r < spriteRuns[i]; ++r)
+				tiles += spriteRun[i][r].count;
+			if (tiles * STREAM_TILE_BYTES <= dmaQueue.budget) {
+				requestDma(&dmaQueue, DmaSpriteFrame, tiles * STREAM_TILE_BYTES, i);
+				continue;
+			}
+			spriteRuns[i] = DELTA_WHOLE; // would be split: send the whole frame in parts instead
+		}
+		// A whole frame larger than the budget is sent in parts: ask for what is left of it.
+		if (partTiles[i] != sprite->frame->tileset)
+			partSent[i] = 0;
+		tiles = sprite->frame->tileset->numTile - partSent[i];
+		requestDma(&dmaQueue, DmaSpriteFrame, tiles * STREAM_TILE_BYTES, i);
+	}
+}
+
+
+
+void uploadSpriteFrame(u8 i, u16 bytes) {
+	const Sprite *sprite = sprites[i];
+	const u32 *tiles = sprite->frame->tileset->tiles;
+	u8 set = spriteSet[i];
+	u16 first = spriteResidency.set[set].tiles.first;
+	u16 r;
+
+	if (spriteRuns[i] == DELTA_WHOLE) {
+		u16 count = bytes / STREAM_TILE_BYTES;
+		VDP_loadTileData(tiles + partSent[i] * (STREAM_TILE_BYTES / 4), first + partSent[i], count, TRUE);
+		partTiles[i] = sprite->frame->tileset;
+		partSent[i] += count;
+		if (partSent[i] < sprite->frame->tileset->numTile) {
+			setFrame[set] = DELTA_WHOLE; // holds part of a frame until the rest is sent
+			return;
+		}
+		partSent[i] = 0;
+	}
+	else
+		for (r = 0; r < spriteRuns[i]; ++r)
+			VDP_loadTileData(tiles + spriteRun[i][r].first * (STREAM_TILE_BYTES / 4), first + spriteRun[i][r].first, spriteRun[i][r].count, TRUE);
+	setAnimation[set] = sprite->animInd;
+	setFrame[set] = sprite->frameInd;
+}
+
+
+
+void spendInterruptDma() {
+	u16 bytes = 0;
+	u8 i;
+
+	for (i = 0; i < 2; ++i) {
+		bytes += sprites[i]->frame->numSprite * 8; // its entries of the sprite table
+		if (spriteSet[i] == RESIDENT_NONE && sprites[i]->frame != engineFrame[i]) {
+			bytes += sprites[i]->frame->tileset->numTile * STREAM_TILE_BYTES; // the sprite engine uploaded its frame
+			engineFrame[i] = sprites[i]->frame;
+		}
+	}
+	if (VDP_isDoingFade())
+		bytes += 64 * 2; // a step of the fade: every color
+	spendDma(&dmaQueue, DmaInterrupt, bytes);
+}
+
+
+
+void sendDmaQueue() {
+	DmaRequest request;
+	u8 i;
+
+	// What the vertical interrupt sent, then sprite frames, then palettes. What does not fit waits, and is asked for again next frame.
+	startDmaFrame(&dmaQueue, IS_PALSYSTEM ? DMA_BUDGET_PAL : DMA_BUDGET_NTSC);
+	spendInterruptDma();
+	requestSpriteFrames();
+	for (i = 0; i < 2; ++i)
+		if (palettesQueued & (1 << i))
+			requestDma(&dmaQueue, DmaPalette, 16 * 2, i);
+
+	while (nextDma(&dmaQueue, &request)) {
+		if (request.priority == DmaSpriteFrame)
+			uploadSpriteFrame(request.tag, request.bytes);
+		else {
+			VDP_setPalette(PAL2 + request.tag, sheetPalette[currentSpriteSheet[request.tag]]->palette->data);
+			palettesQueued &= ~(1 << request.tag);
+		}
+	}
+	uploadStageChunks(); // the stage takes what is left
+}
+
+
+
+void startStageTransition(const Image *planA, const Image *planB) {
+	if (stageImages[0] != planA)
+		prepareStage(planA, planB); // The last enemy came up without streaming (should not happen).
+
+	if (stageFits) {
+		VDP_fadeOutAll(STAGE_FADE_FRAMES, TRUE); // fade out, while the game loop keeps drawing frames
+		stageTransition = TransitionFadingOut;
+		return;
+	}
+
+	// Does not fit next to the stage on screen: draw it at once.
+	VDP_fadeOutAll(STAGE_FADE_FRAMES, FALSE);
+
+	SYS_disableInts(); //disable interrupt when accessing VDP.
+	VDP_resetScreen();
+	initSpriteEngine();
+	SPR_reset();
+	//SND_startPlay_XGM(sonic_music); 		// start music
+	setBackground(*planA, *planB);
+
+	// init sprite
+	spawnSprites(FALSE); // also prepares sprite palettes
+	SPR_setAnim(sprites[0], currentAnimation[0]);
+	SPR_setAnim(sprites[1], currentAnimation[1]);
+	SPR_update();
+	VDP_fadeIn(0, (4 * 16) - 1, palette, STAGE_FADE_FRAMES, FALSE); // fade in
+}
+
+
+
+void advanceStageTransition() {
+	switch (stageTransition)
+	{
+	case TransitionFadingOut:
+		if (!VDP_isDoingFade())
+			stageTransition = TransitionHidden; // uploadStageChunks sends the rest from now on.
+		break;
+
+	case TransitionHidden:
+		if (isStreamDone(&stageStream)) {
+			stageTiles = stageStream.tiles;
+			memcpy(&palette[0], stageImages[0]->palette->data, 16 * 2);
+			memcpy(&palette[16], stageImages[1]->palette->data, 16 * 2);
+			VDP_fadeIn(0, (4 * 16) - 1, palette, STAGE_FADE_FRAMES, TRUE); // fade in
+			stageTransition = TransitionFadingIn;
+		}
+		break;
+
+	case TransitionFadingIn:
+		if (!VDP_isDoingFade())
+			stageTransition = TransitionNone;
+		break;
+
+	default:
+		break;
+	}
+}
+
+
+
 void checkProgression() {
 	// Triggers 'Stage Clear!', or 'Game Over', or transitions backgrounds when appropriate.
 
 	// If a player character died, Game Over.
-	if (ECSWorld.move[currentPlayer].move == Dying && ECSWorld.timing[currentPlayer].frames == DEATH_FRAMES)
+	if (ECSWorld.move[ECSContext.currentPlayer].move == Dying && ECSWorld.timing[ECSContext.currentPlayer].frames == DEATH_FRAMES)
 		gameOver();
 	// If last enemy died, then Stage Clear! (First slot is always final enemy.)
 	if (ECSWorld.move[0].move == Dying && ECSWorld.timing[0].frames == DEATH_FRAMES)
 		gameOver();
 
+	// Start streaming the next stage when the last enemy before it comes up.
+	EntitySlot facing = ECSWorld.timing[ECSContext.currentPlayer].facing;
+	if (facing == GOTO_COURTYARD && stageImages[0] != &courtyard0_image)
+		prepareStage(&courtyard0_image, &courtyard1_image);
+	if (facing == GOTO_GREAT_HALL && stageImages[0] != &greatHall0_image)
+		prepareStage(&greatHall0_image, &greatHall1_image);
+
 	// From forest to courtyard
-	if (ECSWorld.move[GOTO_COURTYARD].move == Dying && ECSWorld.timing[GOTO_COURTYARD].frames == DEATH_FRAMES) {
-		VDP_fadeOutAll(20, FALSE);
-
-		SYS_disableInts(); //disable interrupt when accessing VDP.
-		VDP_resetScreen();
-		SPR_init(0, 0, 0); // 0 here means default values.
-		SPR_reset();
-		//SND_startPlay_XGM(sonic_music); 		// start music
-		setBackground(courtyard0_image, courtyard1_image);
-
-		// init sprite
-		spawnSprites(FALSE); // also prepares sprite palettes
-		SPR_setAnim(sprites[0], 0);
-		SPR_setAnim(sprites[1], 0);
-		SPR_update();
-		VDP_fadeIn(0, (4 * 16) - 1, palette, 20, FALSE); // fade in
-	}
+	if (ECSWorld.move[GOTO_COURTYARD].move == Dying && ECSWorld.timing[GOTO_COURTYARD].frames == DEATH_FRAMES)
+		startStageTransition(&courtyard0_image, &courtyard1_image);
 
-	if (ECSWorld.move[GOTO_GREAT_HALL].move == Dying && ECSWorld.timing[GOTO_GREAT_HALL].frames == DEATH_FRAMES) {
-		VDP_fadeOutAll(20, FALSE);
-
-		SYS_disableInts(); //disable interrupt when accessing VDP.
-		VDP_resetScreen();
-		SPR_init(0, 0, 0); // 0 here means default values.
-		SPR_reset();
-		//SND_startPlay_XGM(sonic_music); 		// start music
-		setBackground(greatHall0_image, greatHall1_image);
-
-		// init sprite
-		spawnSprites(FALSE); // also prepares sprite palettes
-		SPR_setAnim(sprites[0], 0);
-		SPR_setAnim(sprites[1], 0);
-		SPR_update();
-		VDP_fadeIn(0, (4 * 16) - 1, palette, 20, FALSE); // fade in
-	}
-}
\ No newline at end of file
+	if (ECSWorld.move[GOTO_GREAT_HALL].move == Dying && ECSWorld.timing[GOTO_GREAT_HALL].frames == DEATH_FRAMES)
+		startStageTransition(&greatHall0_image, &greatHall1_image);
+}
+
+
+
+#ifdef PROFILE_UPDATE
+void showUpdateCycles(u32 subTicks) {
+	static u32 totalSubTicks = 0;
+	static u16 frames = 0;
+	char text[12];
+
+	totalSubTicks += subTicks;
+	if (++frames < PROFILE_FRAMES)
+		return;
+
+	// A subtick is 1/76800 second. The 68000 runs at 7.67 MHz (NTSC): 99.9 cycles per subtick.
+	VDP_drawText("CYCLES/UPDATE        ", 1, 1);
+	uintToStr(totalSubTicks * 999 / (10 * PROFILE_FRAMES), text, 1);
+	VDP_drawText(text, 16, 1);
+	VDP_drawText("WORLD BYTES", 1, 2);
+	uintToStr(sizeof(World), text, 1);
+	VDP_drawText(text, 16, 2);
+
+	totalSubTicks = 0;
+	frames = 0;
+}
+#endif
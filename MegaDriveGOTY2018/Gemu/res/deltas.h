@@ -0,0 +1,7 @@
+#ifndef __DELTAS_H_
+#define __DELTAS_H_
+
+extern const SpriteDelta mockPlayer_delta;
+extern const SpriteDelta mockEnemy_delta;
+
+#endif // __DELTAS_H_
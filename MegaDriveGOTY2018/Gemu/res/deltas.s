@@ -0,0 +1,999 @@
+.section .rodata
+
+    .align 2
+mockPlayer_delta_animation0_frame0_runs:
+    dc.w    0, 1
+    dc.w    19, 9
+    dc.w    39, 1
+    dc.w    43, 1
+    dc.w    64, 21
+
+    .align 2
+mockPlayer_delta_animation0_frame1_runs:
+    dc.w    0, 1
+
+    .align 2
+mockPlayer_delta_animation0_frame2_runs:
+    dc.w    19, 9
+    dc.w    39, 1
+    dc.w    43, 1
+    dc.w    64, 21
+
+    .align 2
+mockPlayer_delta_animation0_frames:
+    dc.w    5
+    dc.l    mockPlayer_delta_animation0_frame0_runs
+    dc.w    1
+    dc.l    mockPlayer_delta_animation0_frame1_runs
+    dc.w    4
+    dc.l    mockPlayer_delta_animation0_frame2_runs
+    dc.w    0
+    dc.l    0
+
+    .align 2
+mockPlayer_delta_animation1_frame0_runs:
+    dc.w    3, 1
+    dc.w    17, 15
+    dc.w    48, 1
+    dc.w    52, 1
+    dc.w    56, 2
+    dc.w    61, 15
+    dc.w    79, 1
+    dc.w    113, 14
+
+    .align 2
+mockPlayer_delta_animation1_frame1_runs:
+    dc.w    17, 18
+    dc.w    64, 1
+    dc.w    68, 12
+    dc.w    113, 13
+
+    .align 2
+mockPlayer_delta_animation1_frame2_runs:
+    dc.w    19, 16
+    dc.w    64, 13
+    dc.w    114, 13
+
+    .align 2
+mockPlayer_delta_animation1_frame3_runs:
+    dc.w    3, 1
+    dc.w    18, 10
+    dc.w    48, 1
+    dc.w    52, 1
+    dc.w    56, 2
+    dc.w    61, 15
+    dc.w    114, 13
+
+    .align 2
+mockPlayer_delta_animation1_frames:
+    dc.w    8
+    dc.l    mockPlayer_delta_animation1_frame0_runs
+    dc.w    4
+    dc.l    mockPlayer_delta_animation1_frame1_runs
+    dc.w    3
+    dc.l    mockPlayer_delta_animation1_frame2_runs
+    dc.w    7
+    dc.l    mockPlayer_delta_animation1_frame3_runs
+    dc.w    0
+    dc.l    0
+    dc.w    0
+    dc.l    0
+
+    .align 2
+mockPlayer_delta_animation2_frame0_runs:
+    dc.w    17, 11
+    dc.w    61, 23
+    dc.w    87, 1
+    dc.w    104, 25
+    dc.w    132, 1
+
+    .align 2
+mockPlayer_delta_animation2_frame1_runs:
+    dc.w    11, 17
+    dc.w    31, 1
+    dc.w    60, 20
+    dc.w    104, 24
+    dc.w    131, 1
+
+    .align 2
+mockPlayer_delta_animation2_frame2_runs:
+    dc.w    11, 17
+    dc.w    31, 1
+    dc.w    60, 1
+    dc.w    64, 16
+    dc.w    112, 16
+    dc.w    131, 1
+
+    .align 2
+mockPlayer_delta_animation2_frame3_runs:
+    dc.w    13, 2
+    dc.w    18, 10
+    dc.w    64, 20
+    dc.w    87, 1
+    dc.w    112, 17
+    dc.w    132, 1
+
+    .align 2
+mockPlayer_delta_animation2_frames:
+    dc.w    5
+    dc.l    mockPlayer_delta_animation2_frame0_runs
+    dc.w    5
+    dc.l    mockPlayer_delta_animation2_frame1_runs
+    dc.w    6
+    dc.l    mockPlayer_delta_animation2_frame2_runs
+    dc.w    6
+    dc.l    mockPlayer_delta_animation2_frame3_runs
+    dc.w    0
+    dc.l    0
+    dc.w    0
+    dc.l    0
+
+    .align 2
+mockPlayer_delta_animation3_frame0_runs:
+    dc.w    19, 16
+    dc.w    64, 14
+    dc.w    113, 10
+
+    .align 2
+mockPlayer_delta_animation3_frame1_runs:
+    dc.w    19, 14
+    dc.w    64, 14
+    dc.w    114, 9
+
+    .align 2
+mockPlayer_delta_animation3_frame2_runs:
+    dc.w    22, 10
+    dc.w    64, 14
+    dc.w    114, 9
+    dc.w    126, 1
+
+    .align 2
+mockPlayer_delta_animation3_frame3_runs:
+    dc.w    22, 13
+    dc.w    64, 14
+    dc.w    113, 10
+    dc.w    126, 1
+
+    .align 2
+mockPlayer_delta_animation3_frames:
+    dc.w    3
+    dc.l    mockPlayer_delta_animation3_frame0_runs
+    dc.w    3
+    dc.l    mockPlayer_delta_animation3_frame1_runs
+    dc.w    4
+    dc.l    mockPlayer_delta_animation3_frame2_runs
+    dc.w    4
+    dc.l    mockPlayer_delta_animation3_frame3_runs
+    dc.w    0
+    dc.l    0
+    dc.w    0
+    dc.l    0
+
+    .align 2
+mockPlayer_delta_animation4_frame0_runs:
+    dc.w    2, 2
+    dc.w    7, 1
+    dc.w    16, 20
+    dc.w    48, 1
+    dc.w    52, 28
+    dc.w    113, 14
+
+    .align 2
+mockPlayer_delta_animation4_frame1_runs:
+    dc.w    16, 22
+    dc.w    64, 1
+    dc.w    68, 13
+    dc.w    113, 13
+
+    .align 2
+mockPlayer_delta_animation4_frame2_runs:
+    dc.w    18, 20
+    dc.w    60, 17
+    dc.w    80, 1
+    dc.w    114, 13
+
+    .align 2
+mockPlayer_delta_animation4_frame3_runs:
+    dc.w    3, 1
+    dc.w    7, 1
+    dc.w    11, 1
+    dc.w    18, 10
+    dc.w    48, 1
+    dc.w    52, 24
+    dc.w    114, 13
+
+    .align 2
+mockPlayer_delta_animation4_frame4_runs:
+    dc.w    2, 2
+    dc.w    7, 1
+    dc.w    11, 1
+    dc.w    48, 24
+
+    .align 2
+mockPlayer_delta_animation4_frame5_runs:
+    dc.w    3, 1
+    dc.w    7, 1
+    dc.w    48, 23
+
+    .align 2
+mockPlayer_delta_animation4_frames:
+    dc.w    6
+    dc.l    mockPlayer_delta_animation4_frame0_runs
+    dc.w    4
+    dc.l    mockPlayer_delta_animation4_frame1_runs
+    dc.w    4
+    dc.l    mockPlayer_delta_animation4_frame2_runs
+    dc.w    7
+    dc.l    mockPlayer_delta_animation4_frame3_runs
+    dc.w    4
+    dc.l    mockPlayer_delta_animation4_frame4_runs
+    dc.w    3
+    dc.l    mockPlayer_delta_animation4_frame5_runs
+
+    .align 2
+mockPlayer_delta_animation5_frame0_runs:
+    dc.w    17, 11
+    dc.w    57, 31
+    dc.w    101, 28
+    dc.w    132, 6
+
+    .align 2
+mockPlayer_delta_animation5_frame1_runs:
+    dc.w    10, 18
+    dc.w    31, 1
+    dc.w    57, 23
+    dc.w    101, 27
+    dc.w    131, 1
+
+    .align 2
+mockPlayer_delta_animation5_frame2_runs:
+    dc.w    10, 18
+    dc.w    31, 1
+    dc.w    60, 20
+    dc.w    112, 16
+    dc.w    131, 1
+
+    .align 2
+mockPlayer_delta_animation5_frame3_runs:
+    dc.w    10, 18
+    dc.w    64, 24
+    dc.w    91, 1
+    dc.w    112, 17
+    dc.w    132, 6
+
+    .align 2
+mockPlayer_delta_animation5_frame4_runs:
+    dc.w    73, 15
+    dc.w    91, 1
+    dc.w    128, 1
+    dc.w    132, 6
+
+    .align 2
+mockPlayer_delta_animation5_frame5_runs:
+    dc.w    73, 15
+    dc.w    128, 1
+    dc.w    132, 6
+
+    .align 2
+mockPlayer_delta_animation5_frames:
+    dc.w    4
+    dc.l    mockPlayer_delta_animation5_frame0_runs
+    dc.w    5
+    dc.l    mockPlayer_delta_animation5_frame1_runs
+    dc.w    5
+    dc.l    mockPlayer_delta_animation5_frame2_runs
+    dc.w    5
+    dc.l    mockPlayer_delta_animation5_frame3_runs
+    dc.w    4
+    dc.l    mockPlayer_delta_animation5_frame4_runs
+    dc.w    3
+    dc.l    mockPlayer_delta_animation5_frame5_runs
+
+    .align 2
+mockPlayer_delta_animation6_frame0_runs:
+    dc.w    19, 17
+    dc.w    64, 18
+    dc.w    113, 10
+
+    .align 2
+mockPlayer_delta_animation6_frame1_runs:
+    dc.w    19, 17
+    dc.w    64, 17
+    dc.w    114, 9
+
+    .align 2
+mockPlayer_delta_animation6_frame2_runs:
+    dc.w    22, 14
+    dc.w    64, 14
+    dc.w    114, 9
+    dc.w    126, 1
+
+    .align 2
+mockPlayer_delta_animation6_frame3_runs:
+    dc.w    22, 14
+    dc.w    64, 18
+    dc.w    113, 10
+    dc.w    126, 1
+
+    .align 2
+mockPlayer_delta_animation6_frame4_runs:
+    dc.w    27, 9
+    dc.w    72, 10
+
+    .align 2
+mockPlayer_delta_animation6_frame5_runs:
+    dc.w    27, 9
+    dc.w    72, 10
+
+    .align 2
+mockPlayer_delta_animation6_frames:
+    dc.w    3
+    dc.l    mockPlayer_delta_animation6_frame0_runs
+    dc.w    3
+    dc.l    mockPlayer_delta_animation6_frame1_runs
+    dc.w    4
+    dc.l    mockPlayer_delta_animation6_frame2_runs
+    dc.w    4
+    dc.l    mockPlayer_delta_animation6_frame3_runs
+    dc.w    2
+    dc.l    mockPlayer_delta_animation6_frame4_runs
+    dc.w    2
+    dc.l    mockPlayer_delta_animation6_frame5_runs
+
+    .align 2
+mockPlayer_delta_animation7_frames:
+    dc.w    0
+    dc.l    0
+
+    .align 2
+mockPlayer_delta_animation8_frame0_runs:
+    dc.w    19, 9
+    dc.w    64, 20
+    dc.w    87, 1
+    dc.w    112, 17
+    dc.w    132, 1
+
+    .align 2
+mockPlayer_delta_animation8_frame1_runs:
+    dc.w    15, 18
+    dc.w    64, 12
+    dc.w    114, 13
+
+    .align 2
+mockPlayer_delta_animation8_frame2_runs:
+    dc.w    15, 20
+    dc.w    64, 14
+    dc.w    113, 14
+
+    .align 2
+mockPlayer_delta_animation8_frame3_runs:
+    dc.w    19, 16
+    dc.w    64, 20
+    dc.w    87, 1
+    dc.w    112, 17
+    dc.w    132, 1
+
+    .align 2
+mockPlayer_delta_animation8_frames:
+    dc.w    5
+    dc.l    mockPlayer_delta_animation8_frame0_runs
+    dc.w    3
+    dc.l    mockPlayer_delta_animation8_frame1_runs
+    dc.w    3
+    dc.l    mockPlayer_delta_animation8_frame2_runs
+    dc.w    5
+    dc.l    mockPlayer_delta_animation8_frame3_runs
+
+    .align 2
+mockPlayer_delta_animation9_frames:
+    dc.w    0
+    dc.l    0
+
+    .align 2
+mockPlayer_delta_animation10_frame0_runs:
+    dc.w    19, 9
+    dc.w    35, 1
+    dc.w    39, 1
+    dc.w    64, 18
+    dc.w    100, 39
+    dc.w    142, 1
+
+    .align 2
+mockPlayer_delta_animation10_frame1_runs:
+    dc.w    11, 1
+    dc.w    15, 13
+    dc.w    35, 1
+    dc.w    39, 1
+    dc.w    60, 24
+    dc.w    87, 1
+    dc.w    91, 1
+    dc.w    112, 6
+    dc.w    124, 1
+
+    .align 2
+mockPlayer_delta_animation10_frame2_runs:
+    dc.w    11, 1
+    dc.w    15, 9
+    dc.w    27, 1
+    dc.w    48, 1
+    dc.w    56, 24
+    dc.w    83, 1
+    dc.w    87, 1
+    dc.w    91, 1
+    dc.w    108, 1
+    dc.w    112, 1
+    dc.w    116, 14
+    dc.w    133, 1
+    dc.w    137, 1
+    dc.w    141, 1
+
+    .align 2
+mockPlayer_delta_animation10_frame3_runs:
+    dc.w    48, 4
+    dc.w    56, 24
+    dc.w    100, 43
+
+    .align 2
+mockPlayer_delta_animation10_frame4_runs:
+    dc.w    50, 2
+    dc.w    59, 1
+    dc.w    63, 1
+    dc.w    67, 1
+    dc.w    79, 1
+    dc.w    104, 15
+    dc.w    142, 1
+
+    .align 2
+mockPlayer_delta_animation10_frame5_runs:
+    dc.w    104, 15
+
+    .align 2
+mockPlayer_delta_animation10_frames:
+    dc.w    6
+    dc.l    mockPlayer_delta_animation10_frame0_runs
+    dc.w    9
+    dc.l    mockPlayer_delta_animation10_frame1_runs
+    dc.w    14
+    dc.l    mockPlayer_delta_animation10_frame2_runs
+    dc.w    3
+    dc.l    mockPlayer_delta_animation10_frame3_runs
+    dc.w    7
+    dc.l    mockPlayer_delta_animation10_frame4_runs
+    dc.w    1
+    dc.l    mockPlayer_delta_animation10_frame5_runs
+
+    .align 2
+mockPlayer_delta_animations:
+    dc.w    4
+    dc.l    mockPlayer_delta_animation0_frames
+    dc.w    6
+    dc.l    mockPlayer_delta_animation1_frames
+    dc.w    6
+    dc.l    mockPlayer_delta_animation2_frames
+    dc.w    6
+    dc.l    mockPlayer_delta_animation3_frames
+    dc.w    6
+    dc.l    mockPlayer_delta_animation4_frames
+    dc.w    6
+    dc.l    mockPlayer_delta_animation5_frames
+    dc.w    6
+    dc.l    mockPlayer_delta_animation6_frames
+    dc.w    1
+    dc.l    mockPlayer_delta_animation7_frames
+    dc.w    4
+    dc.l    mockPlayer_delta_animation8_frames
+    dc.w    1
+    dc.l    mockPlayer_delta_animation9_frames
+    dc.w    6
+    dc.l    mockPlayer_delta_animation10_frames
+
+    .align 2
+    .global mockPlayer_delta
+mockPlayer_delta:
+    dc.w    11
+    dc.l    mockPlayer_delta_animations
+
+    .align 2
+mockEnemy_delta_animation0_frame0_runs:
+    dc.w    7, 1
+    dc.w    11, 1
+    dc.w    21, 7
+    dc.w    31, 1
+    dc.w    44, 1
+    dc.w    56, 1
+    dc.w    60, 19
+
+    .align 2
+mockEnemy_delta_animation0_frame1_runs:
+    dc.w    44, 1
+
+    .align 2
+mockEnemy_delta_animation0_frame2_runs:
+    dc.w    7, 1
+    dc.w    11, 1
+    dc.w    21, 7
+    dc.w    31, 1
+    dc.w    56, 1
+    dc.w    60, 19
+
+    .align 2
+mockEnemy_delta_animation0_frames:
+    dc.w    7
+    dc.l    mockEnemy_delta_animation0_frame0_runs
+    dc.w    1
+    dc.l    mockEnemy_delta_animation0_frame1_runs
+    dc.w    6
+    dc.l    mockEnemy_delta_animation0_frame2_runs
+    dc.w    0
+    dc.l    0
+
+    .align 2
+mockEnemy_delta_animation1_frame0_runs:
+    dc.w    18, 14
+    dc.w    47, 1
+    dc.w    67, 22
+    dc.w    92, 1
+    dc.w    112, 16
+
+    .align 2
+mockEnemy_delta_animation1_frame1_runs:
+    dc.w    12, 20
+    dc.w    64, 13
+    dc.w    112, 16
+
+    .align 2
+mockEnemy_delta_animation1_frame2_runs:
+    dc.w    12, 16
+    dc.w    31, 1
+    dc.w    64, 1
+    dc.w    68, 11
+    dc.w    113, 10
+    dc.w    126, 1
+
+    .align 2
+mockEnemy_delta_animation1_frame3_runs:
+    dc.w    21, 11
+    dc.w    47, 1
+    dc.w    68, 21
+    dc.w    92, 1
+    dc.w    112, 11
+    dc.w    126, 1
+
+    .align 2
+mockEnemy_delta_animation1_frames:
+    dc.w    5
+    dc.l    mockEnemy_delta_animation1_frame0_runs
+    dc.w    3
+    dc.l    mockEnemy_delta_animation1_frame1_runs
+    dc.w    6
+    dc.l    mockEnemy_delta_animation1_frame2_runs
+    dc.w    6
+    dc.l    mockEnemy_delta_animation1_frame3_runs
+    dc.w    0
+    dc.l    0
+    dc.w    0
+    dc.l    0
+
+    .align 2
+mockEnemy_delta_animation2_frame0_runs:
+    dc.w    21, 11
+    dc.w    59, 25
+    dc.w    104, 1
+    dc.w    108, 1
+    dc.w    112, 23
+
+    .align 2
+mockEnemy_delta_animation2_frame1_runs:
+    dc.w    19, 17
+    dc.w    39, 1
+    dc.w    64, 20
+    dc.w    111, 24
+
+    .align 2
+mockEnemy_delta_animation2_frame2_runs:
+    dc.w    19, 17
+    dc.w    39, 1
+    dc.w    64, 17
+    dc.w    111, 16
+
+    .align 2
+mockEnemy_delta_animation2_frame3_runs:
+    dc.w    21, 14
+    dc.w    59, 20
+    dc.w    104, 1
+    dc.w    108, 1
+    dc.w    112, 15
+
+    .align 2
+mockEnemy_delta_animation2_frame4_runs:
+    dc.w    23, 1
+    dc.w    68, 1
+
+    .align 2
+mockEnemy_delta_animation2_frame5_runs:
+    dc.w    68, 1
+
+    .align 2
+mockEnemy_delta_animation2_frames:
+    dc.w    5
+    dc.l    mockEnemy_delta_animation2_frame0_runs
+    dc.w    4
+    dc.l    mockEnemy_delta_animation2_frame1_runs
+    dc.w    4
+    dc.l    mockEnemy_delta_animation2_frame2_runs
+    dc.w    5
+    dc.l    mockEnemy_delta_animation2_frame3_runs
+    dc.w    2
+    dc.l    mockEnemy_delta_animation2_frame4_runs
+    dc.w    1
+    dc.l    mockEnemy_delta_animation2_frame5_runs
+
+    .align 2
+mockEnemy_delta_animation3_frame0_runs:
+    dc.w    12, 16
+    dc.w    31, 1
+    dc.w    64, 15
+    dc.w    117, 10
+
+    .align 2
+mockEnemy_delta_animation3_frame1_runs:
+    dc.w    12, 1
+    dc.w    16, 12
+    dc.w    31, 1
+    dc.w    64, 14
+    dc.w    116, 7
+    dc.w    126, 1
+
+    .align 2
+mockEnemy_delta_animation3_frame2_runs:
+    dc.w    17, 11
+    dc.w    64, 15
+    dc.w    114, 9
+    dc.w    126, 1
+
+    .align 2
+mockEnemy_delta_animation3_frame3_runs:
+    dc.w    13, 15
+    dc.w    64, 15
+    dc.w    114, 8
+    dc.w    125, 2
+
+    .align 2
+mockEnemy_delta_animation3_frames:
+    dc.w    4
+    dc.l    mockEnemy_delta_animation3_frame0_runs
+    dc.w    6
+    dc.l    mockEnemy_delta_animation3_frame1_runs
+    dc.w    4
+    dc.l    mockEnemy_delta_animation3_frame2_runs
+    dc.w    4
+    dc.l    mockEnemy_delta_animation3_frame3_runs
+    dc.w    0
+    dc.l    0
+    dc.w    0
+    dc.l    0
+
+    .align 2
+mockEnemy_delta_animation4_frame0_runs:
+    dc.w    14, 18
+    dc.w    43, 5
+    dc.w    64, 29
+    dc.w    112, 16
+
+    .align 2
+mockEnemy_delta_animation4_frame1_runs:
+    dc.w    8, 24
+    dc.w    60, 1
+    dc.w    64, 13
+    dc.w    112, 16
+
+    .align 2
+mockEnemy_delta_animation4_frame2_runs:
+    dc.w    8, 24
+    dc.w    60, 1
+    dc.w    64, 1
+    dc.w    68, 15
+    dc.w    113, 10
+    dc.w    126, 1
+
+    .align 2
+mockEnemy_delta_animation4_frame3_runs:
+    dc.w    21, 11
+    dc.w    39, 1
+    dc.w    43, 1
+    dc.w    47, 1
+    dc.w    68, 25
+    dc.w    112, 11
+    dc.w    126, 1
+
+    .align 2
+mockEnemy_delta_animation4_frame4_runs:
+    dc.w    39, 1
+    dc.w    43, 5
+    dc.w    73, 21
+
+    .align 2
+mockEnemy_delta_animation4_frame5_runs:
+    dc.w    43, 1
+    dc.w    47, 1
+    dc.w    72, 22
+
+    .align 2
+mockEnemy_delta_animation4_frames:
+    dc.w    4
+    dc.l    mockEnemy_delta_animation4_frame0_runs
+    dc.w    4
+    dc.l    mockEnemy_delta_animation4_frame1_runs
+    dc.w    6
+    dc.l    mockEnemy_delta_animation4_frame2_runs
+    dc.w    7
+    dc.l    mockEnemy_delta_animation4_frame3_runs
+    dc.w    3
+    dc.l    mockEnemy_delta_animation4_frame4_runs
+    dc.w    3
+    dc.l    mockEnemy_delta_animation4_frame5_runs
+
+    .align 2
+mockEnemy_delta_animation5_frame0_runs:
+    dc.w    21, 11
+    dc.w    58, 30
+    dc.w    100, 9
+    dc.w    112, 27
+
+    .align 2
+mockEnemy_delta_animation5_frame1_runs:
+    dc.w    19, 21
+    dc.w    64, 24
+    dc.w    111, 28
+
+    .align 2
+mockEnemy_delta_animation5_frame2_runs:
+    dc.w    19, 21
+    dc.w    64, 18
+    dc.w    111, 16
+
+    .align 2
+mockEnemy_delta_animation5_frame3_runs:
+    dc.w    21, 18
+    dc.w    55, 24
+    dc.w    100, 9
+    dc.w    112, 15
+
+    .align 2
+mockEnemy_delta_animation5_frame4_runs:
+    dc.w    55, 17
+    dc.w    100, 9
+
+    .align 2
+mockEnemy_delta_animation5_frame5_runs:
+    dc.w    58, 14
+    dc.w    100, 9
+
+    .align 2
+mockEnemy_delta_animation5_frames:
+    dc.w    4
+    dc.l    mockEnemy_delta_animation5_frame0_runs
+    dc.w    3
+    dc.l    mockEnemy_delta_animation5_frame1_runs
+    dc.w    3
+    dc.l    mockEnemy_delta_animation5_frame2_runs
+    dc.w    4
+    dc.l    mockEnemy_delta_animation5_frame3_runs
+    dc.w    2
+    dc.l    mockEnemy_delta_animation5_frame4_runs
+    dc.w    2
+    dc.l    mockEnemy_delta_animation5_frame5_runs
+
+    .align 2
+mockEnemy_delta_animation6_frame0_runs:
+    dc.w    12, 16
+    dc.w    31, 1
+    dc.w    60, 19
+    dc.w    117, 10
+
+    .align 2
+mockEnemy_delta_animation6_frame1_runs:
+    dc.w    12, 16
+    dc.w    31, 1
+    dc.w    60, 1
+    dc.w    64, 14
+    dc.w    116, 7
+    dc.w    126, 1
+
+    .align 2
+mockEnemy_delta_animation6_frame2_runs:
+    dc.w    12, 16
+    dc.w    64, 15
+    dc.w    114, 9
+    dc.w    126, 1
+
+    .align 2
+mockEnemy_delta_animation6_frame3_runs:
+    dc.w    12, 16
+    dc.w    60, 19
+    dc.w    114, 8
+    dc.w    125, 2
+
+    .align 2
+mockEnemy_delta_animation6_frame4_runs:
+    dc.w    13, 7
+    dc.w    23, 1
+    dc.w    60, 11
+
+    .align 2
+mockEnemy_delta_animation6_frame5_runs:
+    dc.w    13, 7
+    dc.w    23, 1
+    dc.w    60, 11
+
+    .align 2
+mockEnemy_delta_animation6_frames:
+    dc.w    4
+    dc.l    mockEnemy_delta_animation6_frame0_runs
+    dc.w    6
+    dc.l    mockEnemy_delta_animation6_frame1_runs
+    dc.w    4
+    dc.l    mockEnemy_delta_animation6_frame2_runs
+    dc.w    4
+    dc.l    mockEnemy_delta_animation6_frame3_runs
+    dc.w    3
+    dc.l    mockEnemy_delta_animation6_frame4_runs
+    dc.w    3
+    dc.l    mockEnemy_delta_animation6_frame5_runs
+
+    .align 2
+mockEnemy_delta_animation7_frames:
+    dc.w    0
+    dc.l    0
+
+    .align 2
+mockEnemy_delta_animation8_frame0_runs:
+    dc.w    21, 7
+    dc.w    31, 1
+    dc.w    59, 20
+    dc.w    104, 1
+    dc.w    108, 1
+    dc.w    112, 15
+
+    .align 2
+mockEnemy_delta_animation8_frame1_runs:
+    dc.w    12, 1
+    dc.w    16, 2
+    dc.w    21, 11
+    dc.w    35, 1
+    dc.w    68, 11
+    dc.w    112, 11
+    dc.w    126, 1
+
+    .align 2
+mockEnemy_delta_animation8_frame2_runs:
+    dc.w    12, 20
+    dc.w    35, 1
+    dc.w    64, 15
+    dc.w    112, 15
+
+    .align 2
+mockEnemy_delta_animation8_frame3_runs:
+    dc.w    13, 2
+    dc.w    18, 10
+    dc.w    31, 1
+    dc.w    59, 20
+    dc.w    104, 1
+    dc.w    108, 1
+    dc.w    112, 15
+
+    .align 2
+mockEnemy_delta_animation8_frames:
+    dc.w    6
+    dc.l    mockEnemy_delta_animation8_frame0_runs
+    dc.w    7
+    dc.l    mockEnemy_delta_animation8_frame1_runs
+    dc.w    4
+    dc.l    mockEnemy_delta_animation8_frame2_runs
+    dc.w    7
+    dc.l    mockEnemy_delta_animation8_frame3_runs
+
+    .align 2
+mockEnemy_delta_animation9_frames:
+    dc.w    0
+    dc.l    0
+
+    .align 2
+mockEnemy_delta_animation10_frame0_runs:
+    dc.w    11, 1
+    dc.w    15, 1
+    dc.w    22, 6
+    dc.w    31, 1
+    dc.w    60, 19
+    dc.w    98, 41
+
+    .align 2
+mockEnemy_delta_animation10_frame1_runs:
+    dc.w    11, 1
+    dc.w    15, 1
+    dc.w    22, 10
+    dc.w    35, 1
+    dc.w    39, 1
+    dc.w    55, 1
+    dc.w    59, 24
+    dc.w    112, 1
+    dc.w    120, 6
+
+    .align 2
+mockEnemy_delta_animation10_frame2_runs:
+    dc.w    23, 9
+    dc.w    35, 1
+    dc.w    39, 1
+    dc.w    55, 1
+    dc.w    59, 1
+    dc.w    63, 25
+    dc.w    92, 1
+    dc.w    97, 1
+    dc.w    101, 1
+    dc.w    105, 20
+    dc.w    128, 1
+
+    .align 2
+mockEnemy_delta_animation10_frame3_runs:
+    dc.w    64, 24
+    dc.w    92, 47
+
+    .align 2
+mockEnemy_delta_animation10_frame4_runs:
+    dc.w    67, 1
+    dc.w    79, 1
+    dc.w    83, 1
+    dc.w    87, 1
+    dc.w    94, 5
+    dc.w    120, 15
+
+    .align 2
+mockEnemy_delta_animation10_frame5_runs:
+    dc.w    121, 14
+
+    .align 2
+mockEnemy_delta_animation10_frames:
+    dc.w    6
+    dc.l    mockEnemy_delta_animation10_frame0_runs
+    dc.w    9
+    dc.l    mockEnemy_delta_animation10_frame1_runs
+    dc.w    11
+    dc.l    mockEnemy_delta_animation10_frame2_runs
+    dc.w    2
+    dc.l    mockEnemy_delta_animation10_frame3_runs
+    dc.w    6
+    dc.l    mockEnemy_delta_animation10_frame4_runs
+    dc.w    1
+    dc.l    mockEnemy_delta_animation10_frame5_runs
+
+    .align 2
+mockEnemy_delta_animations:
+    dc.w    4
+    dc.l    mockEnemy_delta_animation0_frames
+    dc.w    6
+    dc.l    mockEnemy_delta_animation1_frames
+    dc.w    6
+    dc.l    mockEnemy_delta_animation2_frames
+    dc.w    6
+    dc.l    mockEnemy_delta_animation3_frames
+    dc.w    6
+    dc.l    mockEnemy_delta_animation4_frames
+    dc.w    6
+    dc.l    mockEnemy_delta_animation5_frames
+    dc.w    6
+    dc.l    mockEnemy_delta_animation6_frames
+    dc.w    1
+    dc.l    mockEnemy_delta_animation7_frames
+    dc.w    4
+    dc.l    mockEnemy_delta_animation8_frames
+    dc.w    1
+    dc.l    mockEnemy_delta_animation9_frames
+    dc.w    6
+    dc.l    mockEnemy_delta_animation10_frames
+
+    .align 2
+    .global mockEnemy_delta
+mockEnemy_delta:
+    dc.w    11
+    dc.l    mockEnemy_delta_animations
+
@@ -0,0 +1,105 @@
+/*!
+\file DmaQueue.c
+\brief DMA queue file
+\date 10/2026
+
+Sends the requests of a frame by priority within its budget, and defers or splits the others (see DmaQueue.h).
+*/
+
+#include "../inc/DmaQueue.h"
+
+
+void initializeDmaQueue(DmaQueue *queue) {
+	u8 priority;
+
+	queue->requests = 0;
+	queue->taken = 0;
+	queue->budget = 0;
+	queue->spent = 0;
+	queue->overrun = FALSE;
+	queue->frames = 0;
+	queue->overrunFrames = 0;
+	for (priority = 0; priority < DMA_PRIORITIES; ++priority)
+		queue->sentBytes[priority] = queue->deferredBytes[priority] = 0;
+}
+
+
+void startDmaFrame(DmaQueue *queue, u16 budget) {
+	queue->requests = 0;
+	queue->taken = 0;
+	queue->budget = budget;
+	queue->spent = 0;
+	queue->overrun = FALSE;
+	++queue->frames;
+}
+
+
+/*! Marks the frame as asking for more than its budget, once. */
+static void overrun(DmaQueue *queue) {
+	if (!queue->overrun)
+		++queue->overrunFrames;
+	queue->overrun = TRUE;
+}
+
+
+u8 requestDma(DmaQueue *queue, DmaPriority priority, u16 bytes, u8 tag) {
+	DmaRequest *request;
+
+	if (queue->requests == DMA_REQUESTS) {
+		queue->deferredBytes[priority] += bytes;
+		overrun(queue);
+		return FALSE;
+	}
+	request = &queue->request[queue->requests++];
+	request->bytes = bytes;
+	request->priority = priority;
+	request->tag = tag;
+	return TRUE;
+}
+
+
+u8 nextDma(DmaQueue *queue, DmaRequest *request) {
+	for (;;) {
+		u8 i, next = DMA_REQUESTS;
+		u16 left;
+
+		for (i = 0; i < queue->requests; ++i)
+			if (!(queue->taken & (1 << i)) && (next == DMA_REQUESTS || queue->request[i].priority < queue->request[next].priority))
+				next = i;
+		if (next == DMA_REQUESTS)
+			return FALSE;
+
+		queue->taken |= 1 << next;
+		*request = queue->request[next];
+		left = dmaBytesLeft(queue);
+		if (request->bytes <= left) {
+			queue->spent += request->bytes;
+			queue->sentBytes[request->priority] += request->bytes;
+			return TRUE;
+		}
+		overrun(queue);
+		if (request->bytes > queue->budget && left >= DMA_SPLIT_BYTES) {
+			// It would never fit: send what is left now, the caller asks for the rest next frame.
+			u16 part = left - left % DMA_SPLIT_BYTES;
+			queue->deferredBytes[request->priority] += request->bytes - part;
+			request->bytes = part;
+			queue->spent += part;
+			queue->sentBytes[request->priority] += part;
+			return TRUE;
+		}
+		queue->deferredBytes[request->priority] += request->bytes;
+	}
+}
+
+
+u16 dmaBytesLeft(const DmaQueue *queue) {
+	return (queue->spent < queue->budget) ? queue->budget - queue->spent : 0;
+}
+
+
+void spendDma(DmaQueue *queue, DmaPriority priority, u16 bytes) {
+	if (bytes > dmaBytesLeft(queue))
+		overrun(queue);
+	queue->spent += bytes;
+	queue->sentBytes[priority] += bytes;
+}
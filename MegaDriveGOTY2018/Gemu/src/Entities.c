@@ -13,50 +13,267 @@ Entities file of the ECS architecture.
 
 #include "../inc/Entities.h"
 
-u8 nextEmptyEntitySlot(World *world) {
-	for (u8 entity = 0; entity < ENTITY_COUNT; ++entity)
+EntitySlot nextEmptyEntitySlot(World *world) {
+	return world->firstFree;
+}
+
+/*! Puts an unused slot at the head of the free list. */
+static void pushFreeSlot(World *world, EntitySlot entity) {
+	world->previousFree[entity] = ENTITY_NONE;
+	world->nextFree[entity] = world->firstFree;
+	if (world->firstFree != ENTITY_NONE)
+		world->previousFree[world->firstFree] = entity;
+	world->firstFree = entity;
+}
+
+/*! Takes a slot out of the free list, wherever it is. */
+static void unlinkFreeSlot(World *world, EntitySlot entity) {
+	EntitySlot previous = world->previousFree[entity], next = world->nextFree[entity];
+	if (previous != ENTITY_NONE)
+		world->nextFree[previous] = next;
+	else
+		world->firstFree = next;
+	if (next != ENTITY_NONE)
+		world->previousFree[next] = previous;
+}
+
+static void writeComponentSets(World *world, EntitySlot entity, u16 mask) {
+	u32 bit = 1UL << (entity & 31);
+	for (u8 type = 0; type < COMPONENT_TYPES; ++type)
+		if (mask & (1 << type))
+			world->entitySet[type][entity >> 5] |= bit;
+		else
+			world->entitySet[type][entity >> 5] &= ~bit;
+}
+
+void setComponents(World *world, EntitySlot entity, u16 mask) {
+	if (world->mask[entity] == COMPONENT_NONE && mask != COMPONENT_NONE)
+		unlinkFreeSlot(world, entity);
+	else if (world->mask[entity] != COMPONENT_NONE && mask == COMPONENT_NONE) {
+		pushFreeSlot(world, entity);
+		world->generation[entity]++;
+	}
+	writeComponentSets(world, entity, mask);
+	world->mask[entity] = mask;
+	refreshEntityHash(world, entity);
+}
+
+void refreshBusyEntity(World *world, EntitySlot entity) {
+	u32 bit = 1UL << (entity & 31);
+	refreshEntityTimer(world, entity);
+	if (world->move[entity].move != 0 || entityStaggered(world, entity) != 0) // 0 is Idling
+		world->entitySet[COMPONENT_TYPES][entity >> 5] |= bit;
+	else
+		world->entitySet[COMPONENT_TYPES][entity >> 5] &= ~bit;
+	refreshEntityHash(world, entity);
+}
+
+#ifdef ECS_WORLD_HASH
+/*! Finalizer of MurmurHash3: every bit of the result depends on every bit of x. */
+static WorldHash mixHash(WorldHash x) {
+	x ^= x >> 33;
+	x *= 0xFF51AFD7ED558CCDULL;
+	x ^= x >> 33;
+	x *= 0xC4CEB9FE1A85EC53ULL;
+	return x ^ (x >> 33);
+}
+
+WorldHash frameKey(EntitySlot entity) {
+	return ((WorldHash)entity << 1 | 1) * 0xD6E8FEB86659FD93ULL;
+}
+
+WorldHash staggerKey(EntitySlot entity) {
+	return ((WorldHash)entity << 1 | 1) * 0x9FB21C651E98DF25ULL;
+}
+
+/*! Hashes the components of an entity slot but the sprite sheet, 'frames' and 'staggered'. */
+static WorldHash componentHash(const World *world, EntitySlot entity) {
+	WorldHash components = world->health[entity].points
+		| (WorldHash)world->move[entity].move << 16
+		| (WorldHash)world->teamMember[entity].isActive << 24
+		| (WorldHash)world->teamMember[entity].id << 32
+		| (WorldHash)world->mask[entity] << 40
+		| (WorldHash)world->generation[entity] << 56;
+	WorldHash slot = (WorldHash)world->timing[entity].facing | (WorldHash)world->timing[entity].facingGeneration << 24
+		| (WorldHash)entity << 32;
+	return mixHash(components ^ slot * 0x9E3779B97F4A7C15ULL);
+}
+
+WorldHash entitySlotHash(const World *world, EntitySlot entity) {
+	// The sprite sheet is left out: it only decides what is drawn.
+	// The counts are added outside of the mix, so that refreshEntityFrame only adds frameKey,
+	// and so that timers can keep them as sums (see worldHash).
+	return componentHash(world, entity) + entityFrames(world, entity) * frameKey(entity)
+		+ entityStaggered(world, entity) * staggerKey(entity);
+}
+
+void refreshEntityHash(World *world, EntitySlot entity) {
+#ifdef ECS_TIMER_WHEEL
+	// Counts kept by timers are in the sums of EntityTimers instead.
+	WorldHash hash = componentHash(world, entity);
+	if (!entityInSet(world->timers.running, entity))
+		hash += world->timing[entity].frames * frameKey(entity);
+	if (!entityInSet(world->timers.counting, entity))
+		hash += world->health[entity].staggered * staggerKey(entity);
+#else
+	WorldHash hash = entitySlotHash(world, entity);
+#endif
+	world->hash += hash - world->entityHash[entity];
+	world->entityHash[entity] = hash;
+}
+
+void refreshEntityFrame(World *world, EntitySlot entity) {
+	if (world->timing[entity].frames == 0) {
+		refreshEntityHash(world, entity); // Wrapped around from 0xFFFF.
+		return;
+	}
+	world->hash += frameKey(entity);
+	world->entityHash[entity] += frameKey(entity);
+}
+
+void rehashWorld(World *world) {
+	world->hash = 0;
+	for (EntitySlot entity = 0; entity < ENTITY_COUNT; ++entity) {
+		world->entityHash[entity] = 0;
+		refreshEntityHash(world, entity);
+	}
+}
+
+WorldHash worldHash(const World *world) {
+#ifdef ECS_TIMER_WHEEL
+	// Plus frameKey * (clock - frameStart[]) for each running entity, staggerKey * (staggerEnd[] - clock) for each counting one.
+	const EntityTimers *timers = &world->timers;
+	return world->hash + timers->clock * (timers->runningKeys - timers->countingKeys)
+		- timers->runningStarts + timers->countingEnds;
+#else
+	return world->hash;
+#endif
+}
+
+WorldHash fullWorldHash(const World *world) {
+	WorldHash hash = 0;
+	for (EntitySlot entity = 0; entity < ENTITY_COUNT; ++entity)
+		hash += entitySlotHash(world, entity);
+	return hash;
+}
+
+WorldHash simulationHash(const World *world, const SimContext *context) {
+	WorldHash simulation = (WorldHash)context->randomAI.state << 32 | context->difficultyAIaccumulator;
+	return mixHash(worldHash(world) ^ mixHash(mixHash(simulation) ^ context->currentPlayer));
+}
+#endif
+
+void rebuildEntitySets(World *world) {
+	world->firstFree = ENTITY_NONE;
+	for (EntitySlot entity = ENTITY_COUNT; entity-- > 0;) {
 		if (world->mask[entity] == COMPONENT_NONE)
-			return entity;
-	return 255;
+			pushFreeSlot(world, entity);
+		writeComponentSets(world, entity, world->mask[entity]);
+		refreshBusyEntity(world, entity);
+	}
+#ifdef ECS_WORLD_HASH
+	rehashWorld(world);
+#endif
+}
+
+EntitySlot nextEntityWith(World *world, u16 mask, EntitySlot entity) {
+	while (entity < ENTITY_COUNT) {
+		u32 bits = 0xFFFFFFFFUL;
+		for (u8 type = 0; type <= COMPONENT_TYPES; ++type)
+			if (mask & (1 << type))
+				bits &= world->entitySet[type][entity >> 5];
+		bits >>= (entity & 31);
+
+		if (bits) {
+			// Shifting is cheap on the 68000, which has no instruction to find the lowest set bit.
+			for (; (bits & 1) == 0; bits >>= 1)
+				++entity;
+			return (entity < ENTITY_COUNT) ? entity : ENTITY_COUNT;
+		}
+		if ((u32)(entity | 31) >= ENTITY_COUNT - 1)
+			break; // Last word. Also keeps the next word's slot from overflowing EntitySlot.
+		entity = (entity | 31) + 1; // Next word
+	}
+	return ENTITY_COUNT;
+}
+
+EntityHandle entityHandle(World *world, EntitySlot entity) {
+	return ((EntityHandle)world->generation[entity] << ENTITY_HANDLE_SHIFT) | entity;
+}
+
+EntitySlot entityOfHandle(World *world, EntityHandle handle) {
+	EntitySlot entity = (EntitySlot)(handle & ((1UL << ENTITY_HANDLE_SHIFT) - 1));
+	if (entity >= ENTITY_COUNT || world->generation[entity] != (u8)(handle >> ENTITY_HANDLE_SHIFT) || world->mask[entity] == COMPONENT_NONE)
+		return ENTITY_NONE;
+	return entity;
+}
+
+void setFacing(World *world, EntitySlot entity, EntitySlot opponent) {
+	world->timing[entity].facing = opponent;
+	world->timing[entity].facingGeneration = world->generation[opponent];
+}
+
+EntitySlot facedEntity(World *world, EntitySlot entity) {
+	return entityOfHandle(world, ((EntityHandle)world->timing[entity].facingGeneration << ENTITY_HANDLE_SHIFT) | world->timing[entity].facing);
 }
 
-void destroyEntity(World *world, u8 entity) {
-	world->mask[entity] = COMPONENT_NONE;
+void destroyEntity(World *world, EntitySlot entity) {
+	setComponents(world, entity, COMPONENT_NONE);
 }
 
 void destroyAllEntities(World *world) {
-	for (u8 i = 0; i < ENTITY_COUNT; i++)
+#ifdef ECS_TIMER_WHEEL
+	clearEntityTimers(world);
+#endif
+	// Pushed from the last slot down, so that the free list starts with slot 0.
+	world->firstFree = ENTITY_NONE;
+	for (EntitySlot i = ENTITY_COUNT; i-- > 0;) {
+		if (world->mask[i] != COMPONENT_NONE)
+			world->generation[i]++;
 		world->mask[i] = COMPONENT_NONE;
+		writeComponentSets(world, i, COMPONENT_NONE);
+		refreshBusyEntity(world, i);
+		pushFreeSlot(world, i);
+	}
+#ifdef ECS_WORLD_HASH
+	rehashWorld(world); // The World may not be cleared yet.
+#endif
 }
 
 // Helper functions to create template entities.
 
-u8 createPlayerChar(World *world, SpriteSheet spriteCharacter, u8 memberID) {
+EntitySlot createPlayerChar(World *world, SimContext *context, SpriteSheet spriteCharacter, u8 memberID) {
 	// WARNING: Set EVERY value of EVERY component!
-	u8 entity = nextEmptyEntitySlot(world);
-	world->mask[entity] = COMPONENT_HEALTH | COMPONENT_TIMING | COMPONENT_SPRITE | COMPONENT_MOVE | COMPONENT_TEAMMEMBER;
+	EntitySlot entity = nextEmptyEntitySlot(world);
+	if (entity == ENTITY_NONE)
+		return ENTITY_NONE;
+	setComponents(world, entity, COMPONENT_HEALTH | COMPONENT_TIMING | COMPONENT_SPRITE | COMPONENT_MOVE | COMPONENT_TEAMMEMBER);
 	world->teamMember[entity].id = memberID;
 	world->teamMember[entity].isActive = (memberID == 0) ? TRUE : FALSE;
 	if (world->teamMember[entity].isActive)
-		currentPlayer = entity;
+		context->currentPlayer = entity;
 	world->health[entity].points = 10;
-	world->health[entity].staggered = 0;
-	world->timing[entity].frames = 0;
-	world->move[entity].spriteData = spriteCharacter;
+	setEntityStaggered(world, entity, 0);
+	setEntityFrames(world, entity, 0);
+	world->sprite[entity].spriteData = spriteCharacter;
 	world->move[entity].move = 0;
-	world->timing[entity].facing = currentPlayer - 1;
+	setFacing(world, entity, context->currentPlayer - 1);
+	refreshBusyEntity(world, entity);
 	return entity;
 }
 
-u8 createEnemyChar(World *world, SpriteSheet spriteCharacter) {
-	u8 entity = nextEmptyEntitySlot(world);
-	world->mask[entity] = COMPONENT_HEALTH | COMPONENT_TIMING | COMPONENT_SPRITE | COMPONENT_MOVE;
+EntitySlot createEnemyChar(World *world, SpriteSheet spriteCharacter) {
+	EntitySlot entity = nextEmptyEntitySlot(world);
+	if (entity == ENTITY_NONE)
+		return ENTITY_NONE;
+	setComponents(world, entity, COMPONENT_HEALTH | COMPONENT_TIMING | COMPONENT_SPRITE | COMPONENT_MOVE);
 	world->health[entity].points = 10;
-	world->health[entity].staggered = 0;
-	world->move[entity].spriteData = spriteCharacter;
+	setEntityStaggered(world, entity, 0);
+	world->sprite[entity].spriteData = spriteCharacter;
 	world->move[entity].move = 0;
-	world->timing[entity].facing = entity + 1;
-	world->timing[entity].frames = 0;
+	setFacing(world, entity, (entity + 1 < ENTITY_COUNT) ? entity + 1 : 0); // The next slot: the player after the last enemy.
+	setEntityFrames(world, entity, 0);
+	refreshBusyEntity(world, entity);
 	return entity;
 }
 
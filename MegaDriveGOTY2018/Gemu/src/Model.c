@@ -10,7 +10,11 @@ Model file containing ECS architecture.
 #ifndef _MODEL
 #define _MODEL
 
+#include "../inc/Profile.h"	// before pack(1): SystemProfile keeps the layout of Profile.c
+
+#ifndef ECS_UNPACKED_COMPONENTS
 #pragma pack(1)
+#endif
 
 #include "../inc/Model.h"
 
@@ -18,19 +22,63 @@ Model file containing ECS architecture.
 
 /*! \brief Runs all systems once with given controller input.
 \param *world The game state as a World structure.
+\param *context The simulation state belonging to the world.
 \param *buttonInput The input state as a ButtonInput structure.
 \return EventQueue structure with which animations and sound effects to play.
 */
-static EventQueue updateWorld(World *w, ButtonInput *buttonInput) {
-	eventSFX = 0; // default value
-	inputSystem(w, buttonInput);
+EventQueue updateWorld(World *w, SimContext *context, ButtonInput *buttonInput) {
+	context->eventSFX = 0; // default value
+	PROFILE_SYSTEM(ProfileInput, inputSystem(w, context, buttonInput));
 
 	u16 nextAcc;
-	nextAcc = AISystem(w, difficultyAIaccumulator);
-	difficultyAIaccumulator = nextAcc;
+	PROFILE_SYSTEM(ProfileAI, nextAcc = AISystem(w, context, context->difficultyAIaccumulator));
+	context->difficultyAIaccumulator = nextAcc;
 	
-	combatSystem(w);
-	return renderSystem(w);
+	PROFILE_SYSTEM(ProfileCombat, combatSystem(w, context));
+
+	EventQueue eventQueue;
+	PROFILE_SYSTEM(ProfileRender, eventQueue = renderSystem(w, context));
+	return eventQueue;
+}
+
+
+void initializeMatch(World *world, SimContext *context, u8 numAllies, u32 seed) {
+	// Always clear slots for entities before creating them.
+	destroyAllEntities(world);
+	context->eventSFX = 0;
+	context->difficultyAIaccumulator = 0;
+	seedRandom(&context->randomAI, seed);
+
+	u8 i;
+	for (i = 0; i < MAX_ENEMIES; ++i)
+		createEnemyChar(world, mockEnemy);
+	world->health[0].points = BOSS_HEALTH; // Last enemy gets extra health because he's a boss.
+	refreshEntityHash(world, 0);
+
+	for (i = 0; i < numAllies; ++i)
+		if (i % 2)
+			createPlayerChar(world, context, mockPlayer2, i);
+		else
+			createPlayerChar(world, context, mockPlayer1, i);
+
+	for (i = 0; i < numAllies; ++i) {
+		world->health[MAX_ENEMIES + i].points = DEFAULT_PLAYER_HEALTH; // MAX_ENEMIES is also the index of first player character.
+		refreshEntityHash(world, MAX_ENEMIES + i);
+	}
+
+	// The engine draws the starting state before the first frame (see initializeMegaDrive in main.c).
+	context->renderedSpriteSheet[0] = world->sprite[context->currentPlayer].spriteData;
+	context->renderedSpriteSheet[1] = world->sprite[world->timing[context->currentPlayer].facing].spriteData;
+	context->renderedAnimation[0] = world->move[context->currentPlayer].move;
+	context->renderedAnimation[1] = world->move[world->timing[context->currentPlayer].facing].move;
+}
+
+
+void spriteSheetsInUse(World *world, u16 drawn[2]) {
+	EntitySlot entity;
+	drawn[0] = drawn[1] = 0;
+	for (entity = nextEntityWith(world, COMPONENT_SPRITE, 0); entity < ENTITY_COUNT; entity = nextEntityWith(world, COMPONENT_SPRITE, entity + 1))
+		drawn[(world->mask[entity] & COMPONENT_TEAMMEMBER) ? 0 : 1] |= 1 << world->sprite[entity].spriteData;
 }
 
 #endif // !_MODEL_
@@ -0,0 +1,70 @@
+/*!
+\file Profile.c
+\brief System profiling file
+\date 10/2026
+
+Clock and histograms of Profile.h. Empty unless PROFILE_SYSTEMS is defined.
+*/
+
+#ifndef ECS_PROFILE
+#define ECS_PROFILE
+
+#ifdef PROFILE_SYSTEMS
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif !defined(__m68k__)
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#endif
+
+#include "../inc/Profile.h"
+
+SystemProfile systemProfile;
+
+
+u32 profileClock() {
+#if defined(__m68k__)
+	// VDP HV counter: line in the high byte, position in the line in the low byte.
+	u16 hv = *(volatile u16 *)0xC00008;
+	return (u32)(hv >> 8) * 488 + (((u32)(hv & 0xFF) * 488) >> 8);
+#elif defined(__x86_64__) || defined(__i386__)
+	return (u32)__rdtsc();
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (u32)now.tv_sec * 1000000000UL + (u32)now.tv_nsec;
+#endif
+}
+
+
+void recordSystemTime(ProfiledSystem system, u32 start) {
+	u32 end = profileClock();
+#if defined(__m68k__)
+	if (end < start)
+		end += PROFILE_FRAME_CYCLES; // The counter started over at the top of the next frame.
+#endif
+	u32 ticks = end - start; // Wraps around correctly on the host.
+
+	u8 bucket = 0;
+	for (u32 rest = ticks; rest > 1 && bucket < PROFILE_BUCKETS - 1; rest >>= 1)
+		++bucket;
+
+	systemProfile.histogram[system][bucket]++;
+	systemProfile.runs[system]++;
+	systemProfile.totalTicks[system] += ticks;
+}
+
+
+void resetSystemProfile() {
+	for (u8 system = 0; system < PROFILED_SYSTEMS; ++system) {
+		for (u8 bucket = 0; bucket < PROFILE_BUCKETS; ++bucket)
+			systemProfile.histogram[system][bucket] = 0;
+		systemProfile.runs[system] = 0;
+		systemProfile.totalTicks[system] = 0;
+	}
+}
+
+#endif // PROFILE_SYSTEMS
+
+#endif // !ECS_PROFILE
@@ -0,0 +1,68 @@
+/*!
+\file Random.c
+\brief Random number file
+\date 10/2026
+
+Deterministic random numbers for the model.
+*/
+
+#ifndef ECS_RANDOM
+#define ECS_RANDOM
+
+#include "../inc/Random.h"
+
+
+/*! Murmur3 finalizer. Spreads every bit of the input over the whole output.
+	Only used when seeding or splitting, never per frame.
+\param value Value to mix.
+\return The mixed value.
+*/
+static u32 mixRandom(u32 value) {
+	value ^= value >> 16;
+	value *= 0x85EBCA6BUL;
+	value ^= value >> 13;
+	value *= 0xC2B2AE35UL;
+	value ^= value >> 16;
+	return value;
+}
+
+
+void seedRandom(RandomStream *stream, u32 seed) {
+	stream->state = mixRandom(seed + 0x9E3779B9UL);
+	if (stream->state == 0)
+		stream->state = 1; // xorshift never leaves 0
+}
+
+
+void splitRandom(const RandomStream *parent, RandomStream *child, u32 index) {
+	seedRandom(child, parent->state ^ mixRandom(index * 0x9E3779B9UL + 1));
+}
+
+
+u16 nextRandom(RandomStream *stream) {
+	u32 state = stream->state;
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	stream->state = state;
+	return (u16)(state >> 16); // Upper half: the low bits of xorshift are the weakest.
+}
+
+
+u16 randomRange(RandomStream *stream, u16 range) {
+	return (u16)(((u32)nextRandom(stream) * range) >> 16);
+}
+
+
+void fillRandom(RandomStream *stream, u16 *values, u16 count) {
+	u32 state = stream->state;
+	for (u16 i = 0; i < count; ++i) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		values[i] = (u16)(state >> 16);
+	}
+	stream->state = state;
+}
+
+#endif // !ECS_RANDOM
@@ -0,0 +1,24 @@
+/*!
+\file SpriteDelta.c
+\brief Sprite frame delta file
+\date 10/2026
+
+Picks the delta of a change of frame, or the whole frame (see SpriteDelta.h).
+*/
+
+#include "../inc/SpriteDelta.h"
+
+
+u16 frameDelta(const SpriteDelta *delta, u16 shownAnimation, u16 shownFrame, u16 animation, u16 frame, const TileRun **run) {
+	const AnimationDelta *deltas;
+
+	if (shownFrame == DELTA_WHOLE || shownAnimation != animation || animation >= delta->numAnimation)
+		return DELTA_WHOLE;
+	if (shownFrame == frame)
+		return 0;
+	deltas = &delta->animations[animation];
+	if (frame >= deltas->numFrame || frame != ((shownFrame + 1 == deltas->numFrame) ? 0 : shownFrame + 1))
+		return DELTA_WHOLE;
+	*run = deltas->frames[frame].run;
+	return deltas->frames[frame].runs;
+}
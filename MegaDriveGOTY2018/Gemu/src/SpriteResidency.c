@@ -0,0 +1,51 @@
+/*!
+\file SpriteResidency.c
+\brief Sprite residency file
+\date 10/2026
+
+Places the resident sets of the sprite sheets in use one after the other (see SpriteResidency.h).
+*/
+
+#include "../inc/SpriteResidency.h"
+
+
+u8 planSpriteResidency(SpriteResidency *residency, TileRange area, const u8 sheetTileset[], const u16 sheetTiles[], u8 sheets,
+	const u16 drawn[RESIDENT_SPRITES]) {
+	u8 sprite, tileset, sheet;
+
+	residency->sets = 0;
+	residency->used = 0;
+	residency->area = area;
+	for (sprite = 0; sprite < RESIDENT_SPRITES; ++sprite)
+		for (tileset = 0; tileset < sheets; ++tileset) {
+			u8 uses = FALSE;
+			u16 tiles = 0;
+			// A set holds the largest frame of the sheets of its tileset the sprite draws.
+			for (sheet = 0; sheet < sheets; ++sheet)
+				if ((drawn[sprite] & (1 << sheet)) && sheetTileset[sheet] == tileset) {
+					uses = TRUE;
+					if (sheetTiles[sheet] > tiles)
+						tiles = sheetTiles[sheet];
+				}
+			if (!uses)
+				continue;
+			if (residency->sets == RESIDENT_SETS || residency->used + tiles > area.count)
+				return FALSE;
+			residency->set[residency->sets].sprite = sprite;
+			residency->set[residency->sets].tileset = tileset;
+			residency->set[residency->sets].tiles.first = area.first + residency->used;
+			residency->set[residency->sets].tiles.count = tiles;
+			++residency->sets;
+			residency->used += tiles;
+		}
+	return TRUE;
+}
+
+
+u8 findResidentSet(const SpriteResidency *residency, u8 sprite, u8 tileset) {
+	u8 i;
+	for (i = 0; i < residency->sets; ++i)
+		if (residency->set[i].sprite == sprite && residency->set[i].tileset == tileset)
+			return i;
+	return RESIDENT_NONE;
+}
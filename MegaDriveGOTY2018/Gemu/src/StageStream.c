@@ -0,0 +1,122 @@
+/*!
+\file StageStream.c
+\brief Stage streaming file
+\date 10/2026
+
+Plans the upload of the next stage's backgrounds into VRAM, chunk by chunk (see StageStream.h).
+*/
+
+#ifndef STAGE_STREAM
+#define STAGE_STREAM
+
+#include "../inc/StageStream.h"
+
+
+static u16 lowest(u16 a, u16 b) {
+	return (a < b) ? a : b;
+}
+
+static u16 highest(u16 a, u16 b) {
+	return (a > b) ? a : b;
+}
+
+
+/*! Adds a part at the end of a stream, unless it is empty. */
+static void addPart(StageStream *stream, StreamPartType type, u8 plane, u8 hidden, u16 first, u16 count, u16 destination) {
+	if (count == 0)
+		return;
+	StreamChunk *part = &stream->part[stream->parts++];
+	part->type = type;
+	part->plane = plane;
+	part->hidden = hidden;
+	part->first = first;
+	part->count = count;
+	part->destination = destination;
+}
+
+
+/*! Adds the tiles of an image: the ones on tiles of the shown stage if 'hidden', the others if not. */
+static void addTiles(StageStream *stream, u8 plane, u16 tiles, TileRange shown, u8 hidden) {
+	u16 first = stream->tileBase[plane], end = first + tiles;
+	u16 low = highest(first, shown.first), high = lowest(end, shown.first + shown.count);
+
+	if (low >= high) { // Shares no tile with the shown stage.
+		if (!hidden)
+			addPart(stream, StreamTiles, plane, FALSE, 0, tiles, first);
+	}
+	else if (hidden)
+		addPart(stream, StreamTiles, plane, TRUE, low - first, high - low, low);
+	else {
+		addPart(stream, StreamTiles, plane, FALSE, 0, low - first, first);
+		addPart(stream, StreamTiles, plane, FALSE, high - first, end - high, high);
+	}
+}
+
+
+u8 planStageStream(StageStream *stream, TileRange area, TileRange shown, const StreamImage images[STREAM_PLANES]) {
+	u16 tiles = 0;
+	u8 plane;
+
+	for (plane = 0; plane < STREAM_PLANES; ++plane)
+		tiles += images[plane].tiles;
+	if (tiles > area.count)
+		return FALSE;
+
+	// Away from the shown stage: at the high end if it is closer to the low end, and the other way around.
+	stream->tiles.count = tiles;
+	if ((s32)shown.first - area.first <= (s32)(area.first + area.count) - (shown.first + shown.count))
+		stream->tiles.first = area.first + area.count - tiles;
+	else
+		stream->tiles.first = area.first;
+
+	stream->parts = stream->current = 0;
+	stream->done = 0;
+	tiles = stream->tiles.first;
+	for (plane = 0; plane < STREAM_PLANES; ++plane) {
+		stream->tileBase[plane] = tiles;
+		stream->rowBytes[plane] = images[plane].rowBytes;
+		tiles += images[plane].tiles;
+	}
+
+	// What can be uploaded with the shown stage on screen first, then the rest, then the tilemaps drawn over the shown ones.
+	for (plane = 0; plane < STREAM_PLANES; ++plane)
+		addTiles(stream, plane, images[plane].tiles, shown, FALSE);
+	for (plane = 0; plane < STREAM_PLANES; ++plane)
+		addTiles(stream, plane, images[plane].tiles, shown, TRUE);
+	for (plane = 0; plane < STREAM_PLANES; ++plane)
+		addPart(stream, StreamRows, plane, TRUE, 0, images[plane].rows, 0);
+	return TRUE;
+}
+
+
+u16 nextStreamChunk(StageStream *stream, u8 hidden, u16 budget, StreamChunk *chunk) {
+	if (isStreamDone(stream))
+		return 0;
+
+	const StreamChunk *part = &stream->part[stream->current];
+	if (part->hidden && !hidden)
+		return 0;
+
+	u16 unit = (part->type == StreamTiles) ? STREAM_TILE_BYTES : stream->rowBytes[part->plane];
+	u16 count = lowest(part->count - stream->done, budget / unit);
+	if (count == 0)
+		return 0;
+
+	*chunk = *part;
+	chunk->first += stream->done;
+	chunk->destination += stream->done;
+	chunk->count = count;
+	stream->done += count;
+	if (stream->done == part->count) {
+		++stream->current;
+		stream->done = 0;
+	}
+	return count * unit;
+}
+
+
+u8 isStreamDone(const StageStream *stream) {
+	return stream->current >= stream->parts;
+}
+
+#endif // !STAGE_STREAM
@@ -11,208 +11,289 @@ Systems file of the ECS architecture.
 #define ECS_SYSTEMS
 
 #include "../inc/Systems.h"
+#include "../inc/Timers.h"
 
 // Forwarding helper (private) functions
 
-static u8 timedRight(World *world, u8 entity);
-static u8 isAttacking(World *world, u8 entity);
-static void setMove(World *world, u8 entity, u8 move);
-static u8 searchForNextPlayerCharacter(World *world, u8 entity);
-static void DoIdle(World *world, u8 entity);
-static void DoBasicAttack(World *world, u8 entity);
-static void DoSpecialAttack(World *world, u8 entity);
-static void DoCharacterSwitch(World *world, u8 entity);
-static void DoParry(World *world, u8 entity);
-static void DoGuard(World *world, u8 entity);
-//static void DoEvade(World *world, u8 entity); // unused
-static void DealDamage(World *world, u8 entity, u8 damage, u8 isFatal);
+static u8 combatTurn(World *world, SimContext *context, EntitySlot entity);
+static void addRenderCommand(EventQueue *eventQueue, RenderCommandType type, u8 sprite, u8 value);
+static u8 timedRight(World *world, EntitySlot entity);
+static u8 isAttacking(World *world, EntitySlot entity);
+static void setMove(World *world, EntitySlot entity, u8 move);
+static EntitySlot searchForNextPlayerCharacter(World *world, EntitySlot entity);
+static EntitySlot searchForNextEnemy(World *world, EntitySlot entity);
+static void DoIdle(World *world, EntitySlot entity);
+static void DoBasicAttack(World *world, SimContext *context, EntitySlot entity);
+static void DoSpecialAttack(World *world, SimContext *context, EntitySlot entity);
+static void DoCharacterSwitch(World *world, SimContext *context, EntitySlot entity);
+static void DoParry(World *world, EntitySlot entity);
+static void DoGuard(World *world, EntitySlot entity);
+//static void DoEvade(World *world, EntitySlot entity); // unused
+static void DealDamage(World *world, EntitySlot entity, u8 damage, u8 isFatal);
 
 
 // Primary system functions
 
-void inputSystem(World *world, ButtonInput *buttonInput) {
-	if (world->move[currentPlayer].move == Dying || world->move[world->timing[currentPlayer].facing].move == Dying)
+void inputSystem(World *world, SimContext *context, ButtonInput *buttonInput) {
+	EntitySlot opponent = facedEntity(world, context->currentPlayer);
+	if (world->move[context->currentPlayer].move == Dying || opponent == ENTITY_NONE || world->move[opponent].move == Dying)
 		return;
 
 	if (buttonInput->isPressed == TRUE) {
 		switch (buttonInput->latestButtonPress)
 		{
 		case A:
-			DoBasicAttack(world, currentPlayer);
+			DoBasicAttack(world, context, context->currentPlayer);
 			break;
 
 		case B:
-			DoSpecialAttack(world, currentPlayer);
+			DoSpecialAttack(world, context, context->currentPlayer);
 			break;
 
 		case C:
-			DoCharacterSwitch(world, currentPlayer);
+			DoCharacterSwitch(world, context, context->currentPlayer);
 			break;
 
 		case Up:
-			DoParry(world, currentPlayer);
+			DoParry(world, context->currentPlayer);
 			break;
 
 		case Down:
-			DoGuard(world, currentPlayer);
+			DoGuard(world, context->currentPlayer);
 			break;
 
 			//case Left:
-			//	DoEvade(world, currentPlayer);
+			//	DoEvade(world, context->currentPlayer);
 			//	break;
 
 			//case Right:
-			//	DoEvade(world, currentPlayer);
+			//	DoEvade(world, context->currentPlayer);
 			//	break;
 
 		case Left: case Right: default:
 			break;
 		}
 	}
-	else if (world->move[currentPlayer].move == Guarding) // release guard
-		DoIdle(world, currentPlayer);
+	else if (world->move[context->currentPlayer].move == Guarding) // release guard
+		DoIdle(world, context->currentPlayer);
 }
 
 
 
-u16 AISystem(World *world, u16 difficulty) {
+u16 AISystem(World *world, SimContext *context, u16 difficulty) {
 	// Note: The AI is not built through test-driven development. Therefore it has no unit-tests.
 
 	// AI either makes no decision or the correct decision.
 	if (difficulty < 100)
 		return difficulty;
 
-	u8 AIentity = world->timing[currentPlayer].facing;
+	EntitySlot AIentity = facedEntity(world, context->currentPlayer);
+	if (AIentity == ENTITY_NONE)
+		return 0; // No opponent to move.
 
-	randSGDK %= 3; // Have a 2/3 chance to be true, 1/3 to be false.
+	u16 decision = randomRange(&context->randomAI, 3); // Have a 2/3 chance to be true, 1/3 to be false.
 
-	if (world->move[AIentity].move == Dying || world->move[currentPlayer].move == Dying)
+	if (world->move[AIentity].move == Dying || world->move[context->currentPlayer].move == Dying)
 		return 0; // Do nothing if dying
 
 	// If player is staggered, attack.
-	if (world->move[currentPlayer].move == Staggered) {
-		if (randSGDK)
-			DoSpecialAttack(world, AIentity);
+	if (world->move[context->currentPlayer].move == Staggered) {
+		if (decision)
+			DoSpecialAttack(world, context, AIentity);
 		else
-			DoBasicAttack(world, AIentity);
+			DoBasicAttack(world, context, AIentity);
 	}
 
-	else	if (world->move[AIentity].move == Guarding && world->timing[AIentity].frames > PARRY_FRAMES)
+	else	if (world->move[AIentity].move == Guarding && entityFrames(world, AIentity) > PARRY_FRAMES)
 		DoIdle(world, AIentity); // Stop guarding if player is vulnerable post-parrying.
 
 
-	else	if (isAttacking(world, currentPlayer)) {
-		if (world->timing[currentPlayer].frames >= (ATTACK_FRAMES - 4)) {
-			if (randSGDK)
+	else	if (isAttacking(world, context->currentPlayer)) {
+		if (entityFrames(world, context->currentPlayer) >= (ATTACK_FRAMES - 4)) {
+			if (decision)
 				DoParry(world, AIentity);
 			else
 				DoGuard(world, AIentity);
 		}
 	}
 
-	else 	if (world->move[currentPlayer].move == Guarding)
-		DoSpecialAttack(world, AIentity);	// Shave off 1 HP when player is guarding.
+	else 	if (world->move[context->currentPlayer].move == Guarding)
+		DoSpecialAttack(world, context, AIentity);	// Shave off 1 HP when player is guarding.
 
 	else { // If in doubt, guard or attack.
-		if (randSGDK)
-			DoBasicAttack(world, AIentity);
+		if (decision)
+			DoBasicAttack(world, context, AIentity);
 		else
 			DoGuard(world, AIentity);
 	}
 
-	return (difficulty + (randSGDK * difficulty)) % 100;
+	return (difficulty + (decision * difficulty)) % 100;
 }
 
 
 
-void combatSystem(World *world) {
-	for (u8 entity = 0; entity < ENTITY_COUNT; ++entity)
+void combatSystem(World *world, SimContext *context) {
+#ifdef ECS_TIMER_WHEEL
+	// Only visit entities with a timer due: the others would only count, which their timers do.
+	startTimerFrame(world);
+	for (EntitySlot entity = nextTimedEntity(world); entity < ENTITY_COUNT; entity = nextTimedEntity(world))
 	{
-		if (world->health[entity].staggered > 0)
+		countTimedStagger(world, entity);
+		if (combatTurn(world, context, entity)) {
+			stopTimerFrame(world);
+			return;
+		}
+	}
+#else
+	// Idle, unstaggered entities would be left unchanged: only visit busy ones.
+	// Destroyed entities that are still busy are visited as before, e.g. to finish dying.
+	for (EntitySlot entity = nextEntityWith(world, ENTITY_BUSY, 0); entity < ENTITY_COUNT; entity = nextEntityWith(world, ENTITY_BUSY, entity + 1))
+	{
+		if (world->health[entity].staggered > 0) {
 			world->health[entity].staggered--;
+			refreshBusyEntity(world, entity);
+		}
+		if (combatTurn(world, context, entity))
+			return; // Don't loop over entities anymore.
+	}
+#endif
+}
+
+
+EventQueue renderSystem(World *world, SimContext *context) {
+	EventQueue eventQueue;
+	EntitySlot drawn[2] = { context->currentPlayer, facedEntity(world, context->currentPlayer) };
+	u8 i, sprites = (drawn[1] != ENTITY_NONE) ? 2 : 1;
+	eventQueue.commands = 0;
+
+	// Only send what changed since the last frame. Sprite sheets first: changing one redraws the sprites.
+	for (i = 0; i < sprites; ++i)
+		if (world->sprite[drawn[i]].spriteData != context->renderedSpriteSheet[i]) {
+			context->renderedSpriteSheet[i] = world->sprite[drawn[i]].spriteData;
+			addRenderCommand(&eventQueue, RenderSpriteSheet, i, context->renderedSpriteSheet[i]);
+		}
+	for (i = 0; i < sprites; ++i)
+		if (world->move[drawn[i]].move != context->renderedAnimation[i]) {
+			context->renderedAnimation[i] = world->move[drawn[i]].move;
+			addRenderCommand(&eventQueue, RenderAnimation, i, context->renderedAnimation[i]);
+		}
+
+	if (context->eventSFX != 0)
+		addRenderCommand(&eventQueue, RenderSFX, 0, context->eventSFX);
+	context->eventSFX = 0; // Set to not SFX for next frame.
+	return eventQueue;
+}
 
-		// If move finished, set character as idle.
-		if (isAttacking(world, entity) && world->timing[entity].frames > (ATTACK_FRAMES + FOLLOWUP_FRAMES))
-			DoIdle(world, entity);
-		if (world->move[entity].move == Parrying && world->timing[entity].frames > (PARRY_FRAMES + FOLLOWUP_FRAMES))
-			DoIdle(world, entity);
-		if (world->move[entity].move == Staggered && world->health[entity].staggered == 0)
-			DoIdle(world, entity);
-
-		// If idle, don't increase frame count.
-		if (world->move[entity].move == Idling || world->move[entity].move == Staggered)
-			continue;
-		world->timing[entity].frames++;
-
-		// If an attack lands this frame
-		if (world->timing[entity].frames == ATTACK_FRAMES && isAttacking(world, entity)) {
-			// Attempt to hit
-
-			// Guarding
-			if (world->move[world->timing[entity].facing].move == Guarding) {
-				eventSFX = SFX_PARRYGUARD;
-				if (world->timing[world->timing[entity].facing].frames > (PARRY_FRAMES / 2)) {
-					if (world->move[entity].move == B1)
-						DealDamage(world, world->timing[entity].facing, 2, FALSE); // Heavy Attacks deal extra damage to guards.
-					else
-						DealDamage(world, world->timing[entity].facing, 1, FALSE); // Normal guard
-				}
-				continue;
-			}
 
-			// Parrying
-			if (world->move[world->timing[entity].facing].move == Parrying)
-				if (world->timing[world->timing[entity].facing].frames < PARRY_FRAMES) {
-					eventSFX = SFX_PARRYGUARD;
-					world->health[entity].staggered = STAGGERED_FRAMES + 8;
-					world->move[entity].move = Staggered;
-					world->timing[entity].frames = 0;
-					continue;
-				}
-
-			// Clean hit
-			DealDamage(world, world->timing[entity].facing, 4, TRUE);
-			eventSFX = SFX_HIT;
-			if (world->health[world->timing[entity].facing].points == 0)
-				setMove(world, world->timing[entity].facing, Dying);
-			else {
-				world->move[world->timing[entity].facing].move = Staggered;
-				world->health[world->timing[entity].facing].staggered = STAGGERED_FRAMES;
+// Static (private) helper functions
+
+/*! Runs the combat system on one busy entity, after its 'staggered' counted down.
+
+	Ends moves that are over, counts 'frames' of the moves still playing, lands hits and finishes deaths.
+\param *world The game state as a World structure.
+\param *context The simulation state belonging to the world.
+\param entity The busy entity slot.
+\return 1 (TRUE) if a character finished dying: the combat system visits no other entity this frame.
+*/
+static u8 combatTurn(World *world, SimContext *context, EntitySlot entity) {
+	// If move finished, set character as idle.
+	if (isAttacking(world, entity) && entityFrames(world, entity) > (ATTACK_FRAMES + FOLLOWUP_FRAMES))
+		DoIdle(world, entity);
+	if (world->move[entity].move == Parrying && entityFrames(world, entity) > (PARRY_FRAMES + FOLLOWUP_FRAMES))
+		DoIdle(world, entity);
+	if (world->move[entity].move == Staggered && entityStaggered(world, entity) == 0)
+		DoIdle(world, entity);
+
+	// If idle, don't increase frame count.
+	if (world->move[entity].move == Idling || world->move[entity].move == Staggered)
+		return FALSE;
+#ifdef ECS_TIMER_WHEEL
+	countTimedFrame(world, entity);
+#else
+	world->timing[entity].frames++;
+	refreshEntityFrame(world, entity);
+#endif
+
+	// If an attack lands this frame
+	if (entityFrames(world, entity) == ATTACK_FRAMES && isAttacking(world, entity)) {
+		// Attempt to hit
+		EntitySlot opponent = facedEntity(world, entity);
+		if (opponent == ENTITY_NONE)
+			return FALSE; // Opponent destroyed since: nobody to hit.
+
+		// Guarding
+		if (world->move[opponent].move == Guarding) {
+			context->eventSFX = SFX_PARRYGUARD;
+			if (entityFrames(world, opponent) > (PARRY_FRAMES / 2)) {
+				if (world->move[entity].move == B1)
+					DealDamage(world, opponent, 2, FALSE); // Heavy Attacks deal extra damage to guards.
+				else
+					DealDamage(world, opponent, 1, FALSE); // Normal guard
 			}
+			return FALSE;
 		}
 
-		// Character finished dying animation -> switch char / end game
-		if (world->move[entity].move == Dying && world->timing[entity].frames == DEATH_FRAMES)
-		{
-			if (entity == currentPlayer)	 return; // Dev kit project will react at Game Over
-			if (entity == 0) return; // Dev Kit project will react appropriately at Stage Clear.
+		// Parrying
+		if (world->move[opponent].move == Parrying)
+			if (entityFrames(world, opponent) < PARRY_FRAMES) {
+				context->eventSFX = SFX_PARRYGUARD;
+				setEntityStaggered(world, entity, STAGGERED_FRAMES + 8);
+				world->move[entity].move = Staggered;
+				setEntityFrames(world, entity, 0);
+				refreshBusyEntity(world, entity);
+				return FALSE;
+			}
 
-			destroyEntity(world, entity);
-			entity = --world->timing[currentPlayer].facing;
-			DoIdle(world, entity);
-			world->timing[entity].facing = currentPlayer;
-			return; // Don't loop over entities anymore.
+		// Clean hit
+		DealDamage(world, opponent, 4, TRUE);
+		context->eventSFX = SFX_HIT;
+		if (world->health[opponent].points == 0)
+			setMove(world, opponent, Dying);
+		else {
+			world->move[opponent].move = Staggered;
+			setEntityStaggered(world, opponent, STAGGERED_FRAMES);
+			refreshBusyEntity(world, opponent);
 		}
 	}
 
+	// Character finished dying animation -> switch char / end game
+	if (world->move[entity].move == Dying && entityFrames(world, entity) == DEATH_FRAMES)
+	{
+		if (entity == context->currentPlayer)	 return TRUE; // Dev kit project will react at Game Over
+		if (entity == 0) return TRUE; // Dev Kit project will react appropriately at Stage Clear.
+
+		// Only the death of the opponent of the current player brings the next one. Reserve characters can die too.
+		u8 faced = (facedEntity(world, context->currentPlayer) == entity);
+		destroyEntity(world, entity);
+		if (!faced)
+			return TRUE;
+		entity = searchForNextEnemy(world, entity);
+		setFacing(world, context->currentPlayer, entity);
+		refreshEntityHash(world, context->currentPlayer);
+		DoIdle(world, entity);
+		setFacing(world, entity, context->currentPlayer);
+		refreshEntityHash(world, entity);
+		return TRUE; // Don't loop over entities anymore.
+	}
+	return FALSE;
 }
 
 
-EventQueue renderSystem(World *world) {
-	EventQueue eventQueue;
-	eventQueue.sfx = eventSFX;
-	eventSFX = 0; // Set to not SFX for next frame.
-
-	eventQueue.animation[0] = world->move[currentPlayer].move;
-	eventQueue.animation[1] = world->move[world->timing[currentPlayer].facing].move;
-	eventQueue.spriteSheet[0] = world->move[currentPlayer].spriteData;
-	eventQueue.spriteSheet[1] = world->move[world->timing[currentPlayer].facing].spriteData;
-	return eventQueue;
+/*! Adds a command at the end of an EventQueue.
+\param *eventQueue The EventQueue.
+\param type What the command changes.
+\param sprite Which sprite it changes.
+\param value The new sprite sheet, animation or sound effect ID.
+\return void
+*/
+static void addRenderCommand(EventQueue *eventQueue, RenderCommandType type, u8 sprite, u8 value) {
+	RenderCommand *command = &eventQueue->command[eventQueue->commands++];
+	command->type = type;
+	command->sprite = sprite;
+	command->value = value;
 }
 
 
-// Static (private) helper functions
-
 /*! Returns 1 (TRUE) if the entity can chain a previous attack into another attack.
 
 	When attacking, some frames have to play before the hit lands.
@@ -223,8 +304,8 @@ EventQueue renderSystem(World *world) {
 	\param entity Entity slot attempting to chain attack.
 	\return 1 (TRUE) if the entity can chain a previous attack into another attack.
 	*/
-static u8 timedRight(World *world, u8 entity) {
-	if (ATTACK_FRAMES < world->timing[entity].frames && world->timing[entity].frames < (ATTACK_FRAMES + FOLLOWUP_FRAMES))
+static u8 timedRight(World *world, EntitySlot entity) {
+	if (ATTACK_FRAMES < entityFrames(world, entity) && entityFrames(world, entity) < (ATTACK_FRAMES + FOLLOWUP_FRAMES))
 		return TRUE;
 	return FALSE;
 }
@@ -235,7 +316,7 @@ static u8 timedRight(World *world, u8 entity) {
 	\param entity Entity in question.
 	\return 1 (TRUE) if the entity is currently attacking
 */
-static u8 isAttacking(World *world, u8 entity) {
+static u8 isAttacking(World *world, EntitySlot entity) {
 	switch (world->move[entity].move)
 	{
 	case Idling: case Guarding: case Parrying: case Staggered: case Dying:
@@ -252,9 +333,10 @@ static u8 isAttacking(World *world, u8 entity) {
 \param move A move set by the AttackType enumeration.
 \return void
 */
-static void setMove(World *world, u8 entity, u8 move) {
-	world->timing[entity].frames = 0;
+static void setMove(World *world, EntitySlot entity, u8 move) {
+	setEntityFrames(world, entity, 0);
 	world->move[entity].move = move;
+	refreshBusyEntity(world, entity);
 }
 
 
@@ -263,21 +345,34 @@ static void setMove(World *world, u8 entity, u8 move) {
 \param entity The entity slot of the current player character.
 \return The entity slot in the World structure of the next playable character.
 */
-static u8 searchForNextPlayerCharacter(World *world, u8 entity) {
+static EntitySlot searchForNextPlayerCharacter(World *world, EntitySlot entity) {
 	// If not last reserve character, pick next character in line.
 	if (world->teamMember[entity + 1].id == (world->teamMember[entity].id + 1))
 		if (world->mask[entity + 1] != COMPONENT_NONE)
 			return (entity + 1);
 
 	// If last reserve character, rotate and pick first character.
-	for (u8 iterator = entity; entity > 0; iterator--) {
+	for (EntitySlot iterator = entity; entity > 0; iterator--) {
 		if (iterator == 1)
 			return 1;
 		if (world->teamMember[iterator].id == 0)
 			return iterator;
 	}
 
-	return 255; // Failure
+	return ENTITY_NONE; // Failure
+}
+
+
+/*! Finds the enemy that comes after a dead one: the next live enemy down the slots.
+\param *world The game state as a World structure.
+\param entity The slot of the dead enemy, above 0.
+\return The slot of the next enemy. The boss in slot 0 is alive until the stage is cleared.
+*/
+static EntitySlot searchForNextEnemy(World *world, EntitySlot entity) {
+	while (--entity > 0)
+		if (world->mask[entity] != COMPONENT_NONE && !(world->mask[entity] & COMPONENT_TEAMMEMBER))
+			return entity;
+	return 0;
 }
 
 
@@ -286,20 +381,24 @@ static u8 searchForNextPlayerCharacter(World *world, u8 entity) {
 \param entity The entity to idle.
 \return void
 */
-static void DoIdle(World *world, u8 entity) {
+static void DoIdle(World *world, EntitySlot entity) {
 	world->move[entity].move = Idling;
-	world->timing[entity].frames = 0;
+	setEntityFrames(world, entity, 0);
+	refreshBusyEntity(world, entity);
 }
 
 
 /*! Has the entity perform a basic attack.
 \param *world The game state as a World structure.
+\param *context The simulation state belonging to the world.
 \param entity The entity slot to initiate an attack.
 \return void
 */
-static void DoBasicAttack(World *world, u8 entity) {
-	if (world->move[entity].move == Idling)
+static void DoBasicAttack(World *world, SimContext *context, EntitySlot entity) {
+	if (world->move[entity].move == Idling) {
 		world->move[entity].move = A1;
+		refreshBusyEntity(world, entity);
+	}
 	else if (timedRight(world, entity) && isAttacking(world, entity)) {
 		switch (world->move[entity].move)
 		{
@@ -316,21 +415,24 @@ static void DoBasicAttack(World *world, u8 entity) {
 		}
 	}
 
-	if (world->timing[entity].frames == 0 && isAttacking(world, entity))
-		eventSFX = SFX_SWING;
+	if (entityFrames(world, entity) == 0 && isAttacking(world, entity))
+		context->eventSFX = SFX_SWING;
 }
 
 
 /*! Has the entity perform a special attack. Type depends on previous basic attacks, if any.
 \param *world The game state as a World structure.
+\param *context The simulation state belonging to the world.
 \param entity The entity slot to initiate an attack.
 \return void
 */
-static void DoSpecialAttack(World *world, u8 entity) {
-	if (world->move[entity].move == Idling)
+static void DoSpecialAttack(World *world, SimContext *context, EntitySlot entity) {
+	if (world->move[entity].move == Idling) {
 		world->move[entity].move = B1; // Heavy
+		refreshBusyEntity(world, entity);
+	}
 	else if (timedRight(world, entity) && isAttacking(world, entity)) {
-		eventSFX = SFX_SWING;
+		context->eventSFX = SFX_SWING;
 		switch (world->move[entity].move)
 		{
 		case A1:
@@ -346,36 +448,41 @@ static void DoSpecialAttack(World *world, u8 entity) {
 		}
 	}
 
-	if (world->timing[entity].frames == 0 && isAttacking(world, entity))
-		eventSFX = SFX_SWING;
+	if (entityFrames(world, entity) == 0 && isAttacking(world, entity))
+		context->eventSFX = SFX_SWING;
 }
 
 
 /*! Switches to the next player character if possible (player characters only)
 \param *world The game state as a World structure.
+\param *context The simulation state belonging to the world.
 \param entity Entity slot of the current player character.
 \return void
 */
-static void DoCharacterSwitch(World *world, u8 entity) {
+static void DoCharacterSwitch(World *world, SimContext *context, EntitySlot entity) {
 	// Search for the next available player character
-	u8 nextChar = searchForNextPlayerCharacter(world, entity);
+	EntitySlot nextChar = searchForNextPlayerCharacter(world, entity);
 
 	// Only do something if there's a reserve player character.
 	if (world->teamMember[entity].id != world->teamMember[nextChar].id) {
 		if (world->move[entity].move == Idling) {
 			DoIdle(world, nextChar);
-			world->health[nextChar].staggered = STAGGERED_FRAMES;
+			setEntityStaggered(world, nextChar, STAGGERED_FRAMES);
 			world->move[nextChar].move = Staggered;
 		}
 		else if (timedRight(world, entity) && world->move[entity].move == B2)
 			world->move[nextChar].move = A3; // Chain Attack into Character Switch.
 		else
 			return; // If occupied, character cannot switch.
+		refreshBusyEntity(world, nextChar);
 		world->teamMember[entity].isActive = FALSE;
 		world->teamMember[nextChar].isActive = TRUE;
-		world->timing[nextChar].frames = 0;
+		setEntityFrames(world, nextChar, 0);
 		world->timing[nextChar].facing = world->timing[entity].facing;
-		currentPlayer = nextChar;
+		world->timing[nextChar].facingGeneration = world->timing[entity].facingGeneration;
+		refreshEntityHash(world, entity);
+		refreshEntityHash(world, nextChar);
+		context->currentPlayer = nextChar;
 	}
 }
 
@@ -385,9 +492,11 @@ static void DoCharacterSwitch(World *world, u8 entity) {
 \param entity The entity to parry.
 \return void
 */
-static void DoParry(World *world, u8 entity) {
-	if (world->move[entity].move == Idling)
+static void DoParry(World *world, EntitySlot entity) {
+	if (world->move[entity].move == Idling) {
 		world->move[entity].move = Parrying;
+		refreshBusyEntity(world, entity);
+	}
 }
 
 
@@ -396,9 +505,11 @@ static void DoParry(World *world, u8 entity) {
 \param entity Entity to guard.
 \return void
 */
-static void DoGuard(World *world, u8 entity) {
-	if (world->move[entity].move == Idling)
+static void DoGuard(World *world, EntitySlot entity) {
+	if (world->move[entity].move == Idling) {
 		world->move[entity].move = Guarding;
+		refreshBusyEntity(world, entity);
+	}
 }
 
 
@@ -407,7 +518,7 @@ static void DoGuard(World *world, u8 entity) {
 ////\param entity affected entity
 ////\return void
 ////*/
-////static void DoEvade(World *world, u8 entity) { };
+////static void DoEvade(World *world, EntitySlot entity) { };
 
 
 /*! Deals damage dealt to an enemy and determines fatality.
@@ -420,11 +531,12 @@ static void DoGuard(World *world, u8 entity) {
 \param isFatal set to 1 (TRUE) if the blow can defeat the entity.
 \return void
 */
-static void DealDamage(World *world, u8 entity, u8 damage, u8 isFatal) {
+static void DealDamage(World *world, EntitySlot entity, u8 damage, u8 isFatal) {
 	if (world->health[entity].points > damage)
 		world->health[entity].points -= damage;
 	else
 		world->health[entity].points = (isFatal) ? 0 : 1;
+	refreshEntityHash(world, entity);
 }
 
 #endif // !ECS_SYSTEMS
\ No newline at end of file
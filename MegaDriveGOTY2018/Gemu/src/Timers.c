@@ -0,0 +1,369 @@
+/*!
+\file Timers.c
+\brief Entity timer file
+\date 10/2026
+
+Timer wheel of the busy entities (see Timers.h and EntityTimers in Entities.h). Empty unless ECS_TIMER_WHEEL is defined.
+*/
+
+#ifndef ECS_TIMERS
+#define ECS_TIMERS
+
+#ifdef ECS_TIMER_WHEEL
+
+#include "../inc/Timers.h"
+
+static void addToSet(u32 *set, EntitySlot entity) {
+	set[entity >> 5] |= 1UL << (entity & 31);
+}
+
+static void removeFromSet(u32 *set, EntitySlot entity) {
+	set[entity >> 5] &= ~(1UL << (entity & 31));
+}
+
+/*! Returns TRUE if 'frames' of the entity has yet to count in the current frame of combatSystem. */
+static u8 framePending(const World *world, EntitySlot entity) {
+	const EntityTimers *timers = &world->timers;
+	return entity > timers->cursor || (entity == timers->cursor && timers->phase < TimerFrameCounted);
+}
+
+/*! Returns TRUE if 'staggered' of the entity has yet to count in the current frame of combatSystem. */
+static u8 staggerPending(const World *world, EntitySlot entity) {
+	const EntityTimers *timers = &world->timers;
+	return entity > timers->cursor || (entity == timers->cursor && timers->phase < TimerStaggerCounted);
+}
+
+/*! Returns TRUE if an entity with this move counts 'frames'. */
+static u8 countsFrames(u8 move) {
+	return move != Idling && move != Staggered;
+}
+
+
+// Starting and stopping counts. Keeps the sums of the world hash (see worldHash).
+
+static void startFrames(World *world, EntitySlot entity, u32 start) {
+	addToSet(world->timers.running, entity);
+	world->timers.frameStart[entity] = start;
+#ifdef ECS_WORLD_HASH
+	world->timers.runningKeys += frameKey(entity);
+	world->timers.runningStarts += frameKey(entity) * start;
+#endif
+}
+
+static void stopFrames(World *world, EntitySlot entity) {
+	removeFromSet(world->timers.running, entity);
+#ifdef ECS_WORLD_HASH
+	world->timers.runningKeys -= frameKey(entity);
+	world->timers.runningStarts -= frameKey(entity) * world->timers.frameStart[entity];
+#endif
+}
+
+static void startStagger(World *world, EntitySlot entity, u32 end) {
+	addToSet(world->timers.counting, entity);
+	world->timers.staggerEnd[entity] = end;
+#ifdef ECS_WORLD_HASH
+	world->timers.countingKeys += staggerKey(entity);
+	world->timers.countingEnds += staggerKey(entity) * end;
+#endif
+}
+
+static void stopStagger(World *world, EntitySlot entity) {
+	removeFromSet(world->timers.counting, entity);
+#ifdef ECS_WORLD_HASH
+	world->timers.countingKeys -= staggerKey(entity);
+	world->timers.countingEnds -= staggerKey(entity) * world->timers.staggerEnd[entity];
+#endif
+}
+
+
+// The wheel and the queue.
+
+static void linkTimer(EntityTimers *timers, EntitySlot entity) {
+	EntitySlot *first = &timers->slot[timers->due[entity] & (TIMER_SLOTS - 1)];
+	timers->previous[entity] = ENTITY_NONE;
+	timers->next[entity] = *first;
+	if (*first != ENTITY_NONE)
+		timers->previous[*first] = entity;
+	*first = entity;
+}
+
+static void unlinkTimer(EntityTimers *timers, EntitySlot entity) {
+	EntitySlot previous = timers->previous[entity], next = timers->next[entity];
+	if (previous != ENTITY_NONE)
+		timers->next[previous] = next;
+	else
+		timers->slot[timers->due[entity] & (TIMER_SLOTS - 1)] = next;
+	if (next != ENTITY_NONE)
+		timers->previous[next] = previous;
+}
+
+static void pushQueue(EntityTimers *timers, EntitySlot entity) {
+	u32 child = timers->queueLength++;
+	for (; child > 0 && timers->queue[(child - 1) / 2] > entity; child = (child - 1) / 2)
+		timers->queue[child] = timers->queue[(child - 1) / 2];
+	timers->queue[child] = entity;
+	addToSet(timers->queued, entity);
+}
+
+static EntitySlot popQueue(EntityTimers *timers) {
+	EntitySlot first = timers->queue[0], last = timers->queue[--timers->queueLength];
+	u32 parent = 0, child;
+	while ((child = 2 * parent + 1) < timers->queueLength) {
+		if (child + 1 < timers->queueLength && timers->queue[child + 1] < timers->queue[child])
+			++child;
+		if (timers->queue[child] >= last)
+			break;
+		timers->queue[parent] = timers->queue[child];
+		parent = child;
+	}
+	timers->queue[parent] = last;
+	removeFromSet(timers->queued, first);
+	return first;
+}
+
+/*! Returns the lowest of two frames, TIMER_NEVER being above every frame. */
+static u32 earliest(u32 a, u32 b) {
+	return (a < b) ? a : b;
+}
+
+/*! Returns the first frame, from 'first' on, at which an entity whose 'frames' counts to 'frames' at 'first'
+	has more than 'limit' frames before counting: the frame a move that lasts 'limit' frames ends at. */
+static u32 framesAbove(u32 first, u16 frames, u16 limit) {
+	if ((u16)(frames - 1) > limit)
+		return first;
+	return first + limit + 2 - frames;
+}
+
+/*! Returns the next frame at which combatSystem has to visit an entity, or TIMER_NEVER.
+	The entity is visited at every frame at which, when counting, one of the conditions of combatSystem
+	on 'frames' or 'staggered' holds, and at every frame its 'frames' wraps around to 0. */
+static u32 nextTimer(const World *world, EntitySlot entity) {
+	const EntityTimers *timers = &world->timers;
+	u32 first = timers->clock + !framePending(world, entity); // Next frame at which it counts.
+	u8 move = world->move[entity].move;
+	u32 due = TIMER_NEVER;
+
+	if (entityInSet(timers->counting, entity))
+		due = timers->staggerEnd[entity];
+	else if (move == Staggered)
+		due = first; // Goes idle.
+
+	if (entityInSet(timers->running, entity)) {
+		u16 frames = (u16)(first - timers->frameStart[entity]); // Once counted at 'first'
+		due = earliest(due, first + (u16)(0 - frames)); // Wraps around: frameStart[] moves up (see countTimedFrame).
+		switch (move)
+		{
+		case Guarding:
+			break;
+		case Parrying:
+			due = earliest(due, framesAbove(first, frames, PARRY_FRAMES + FOLLOWUP_FRAMES));
+			break;
+		case Dying:
+			due = earliest(due, first + (u16)(DEATH_FRAMES - frames));
+			break;
+		default: // Attacks
+			due = earliest(due, first + (u16)(ATTACK_FRAMES - frames));
+			due = earliest(due, framesAbove(first, frames, ATTACK_FRAMES + FOLLOWUP_FRAMES));
+			break;
+		}
+	}
+	return due;
+}
+
+/*! Moves the timer of an entity to the next frame combatSystem has to visit it at. */
+static void scheduleTimer(World *world, EntitySlot entity) {
+	EntityTimers *timers = &world->timers;
+	if (entity == timers->cursor && timers->phase != TimerStarted && timers->phase != TimerVisited)
+		return; // Visiting it: scheduled when the visit ends.
+
+	// Timers of the current frame are in the queue, the others in the wheel.
+	if (timers->due[entity] != TIMER_NEVER && timers->due[entity] != timers->clock)
+		unlinkTimer(timers, entity);
+	timers->due[entity] = nextTimer(world, entity);
+	if (timers->due[entity] == TIMER_NEVER)
+		return;
+	if (timers->due[entity] != timers->clock)
+		linkTimer(timers, entity);
+	else if (!entityInSet(timers->queued, entity))
+		pushQueue(timers, entity);
+}
+
+
+// Entities.h
+
+u16 entityFrames(const World *world, EntitySlot entity) {
+	if (entity < ENTITY_COUNT && entityInSet(world->timers.running, entity))
+		return (u16)(world->timers.clock - world->timers.frameStart[entity] - framePending(world, entity));
+	return world->timing[entity].frames;
+}
+
+void setEntityFrames(World *world, EntitySlot entity, u16 frames) {
+	if (entity < ENTITY_COUNT && entityInSet(world->timers.running, entity)) {
+		stopFrames(world, entity);
+		startFrames(world, entity, world->timers.clock - frames - framePending(world, entity));
+		scheduleTimer(world, entity);
+	}
+	else
+		world->timing[entity].frames = frames;
+}
+
+u8 entityStaggered(const World *world, EntitySlot entity) {
+	if (entity < ENTITY_COUNT && entityInSet(world->timers.counting, entity))
+		return (u8)(world->timers.staggerEnd[entity] - world->timers.clock + staggerPending(world, entity));
+	return world->health[entity].staggered;
+}
+
+void setEntityStaggered(World *world, EntitySlot entity, u8 staggered) {
+	world->health[entity].staggered = staggered;
+	if (entity >= ENTITY_COUNT)
+		return;
+	if (entityInSet(world->timers.counting, entity))
+		stopStagger(world, entity);
+	if (staggered > 0)
+		startStagger(world, entity, world->timers.clock + staggered - staggerPending(world, entity));
+	scheduleTimer(world, entity);
+}
+
+void refreshEntityTimer(World *world, EntitySlot entity) {
+	u8 running = entityInSet(world->timers.running, entity);
+	if (!running && countsFrames(world->move[entity].move))
+		startFrames(world, entity, world->timers.clock - world->timing[entity].frames - framePending(world, entity));
+	else if (running && !countsFrames(world->move[entity].move)) {
+		world->timing[entity].frames = entityFrames(world, entity);
+		stopFrames(world, entity);
+	}
+	// Only a World written without setEntityStaggered has a 'staggered' above 0 that does not count.
+	if (!entityInSet(world->timers.counting, entity) && world->health[entity].staggered > 0)
+		startStagger(world, entity, world->timers.clock + world->health[entity].staggered - staggerPending(world, entity));
+	scheduleTimer(world, entity);
+}
+
+void clearEntityTimers(World *world) {
+	EntityTimers *timers = &world->timers;
+	timers->clock = TIMER_EPOCH;
+	timers->cursor = ENTITY_COUNT;
+	timers->phase = TimerVisited;
+	for (u32 word = 0; word < ENTITY_WORDS; ++word) {
+		timers->running[word] = 0;
+		timers->counting[word] = 0;
+		timers->queued[word] = 0;
+	}
+	for (EntitySlot entity = 0; entity < ENTITY_COUNT; ++entity)
+		timers->due[entity] = TIMER_NEVER;
+	for (u32 slot = 0; slot < TIMER_SLOTS; ++slot)
+		timers->slot[slot] = ENTITY_NONE;
+	timers->queueLength = 0;
+#ifdef ECS_WORLD_HASH
+	timers->runningKeys = 0;
+	timers->runningStarts = 0;
+	timers->countingKeys = 0;
+	timers->countingEnds = 0;
+#endif
+}
+
+
+// Timers.h
+
+void startTimerFrame(World *world) {
+	EntityTimers *timers = &world->timers;
+	++timers->clock;
+	timers->cursor = 0;
+	timers->phase = TimerStarted;
+
+	// The list of a wheel slot also holds timers due TIMER_SLOTS frames later, or more.
+	EntitySlot entity = timers->slot[timers->clock & (TIMER_SLOTS - 1)];
+	while (entity != ENTITY_NONE) {
+		EntitySlot next = timers->next[entity];
+		if (timers->due[entity] == timers->clock) {
+			unlinkTimer(timers, entity);
+			pushQueue(timers, entity);
+		}
+		entity = next;
+	}
+}
+
+EntitySlot nextTimedEntity(World *world) {
+	EntityTimers *timers = &world->timers;
+	if (timers->phase != TimerStarted) {
+		timers->phase = TimerVisited;
+		scheduleTimer(world, timers->cursor);
+	}
+
+	while (timers->queueLength > 0) {
+		EntitySlot entity = popQueue(timers);
+		if (timers->due[entity] == timers->clock) { // Else it was scheduled again since it was queued.
+			timers->cursor = entity;
+			timers->phase = TimerVisiting;
+			return entity;
+		}
+	}
+	timers->cursor = ENTITY_COUNT;
+	timers->phase = TimerVisited;
+	return ENTITY_COUNT;
+}
+
+void countTimedStagger(World *world, EntitySlot entity) {
+	world->timers.phase = TimerStaggerCounted;
+	if (entityInSet(world->timers.counting, entity) && world->timers.staggerEnd[entity] == world->timers.clock) {
+		setEntityStaggered(world, entity, 0);
+		refreshBusyEntity(world, entity);
+	}
+}
+
+void countTimedFrame(World *world, EntitySlot entity) {
+	EntityTimers *timers = &world->timers;
+	timers->phase = TimerFrameCounted;
+	if (timers->clock - timers->frameStart[entity] > 0xFFFF) {
+		// 'frames' wrapped around to 0. Keeps clock - frameStart[] equal to it, as the world hash needs.
+		u32 start = timers->frameStart[entity] + 0x10000;
+		stopFrames(world, entity);
+		startFrames(world, entity, start);
+	}
+}
+
+void stopTimerFrame(World *world) {
+	EntityTimers *timers = &world->timers;
+	EntitySlot last = timers->cursor;
+
+	while (timers->queueLength > 0)
+		popQueue(timers);
+	timers->cursor = ENTITY_COUNT;
+	timers->phase = TimerVisited;
+	scheduleTimer(world, last);
+
+	// Entities after the last one visited do not count in this frame: their counts start and end one frame later.
+	for (EntitySlot entity = nextEntityWith(world, ENTITY_BUSY, last + 1); entity < ENTITY_COUNT; entity = nextEntityWith(world, ENTITY_BUSY, entity + 1)) {
+		if (entityInSet(timers->running, entity)) {
+			u32 start = timers->frameStart[entity] + 1;
+			stopFrames(world, entity);
+			startFrames(world, entity, start);
+		}
+		if (entityInSet(timers->counting, entity)) {
+			u32 end = timers->staggerEnd[entity] + 1;
+			stopStagger(world, entity);
+			startStagger(world, entity, end);
+		}
+		scheduleTimer(world, entity);
+	}
+}
+
+u32 quietTimerFrames(const World *world, u32 limit) {
+	const EntityTimers *timers = &world->timers;
+	u32 quiet = limit;
+
+	// Between frames, every timer is due after the clock. One turn of the wheel holds all of them.
+	for (u32 frame = 1; frame <= quiet && frame <= TIMER_SLOTS; ++frame)
+		for (EntitySlot entity = timers->slot[(timers->clock + frame) & (TIMER_SLOTS - 1)]; entity != ENTITY_NONE; entity = timers->next[entity])
+			if (timers->due[entity] - timers->clock <= quiet)
+				quiet = timers->due[entity] - timers->clock - 1;
+	return quiet;
+}
+
+void skipTimerFrames(World *world, u32 frames) {
+	// Every count follows the clock, and the wheel slots passed hold no timer due before the next frame.
+	world->timers.clock += frames;
+}
+
+#endif // ECS_TIMER_WHEEL
+
+#endif // !ECS_TIMERS
@@ -0,0 +1,2 @@
+SPRITE_DELTA mockPlayer_delta "sprite/mockPlayer.png" 12 12
+SPRITE_DELTA mockEnemy_delta "sprite/mockEnemy.png" 12 12
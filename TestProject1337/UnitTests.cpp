@@ -9,6 +9,9 @@ using namespace Microsoft::VisualStudio::TestTools::UnitTesting;
 #include "../MegaDriveGOTY2018/Gemu/src/Model.c"
 #include "../MegaDriveGOTY2018/Gemu/src/Entities.c"
 #include "../MegaDriveGOTY2018/Gemu/src/Systems.c"
+#include "../MegaDriveGOTY2018/Gemu/src/Random.c"
+#include "../MegaDriveGOTY2018/Gemu/src/Timers.c"
+#include "../MegaDriveGOTY2018/Gemu/src/Profile.c"
 
 
 
@@ -19,6 +22,7 @@ using namespace Microsoft::VisualStudio::TestTools::UnitTesting;
 namespace TestProject1337
 {
 	World world;
+	SimContext context;
 	EventQueue queue;
 	ButtonInput buttonInput;
 
@@ -80,7 +84,7 @@ namespace TestProject1337
 			// [0..n] are enemies, [n-m] are teammates, where
 			// n are # of enemies and m are # of teammates.
 			enemy1 = createEnemyChar(&world, mockEnemy);
-			player1 = createPlayerChar(&world, mockPlayer1, 0);
+			player1 = createPlayerChar(&world, &context, mockPlayer1, 0);
 
 			//world.timing[player1].facing = enemy1; // set to lowest AI entity ID
 			//world.timing[enemy1].facing = player1; // set to lowest player entity ID
@@ -95,7 +99,7 @@ namespace TestProject1337
 			u8 updatesToRun = 1;
 
 			for (int i = 0; i < updatesToRun; ++i)
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 
 			destroyEntity(&world, 0);
 			u8 empty = nextEmptyEntitySlot(&world);
@@ -111,7 +115,7 @@ namespace TestProject1337
 			Assert::AreEqual((u16)0, world.timing[player1].frames);
 			Assert::AreEqual((u8)Idling, world.move[player1].move);
 
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 
 			// Still no moves are being made currently
 			Assert::AreEqual((u8)10, world.health[player1].points);
@@ -122,7 +126,7 @@ namespace TestProject1337
 
 			// Press A button.
 			buttonInput = { TRUE, A };
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 
 			// Fast attack is executing.
 			Assert::AreEqual((u16)1, world.timing[player1].frames);
@@ -135,7 +139,7 @@ namespace TestProject1337
 			// Let first move's frames pass.
 			for (u8 i = 1; i < ATTACK_FRAMES; ++i) {
 				Assert::AreEqual((u16)i, world.timing[player1].frames);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 
 			//On the move's last frame, enemy receives clean hit losing 4 HP.
@@ -144,11 +148,11 @@ namespace TestProject1337
 			for (u8 i = ATTACK_FRAMES; i <= (ATTACK_FRAMES + FOLLOWUP_FRAMES); ++i) {
 				Assert::AreEqual((u16)i, world.timing[player1].frames);
 				Assert::AreEqual((u8)1, world.move[player1].move); // Fast attack still active.
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 
 			// On the next frame, reset to no attack executing.
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 			Assert::AreEqual((u8)Idling, world.move[player1].move);
 			Assert::AreEqual((u16)0, world.timing[player1].frames);
 
@@ -161,24 +165,24 @@ namespace TestProject1337
 		void TestCase1Alt1_1() {
 			buttonInput = { TRUE, A };
 
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 			buttonInput = { FALSE, A };
 
 			for (u8 i = 1; i <= ATTACK_FRAMES; ++i)
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 
 			Assert::AreEqual((u8)A1, world.move[player1].move);
 			Assert::AreEqual((u8)6, world.health[enemy1].points);
 
 			buttonInput = { TRUE, A };
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 			buttonInput = { FALSE, A };
 
 			Assert::AreEqual((u8)A2, world.move[player1].move);
 			Assert::AreEqual((u8)6, world.health[enemy1].points);
 
 			for (u8 i = 1; i <= ATTACK_FRAMES; ++i)
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 
 			Assert::AreEqual((u8)A2, world.move[player1].move);
 			Assert::AreEqual((u8)2, world.health[enemy1].points);
@@ -190,24 +194,24 @@ namespace TestProject1337
 			world.health[enemy1].points = 31; // some high value
 
 			Assert::AreEqual((u8)Idling, world.move[player1].move);
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 
 			//Do A1->A2->A3->A1... combo 6 times.
 			for (int j = 0; j < 2; j++) {
 
 				for (int i = 0; i <= ATTACK_FRAMES; i++) {
 					Assert::AreEqual((u8)A1, world.move[player1].move);
-					queue = updateWorld(&world, &buttonInput);
+					queue = updateWorld(&world, &context, &buttonInput);
 				}
 
 				for (int i = 0; i <= ATTACK_FRAMES; i++) {
 					Assert::AreEqual((u8)A2, world.move[player1].move);
-					queue = updateWorld(&world, &buttonInput);
+					queue = updateWorld(&world, &context, &buttonInput);
 				}
 
 				for (int i = 0; i <= ATTACK_FRAMES; i++) {
 					Assert::AreEqual((u8)A3, world.move[player1].move);
-					queue = updateWorld(&world, &buttonInput);
+					queue = updateWorld(&world, &context, &buttonInput);
 				}
 			}
 
@@ -221,7 +225,7 @@ namespace TestProject1337
 
 			for (u8 i = 0; i < ATTACK_FRAMES; i++) {
 				Assert::AreEqual((u8)10, world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)B1, world.move[player1].move);
 			}
 
@@ -235,16 +239,16 @@ namespace TestProject1337
 
 			for (u8 i = 0; i < ATTACK_FRAMES; i++) {
 				Assert::AreEqual((u8)10, world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)A1, world.move[player1].move);
 			}
 
 			buttonInput = { TRUE, B };
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 
 			for (u8 i = 0; i < ATTACK_FRAMES; i++) {
 				Assert::AreEqual((u8)6, world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)B2, world.move[player1].move);
 			}
 
@@ -258,25 +262,25 @@ namespace TestProject1337
 
 			for (u8 i = 0; i < ATTACK_FRAMES; i++) {
 				Assert::AreEqual((u8)10, world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)A1, world.move[player1].move);
 			}
 
 			buttonInput = { TRUE, A };
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 
 			for (u8 i = 0; i < ATTACK_FRAMES; i++) {
 				Assert::AreEqual((u8)6, world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)A2, world.move[player1].move);
 			}
 
 			buttonInput = { TRUE, B };
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 
 			for (u8 i = 0; i < ATTACK_FRAMES; i++) {
 				Assert::AreEqual((u8)2, world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)B3, world.move[player1].move);
 			}
 
@@ -292,34 +296,34 @@ namespace TestProject1337
 
 			for (u8 i = 0; i < ATTACK_FRAMES; i++) {
 				Assert::AreEqual((u8)31, world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)A1, world.move[player1].move);
 			}
 
 			buttonInput = { TRUE, A };
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 
 			for (u8 i = 0; i < ATTACK_FRAMES; i++) {
 				Assert::AreEqual((u8)(31 - 4), world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)A2, world.move[player1].move);
 			}
 
 			buttonInput = { TRUE, A };
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 
 			for (u8 i = 0; i < ATTACK_FRAMES; i++) {
 				Assert::AreEqual((u8)(31 - 8), world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)A3, world.move[player1].move);
 			}
 
 			buttonInput = { TRUE, B };
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 
 			for (u8 i = 0; i < ATTACK_FRAMES; i++) {
 				Assert::AreEqual((u8)(31 - 12), world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)B1, world.move[player1].move);
 			}
 
@@ -335,27 +339,27 @@ namespace TestProject1337
 			Assert::IsTrue(world.teamMember[player1].isActive);
 
 			for (u8 i = 0; i < 30; ++i)
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 
 			// With only 1 player character, character switch does nothing.
 			Assert::IsTrue(world.teamMember[player1].isActive);
 			Assert::AreEqual(player1, searchForNextPlayerCharacter(&world, player1));
 
 			// Create 2nd character.
-			u8 player2 = createPlayerChar(&world, mockPlayer2, 1);
+			u8 player2 = createPlayerChar(&world, &context, mockPlayer2, 1);
 			Assert::AreEqual(player2, searchForNextPlayerCharacter(&world, player1));
 			Assert::AreEqual(player1, searchForNextPlayerCharacter(&world, player2));
 
 			Assert::IsTrue(world.teamMember[player1].isActive);
 
 			for (u8 i = 0; i < STAGGERED_FRAMES; ++i) {
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::IsFalse(world.teamMember[player1].isActive);
 				Assert::IsTrue(world.teamMember[player2].isActive);
 			}
 
 			for (u8 i = 0; i < STAGGERED_FRAMES; ++i) {
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::IsTrue(world.teamMember[player1].isActive);
 				Assert::IsFalse(world.teamMember[player2].isActive);
 			}
@@ -363,24 +367,24 @@ namespace TestProject1337
 			Assert::AreEqual(enemy1, world.timing[player2].facing);
 
 			// Create third character
-			u8 player3 = createPlayerChar(&world, mockPlayer2, 2);
+			u8 player3 = createPlayerChar(&world, &context, mockPlayer2, 2);
 			Assert::AreEqual(player2, searchForNextPlayerCharacter(&world, player1));
 			Assert::AreEqual(player3, searchForNextPlayerCharacter(&world, player2));
 			Assert::AreEqual(player1, searchForNextPlayerCharacter(&world, player3));
 
 			for (u8 i = 0; i < STAGGERED_FRAMES; ++i) {
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::IsTrue(world.teamMember[player2].isActive);
 			}
 
 			for (u8 i = 0; i < STAGGERED_FRAMES; ++i) {
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::IsTrue(world.teamMember[player3].isActive);
 			}
 
-			//queue = updateWorld(&world, &buttonInput);
+			//queue = updateWorld(&world, &context, &buttonInput);
 			for (u8 i = 0; i < STAGGERED_FRAMES; ++i) {
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::IsTrue(world.teamMember[player1].isActive);
 			}
 
@@ -391,36 +395,36 @@ namespace TestProject1337
 		void TestCase3Alt1() {
 
 			world.health[enemy1].points = 31;
-			u8 player2 = createPlayerChar(&world, mockPlayer2, 1);
+			u8 player2 = createPlayerChar(&world, &context, mockPlayer2, 1);
 
 			buttonInput = { TRUE, A };
 
 			for (u8 i = 0; i < ATTACK_FRAMES; i++) {
 				Assert::AreEqual((u8)31, world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)A1, world.move[player1].move);
 			}
 
 			buttonInput = { TRUE, B };
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 
 			for (u8 i = 0; i < ATTACK_FRAMES; i++) {
 				Assert::AreEqual((u8)(31 - 4), world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)B2, world.move[player1].move);
 			}
 
 			buttonInput = { TRUE, C };
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 			// Need one more iteration to switch to next character.
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 			Assert::IsTrue(world.teamMember[player2].isActive);
 
 			// Note: one less iteration in this loop, i = 1
 			for (u8 i = 1; i < ATTACK_FRAMES; i++) {
 				Assert::IsTrue(world.teamMember[player2].isActive);
 				Assert::AreEqual((u8)(31 - 8), world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)A3, world.move[player2].move);
 			}
 
@@ -433,7 +437,7 @@ namespace TestProject1337
 			buttonInput = { TRUE, A };
 
 			for (u8 i = 1; i < ATTACK_FRAMES; i++) {
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)A1, world.move[player1].move);
 				Assert::AreEqual((u8)10, world.health[enemy1].points);
 			}
@@ -443,7 +447,7 @@ namespace TestProject1337
 
 			// Enemy should've taken no damage because of well-timed parry.
 			for (u8 i = 1; i < PARRY_FRAMES; i++) {
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)10, world.health[enemy1].points);
 				Assert::AreEqual((u8)Staggered, world.move[player1].move);
 			}
@@ -454,7 +458,7 @@ namespace TestProject1337
 			buttonInput = { TRUE, A };
 
 			for (u8 i = 0; i < PARRY_FRAMES; i++) {
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)A1, world.move[player1].move);
 				Assert::AreEqual((u8)10, world.health[enemy1].points);
 			}
@@ -464,7 +468,7 @@ namespace TestProject1337
 
 			for (u8 i = 0; i < PARRY_FRAMES; i++) {
 				Assert::AreEqual((u8)10, world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)A1, world.move[player1].move);
 
 			}
@@ -480,14 +484,14 @@ namespace TestProject1337
 
 			// Guard for a while
 			for (u8 i = 0; i < ATTACK_FRAMES; i++)
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 
 			buttonInput = { TRUE, A };
 
 			for (u8 i = 0; i < ATTACK_FRAMES; i++) {
 				Assert::AreEqual((u8)10, world.health[enemy1].points);
 				Assert::AreEqual((u8)Guarding, world.move[enemy1].move);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)A1, world.move[player1].move);
 
 			}
@@ -502,7 +506,7 @@ namespace TestProject1337
 			buttonInput = { TRUE, A };
 
 			for (u8 i = 1; i < ATTACK_FRAMES; i++) {
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)A1, world.move[player1].move);
 				Assert::AreEqual((u8)10, world.health[enemy1].points);
 			}
@@ -511,7 +515,7 @@ namespace TestProject1337
 			buttonInput = { FALSE, A };
 
 			for (u8 i = 1; i < ATTACK_FRAMES; i++) {
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)10, world.health[enemy1].points);
 			}
 
@@ -522,12 +526,12 @@ namespace TestProject1337
 		[TestMethod]
 		void TestCase7MainScenario() {
 
-			DoBasicAttack(&world, enemy1);
+			DoBasicAttack(&world, &context, enemy1);
 
 			// Let first move's frames pass.
 			for (u8 i = 0; i < ATTACK_FRAMES; ++i) {
 				Assert::AreEqual((u16)i, world.timing[enemy1].frames);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 
 			//On the move's last frame, player receives clean hit losing 4 HP.
@@ -535,15 +539,15 @@ namespace TestProject1337
 
 			// Let time pass
 			for (u8 i = 0; i <= ATTACK_FRAMES; ++i)
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 
 			// Attack again
-			DoBasicAttack(&world, enemy1);
+			DoBasicAttack(&world, &context, enemy1);
 
 			// Let move frames pass.
 			for (u8 i = 0; i < (ATTACK_FRAMES - 1); ++i) {
 				Assert::AreEqual((u16)i, world.timing[enemy1].frames);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 
 			//DoParry(&world, player1);
@@ -552,19 +556,19 @@ namespace TestProject1337
 			// Player parried successfully and won't receive damage.
 			for (u8 i = 0; i < (PARRY_FRAMES); ++i) {
 				Assert::AreEqual((u8)6, world.health[player1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 		}
 
 		[TestMethod]
 		void TestCase8MainScenario() {
 
-			DoSpecialAttack(&world, enemy1);
+			DoSpecialAttack(&world, &context, enemy1);
 
 			// Let first move's frames pass.
 			for (u8 i = 0; i < ATTACK_FRAMES; ++i) {
 				Assert::AreEqual((u16)i, world.timing[enemy1].frames);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 
 			//On the move's last frame, player receives clean hit losing 4 HP.
@@ -572,15 +576,15 @@ namespace TestProject1337
 
 			// Let time pass
 			for (u8 i = 0; i <= ATTACK_FRAMES; ++i)
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 
 			// Attack again
-			DoSpecialAttack(&world, enemy1);
+			DoSpecialAttack(&world, &context, enemy1);
 
 			// Let move frames pass.
 			for (u8 i = 0; i < (ATTACK_FRAMES - 1); ++i) {
 				Assert::AreEqual((u16)i, world.timing[enemy1].frames);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 
 			DoParry(&world, player1);
@@ -588,15 +592,15 @@ namespace TestProject1337
 			// Player parried successfully and won't receive damage.
 			for (u8 i = 0; i < (PARRY_FRAMES); ++i) {
 				Assert::AreEqual((u8)6, world.health[player1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 
 			// Let time pass
 			for (u8 i = 0; i <= ATTACK_FRAMES; ++i)
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 
 			// Attack again
-			DoSpecialAttack(&world, enemy1);
+			DoSpecialAttack(&world, &context, enemy1);
 
 			// Context: DoGuard works fine for enemies.
 			// But for players, guarding only works while button down is held.
@@ -605,7 +609,7 @@ namespace TestProject1337
 			// Let move frames pass.
 			for (u8 i = 0; i < (ATTACK_FRAMES); ++i) {
 				Assert::AreEqual((u16)i, world.timing[enemy1].frames);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 
 			// Blocking Heavy Attacks shaves off 2 HP.
@@ -613,8 +617,8 @@ namespace TestProject1337
 
 			buttonInput = { FALSE, Down };
 
-			queue = updateWorld(&world, &buttonInput);
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 
 			Assert::AreEqual((u8)Idling, world.move[player1].move);
 
@@ -627,20 +631,20 @@ namespace TestProject1337
 			// Let move frames pass.
 			for (u8 i = 0; i < (ATTACK_FRAMES - 1); ++i) {
 				Assert::AreEqual((u16)i, world.timing[player1].frames);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 
 			DoGuard(&world, enemy1);
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 
 			// Enemy guarded perfectly and took no damage.
 			Assert::AreEqual((u8)10, world.health[player1].points);
-			queue = updateWorld(&world, &buttonInput);
-			queue = updateWorld(&world, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
+			queue = updateWorld(&world, &context, &buttonInput);
 
 			for (u8 i = 1; i < (ATTACK_FRAMES); ++i) {
 				Assert::AreEqual((u16)i, world.timing[player1].frames);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 
 			// Player shaves off 1 HP from guarding enemy.
@@ -650,12 +654,12 @@ namespace TestProject1337
 		[TestMethod]
 		void TestCase10MainScenario() {
 
-			DoBasicAttack(&world, player1);
+			DoBasicAttack(&world, &context, player1);
 
 			// Let move frames pass.
 			for (u8 i = 0; i < (ATTACK_FRAMES - 1); ++i) {
 				Assert::AreEqual((u16)i, world.timing[player1].frames);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 
 			DoParry(&world, enemy1);
@@ -663,7 +667,7 @@ namespace TestProject1337
 			// Enemy parried successfully and won't receive damage.
 			for (u8 i = 0; i < (PARRY_FRAMES); ++i) {
 				Assert::AreEqual((u8)10, world.health[enemy1].points);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 		}
 
@@ -676,6 +680,56 @@ namespace TestProject1337
 			Assert::AreEqual((u8)255, nextEmptyEntitySlot(&world));
 		}
 
+		[TestMethod]
+		void TestFreeListReuse() {
+			destroyEntity(&world, enemy1);
+			destroyEntity(&world, player1);
+			// Most recently destroyed slot first, then the other one, then the untouched ones.
+			Assert::AreEqual(player1, createEnemyChar(&world, mockEnemy));
+			Assert::AreEqual(enemy1, createEnemyChar(&world, mockEnemy));
+			Assert::AreEqual((u8)2, createEnemyChar(&world, mockEnemy));
+
+			destroyEntity(&world, 1);
+			destroyEntity(&world, 1); // Destroying an unused slot does nothing.
+			Assert::AreEqual((u8)1, createEnemyChar(&world, mockEnemy));
+			Assert::AreEqual((u8)3, nextEmptyEntitySlot(&world));
+		}
+
+		[TestMethod]
+		void TestStaleHandle() {
+			EntityHandle handle = entityHandle(&world, enemy1);
+			Assert::AreEqual(enemy1, entityOfHandle(&world, handle));
+
+			destroyEntity(&world, enemy1);
+			Assert::AreEqual((u8)ENTITY_NONE, entityOfHandle(&world, handle));
+
+			// The slot is reused, but the handle still refers to the destroyed entity.
+			Assert::AreEqual(enemy1, createEnemyChar(&world, mockEnemy));
+			Assert::AreEqual((u8)ENTITY_NONE, entityOfHandle(&world, handle));
+			Assert::AreEqual(enemy1, entityOfHandle(&world, entityHandle(&world, enemy1)));
+		}
+
+		[TestMethod]
+		void TestStaleOpponent() {
+			u8 player2 = createPlayerChar(&world, &context, mockPlayer2, 1);
+			setFacing(&world, enemy1, player2);
+			Assert::AreEqual(player2, facedEntity(&world, enemy1));
+
+			// The reserve character dies while the enemy still faces it, and its slot is reused.
+			destroyEntity(&world, player2);
+			Assert::AreEqual((u8)ENTITY_NONE, facedEntity(&world, enemy1));
+			Assert::AreEqual(player2, createPlayerChar(&world, &context, mockPlayer2, 1));
+			Assert::AreEqual((u8)ENTITY_NONE, facedEntity(&world, enemy1));
+
+			// The attack of the enemy lands on nobody.
+			setMove(&world, enemy1, A1);
+			for (u8 i = 0; i < ATTACK_FRAMES; ++i)
+				combatSystem(&world, &context);
+			Assert::AreEqual((u8)10, world.health[player2].points);
+			Assert::AreEqual((u8)10, world.health[player1].points);
+			Assert::AreEqual((u8)0, context.eventSFX);
+		}
+
 		[TestMethod]
 		void TestPlayerDying() {
 			DealDamage(&world, player1, 25, TRUE);
@@ -686,7 +740,7 @@ namespace TestProject1337
 
 			for (u16 i = 0; i < DEATH_FRAMES; ++i) {
 				Assert::AreEqual((u16)i, world.timing[player1].frames);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 		}
 
@@ -700,7 +754,7 @@ namespace TestProject1337
 
 			for (u16 i = 0; i < DEATH_FRAMES; ++i) {
 				Assert::AreEqual((u16)i, world.timing[enemy1].frames);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 			}
 		}
 
@@ -711,8 +765,8 @@ namespace TestProject1337
 			enemy1 = createEnemyChar(&world, mockEnemy);
 			u8 enemy2 = createEnemyChar(&world, mockEnemy);
 			u8 enemy3 = createEnemyChar(&world, mockEnemy);
-			player1 = createPlayerChar(&world, mockPlayer1, 0);
-			u8 player2 = createPlayerChar(&world, mockPlayer2, 1);
+			player1 = createPlayerChar(&world, &context, mockPlayer1, 0);
+			u8 player2 = createPlayerChar(&world, &context, mockPlayer2, 1);
 
 			Assert::AreEqual(player1, world.timing[enemy3].facing);
 			Assert::AreEqual(enemy3, world.timing[player1].facing);
@@ -734,7 +788,7 @@ namespace TestProject1337
 					Assert::AreEqual((u8)0, world.health[(u8)i].points);
 					Assert::AreEqual((u16)j, world.timing[(u8)i].frames);
 					Assert::AreEqual((u8)Dying, world.move[(u8)i].move);
-					queue = updateWorld(&world, &buttonInput);
+					queue = updateWorld(&world, &context, &buttonInput);
 				}
 
 				// Enemy should've switched automatically if next is available.
@@ -755,7 +809,7 @@ namespace TestProject1337
 			u8 enemy2 = createEnemyChar(&world, mockEnemy);
 			u8 enemy3 = createEnemyChar(&world, mockEnemy);
 			u8 enemy4 = createEnemyChar(&world, mockEnemy);
-			player1 = createPlayerChar(&world, mockPlayer1, 0);
+			player1 = createPlayerChar(&world, &context, mockPlayer1, 0);
 
 			Assert::AreEqual(player1, world.timing[enemy4].facing);
 			Assert::AreEqual(enemy4, world.timing[player1].facing);
@@ -763,7 +817,7 @@ namespace TestProject1337
 			buttonInput = { TRUE, A };
 
 			while (world.health[enemy4].points != 0) {
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)10, world.health[player1].points);
 			}
 
@@ -771,7 +825,7 @@ namespace TestProject1337
 			while (world.timing[player1].facing == enemy4)
 			{
 				Assert::AreEqual((u8)Dying, world.move[enemy4].move);
-				queue = updateWorld(&world, &buttonInput);
+				queue = updateWorld(&world, &context, &buttonInput);
 				Assert::AreEqual((u8)10, world.health[player1].points);
 			}
 